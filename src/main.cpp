@@ -4,19 +4,26 @@
 #include <QQmlContext>
 #include <QIcon>
 #include <QDir>
+#include <QQuickWindow>
 #include "plugins.h"
 #include "rrcore/database/databaseserver.h"
+#include "rrcore/database/imagecache.h"
+#include "rrcore/qmlapi/qmlimageprovider.h"
 #include "singletons/logger.h"
+#include "singletons/startupprofiler.h"
 
 int main(int argc, char *argv[])
 {
+    StartupProfiler::instance(); // Start the clock
 #if defined(Q_OS_WIN) || defined(Q_OS_ANDROID)
     QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 #endif
     //qputenv("QT_SCALE_FACTOR", "1.4");
     QApplication app(argc, argv);
+    StartupProfiler::instance().mark("create_application");
 
     Logger::instance().start();
+    StartupProfiler::instance().mark("start_logger");
 
     QApplication::setApplicationName("Record Rack");
     QGuiApplication::setApplicationVersion("0.0.1");
@@ -25,17 +32,22 @@ int main(int argc, char *argv[])
     app.setWindowIcon(QIcon(":/images/rr_logo.png"));
 
     Plugins::registerFonts();
+    StartupProfiler::instance().mark("register_fonts");
     Plugins::registerTypes();
     QQuickStyle::setStyle("Material");
+    StartupProfiler::instance().mark("register_types");
 
     QQmlApplicationEngine engine;
     engine.addImportPath(QDir::fromNativeSeparators(QCoreApplication::applicationDirPath())
                          + "/../3rdparty/fluid/qml");
+    engine.addImageProvider(ImageCache::PROVIDER_ID, new QMLImageProvider);
     engine.load(QUrl(QLatin1String("qrc:/main.qml")));
     if (engine.rootObjects().isEmpty())
         return -1;
 
     engine.rootContext()->setContextProperty("MainWindow", engine.rootObjects().last());
+    StartupProfiler::instance().mark("load_qml");
+    StartupProfiler::instance().watch(qobject_cast<QQuickWindow *>(engine.rootObjects().last()));
 
     return app.exec();
 }
@@ -43,6 +43,8 @@
 #include "rrcore/qmlapi/qmlexpensetransactionmodel.h"
 #include "rrcore/qmlapi/qmlstockitemmodel.h"
 #include "rrcore/qmlapi/qmlstockitemcountrecord.h"
+#include "rrcore/qmlapi/qmlquerymetricsmodel.h"
+#include "rrcore/qmlapi/qmlindexadvicemodel.h"
 
 #include "rrcore/widgets/dialogs.h"
 #include "rrcore/user/businessdetails.h"
@@ -103,6 +105,8 @@ void Plugins::registerTypes()
     qmlRegisterType<QMLExpenseTransactionModel>("com.gecko.rr.models", 1, 0, "ExpenseTransactionModel");
     qmlRegisterType<QMLStockItemModel>("com.gecko.rr.models", 1, 0, "StockItemModel");
     qmlRegisterType<QMLStockItemCountRecord>("com.gecko.rr.models", 1, 0, "StockItemCountRecord");
+    qmlRegisterType<QMLQueryMetricsModel>("com.gecko.rr.models", 1, 0, "QueryMetricsModel");
+    qmlRegisterType<QMLIndexAdviceModel>("com.gecko.rr.models", 1, 0, "IndexAdviceModel");
 
     // Components
     qmlRegisterType<QMLDoubleValidator>("com.gecko.rr.components", 1, 0, "DoubleValidator");
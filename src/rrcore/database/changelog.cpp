@@ -0,0 +1,449 @@
+#include "changelog.h"
+#include "databaseexception.h"
+#include "databaseutils.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QRegularExpression>
+#include <QHash>
+#include <QSet>
+
+QStringList ChangeLog::tables()
+{
+    // NOTE: Keep in sync with the triggers in changelog.sql. Tables come after the
+    // tables they refer to, which is the order pulled changes are applied in.
+    return {
+        QStringLiteral("note"), QStringLiteral("client"), QStringLiteral("category"), QStringLiteral("item"),
+        QStringLiteral("unit"), QStringLiteral("unit_relation"), QStringLiteral("current_quantity"),
+        QStringLiteral("initial_quantity"), QStringLiteral("damaged_quantity"), QStringLiteral("customer"),
+        QStringLiteral("vendor"), QStringLiteral("debtor"), QStringLiteral("creditor"),
+        QStringLiteral("expense_purpose"), QStringLiteral("income_purpose"), QStringLiteral("expense"),
+        QStringLiteral("expense_payment"), QStringLiteral("income"), QStringLiteral("income_payment"),
+        QStringLiteral("sale_transaction"), QStringLiteral("sale_item"), QStringLiteral("sale_payment"),
+        QStringLiteral("purchase_transaction"), QStringLiteral("purchase_item"), QStringLiteral("purchase_payment"),
+        QStringLiteral("debt_transaction"), QStringLiteral("debt_payment"), QStringLiteral("credit_transaction"),
+        QStringLiteral("credit_payment")
+    };
+}
+
+qint64 ChangeLog::watermark(const QString &connectionName, const QString &name)
+{
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    query.prepare(QStringLiteral("SELECT sequence FROM sync_watermark WHERE name = ?"));
+    query.addBindValue(name);
+    if (!query.exec())
+        throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to read sync watermark '%1'.").arg(name));
+
+    return query.next() ? query.value(0).toLongLong() : 0;
+}
+
+QVariantMap ChangeLog::collect(const QString &connectionName,
+                               const QString &rackId,
+                               qint64 afterSequence,
+                               int limit)
+{
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    QSqlQuery originQuery(QSqlDatabase::database(connectionName));
+    QHash<QString, QVariantMap> origins;
+    query.prepare(QStringLiteral("CALL ViewChangeLog(?, ?)"));
+    query.addBindValue(afterSequence);
+    query.addBindValue(limit);
+    if (!query.exec())
+        throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to read change log."));
+
+    // NOTE: Only the last operation on a row matters; its current state is read below.
+    QHash<QString, QHash<int, QString>> operations;
+    qint64 lastSequence = afterSequence;
+    int entryCount = 0;
+    while (query.next()) {
+        operations[query.value("table_name").toString()].insert(query.value("row_id").toInt(),
+                                                                query.value("operation").toString());
+        lastSequence = query.value("sequence").toLongLong();
+        ++entryCount;
+    }
+
+    const QStringList &capturedTables = tables();
+    QVariantMap changes;
+    for (auto iter = operations.cbegin(); iter != operations.cend(); ++iter) {
+        const QString &table = iter.key();
+        if (!capturedTables.contains(table))
+            continue;
+
+        QStringList placeholders;
+        QVariantList changedIds;
+        QSet<int> deletedIds;
+        for (auto operation = iter.value().cbegin(); operation != iter.value().cend(); ++operation) {
+            if (operation.value() == QStringLiteral("D")) {
+                deletedIds.insert(operation.key());
+            } else {
+                placeholders.append(QStringLiteral("?"));
+                changedIds.append(operation.key());
+            }
+        }
+
+        QVariantList rows;
+        if (!changedIds.isEmpty()) {
+            query.prepare(QStringLiteral("SELECT * FROM %1 WHERE id IN (%2) ORDER BY id")
+                          .arg(table, placeholders.join(", ")));
+            for (const QVariant &id : changedIds)
+                query.addBindValue(id);
+            if (!query.exec())
+                throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                        query.lastError().text(),
+                                        QStringLiteral("Failed to read changed rows of '%1'.").arg(table));
+
+            QSet<int> foundIds;
+            while (query.next()) {
+                const QSqlRecord &record = query.record();
+                QVariantMap row;
+                for (int i = 0; i < record.count(); ++i)
+                    row.insert(record.fieldName(i), record.value(i));
+
+                foundIds.insert(row.value("id").toInt());
+                rows.append(row);
+            }
+
+            // NOTE: Rows and references are sent under the rack that wrote them and their id there.
+            for (QVariant &row : rows) {
+                QVariantMap record = row.toMap();
+                for (auto column = record.begin(); column != record.end(); ++column) {
+                    const QString &referencedTable = ChangeLog::referencedTable(column.key());
+                    if (!referencedTable.isEmpty() && column.value().toInt() > 0)
+                        column.value() = origin(originQuery, rackId, referencedTable, column.value().toInt(), origins);
+                }
+
+                const QVariantMap &rowOrigin = origin(originQuery, rackId, table, record.value("id").toInt(), origins);
+                record.insert("origin_rack_id", rowOrigin.value("origin_rack_id"));
+                record.insert("id", rowOrigin.value("id"));
+                row = record;
+            }
+
+            // NOTE: A row deleted after this batch was logged is sent as deleted.
+            for (const QVariant &id : changedIds) {
+                if (!foundIds.contains(id.toInt()))
+                    deletedIds.insert(id.toInt());
+            }
+        }
+
+        QVariantList deleted;
+        for (const int id : deletedIds)
+            deleted.append(origin(originQuery, rackId, table, id, origins));
+
+        changes.insert(table, QVariantMap {
+                           { "rows", rows },
+                           { "deleted", deleted }
+                       });
+    }
+
+    return {
+        { "changes", changes },
+        { "first_sequence", afterSequence + 1 },
+        { "last_sequence", lastSequence },
+        { "has_more", entryCount == limit }
+    };
+}
+
+void ChangeLog::acknowledge(const QString &connectionName, qint64 sequence)
+{
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    query.prepare(QStringLiteral("CALL AcknowledgeChangeLog(?)"));
+    query.addBindValue(sequence);
+    if (!query.exec())
+        throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to acknowledge change log up to %1.").arg(sequence));
+}
+
+void ChangeLog::apply(const QString &connectionName,
+                      const QString &rackId,
+                      const QVariantMap &changes,
+                      qint64 sequence)
+{
+    const QStringList &capturedTables = tables();
+    for (const QString &table : changes.keys()) {
+        if (!capturedTables.contains(table))
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    QStringLiteral("Table '%1' is not synchronized.").arg(table));
+    }
+
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    DatabaseUtils::beginTransaction(query);
+
+    try {
+        setCaptureSuppressed(query, true);
+
+        // NOTE: Parents are applied first, so that the references of a row can be mapped to local ids.
+        QHash<QString, int> localIds;
+        for (const QString &table : capturedTables) {
+            if (!changes.contains(table))
+                continue;
+
+            const QVariantMap &change = changes.value(table).toMap();
+            mergeRows(query, rackId, table, change.value("rows").toList(), change.value("deleted").toList(), localIds);
+        }
+
+        query.prepare(QStringLiteral("CALL UpdateSyncWatermark(?, ?)"));
+        query.addBindValue(PULLED_WATERMARK);
+        query.addBindValue(sequence);
+        if (!query.exec())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to store sync watermark."));
+
+        setCaptureSuppressed(query, false);
+        DatabaseUtils::commitTransaction(query);
+    } catch (DatabaseException &) {
+        DatabaseUtils::rollbackTransaction(query);
+        query.exec(QStringLiteral("SET @rr_capture_suppressed = NULL"));
+        throw;
+    }
+}
+
+void ChangeLog::setCaptureSuppressed(QSqlQuery &query, bool suppressed)
+{
+    if (!query.exec(suppressed ? QStringLiteral("SET @rr_capture_suppressed = 1")
+                               : QStringLiteral("SET @rr_capture_suppressed = NULL")))
+        throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to toggle change capture."));
+}
+
+void ChangeLog::applyRows(QSqlQuery &query,
+                          const QString &table,
+                          const QVariantList &rows,
+                          const QVariantList &deletedIds)
+{
+    static const QRegularExpression columnPattern(QStringLiteral("^[a-z_][a-z0-9_]*$"));
+
+    for (const QVariant &row : rows) {
+        const QVariantMap &record = row.toMap();
+        QStringList columns;
+        QStringList placeholders;
+        for (const QString &column : record.keys()) {
+            if (!columnPattern.match(column).hasMatch())
+                throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                        QStringLiteral("Invalid column '%1' in table '%2'.").arg(column, table));
+            columns.append(column);
+            placeholders.append(QStringLiteral("?"));
+        }
+
+        query.prepare(QStringLiteral("REPLACE INTO %1 (%2) VALUES (%3)")
+                      .arg(table, columns.join(", "), placeholders.join(", ")));
+        for (const QString &column : columns)
+            query.addBindValue(record.value(column));
+
+        if (!query.exec())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to apply changes to '%1'.").arg(table));
+    }
+
+    for (const QVariant &id : deletedIds) {
+        query.prepare(QStringLiteral("DELETE FROM %1 WHERE id = ?").arg(table));
+        query.addBindValue(id);
+        if (!query.exec())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to delete from '%1'.").arg(table));
+    }
+}
+
+QString ChangeLog::referencedTable(const QString &column)
+{
+    if (column == QStringLiteral("old_unit_id") || column == QStringLiteral("new_unit_id"))
+        return QStringLiteral("unit");
+    if (!column.endsWith(QStringLiteral("_id")))
+        return QString();
+
+    const QString &table = column.left(column.length() - 3);
+    return tables().contains(table) ? table : QString();
+}
+
+void ChangeLog::mergeRows(QSqlQuery &query,
+                          const QString &rackId,
+                          const QString &table,
+                          const QVariantList &rows,
+                          const QVariantList &deleted,
+                          QHash<QString, int> &localIds)
+{
+    static const QRegularExpression columnPattern(QStringLiteral("^[a-z_][a-z0-9_]*$"));
+
+    for (const QVariant &row : rows) {
+        QVariantMap record = row.toMap();
+        const QString &originRackId = record.take("origin_rack_id").toString();
+        const int originId = record.take("id").toInt();
+        if (originRackId.isEmpty() || originId <= 0)
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    QStringLiteral("Row of '%1' has no origin.").arg(table));
+
+        // NOTE: Rows written on this rack keep their id. A reference to a row that was never
+        // pulled (e.g. one that predates syncing) fails the batch, since its id here is unknown.
+        const bool isLocalRow = originRackId == rackId;
+        int id = isLocalRow ? originId : localId(query, table, originRackId, originId, localIds);
+        for (auto column = record.begin(); column != record.end(); ++column) {
+            const QString &referencedTable = ChangeLog::referencedTable(column.key());
+            if (referencedTable.isEmpty())
+                continue;
+
+            if (column.value().type() != QVariant::Map) {
+                if (column.value().toInt() > 0)
+                    throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                            QStringLiteral("Reference '%1' of '%2' has no origin.")
+                                            .arg(column.key(), table));
+                continue;
+            }
+
+            const QVariantMap &reference = column.value().toMap();
+            const QString &referenceRackId = reference.value("origin_rack_id").toString();
+            const int referenceId = reference.value("id").toInt();
+            const int referencedId = referenceRackId == rackId
+                    ? referenceId
+                    : localId(query, referencedTable, referenceRackId, referenceId, localIds);
+            if (referencedId <= 0)
+                throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                        QStringLiteral("Reference '%1' of '%2' points to a row of rack '%3' "
+                                                       "that was never pulled.").arg(column.key(), table, referenceRackId));
+
+            column.value() = referencedId;
+        }
+
+        QStringList columns;
+        QStringList placeholders;
+        QStringList assignments{ QStringLiteral("id = LAST_INSERT_ID(id)") };
+        for (const QString &column : record.keys()) {
+            if (!columnPattern.match(column).hasMatch())
+                throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                        QStringLiteral("Invalid column '%1' in table '%2'.").arg(column, table));
+            columns.append(column);
+            placeholders.append(QStringLiteral("?"));
+            assignments.append(QStringLiteral("%1 = VALUES(%1)").arg(column));
+        }
+
+        // NOTE: A row that is new here is given a local id. One that clashes with a local row
+        // on another unique key (e.g. an item of the same name) is merged into it.
+        if (id > 0) {
+            columns.prepend(QStringLiteral("id"));
+            placeholders.prepend(QStringLiteral("?"));
+        }
+
+        query.prepare(QStringLiteral("INSERT INTO %1 (%2) VALUES (%3) ON DUPLICATE KEY UPDATE %4")
+                      .arg(table, columns.join(", "), placeholders.join(", "), assignments.join(", ")));
+        if (id > 0)
+            query.addBindValue(id);
+        for (const QString &column : record.keys())
+            query.addBindValue(record.value(column));
+
+        if (!query.exec())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to apply changes to '%1'.").arg(table));
+
+        if (isLocalRow)
+            continue;
+
+        const int appliedId = query.lastInsertId().toInt() > 0 ? query.lastInsertId().toInt() : id;
+        if (appliedId == id)
+            continue;
+
+        query.prepare(QStringLiteral("INSERT INTO sync_origin (table_name, origin_rack_id, origin_id, local_id) "
+                                     "VALUES (?, ?, ?, ?) ON DUPLICATE KEY UPDATE local_id = VALUES(local_id)"));
+        query.addBindValue(table);
+        query.addBindValue(originRackId);
+        query.addBindValue(originId);
+        query.addBindValue(appliedId);
+        if (!query.exec())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to store the origin of a row of '%1'.").arg(table));
+
+        localIds.insert(QStringLiteral("%1/%2/%3").arg(table, originRackId).arg(originId), appliedId);
+    }
+
+    for (const QVariant &deletedRow : deleted) {
+        const QVariantMap &origin = deletedRow.toMap();
+        const QString &originRackId = origin.value("origin_rack_id").toString();
+        const int originId = origin.value("id").toInt();
+        const bool isLocalRow = originRackId == rackId;
+        const int id = isLocalRow ? originId : localId(query, table, originRackId, originId, localIds);
+        if (id <= 0)
+            continue;
+
+        query.prepare(QStringLiteral("DELETE FROM %1 WHERE id = ?").arg(table));
+        query.addBindValue(id);
+        if (!query.exec())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to delete from '%1'.").arg(table));
+
+        if (isLocalRow)
+            continue;
+
+        query.prepare(QStringLiteral("DELETE FROM sync_origin WHERE table_name = ? AND origin_rack_id = ? AND origin_id = ?"));
+        query.addBindValue(table);
+        query.addBindValue(originRackId);
+        query.addBindValue(originId);
+        if (!query.exec())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to delete the origin of a row of '%1'.").arg(table));
+
+        localIds.remove(QStringLiteral("%1/%2/%3").arg(table, originRackId).arg(originId));
+    }
+}
+
+int ChangeLog::localId(QSqlQuery &query,
+                       const QString &table,
+                       const QString &originRackId,
+                       int originId,
+                       QHash<QString, int> &localIds)
+{
+    const QString &key = QStringLiteral("%1/%2/%3").arg(table, originRackId).arg(originId);
+    const auto iter = localIds.constFind(key);
+    if (iter != localIds.cend())
+        return iter.value();
+
+    query.prepare(QStringLiteral("SELECT local_id FROM sync_origin WHERE table_name = ? AND origin_rack_id = ? AND origin_id = ?"));
+    query.addBindValue(table);
+    query.addBindValue(originRackId);
+    query.addBindValue(originId);
+    if (!query.exec())
+        throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to read the origin of a row of '%1'.").arg(table));
+
+    const int id = query.next() ? query.value(0).toInt() : 0;
+    localIds.insert(key, id);
+    return id;
+}
+
+QVariantMap ChangeLog::origin(QSqlQuery &query,
+                              const QString &rackId,
+                              const QString &table,
+                              int localId,
+                              QHash<QString, QVariantMap> &origins)
+{
+    const QString &key = QStringLiteral("%1/%2").arg(table).arg(localId);
+    const auto iter = origins.constFind(key);
+    if (iter != origins.cend())
+        return iter.value();
+
+    query.prepare(QStringLiteral("SELECT origin_rack_id, origin_id FROM sync_origin WHERE table_name = ? AND local_id = ?"));
+    query.addBindValue(table);
+    query.addBindValue(localId);
+    if (!query.exec())
+        throw DatabaseException(DatabaseError::QueryErrorCode::ChangeSyncFailure,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to read the origin of a row of '%1'.").arg(table));
+
+    const QVariantMap &rowOrigin = query.next()
+            ? QVariantMap { { "origin_rack_id", query.value(0) }, { "id", query.value(1) } }
+            : QVariantMap { { "origin_rack_id", rackId }, { "id", localId } };
+    origins.insert(key, rowOrigin);
+    return rowOrigin;
+}
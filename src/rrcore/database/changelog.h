@@ -0,0 +1,75 @@
+#ifndef CHANGELOG_H
+#define CHANGELOG_H
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QHash>
+
+class QSqlQuery;
+
+// Rows changed locally, in the order they changed.
+// Triggers on every business table append (table, row id, operation) to the
+// change_log table; the sequence of an entry is its id. Changes are read in
+// batches after a watermark, and only the latest state of each row is sent,
+// so a row edited many times between two pushes is sent once. Rows applied
+// from the server suppress the triggers, so they are never sent back.
+// Rows travel in both directions under the rack they were written on
+// ("origin_rack_id") and their id there, and so do deleted rows and the
+// references a row holds to other synchronized tables ({origin_rack_id, id}).
+// sync_origin maps (table, origin rack, origin id) to the local id of a row
+// pulled from another rack: pushes translate local ids back through it, and
+// pulls match rows against it, giving new rows a local id. A pulled row never
+// overwrites an unrelated local row, and a batch that refers to a row that was
+// never pulled is rejected.
+class ChangeLog
+{
+public:
+    static inline const QString PUSHED_WATERMARK = QStringLiteral("pushed");
+    static inline const QString PULLED_WATERMARK = QStringLiteral("pulled");
+
+    static QStringList tables();
+
+    // Run on the thread that owns the connection.
+    static qint64 watermark(const QString &connectionName, const QString &name); // throws DatabaseException
+    static QVariantMap collect(const QString &connectionName,
+                               const QString &rackId,
+                               qint64 afterSequence,
+                               int limit); // throws DatabaseException
+    static void acknowledge(const QString &connectionName, qint64 sequence); // throws DatabaseException
+    static void apply(const QString &connectionName,
+                      const QString &rackId,
+                      const QVariantMap &changes,
+                      qint64 sequence); // throws DatabaseException
+
+    // Run inside a transaction.
+    static void setCaptureSuppressed(QSqlQuery &query, bool suppressed); // throws DatabaseException
+    // Copies rows under the ids they have on the server, for tables that mirror it.
+    static void applyRows(QSqlQuery &query,
+                          const QString &table,
+                          const QVariantList &rows,
+                          const QVariantList &deletedIds); // throws DatabaseException
+
+    static QString referencedTable(const QString &column);
+private:
+    explicit ChangeLog() = default;
+
+    static void mergeRows(QSqlQuery &query,
+                          const QString &rackId,
+                          const QString &table,
+                          const QVariantList &rows,
+                          const QVariantList &deleted,
+                          QHash<QString, int> &localIds); // throws DatabaseException
+    static int localId(QSqlQuery &query,
+                       const QString &table,
+                       const QString &originRackId,
+                       int originId,
+                       QHash<QString, int> &localIds); // throws DatabaseException
+    static QVariantMap origin(QSqlQuery &query,
+                              const QString &rackId,
+                              const QString &table,
+                              int localId,
+                              QHash<QString, QVariantMap> &origins); // throws DatabaseException
+};
+
+#endif // CHANGELOG_H
@@ -0,0 +1,206 @@
+#include "changesync.h"
+#include "changelog.h"
+#include "databaseexception.h"
+#include "queryresult.h"
+#include "network/serverrequest.h"
+#include "network/serverresponse.h"
+#include "user/userprofile.h"
+
+#include <QTimer>
+#include <QSqlDatabase>
+
+Q_LOGGING_CATEGORY(changeSync, "rrcore.database.changesync");
+
+ChangeSync::ChangeSync(QObject *worker, const QString &connectionName, QObject *parent) :
+    QObject(parent),
+    m_worker(worker),
+    m_connectionName(connectionName),
+    m_pushTimer(new QTimer(this)),
+    m_pullTimer(new QTimer(this)),
+    m_pushing(false),
+    m_pushNeeded(false),
+    m_pulling(false)
+{
+    // NOTE: Writes that finish close together share a single push.
+    m_pushTimer->setSingleShot(true);
+    m_pushTimer->setInterval(PUSH_DELAY);
+    connect(m_pushTimer, &QTimer::timeout, this, &ChangeSync::push);
+
+    m_pullTimer->setInterval(PULL_INTERVAL);
+    connect(m_pullTimer, &QTimer::timeout, this, &ChangeSync::pull);
+    connect(m_pullTimer, &QTimer::timeout, this, &ChangeSync::push);
+}
+
+void ChangeSync::start()
+{
+    // NOTE: Changes made while the app was closed, or before this started, are pushed right away.
+    m_pullTimer->start();
+    m_pushTimer->start();
+}
+
+void ChangeSync::notifyWrite(const QueryResult &result)
+{
+    if (!result.isSuccessful()
+            || result.request().commandVerb() == QueryRequest::CommandVerb::Read
+            || result.request().commandVerb() == QueryRequest::CommandVerb::Authenticate)
+        return;
+
+    m_pushTimer->start();
+}
+
+void ChangeSync::push()
+{
+    if (m_pushing) {
+        m_pushNeeded = true;
+        return;
+    }
+
+    m_pushing = true;
+    m_pushNeeded = false;
+    const QString &rackId = UserProfile::instance().rackId();
+    runOnWorker([this, rackId]() {
+        const qint64 pushedSequence = ChangeLog::watermark(m_connectionName, ChangeLog::PUSHED_WATERMARK);
+        const QVariantMap &batch = ChangeLog::collect(m_connectionName, rackId, pushedSequence, MAX_BATCH_CHANGE_COUNT);
+        QMetaObject::invokeMethod(this, [this, batch]() {
+            if (batch.value("last_sequence").toLongLong() < batch.value("first_sequence").toLongLong()) {
+                m_pushing = false;
+                return;
+            }
+
+            sendPush(batch);
+        }, Qt::QueuedConnection);
+    }, [this](const QString &reason) {
+        fail(PUSH_ACTION, reason);
+    });
+}
+
+void ChangeSync::pull()
+{
+    if (m_pulling)
+        return;
+
+    m_pulling = true;
+    runOnWorker([this]() {
+        const qint64 pulledSequence = ChangeLog::watermark(m_connectionName, ChangeLog::PULLED_WATERMARK);
+        QMetaObject::invokeMethod(this, [this, pulledSequence]() {
+            ServerRequest request(this);
+            request.setAction(PULL_ACTION, QVariantMap {
+                                  { "rack_id", UserProfile::instance().rackId() },
+                                  { "after_sequence", pulledSequence },
+                                  { "limit", MAX_BATCH_CHANGE_COUNT }
+                              });
+            emit syncRequested(request);
+        }, Qt::QueuedConnection);
+    }, [this](const QString &reason) {
+        fail(PULL_ACTION, reason);
+    });
+}
+
+void ChangeSync::processServerResponse(const ServerResponse &response)
+{
+    if (response.request().receiver() != this)
+        return;
+
+    const QString &action = response.request().action();
+    if (!response.isSuccessful()) {
+        fail(action, response.errorMessage());
+        return;
+    }
+
+    if (action == PUSH_ACTION) {
+        const qint64 lastSequence = response.request().data().value("last_sequence").toLongLong();
+        const bool hasMore = response.request().data().value("has_more").toBool();
+        runOnWorker([this, lastSequence, hasMore]() {
+            ChangeLog::acknowledge(m_connectionName, lastSequence);
+            QMetaObject::invokeMethod(this, [this, hasMore]() {
+                finishPush(hasMore);
+            }, Qt::QueuedConnection);
+        }, [this](const QString &reason) {
+            fail(PUSH_ACTION, reason);
+        });
+    } else if (action == PULL_ACTION) {
+        const QVariantMap &changes = response.data().value("changes").toMap();
+        const qint64 lastSequence = response.data().value("last_sequence").toLongLong();
+        const bool hasMore = response.data().value("has_more").toBool();
+        const QString &rackId = UserProfile::instance().rackId();
+        runOnWorker([this, rackId, changes, lastSequence, hasMore]() {
+            ChangeLog::apply(m_connectionName, rackId, changes, lastSequence);
+            QMetaObject::invokeMethod(this, [this, changes, hasMore]() {
+                if (!changes.isEmpty())
+                    emit changed();
+                finishPull(hasMore);
+            }, Qt::QueuedConnection);
+        }, [this](const QString &reason) {
+            fail(PULL_ACTION, reason);
+        });
+    }
+}
+
+void ChangeSync::sendPush(const QVariantMap &batch)
+{
+    ServerRequest request(this);
+    request.setAction(PUSH_ACTION, QVariantMap {
+                          { "rack_id", UserProfile::instance().rackId() },
+                          { "changes", batch.value("changes") },
+                          { "first_sequence", batch.value("first_sequence") },
+                          { "last_sequence", batch.value("last_sequence") },
+                          { "has_more", batch.value("has_more") }
+                      });
+
+    // NOTE: A batch that is sent again after a lost reply carries the same key.
+    request.setIdempotencyKey(QStringLiteral("%1:%2").arg(UserProfile::instance().rackId(),
+                                                          batch.value("last_sequence").toString()));
+    qCDebug(changeSync) << "Pushing changes" << batch.value("first_sequence").toLongLong()
+                        << "to" << batch.value("last_sequence").toLongLong();
+    emit syncRequested(request);
+}
+
+void ChangeSync::finishPush(bool hasMore)
+{
+    m_pushing = false;
+    if (hasMore || m_pushNeeded)
+        push();
+}
+
+void ChangeSync::finishPull(bool hasMore)
+{
+    m_pulling = false;
+    if (hasMore)
+        pull();
+}
+
+void ChangeSync::fail(const QString &action, const QString &reason)
+{
+    // NOTE: Nothing is lost; the change log still holds every change after the
+    // watermark, and the pull timer tries again.
+    qCWarning(changeSync) << "Failed to" << action << ":" << reason;
+    if (action == PUSH_ACTION) {
+        m_pushing = false;
+        m_pushNeeded = false;
+    } else {
+        m_pulling = false;
+    }
+}
+
+void ChangeSync::runOnWorker(std::function<void()> task, std::function<void(const QString &)> onFailure)
+{
+    QMetaObject::invokeMethod(m_worker, [this, task, onFailure]() {
+        // NOTE: The connection is opened when the user signs in.
+        if (!QSqlDatabase::database(m_connectionName, false).isOpen()) {
+            QMetaObject::invokeMethod(this, [onFailure]() {
+                onFailure(QStringLiteral("Not signed in."));
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        try {
+            task();
+        } catch (DatabaseException &e) {
+            qCCritical(changeSync) << e;
+            const QString reason = e.message();
+            QMetaObject::invokeMethod(this, [onFailure, reason]() {
+                onFailure(reason);
+            }, Qt::QueuedConnection);
+        }
+    }, Qt::QueuedConnection);
+}
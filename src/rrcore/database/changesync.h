@@ -0,0 +1,61 @@
+#ifndef CHANGESYNC_H
+#define CHANGESYNC_H
+
+#include <QObject>
+#include <QVariantMap>
+#include <QLoggingCategory>
+#include <functional>
+
+class QTimer;
+class QueryResult;
+class ServerRequest;
+class ServerResponse;
+
+// Keeps the local database and the server in step using the change log.
+// Local changes are pushed in batches after the "pushed" watermark shortly
+// after each write, and changes made elsewhere (another till, the web) are
+// pulled after the "pulled" watermark, which is a sequence number of the
+// server's own change log. Both watermarks are stored in the database, so a
+// till that was offline, or reinstalled from a backup, catches up with only
+// the rows it missed.
+// Pushed rows are identified by rack and local id; the server maps them to
+// its own rows, and sends pulled rows back in the till's id space.
+class ChangeSync : public QObject
+{
+    Q_OBJECT
+public:
+    static inline const QString PUSH_ACTION = QStringLiteral("push_changes");
+    static inline const QString PULL_ACTION = QStringLiteral("pull_changes");
+    static const int MAX_BATCH_CHANGE_COUNT = 200;
+    static const int PUSH_DELAY = 500; // milliseconds
+    static const int PULL_INTERVAL = 60 * 1000; // milliseconds
+
+    explicit ChangeSync(QObject *worker, const QString &connectionName, QObject *parent = nullptr);
+
+    void start();
+    void notifyWrite(const QueryResult &result);
+    void push();
+    void pull();
+    void processServerResponse(const ServerResponse &response);
+signals:
+    void syncRequested(const ServerRequest request);
+    void changed();
+private:
+    QObject *m_worker;
+    QString m_connectionName;
+    QTimer *m_pushTimer;
+    QTimer *m_pullTimer;
+    bool m_pushing;
+    bool m_pushNeeded;
+    bool m_pulling;
+
+    void sendPush(const QVariantMap &batch);
+    void finishPush(bool hasMore);
+    void finishPull(bool hasMore);
+    void fail(const QString &action, const QString &reason);
+    void runOnWorker(std::function<void()> task, std::function<void(const QString &)> onFailure);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(changeSync);
+
+#endif // CHANGESYNC_H
@@ -13,6 +13,10 @@
 #include <QUrl>
 #include <QSettings>
 #include <QByteArray>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
 
 #include "database/databaseexception.h"
 #include "database/databaseutils.h"
@@ -62,7 +66,7 @@ void DatabaseCreator::executeSqlFile(const QString &fileName)
     if (QFileInfo(fileName).suffix() != "sql")
         throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed, QString(),
                                 QString("File '%1' is not a sql file").arg(fileName));
-    if (QFileInfo(fileName).size() > 1024 * 50)
+    if (QFileInfo(fileName).size() > MAX_SQL_FILE_SIZE)
         throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed, QString(),
                                 QString("File '%1' is too large (larger than 50MB).").arg(fileName));
     if (!file.open(QFile::ReadOnly))
@@ -135,14 +139,20 @@ void DatabaseCreator::executeSqlFile(const QString &fileName)
 bool DatabaseCreator::start()
 {
     try {
-        QSettings settings;
-
-        // NOTE: Only drop if database was not ready
-        if (!UserProfile::instance().isDatabaseReady())
-            dropDatabase();
-        initDatabase();
+        QElapsedTimer timer;
+        timer.start();
+
+        // NOTE: The database is never dropped here. A database that exists is brought up to date;
+        // one that does not is created from the shared schema.
+        if (!isDatabaseInitialized())
+            initDatabase();
+        selectDatabase();
+        migrateDatabase();
         createProcedures();
         updateBusinessDetails();
+
+        qCInfo(databaseCreator) << "Database ready at schema version" << schemaVersion()
+                                << "in" << timer.elapsed() << "ms.";
     } catch (DatabaseException &e) {
         qCCritical(databaseCreator) << "Exception caught:" << e.code() << e.message() << e.userMessage();
         return false;
@@ -151,15 +161,68 @@ bool DatabaseCreator::start()
     return true;
 }
 
-void DatabaseCreator::dropDatabase()
+int DatabaseCreator::schemaVersion()
 {
     QSqlQuery q(m_connection);
-    q.prepare(QStringLiteral("DROP DATABASE IF EXISTS %1").arg(Config::instance().databaseName()));
+    if (!q.exec(QStringLiteral("SELECT version FROM db_info ORDER BY last_edited DESC LIMIT 1")))
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                q.lastError().text(),
+                                QStringLiteral("Failed to read schema version!"));
+
+    // NOTE: A version that is not a number predates migrations.
+    return q.next() ? q.value(0).toString().toInt() : 0;
+}
+
+int DatabaseCreator::migrationVersion(const QString &fileName)
+{
+    static const QRegularExpression migrationPattern(QStringLiteral("^(\\d+)_\\w+\\.sql$"));
+    const QRegularExpressionMatch &match = migrationPattern.match(QFileInfo(fileName).fileName());
+    return match.hasMatch() ? match.captured(1).toInt() : -1;
+}
+
+QStringList DatabaseCreator::splitStatements(const QString &sqlData)
+{
+    QStringList statements;
+    for (QString statement : sqlData.split(PROCEDURE_SEPARATOR)) {
+        // Replace comments and tabs and new lines with space
+        statement = statement.trimmed().append('\n')
+                .replace(QRegularExpression(SPACES_AND_TABS_PATTERN,
+                                            QRegularExpression::CaseInsensitiveOption | QRegularExpression::MultilineOption), " ");
+        // Remove waste spaces
+        statement = statement.trimmed();
+
+        if (!statement.isEmpty())
+            statements.append(statement);
+    }
+
+    return statements;
+}
+
+bool DatabaseCreator::isDatabaseInitialized()
+{
+    QSqlQuery q(m_connection);
+    q.prepare(QStringLiteral("SELECT 1 FROM information_schema.TABLES WHERE TABLE_SCHEMA = ? AND TABLE_NAME = 'db_info'"));
+    q.addBindValue(Config::instance().databaseName());
 
     if (!q.exec())
         throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
                                 q.lastError().text(),
-                                QStringLiteral("Failed to drop database!"));
+                                QStringLiteral("Failed to check for database!"));
+
+    return q.next();
+}
+
+void DatabaseCreator::selectDatabase()
+{
+    if (Config::instance().databaseName().toLower() == QStringLiteral("mysql"))
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                QString(), "Database name cannot be mysql.");
+
+    QSqlQuery q(m_connection);
+    if (!q.exec(QStringLiteral("USE %1").arg(Config::instance().databaseName())))
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                q.lastError().text(),
+                                QStringLiteral("Failed to select database!"));
 }
 
 void DatabaseCreator::initDatabase()
@@ -167,20 +230,109 @@ void DatabaseCreator::initDatabase()
     executeSqlFile(Schema::Common::INIT_SQL_FILE);
 }
 
-void DatabaseCreator::createProcedures()
+void DatabaseCreator::migrateDatabase()
 {
-    QDirIterator iter(Schema::Common::PROCEDURE_DIR);
+    QMap<int, QString> migrations;
+    QDirIterator iter(Schema::Common::MIGRATION_DIR);
     while (iter.hasNext()) {
-        QFile file(iter.next());
-        if (QFileInfo(file).suffix() != "sql")
+        const QString &fileName = iter.next();
+        const int version = migrationVersion(fileName);
+        if (version <= 0)
             continue;
-        if (!file.open(QFile::ReadOnly))
+        if (migrations.contains(version))
+            throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed, QString(),
+                                    QStringLiteral("Migrations '%1' and '%2' have the same version.")
+                                    .arg(migrations.value(version), fileName));
+
+        migrations.insert(version, fileName);
+    }
+
+    const int currentVersion = schemaVersion();
+    for (auto migration = migrations.upperBound(currentVersion); migration != migrations.end(); ++migration)
+        applyMigration(migration.value(), migration.key());
+}
+
+void DatabaseCreator::applyMigration(const QString &fileName, int version)
+{
+    qCInfo(databaseCreator) << "Applying migration" << fileName;
+    const QStringList &statements = splitStatements(readSqlFile(fileName));
+
+    // NOTE: MySQL commits DDL statements as it runs them, so only data changes and the
+    // version bump are undone on failure. Migrations must be safe to run again.
+    QSqlQuery q(m_connection);
+    m_connection.transaction();
+    for (const QString &statement : statements) {
+        if (!q.exec(statement)) {
+            const QString &error = q.lastError().text();
+            m_connection.rollback();
+            qCCritical(databaseCreator) << "Invalid statement=====" << statement;
             throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
-                                    file.errorString(),
-                                    QStringLiteral("Failed to create procedures!"));
+                                    error,
+                                    QStringLiteral("Failed to apply migration '%1'.").arg(fileName));
+        }
+    }
 
-        executeStoredProcedures(QFileInfo(file).filePath());
+    try {
+        setSchemaVersion(version);
+    } catch (DatabaseException &) {
+        m_connection.rollback();
+        throw;
     }
+
+    if (!m_connection.commit())
+        throw DatabaseException(DatabaseError::QueryErrorCode::CommitTransationFailed,
+                                m_connection.lastError().text(),
+                                QStringLiteral("Failed to commit migration '%1'.").arg(fileName));
+}
+
+void DatabaseCreator::setSchemaVersion(int version)
+{
+    QSqlQuery q(m_connection);
+    q.prepare(QStringLiteral("UPDATE db_info SET version = ?, last_edited = CURRENT_TIMESTAMP()"));
+    q.addBindValue(QString::number(version));
+    if (q.exec() && q.numRowsAffected() == 0) {
+        q.prepare(QStringLiteral("INSERT INTO db_info (version, rack_id, created, last_edited) "
+                                 "VALUES (?, ?, CURRENT_TIMESTAMP(), CURRENT_TIMESTAMP())"));
+        q.addBindValue(QString::number(version));
+        q.addBindValue(UserProfile::instance().rackId());
+        q.exec();
+    }
+
+    if (q.lastError().isValid())
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                q.lastError().text(),
+                                QStringLiteral("Failed to update schema version!"));
+}
+
+void DatabaseCreator::createProcedures()
+{
+    const QHash<QString, QString> &checksums = readFileChecksums();
+
+    // NOTE: Procedures that are local to this client (e.g. bulk writes) are created last,
+    // since they depend on tables defined by the shared schema.
+    int skippedCount = 0;
+    for (const QString &procedureDir : { Schema::Common::PROCEDURE_DIR, Schema::Common::LOCAL_PROCEDURE_DIR }) {
+        QDirIterator iter(procedureDir);
+        while (iter.hasNext()) {
+            const QString &fileName = iter.next();
+            if (QFileInfo(fileName).suffix() != "sql")
+                continue;
+
+            // NOTE: A file that has not changed since it was last run is skipped.
+            const QString &sqlData = readSqlFile(fileName);
+            const QString &checksum = QString(QCryptographicHash::hash(sqlData.toUtf8(),
+                                                                       QCryptographicHash::Sha256).toHex());
+            if (checksums.value(fileName) == checksum) {
+                ++skippedCount;
+                continue;
+            }
+
+            executeStatements(fileName, splitStatements(sqlData));
+            writeFileChecksum(fileName, checksum);
+        }
+    }
+
+    qCDebug(databaseCreator) << "Skipped" << skippedCount << "unchanged procedure files.";
 }
 
 void DatabaseCreator::updateBusinessDetails()
@@ -200,48 +352,65 @@ void DatabaseCreator::updateBusinessDetails()
                                 QStringLiteral("Failed to update business details table!"));
 }
 
-void DatabaseCreator::executeStoredProcedures(const QString &fileName)
+QHash<QString, QString> DatabaseCreator::readFileChecksums()
 {
-    if (fileName.trimmed().isEmpty())
-        return;
+    QSqlQuery q(m_connection);
+    if (!q.exec(QStringLiteral("SELECT file_name, checksum FROM schema_file")))
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                q.lastError().text(),
+                                QStringLiteral("Failed to read schema file checksums!"));
+
+    QHash<QString, QString> checksums;
+    while (q.next())
+        checksums.insert(q.value(0).toString(), q.value(1).toString());
+
+    return checksums;
+}
+
+void DatabaseCreator::writeFileChecksum(const QString &fileName, const QString &checksum)
+{
+    QSqlQuery q(m_connection);
+    q.prepare(QStringLiteral("REPLACE INTO schema_file (file_name, checksum, last_edited) "
+                             "VALUES (?, ?, CURRENT_TIMESTAMP())"));
+    q.addBindValue(fileName);
+    q.addBindValue(checksum);
+
+    if (!q.exec())
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                q.lastError().text(),
+                                QStringLiteral("Failed to record checksum of '%1'.").arg(fileName));
+}
 
+QString DatabaseCreator::readSqlFile(const QString &fileName)
+{
     QFile file(fileName);
     if (QFileInfo(fileName).suffix() != "sql")
         throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed, QString(),
                                 QStringLiteral("File '%1' is not a sql file").arg(fileName));
-    if (QFileInfo(fileName).size() > 1024 * 50)
+    if (QFileInfo(fileName).size() > MAX_SQL_FILE_SIZE)
         throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed, QString(),
                                 QStringLiteral("File '%1' is too large (larger than 50MB).").arg(fileName));
     if (!file.open(QFile::ReadOnly))
-        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed, QString(),
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed, file.errorString(),
                                 QStringLiteral("Failed to open '%1'").arg(fileName));
 
-    QSqlQuery q(m_connection);
-    file.seek(0);
-    QString sqlData = file.readAll();
-
     if (Config::instance().databaseName().toLower() == QStringLiteral("mysql"))
         throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
-                                q.lastError().text(), "Database name cannot be mysql.");
+                                QString(), "Database name cannot be mysql.");
 
     // Inject database name
-    sqlData = sqlData.replace(QRegularExpression(DATABASE_NAME_PATTERN), Config::instance().databaseName());
-
-    QStringList statements = sqlData.split(PROCEDURE_SEPARATOR);
-    for (auto &statement : statements) {
-        // Remove waste spaces
-        statement = statement.trimmed();
-
-        // Replace comments and tabs and new lines with space
-        statement = statement.replace(QRegularExpression(SPACES_AND_TABS_PATTERN,
-                                                     QRegularExpression::CaseInsensitiveOption | QRegularExpression::MultilineOption), " ");
-        // Remove waste spaces
-        statement = statement.trimmed();
+    return QString(file.readAll()).replace(DATABASE_NAME_PATTERN, Config::instance().databaseName());
+}
 
+void DatabaseCreator::executeStatements(const QString &fileName, const QStringList &statements)
+{
+    QSqlQuery q(m_connection);
+    for (const QString &statement : statements) {
         if (!q.exec(statement)) {
             qCCritical(databaseCreator) << "Invalid statement=====" << statement;
             throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
-                                    QString("Failed to execute query: %1").arg(statement));
+                                    q.lastError().text(),
+                                    QString("Failed to execute query in '%1': %2").arg(fileName, statement));
         }
     }
 }
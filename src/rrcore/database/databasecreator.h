@@ -2,26 +2,48 @@
 #define DATABASECREATOR_H
 
 #include <QSqlDatabase>
+#include <QStringList>
+#include <QHash>
 #include <QLoggingCategory>
 
 class QString;
 
+// Brings the database up to date on start.
+// A database that does not exist is created from the shared schema. The
+// schema version is kept in db_info, and every migration numbered above it
+// (sql/migrations/<version>_<name>.sql) is applied in order, each with its
+// version bump in one transaction. Procedure files are recorded by checksum
+// in schema_file and only run again when their contents change, so a normal
+// start runs no DDL at all.
 class DatabaseCreator
 {
 public:
+    static const qint64 MAX_SQL_FILE_SIZE = 1024 * 1024 * 50;
+
     explicit DatabaseCreator(QSqlDatabase connection = QSqlDatabase());
 
     void executeSqlFile(const QString &fileName); // throws DatabaseException!
     bool start();
+
+    int schemaVersion(); // throws DatabaseException!
+    static int migrationVersion(const QString &fileName);
+    static QStringList splitStatements(const QString &sqlData);
 private:
     QSqlDatabase m_connection;
 
-    void dropDatabase(); // throw DatabaseException!
+    bool isDatabaseInitialized(); // throws DatabaseException!
     void initDatabase(); // throws DatabaseException!
+    void selectDatabase(); // throws DatabaseException!
+    void migrateDatabase(); // throws DatabaseException!
+    void applyMigration(const QString &fileName, int version); // throws DatabaseException!
+    void setSchemaVersion(int version); // throws DatabaseException!
     void createProcedures(); // throws DatabaseException!
     void updateBusinessDetails(); // throws DatabseException!
 
-    void executeStoredProcedures(const QString &fileName); // throws DatabaseException!
+    QHash<QString, QString> readFileChecksums(); // throws DatabaseException!
+    void writeFileChecksum(const QString &fileName, const QString &checksum); // throws DatabaseException!
+    QString readSqlFile(const QString &fileName); // throws DatabaseException!
+    void executeStatements(const QString &fileName, const QStringList &statements); // throws DatabaseException!
 };
 
 Q_DECLARE_LOGGING_CATEGORY(databaseCreator);
@@ -57,14 +57,21 @@ namespace DatabaseError
         AddUserFailed,
         OldPasswordWrong,
         UserAccountIsLocked,
-        UserPreviouslyArchived
+        UserPreviouslyArchived,
+        ReplicaSyncFailure,
+        ChangeSyncFailure
     };
 
     enum class MySqlErrorCode {
         UncommonError,
         DuplicateEntryError = 1062,
+        LockWaitTimeoutError = 1205,
+        DeadlockError = 1213,
+        UnknownStatementHandlerError = 1243,
         CreateUserError = 1396,
         UserDefinedException = 1644,
+        ServerGoneError = 2006,
+        ServerLostError = 2013,
         UserAccountIsLockedError = 3118
     };
 
@@ -4,35 +4,156 @@
 #include <QDebug>
 #include <QLoggingCategory>
 #include <QSettings>
+#include <QSqlError>
+#include <QRegularExpression>
 
 #include "databaseexception.h"
+#include "preparedstatementcache.h"
+#include "querymetrics.h"
+#include "readreplica.h"
+#include "changesync.h"
+#include "imagecache.h"
 #include "queryrequest.h"
 #include "queryresult.h"
 #include "network/networkthread.h"
 #include "user/userprofile.h"
+#include "singletons/startupprofiler.h"
 #include "queryexecutors/user/userexecutor.h"
+#include "queryexecutors/stock/viewstockitemimage.h"
 
 Q_LOGGING_CATEGORY(databaseThread, "rrcore.database.databasethread");
 
 const QString CONNECTION_NAME(QStringLiteral("db_thread"));
+const QString READ_CONNECTION_NAME(QStringLiteral("db_thread_read_%1"));
+const QString IMAGE_CONNECTION_NAME(QStringLiteral("db_thread_image_%1"));
+const QString READ_WORKER_COUNT_KEY(QStringLiteral("database/read_worker_count"));
+const int DEFAULT_READ_WORKER_COUNT = 2;
+const int MAX_READ_WORKER_COUNT = 8;
+const QString RESULT_CACHE_SIZE_KEY(QStringLiteral("database/result_cache_bytes"));
 
-DatabaseWorker::DatabaseWorker(QObject *parent) :
-    QObject(parent)
+// Bumped each time a user authenticates on the write connection, so that
+// read connections know they must be cloned again with the new credentials.
+static QAtomicInt connectionGeneration(0);
+
+// Clones the write connection as "connectionName", unless a clone made since
+// the last authentication is still open.
+static void openClonedConnection(const QString &connectionName, int &clonedGeneration) // throws DatabaseException
+{
+    const int generation = connectionGeneration.loadAcquire();
+    if (clonedGeneration == generation && QSqlDatabase::database(connectionName, false).isOpen())
+        return;
+
+    PreparedStatementCache::instance().clear(connectionName);
+    if (QSqlDatabase::contains(connectionName)) {
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+
+    QSqlDatabase connection = QSqlDatabase::cloneDatabase(CONNECTION_NAME, connectionName);
+    if (!connection.open())
+        throw DatabaseException(DatabaseError::QueryErrorCode::NoValidConnection,
+                                connection.lastError().text(),
+                                QStringLiteral("Failed to open connection '%1'.").arg(connectionName));
+
+    clonedGeneration = generation;
+}
+
+// The connection an image provider thread reads on, removed when the thread exits,
+// so that threads the provider's pool retires do not leave connections open.
+struct ImageConnection
+{
+    explicit ImageConnection(const QString &name) :
+        name(name),
+        clonedGeneration(-1)
+    {}
+
+    ~ImageConnection()
+    {
+        PreparedStatementCache::instance().clear(name);
+        if (!QSqlDatabase::contains(name))
+            return;
+
+        QSqlDatabase::database(name, false).close();
+        QSqlDatabase::removeDatabase(name);
+    }
+
+    const QString name;
+    int clonedGeneration;
+};
+
+// NOTE: Called on the image provider's threads, so each thread reads on a connection of its own.
+static QByteArray readImage(const QString &key)
+{
+    static const QRegularExpression stockItemKeyPattern(QStringLiteral("^stock_item/(\\d+)$"));
+    const QRegularExpressionMatch &match = stockItemKeyPattern.match(key);
+    if (!match.hasMatch())
+        return QByteArray();
+
+    thread_local ImageConnection imageConnection(IMAGE_CONNECTION_NAME
+                                                 .arg(reinterpret_cast<quintptr>(QThread::currentThreadId())));
+
+    try {
+        openClonedConnection(imageConnection.name, imageConnection.clonedGeneration);
+
+        StockQuery::ViewStockItemImage queryExecutor(match.captured(1).toInt(), nullptr);
+        queryExecutor.setConnectionName(imageConnection.name);
+        return queryExecutor.execute().outcome().toMap().value("image").toByteArray();
+    } catch (DatabaseException &e) {
+        qCWarning(databaseThread) << "Failed to read image of" << key << e;
+        return QByteArray();
+    }
+}
+
+DatabaseWorker::DatabaseWorker(const QString &connectionName, QObject *parent) :
+    QObject(parent),
+    m_connectionName(connectionName),
+    m_queueDepth(0),
+    m_connectionGeneration(-1)
 {
 }
 
 DatabaseWorker::~DatabaseWorker()
 {
-    QSqlDatabase connection = QSqlDatabase::database(CONNECTION_NAME);
+    PreparedStatementCache::instance().clear(m_connectionName);
+    QSqlDatabase connection = QSqlDatabase::database(m_connectionName, false);
     connection.close();
 }
 
-void DatabaseWorker::execute(QueryExecutor *queryExecutor)
+QString DatabaseWorker::connectionName() const
+{
+    return m_connectionName;
+}
+
+int DatabaseWorker::queueDepth() const
+{
+    return m_queueDepth.loadAcquire();
+}
+
+void DatabaseWorker::enqueue()
+{
+    m_queueDepth.ref();
+}
+
+void DatabaseWorker::execute(QueryExecutor *queryExecutor,
+                             quint64 ticket,
+                             QSharedPointer<QAtomicInt> superseded)
 {
-    qCInfo(databaseThread) << queryExecutor->request();
     const QueryRequest &request(queryExecutor->request());
     QueryResult result{ request };
 
+    // NOTE: A newer request from the same receiver makes this one useless, so it is
+    // dropped here rather than run to completion.
+    if (superseded && superseded->loadAcquire()) {
+        qCDebug(databaseThread) << "Skipped superseded" << request;
+        result.setSuccessful(false);
+        queryExecutor->deleteLater();
+        m_queueDepth.deref();
+        emit resultReady(result, ticket);
+        return;
+    }
+
+    qCInfo(databaseThread) << request << "on" << m_connectionName;
+
     QElapsedTimer timer;
     timer.start();
 
@@ -40,8 +161,16 @@ void DatabaseWorker::execute(QueryExecutor *queryExecutor)
         if (request.command().trimmed().isEmpty())
             throw DatabaseException(DatabaseError::QueryErrorCode::NoCommand);
 
-        queryExecutor->setConnectionName(CONNECTION_NAME);
+        // NOTE: Authentication reopens the connection, which invalidates its statement handles.
+        if (request.commandVerb() == QueryRequest::CommandVerb::Authenticate)
+            PreparedStatementCache::instance().clear(m_connectionName);
+
+        openClonedConnection();
+        queryExecutor->setConnectionName(m_connectionName);
         result = queryExecutor->execute();
+
+        if (request.commandVerb() == QueryRequest::CommandVerb::Authenticate)
+            connectionGeneration.ref();
     } catch (DatabaseException &e) {
         result.setSuccessful(false);
         result.setErrorCode(e.code());
@@ -50,42 +179,118 @@ void DatabaseWorker::execute(QueryExecutor *queryExecutor)
         qCCritical(databaseThread) << e;
     }
 
+    const qint64 elapsed = timer.nsecsElapsed() / 1000;
+    QueryMetrics::instance().recordResult(result, elapsed);
+
     queryExecutor->deleteLater();
-    emit resultReady(result);
-    qCInfo(databaseThread) << result << " [elapsed = " << timer.elapsed() << " ms]";
+    m_queueDepth.deref();
+    emit resultReady(result, ticket);
+    qCInfo(databaseThread) << result << " [elapsed = " << elapsed / 1000 << " ms]";
+}
+
+void DatabaseWorker::openClonedConnection()
+{
+    if (m_connectionName == CONNECTION_NAME)
+        return;
+
+    ::openClonedConnection(m_connectionName, m_connectionGeneration);
 }
 
 DatabaseThread::DatabaseThread(QObject *parent) :
-    QThread(parent)
+    QThread(parent),
+    m_writeWorker(nullptr),
+    m_replica(nullptr),
+    m_changeSync(nullptr),
+    m_connectedToServer(false),
+    m_lastTicket(0),
+    m_supersededCount(0)
 {
+    connect(this, &DatabaseThread::resultReady, this, &DatabaseThread::deliverResult);
+
     if (!isRunning()) {
+        StartupProfiler::Phase phase(QStringLiteral("start_database_pool"));
+        setResultCacheCapacity(QSettings().value(RESULT_CACHE_SIZE_KEY,
+                                                 QueryResultCache::DEFAULT_CAPACITY).toInt());
+        m_writeWorker = new DatabaseWorker(CONNECTION_NAME);
+
+        connect(m_writeWorker, &DatabaseWorker::resultReady, this, &DatabaseThread::releaseRequest);
+        connect(this, &DatabaseThread::finished, m_writeWorker, &DatabaseWorker::deleteLater);
+        m_writeWorker->moveToThread(this);
+
+        const int readWorkerCount = qBound(0,
+                                           QSettings().value(READ_WORKER_COUNT_KEY,
+                                                             DEFAULT_READ_WORKER_COUNT).toInt(),
+                                           MAX_READ_WORKER_COUNT);
+        for (int i = 0; i < readWorkerCount; ++i) {
+            QThread *readThread = new QThread(this);
+            DatabaseWorker *readWorker = new DatabaseWorker(READ_CONNECTION_NAME.arg(i));
+
+            connect(readWorker, &DatabaseWorker::resultReady, this, &DatabaseThread::releaseRequest);
+            connect(readThread, &QThread::finished, readWorker, &DatabaseWorker::deleteLater);
+            readWorker->moveToThread(readThread);
+
+            m_readThreads.append(readThread);
+            m_readWorkers.append(readWorker);
+            readThread->start();
+        }
+
+        connect(this, &DatabaseThread::execute, this, &DatabaseThread::dispatch);
+        ImageCache::instance().setLoader(&readImage);
+
+        // NOTE: When tunnelling, the server owns the data. The write connection only keeps
+        // the read replica up to date, and every other request goes to the server.
         if (UserProfile::instance().isServerTunnelingEnabled()) {
-            connect(this, &DatabaseThread::execute,
-                    &NetworkThread::instance(), &NetworkThread::tunnelToServer);
-            connect(&NetworkThread::instance(), &NetworkThread::resultReady,
-                    this, &DatabaseThread::resultReady);
-        } else {
-            DatabaseWorker *worker = new DatabaseWorker;
+            m_replica = new ReadReplica(m_writeWorker, CONNECTION_NAME, this);
+            connect(m_replica, &ReadReplica::changed, this, &DatabaseThread::invalidateReplicatedResults);
 
-            connect(worker, &DatabaseWorker::resultReady, this, &DatabaseThread::resultReady);
-            connect(this, &DatabaseThread::execute, worker, &DatabaseWorker::execute);
-            connect(this, &DatabaseThread::finished, worker, &DatabaseWorker::deleteLater);
-            connect(this, &DatabaseThread::resultReady,
-                    &NetworkThread::instance(), &NetworkThread::syncWithServer);
+            // NOTE: Until the replica has pulled, every request is tunnelled anyway, so it
+            // is started once the first frame is shown. The network thread is only started
+            // then, or by the first tunnelled request if that comes sooner.
+            StartupProfiler::instance().runAfterFirstFrame(this, [this]() {
+                connectToServer();
+                m_replica->start();
+            });
+        } else {
+            // NOTE: Syncing with the server is not needed to show the first frame, and
+            // the change log keeps every write made until then.
+            StartupProfiler::instance().runAfterFirstFrame(this, [this]() {
+                m_changeSync = new ChangeSync(m_writeWorker, CONNECTION_NAME, this);
 
-            worker->moveToThread(this);
-            start();
+                connect(m_changeSync, &ChangeSync::syncRequested,
+                        &NetworkThread::instance(), &NetworkThread::sync);
+                connect(&NetworkThread::instance(), &NetworkThread::responseReady,
+                        m_changeSync, &ChangeSync::processServerResponse);
+                connect(m_changeSync, &ChangeSync::changed, this, &DatabaseThread::invalidateSyncedResults);
+                connect(this, &DatabaseThread::resultReady, m_changeSync, &ChangeSync::notifyWrite);
+                m_changeSync->start();
+            });
         }
+
+        start();
+
+        qCInfo(databaseThread) << "Database pool started with" << readWorkerCount << "read worker(s).";
     }
 }
 
 DatabaseThread::DatabaseThread(QueryResult *, QObject *parent) :
-    QThread(parent)
+    QThread(parent),
+    m_writeWorker(nullptr),
+    m_replica(nullptr),
+    m_changeSync(nullptr),
+    m_connectedToServer(false),
+    m_lastTicket(0),
+    m_supersededCount(0)
 {
+    connect(this, &DatabaseThread::resultReady, this, &DatabaseThread::deliverResult);
 }
 
 DatabaseThread::~DatabaseThread()
 {
+    for (QThread *readThread : m_readThreads) {
+        readThread->quit();
+        readThread->wait();
+    }
+
     quit();
     wait();
 }
@@ -98,7 +303,276 @@ DatabaseThread &DatabaseThread::instance()
     return instance;
 }
 
+int DatabaseThread::workerCount() const
+{
+    if (!m_writeWorker)
+        return 0;
+
+    return m_readWorkers.count() + 1;
+}
+
+int DatabaseThread::queueDepth(int worker) const
+{
+    if (worker < 0 || worker >= workerCount())
+        return 0;
+    if (worker == 0)
+        return m_writeWorker->queueDepth();
+
+    return m_readWorkers.at(worker - 1)->queueDepth();
+}
+
+QList<int> DatabaseThread::queueDepths() const
+{
+    QList<int> depths;
+    for (int i = 0; i < workerCount(); ++i)
+        depths.append(queueDepth(i));
+
+    return depths;
+}
+
+const QueryResultCache &DatabaseThread::resultCache() const
+{
+    return m_resultCache;
+}
+
+void DatabaseThread::setResultCacheCapacity(int capacity)
+{
+    m_resultCache.setCapacity(capacity);
+}
+
+int DatabaseThread::supersededCount() const
+{
+    return m_supersededCount.loadAcquire();
+}
+
+void DatabaseThread::addReceiver(QObject *receiver, ResultHandler handler)
+{
+    if (!receiver || !handler)
+        return;
+
+    m_receivers.insert(receiver, handler);
+    connect(receiver, &QObject::destroyed, this, &DatabaseThread::removeReceiver);
+}
+
+void DatabaseThread::removeReceiver(QObject *receiver)
+{
+    m_receivers.remove(receiver);
+
+    // NOTE: Reads still in flight for a receiver that is gone are skipped, and their
+    // results dropped when they come back.
+    auto iter = m_inFlightReads.begin();
+    while (iter != m_inFlightReads.end()) {
+        if (iter.key().first == receiver) {
+            iter->superseded->storeRelease(1);
+            iter = m_inFlightReads.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 void DatabaseThread::run()
 {
     exec();
 }
+
+void DatabaseThread::dispatch(QueryExecutor *queryExecutor)
+{
+    const QueryRequest request(queryExecutor->request());
+    if (m_replica && !m_replica->canServe(request)) {
+        tunnel(queryExecutor);
+        return;
+    }
+
+    quint64 ticket = 0;
+    QSharedPointer<QAtomicInt> superseded;
+    if (!beginRequest(queryExecutor, ticket, superseded))
+        return;
+
+    DatabaseWorker *worker = m_writeWorker;
+    if (request.commandVerb() == QueryRequest::CommandVerb::Read
+            && !m_pendingWrites.affects(request.queryGroup())
+            && !m_readWorkers.isEmpty())
+        worker = leastBusyReadWorker();
+
+    QElapsedTimer queueTimer;
+    queueTimer.start();
+
+    worker->enqueue();
+    QMetaObject::invokeMethod(worker, [worker, queryExecutor, ticket, superseded, queueTimer]() {
+        QueryMetrics::instance().recordQueueWait(queryExecutor->request(), queueTimer.nsecsElapsed() / 1000);
+        worker->execute(queryExecutor, ticket, superseded);
+    }, Qt::QueuedConnection);
+}
+
+bool DatabaseThread::beginRequest(QueryExecutor *queryExecutor,
+                                  quint64 &ticket,
+                                  QSharedPointer<QAtomicInt> &superseded)
+{
+    const QueryRequest request(queryExecutor->request());
+    ticket = ++m_lastTicket;
+
+    if (request.commandVerb() == QueryRequest::CommandVerb::Read) {
+        superseded = supersedeReads(request, ticket);
+
+        QVariant outcome;
+        if (m_resultCache.lookup(request, outcome)) {
+            QueryResult result{ request };
+            result.setSuccessful(true);
+            result.setOutcome(outcome);
+            queryExecutor->deleteLater();
+
+            // NOTE: Cached results are still delivered asynchronously, so that
+            // receivers see the same ordering as with a database round trip.
+            QMetaObject::invokeMethod(this, [this, result, ticket]() {
+                if (!takeLatestRead(result.request(), ticket)) {
+                    m_supersededCount.ref();
+                    return;
+                }
+
+                emit resultReady(result);
+            }, Qt::QueuedConnection);
+            qCDebug(databaseThread) << "Cache hit:" << request;
+            return false;
+        }
+
+        m_resultCache.beginRead(request);
+    } else if (request.commandVerb() == QueryRequest::CommandVerb::Authenticate) {
+        m_resultCache.clear();
+    } else {
+        // NOTE: Entries are dropped as soon as a write is queued, so that no read
+        // issued while the write is pending can be answered from the cache.
+        m_resultCache.invalidate(request.queryGroup());
+    }
+
+    // NOTE: A read is kept behind pending writes that can change it, so that a screen
+    // always sees the outcome of its last write, even one made in another group.
+    if (request.commandVerb() != QueryRequest::CommandVerb::Read)
+        m_pendingWrites.begin(request.queryGroup());
+
+    return true;
+}
+
+void DatabaseThread::connectToServer()
+{
+    if (m_connectedToServer)
+        return;
+
+    m_connectedToServer = true;
+
+    // NOTE: Pulls go through the sync lane, so that they never hold up tunnelled requests.
+    connect(m_replica, &ReadReplica::pullRequested,
+            &NetworkThread::instance(), &NetworkThread::sync);
+    connect(&NetworkThread::instance(), &NetworkThread::responseReady,
+            m_replica, &ReadReplica::processServerResponse);
+    connect(&NetworkThread::instance(), &NetworkThread::resultReady,
+            this, &DatabaseThread::finishTunnelledRequest);
+}
+
+void DatabaseThread::tunnel(QueryExecutor *queryExecutor)
+{
+    connectToServer();
+    m_replica->beginWrite(queryExecutor->request());
+    NetworkThread::instance().tunnelToServer(queryExecutor);
+    queryExecutor->deleteLater();
+}
+
+void DatabaseThread::finishTunnelledRequest(const QueryResult result)
+{
+    m_replica->endWrite(result);
+    if (result.request().commandVerb() == QueryRequest::CommandVerb::Authenticate)
+        m_resultCache.clear();
+
+    emit resultReady(result);
+}
+
+void DatabaseThread::invalidateReplicatedResults()
+{
+    m_resultCache.invalidate(QueryRequest::QueryGroup::Stock);
+    m_resultCache.invalidate(QueryRequest::QueryGroup::Client);
+    emit changesPulled();
+}
+
+void DatabaseThread::invalidateSyncedResults()
+{
+    // NOTE: Rows pulled from the server may belong to any table.
+    m_resultCache.clear();
+    emit changesPulled();
+}
+
+void DatabaseThread::releaseRequest(const QueryResult result, quint64 ticket)
+{
+    const QueryRequest::QueryGroup queryGroup = result.request().queryGroup();
+    if (result.request().commandVerb() != QueryRequest::CommandVerb::Read)
+        m_pendingWrites.end(queryGroup);
+
+    switch (result.request().commandVerb()) {
+    case QueryRequest::CommandVerb::Read:
+        m_resultCache.endRead(result);
+        break;
+    case QueryRequest::CommandVerb::Authenticate:
+        m_resultCache.clear();
+        break;
+    default:
+        if (result.isSuccessful())
+            m_resultCache.invalidate(queryGroup);
+        break;
+    }
+
+    if (result.request().commandVerb() == QueryRequest::CommandVerb::Read
+            && !takeLatestRead(result.request(), ticket)) {
+        m_supersededCount.ref();
+        return;
+    }
+
+    emit resultReady(result);
+}
+
+QSharedPointer<QAtomicInt> DatabaseThread::supersedeReads(const QueryRequest &request, quint64 ticket)
+{
+    QSharedPointer<QAtomicInt> superseded(new QAtomicInt(0));
+    if (!request.receiver())
+        return superseded;
+
+    const auto key = qMakePair(request.receiver(), request.command());
+    const auto iter = m_inFlightReads.constFind(key);
+    if (iter != m_inFlightReads.cend())
+        iter->superseded->storeRelease(1);
+
+    m_inFlightReads.insert(key, InFlightRead{ ticket, superseded });
+    return superseded;
+}
+
+bool DatabaseThread::takeLatestRead(const QueryRequest &request, quint64 ticket)
+{
+    if (!request.receiver())
+        return true;
+
+    const auto key = qMakePair(request.receiver(), request.command());
+    const auto iter = m_inFlightReads.find(key);
+    if (iter == m_inFlightReads.end() || iter->ticket != ticket)
+        return false;
+
+    m_inFlightReads.erase(iter);
+    return true;
+}
+
+DatabaseWorker *DatabaseThread::leastBusyReadWorker() const
+{
+    DatabaseWorker *leastBusyWorker = m_readWorkers.first();
+    for (DatabaseWorker *readWorker : m_readWorkers) {
+        if (readWorker->queueDepth() < leastBusyWorker->queueDepth())
+            leastBusyWorker = readWorker;
+    }
+
+    return leastBusyWorker;
+}
+
+void DatabaseThread::deliverResult(const QueryResult &result)
+{
+    // NOTE: Only the issuing receiver is handed the result, so the cost of
+    // delivery does not grow with the number of live models.
+    const ResultHandler handler = m_receivers.value(result.request().receiver());
+    if (handler)
+        handler(result);
+}
@@ -4,21 +4,43 @@
 #include <QThread>
 #include <QSqlDatabase>
 #include <QLoggingCategory>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QPair>
+#include <QMap>
+#include <QHash>
+#include <functional>
 #include "queryrequest.h"
 #include "queryresult.h"
+#include "queryresultcache.h"
+#include "pendingwrites.h"
 
 class QueryExecutor;
+class ReadReplica;
+class ChangeSync;
 
 class DatabaseWorker : public QObject
 {
     Q_OBJECT
 public:
-    explicit DatabaseWorker(QObject *parent = nullptr);
+    explicit DatabaseWorker(const QString &connectionName, QObject *parent = nullptr);
     ~DatabaseWorker();
 
-    void execute(QueryExecutor *queryExecutor);
+    QString connectionName() const;
+    int queueDepth() const;
+    void enqueue();
+
+    void execute(QueryExecutor *queryExecutor,
+                 quint64 ticket = 0,
+                 QSharedPointer<QAtomicInt> superseded = QSharedPointer<QAtomicInt>());
 signals:
-    void resultReady(const QueryResult result);
+    void resultReady(const QueryResult result, quint64 ticket);
+private:
+    QString m_connectionName;
+    QAtomicInt m_queueDepth;
+    int m_connectionGeneration;
+
+    void openClonedConnection(); // throws DatabaseException
 };
 
 class DatabaseThread : public QThread
@@ -33,12 +55,57 @@ public:
     DatabaseThread(DatabaseThread const &) = delete;
     void operator=(DatabaseThread const &) = delete;
 
+    int workerCount() const;
+    int queueDepth(int worker) const;
+    QList<int> queueDepths() const;
+    const QueryResultCache &resultCache() const;
+    void setResultCacheCapacity(int capacity);
+    int supersededCount() const;
+
+    using ResultHandler = std::function<void(const QueryResult &)>;
+    void addReceiver(QObject *receiver, ResultHandler handler);
+    void removeReceiver(QObject *receiver);
+
     void run() override final;
 signals:
     void execute(QueryExecutor *queryExecutor);
     void resultReady(const QueryResult result);
+    void changesPulled();
+protected:
+    // Returns false when a read was answered from the result cache.
+    bool beginRequest(QueryExecutor *queryExecutor, quint64 &ticket, QSharedPointer<QAtomicInt> &superseded);
+    void releaseRequest(const QueryResult result, quint64 ticket);
 private:
+    DatabaseWorker *m_writeWorker;
+    QList<DatabaseWorker *> m_readWorkers;
+    QList<QThread *> m_readThreads;
+    PendingWrites m_pendingWrites;
+    QHash<QObject *, ResultHandler> m_receivers;
+    QueryResultCache m_resultCache;
+    ReadReplica *m_replica;
+    ChangeSync *m_changeSync;
+    bool m_connectedToServer;
+
+    struct InFlightRead {
+        quint64 ticket;
+        QSharedPointer<QAtomicInt> superseded;
+    };
+
+    quint64 m_lastTicket;
+    QHash<QPair<QObject *, QString>, InFlightRead> m_inFlightReads;
+    QAtomicInt m_supersededCount;
+
     explicit DatabaseThread(QObject *parent = nullptr);
+    void dispatch(QueryExecutor *queryExecutor);
+    void connectToServer();
+    void tunnel(QueryExecutor *queryExecutor);
+    void finishTunnelledRequest(const QueryResult result);
+    void invalidateReplicatedResults();
+    void invalidateSyncedResults();
+    QSharedPointer<QAtomicInt> supersedeReads(const QueryRequest &request, quint64 ticket);
+    bool takeLatestRead(const QueryRequest &request, quint64 ticket);
+    DatabaseWorker *leastBusyReadWorker() const;
+    void deliverResult(const QueryResult &result);
 };
 
 Q_DECLARE_LOGGING_CATEGORY(databaseThread);
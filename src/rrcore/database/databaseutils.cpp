@@ -1,7 +1,5 @@
 #include "databaseutils.h"
 #include <QSqlQuery>
-#include <QBuffer>
-#include <QImage>
 #include <QByteArray>
 #include <QUrl>
 #include <QFile>
@@ -11,11 +9,11 @@
 #include <QSqlError>
 
 #include "database/databaseexception.h"
+#include "database/imagecache.h"
+#include "database/imagenormalizer.h"
 
 #include <QDebug>
 
-const int HASH_INPUT_LENGTH = 64;
-
 DatabaseUtils::DatabaseUtils(QObject *parent)
     : QObject(parent)
 {
@@ -81,16 +79,15 @@ QByteArray DatabaseUtils::imageUrlToByteArray(const QUrl &imageUrl, qint64 maxSi
     if (imageUrl.isEmpty())
         return QByteArray();
 
-    QImage image(imageUrl.toLocalFile());
-    QByteArray ba;
-    QBuffer buffer(&ba);
-    buffer.open(QIODevice::WriteOnly);
-    image.save(&buffer, "PNG");
+    const NormalizedImage &normalizedImage = ImageNormalizer::instance().take(imageUrl);
+    const QByteArray &ba = normalizedImage.image;
 
     if (ba.size() > maxSize)
         throw DatabaseException(DatabaseError::QueryErrorCode::ImageTooLarge,
                                 QStringLiteral("Image too large (%1 bytes). Expected size should be less than %2").arg(ba.size()).arg(maxSize),
                                 QStringLiteral("Image too large (%1 bytes). Expected size should be less than %2").arg(ba.size()).arg(maxSize));
+
+    ImageCache::instance().insertThumbnail(normalizedImage.image, normalizedImage.thumbnail);
     return ba;
 }
 
@@ -99,25 +96,19 @@ QUrl DatabaseUtils::byteArrayToImageUrl(const QByteArray &imageData)
     if (imageData.isNull())
         return QString();
 
-    const QString &imageSource = generateFileName(imageData);
-    QFile file(imageSource);
-    file.open(QIODevice::WriteOnly);
-    file.write(QByteArray::fromHex(imageData));
+    const QByteArray &image = QByteArray::fromHex(imageData);
+    const QString &imageSource = generateFileName(image);
+    if (!QFile::exists(imageSource)) {
+        QFile file(imageSource);
+        file.open(QIODevice::WriteOnly);
+        file.write(image);
+    }
 
     return QUrl::fromLocalFile(imageSource).toString();
 }
 
 QString DatabaseUtils::generateFileName(const QByteArray &imageData)
 {
-    QByteArray ba;
-    if (imageData.size() < HASH_INPUT_LENGTH) {
-        for (int i = 0; i < imageData.size(); ++i)
-            ba.append(imageData.at(i));
-    } else {
-        for (int i = 0; i < HASH_INPUT_LENGTH; ++i)
-            ba.append(imageData.at(i));
-    }
-
     return QString("%1/%2.png").arg(QStandardPaths::writableLocation(QStandardPaths::TempLocation),
-                                    QString(QCryptographicHash::hash(ba, QCryptographicHash::Md5).toHex()));
+                                    QString(QCryptographicHash::hash(imageData, QCryptographicHash::Sha1).toHex()));
 }
@@ -0,0 +1,306 @@
+#include "imagecache.h"
+#include "imagenormalizer.h"
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QSettings>
+#include <QDateTime>
+#include <QImage>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QRegularExpression>
+
+Q_LOGGING_CATEGORY(imageCache, "rrcore.database.imagecache");
+
+const QString MAX_DISK_SIZE_KEY(QStringLiteral("image_cache/max_size"));
+const QString IMAGE_FILE_SUFFIX(QStringLiteral(".png"));
+const QString THUMBNAIL_SUFFIX(QStringLiteral("_thumbnail"));
+const QRegularExpression HASH_PATTERN(QStringLiteral("^[0-9a-f]{40}$"));
+
+ImageCache::ImageCache(const QString &directory, qint64 maxDiskSize) :
+    m_directory(directory),
+    m_maxDiskSize(maxDiskSize),
+    m_diskSize(0),
+    m_pendingSize(0),
+    m_indexed(false)
+{
+
+}
+
+ImageCache &ImageCache::instance()
+{
+    static ImageCache instance(QStringLiteral("%1/images")
+                               .arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)),
+                               QSettings().value(MAX_DISK_SIZE_KEY, DEFAULT_MAX_DISK_SIZE).toLongLong());
+    return instance;
+}
+
+QString ImageCache::directory() const
+{
+    return m_directory;
+}
+
+qint64 ImageCache::maxDiskSize() const
+{
+    return m_maxDiskSize;
+}
+
+qint64 ImageCache::diskSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_diskSize;
+}
+
+QUrl ImageCache::insert(const QString &key, const QByteArray &imageData)
+{
+    if (imageData.isEmpty())
+        return QUrl();
+
+    const QByteArray &image = QByteArray::fromHex(imageData);
+    const QString hash(QCryptographicHash::hash(image, QCryptographicHash::Sha1).toHex());
+
+    QMutexLocker locker(&m_mutex);
+    indexDirectory();
+    m_keys.insert(key, hash);
+
+    if (!m_diskIndex.contains(hash) && !m_pending.contains(hash)) {
+        m_pending.insert(hash, image);
+        m_pendingOrder.append(hash);
+        m_pendingSize += image.size();
+
+        // NOTE: Images that were never displayed are persisted, not dropped, since
+        // an image inserted with its data may not be readable through the loader.
+        while (m_pendingSize > MAX_PENDING_SIZE && !m_pendingOrder.isEmpty())
+            flushPending(m_pendingOrder.first());
+    }
+
+    return QUrl(QStringLiteral("image://%1/%2/%3").arg(PROVIDER_ID, key, hash));
+}
+
+QUrl ImageCache::insertHash(const QString &key, const QString &hash)
+{
+    if (!HASH_PATTERN.match(hash).hasMatch())
+        return QUrl();
+
+    QMutexLocker locker(&m_mutex);
+    m_keys.insert(key, hash);
+
+    return QUrl(QStringLiteral("image://%1/%2/%3").arg(PROVIDER_ID, key, hash));
+}
+
+QByteArray ImageCache::imageData(const QString &hash, const QString &key)
+{
+    if (!HASH_PATTERN.match(hash).hasMatch())
+        return QByteArray();
+
+    QMutexLocker locker(&m_mutex);
+    indexDirectory();
+
+    if (m_pending.contains(hash)) {
+        const QByteArray image = m_pending.value(hash);
+        flushPending(hash);
+        return image;
+    }
+
+    const QByteArray &image = readFile(hash);
+    if (!image.isEmpty() || key.isEmpty())
+        return image;
+
+    // NOTE: Either only the hash was inserted, or the file was trimmed after its URL was handed out.
+    return load(key, locker);
+}
+
+QByteArray ImageCache::imageData(const QUrl &imageUrl)
+{
+    if (!isCacheUrl(imageUrl))
+        return QByteArray();
+
+    return imageData(hashFromId(imageUrl.path()), keyFromId(imageUrl.path()));
+}
+
+QByteArray ImageCache::thumbnailData(const QString &hash, const QString &key)
+{
+    if (!HASH_PATTERN.match(hash).hasMatch())
+        return QByteArray();
+
+    QMutexLocker locker(&m_mutex);
+    indexDirectory();
+    QByteArray thumbnail = readFile(hash + THUMBNAIL_SUFFIX);
+    locker.unlock();
+
+    if (!thumbnail.isEmpty())
+        return thumbnail;
+
+    // NOTE: Images stored before thumbnails existed get one the first time they are shown.
+    const QByteArray &image = imageData(hash, key);
+    if (image.isEmpty())
+        return QByteArray();
+
+    thumbnail = ImageNormalizer::encode(ImageNormalizer::thumbnail(QImage::fromData(image)));
+
+    locker.relock();
+    writeFile(hash + THUMBNAIL_SUFFIX, thumbnail);
+    return thumbnail;
+}
+
+void ImageCache::insertThumbnail(const QByteArray &image, const QByteArray &thumbnail)
+{
+    if (image.isEmpty() || thumbnail.isEmpty())
+        return;
+
+    const QString hash(QCryptographicHash::hash(image, QCryptographicHash::Sha1).toHex());
+
+    QMutexLocker locker(&m_mutex);
+    indexDirectory();
+    writeFile(hash + THUMBNAIL_SUFFIX, thumbnail);
+}
+
+QString ImageCache::hashForKey(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_keys.value(key);
+}
+
+QUrl ImageCache::urlForKey(const QString &key) const
+{
+    const QString &hash = hashForKey(key);
+    if (hash.isEmpty())
+        return QUrl();
+
+    return QUrl(QStringLiteral("image://%1/%2/%3").arg(PROVIDER_ID, key, hash));
+}
+
+void ImageCache::setLoader(const Loader &loader)
+{
+    QMutexLocker locker(&m_mutex);
+    m_loader = loader;
+}
+
+bool ImageCache::isCacheUrl(const QUrl &imageUrl)
+{
+    return imageUrl.scheme() == QStringLiteral("image") && imageUrl.host() == PROVIDER_ID;
+}
+
+QString ImageCache::hashFromId(const QString &id)
+{
+    return id.section('/', -1);
+}
+
+QString ImageCache::keyFromId(const QString &id)
+{
+    return id.section('/', 0, -2, QString::SectionSkipEmpty);
+}
+
+void ImageCache::indexDirectory()
+{
+    if (m_indexed)
+        return;
+
+    m_indexed = true;
+    if (!QDir().mkpath(m_directory)) {
+        qCWarning(imageCache) << "Failed to create image cache directory:" << m_directory;
+        return;
+    }
+
+    const QFileInfoList &files = QDir(m_directory).entryInfoList({ QStringLiteral("*") + IMAGE_FILE_SUFFIX },
+                                                                  QDir::Files);
+    for (const QFileInfo &fileInfo : files) {
+        m_diskIndex.insert(fileInfo.completeBaseName());
+        m_diskSize += fileInfo.size();
+    }
+
+    qCDebug(imageCache) << "Indexed" << m_diskIndex.count() << "cached images," << m_diskSize << "bytes.";
+}
+
+void ImageCache::flushPending(const QString &hash)
+{
+    const QByteArray image = m_pending.take(hash);
+    m_pendingOrder.removeOne(hash);
+    m_pendingSize -= image.size();
+
+    writeFile(hash, image);
+}
+
+QByteArray ImageCache::load(const QString &key, QMutexLocker &locker)
+{
+    if (!m_loader)
+        return QByteArray();
+
+    // NOTE: The loader reads from the database, so other images are served meanwhile.
+    const Loader loader = m_loader;
+    locker.unlock();
+    const QByteArray &image = QByteArray::fromHex(loader(key));
+    locker.relock();
+
+    if (image.isEmpty())
+        return QByteArray();
+
+    // NOTE: The image may have changed since its URL was handed out; the current one is served.
+    const QString hash(QCryptographicHash::hash(image, QCryptographicHash::Sha1).toHex());
+    m_keys.insert(key, hash);
+    writeFile(hash, image);
+    return image;
+}
+
+QByteArray ImageCache::readFile(const QString &fileName)
+{
+    if (!m_diskIndex.contains(fileName))
+        return QByteArray();
+
+    QFile file(filePath(fileName));
+    if (!file.open(QIODevice::ReadWrite)) {
+        qCWarning(imageCache) << "Failed to open cached image:" << file.fileName() << file.errorString();
+        return QByteArray();
+    }
+
+    // NOTE: Touch the file so that images still in use are trimmed last.
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return file.readAll();
+}
+
+bool ImageCache::writeFile(const QString &fileName, const QByteArray &data)
+{
+    if (m_diskIndex.contains(fileName))
+        return true;
+
+    QFile file(filePath(fileName));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+        qCWarning(imageCache) << "Failed to write cached image:" << file.fileName() << file.errorString();
+        file.remove();
+        return false;
+    }
+
+    m_diskIndex.insert(fileName);
+    m_diskSize += data.size();
+    trimDirectory();
+    return true;
+}
+
+void ImageCache::trimDirectory()
+{
+    if (m_maxDiskSize <= 0 || m_diskSize <= m_maxDiskSize)
+        return;
+
+    // NOTE: Trim below the limit, so that the directory is not listed on every write.
+    // Files whose URLs were handed out may go too; they are read through the loader when next shown.
+    const qint64 targetSize = m_maxDiskSize * 9 / 10;
+    const QFileInfoList &files = QDir(m_directory).entryInfoList({ QStringLiteral("*") + IMAGE_FILE_SUFFIX },
+                                                                  QDir::Files,
+                                                                  QDir::Time | QDir::Reversed);
+    for (const QFileInfo &fileInfo : files) {
+        if (m_diskSize <= targetSize)
+            break;
+
+        if (QFile::remove(fileInfo.absoluteFilePath())) {
+            m_diskIndex.remove(fileInfo.completeBaseName());
+            m_diskSize -= fileInfo.size();
+        }
+    }
+
+    qCDebug(imageCache) << "Image cache trimmed to" << m_diskSize << "bytes.";
+}
+
+QString ImageCache::filePath(const QString &fileName) const
+{
+    return QStringLiteral("%1/%2%3").arg(m_directory, fileName, IMAGE_FILE_SUFFIX);
+}
@@ -0,0 +1,83 @@
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QUrl>
+#include <QMutex>
+#include <QByteArray>
+#include <QLoggingCategory>
+#include <functional>
+
+// Content-addressed store for images read from the database.
+// Images are kept in memory when a query returns them and are only written
+// to disk the first time they are requested, so viewing a list of items never
+// touches the file system. Files are named after a hash of the full image and
+// the cache directory is trimmed to a maximum size, oldest files first.
+// A thumbnail is kept next to each image for list views.
+// List queries only return the hash of each image; an image that is not in
+// the cache (never read, or trimmed since) is read through the loader.
+class ImageCache
+{
+public:
+    // Returns the hex-encoded image of "key", as returned by the database.
+    using Loader = std::function<QByteArray(const QString &key)>;
+
+    static inline const QString PROVIDER_ID = QStringLiteral("rrcore");
+    static const qint64 DEFAULT_MAX_DISK_SIZE = 64 * 1024 * 1024;
+    static const qint64 MAX_PENDING_SIZE = 16 * 1024 * 1024;
+
+    static ImageCache &instance();
+
+    explicit ImageCache(const QString &directory, qint64 maxDiskSize = DEFAULT_MAX_DISK_SIZE);
+
+    ImageCache(ImageCache const &) = delete;
+    void operator=(ImageCache const &) = delete;
+
+    QString directory() const;
+    qint64 maxDiskSize() const;
+    qint64 diskSize() const;
+
+    // "key" identifies the owner of the image (e.g. "stock_item/12") and
+    // "imageData" is the hex-encoded blob, as returned by the database.
+    QUrl insert(const QString &key, const QByteArray &imageData);
+    // Same as insert(), for an image whose data is left in the database.
+    QUrl insertHash(const QString &key, const QString &hash);
+    QByteArray imageData(const QString &hash, const QString &key = QString());
+    QByteArray imageData(const QUrl &imageUrl);
+    QByteArray thumbnailData(const QString &hash, const QString &key = QString());
+    void insertThumbnail(const QByteArray &image, const QByteArray &thumbnail);
+    QString hashForKey(const QString &key) const;
+    QUrl urlForKey(const QString &key) const;
+
+    void setLoader(const Loader &loader);
+
+    static bool isCacheUrl(const QUrl &imageUrl);
+    static QString hashFromId(const QString &id);
+    static QString keyFromId(const QString &id);
+private:
+    QString m_directory;
+    qint64 m_maxDiskSize;
+    qint64 m_diskSize;
+    qint64 m_pendingSize;
+    bool m_indexed;
+    QSet<QString> m_diskIndex;
+    QHash<QString, QByteArray> m_pending;
+    QList<QString> m_pendingOrder;
+    QHash<QString, QString> m_keys;
+    Loader m_loader;
+    mutable QMutex m_mutex;
+
+    void indexDirectory();
+    void flushPending(const QString &hash);
+    QByteArray load(const QString &key, QMutexLocker &locker);
+    QByteArray readFile(const QString &fileName);
+    bool writeFile(const QString &fileName, const QByteArray &data);
+    void trimDirectory();
+    QString filePath(const QString &fileName) const;
+};
+
+Q_DECLARE_LOGGING_CATEGORY(imageCache);
+
+#endif // IMAGECACHE_H
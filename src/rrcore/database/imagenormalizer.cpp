@@ -0,0 +1,144 @@
+#include "imagenormalizer.h"
+#include "database/imagecache.h"
+
+#include <QtConcurrent>
+#include <QImageReader>
+#include <QElapsedTimer>
+#include <QBuffer>
+#include <QImage>
+
+Q_LOGGING_CATEGORY(imageNormalizer, "rrcore.database.imagenormalizer");
+
+const int JPEG_QUALITY = 85;
+
+ImageNormalizer::ImageNormalizer()
+{
+    // NOTE: Leave a core free for the GUI thread.
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+}
+
+ImageNormalizer &ImageNormalizer::instance()
+{
+    static ImageNormalizer instance;
+    return instance;
+}
+
+void ImageNormalizer::prefetch(const QUrl &imageUrl)
+{
+    if (imageUrl.isEmpty())
+        return;
+
+    // NOTE: Requests for the same image (e.g. a save that is retried) share one future.
+    QMutexLocker locker(&m_mutex);
+    auto pending = m_pending.find(imageUrl);
+    if (pending == m_pending.end())
+        m_pending.insert(imageUrl, PendingImage{ QtConcurrent::run(&m_threadPool, &ImageNormalizer::normalize, imageUrl), 1 });
+    else
+        ++pending->users;
+}
+
+NormalizedImage ImageNormalizer::take(const QUrl &imageUrl)
+{
+    if (imageUrl.isEmpty())
+        return NormalizedImage();
+
+    QMutexLocker locker(&m_mutex);
+    if (m_pending.contains(imageUrl)) {
+        QFuture<NormalizedImage> future = m_pending.value(imageUrl).future;
+        locker.unlock();
+        return future.result();
+    }
+
+    locker.unlock();
+    return normalize(imageUrl);
+}
+
+void ImageNormalizer::release(const QUrl &imageUrl)
+{
+    if (imageUrl.isEmpty())
+        return;
+
+    // NOTE: Executors that never run (e.g. requests tunnelled to the server) release their image here too.
+    QMutexLocker locker(&m_mutex);
+    auto pending = m_pending.find(imageUrl);
+    if (pending != m_pending.end() && --pending->users <= 0)
+        m_pending.erase(pending);
+}
+
+int ImageNormalizer::pendingCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_pending.count();
+}
+
+NormalizedImage ImageNormalizer::normalize(const QUrl &imageUrl)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray imageData;
+    QBuffer buffer(&imageData);
+    QImageReader reader;
+    if (ImageCache::isCacheUrl(imageUrl)) {
+        imageData = ImageCache::instance().imageData(imageUrl);
+        buffer.open(QIODevice::ReadOnly);
+        reader.setDevice(&buffer);
+    } else {
+        reader.setFileName(imageUrl.toLocalFile());
+    }
+
+    reader.setAutoTransform(true);
+    const QSize &originalSize = reader.size();
+
+    // NOTE: Images from the cache were normalized when they were stored.
+    if (!imageData.isEmpty() && originalSize.isValid()
+            && originalSize.width() <= MAX_IMAGE_SIZE && originalSize.height() <= MAX_IMAGE_SIZE) {
+        QImage image;
+        image.loadFromData(imageData);
+        return NormalizedImage{ imageData, encode(thumbnail(image)) };
+    }
+
+    // NOTE: Let the decoder scale while it reads, which is much cheaper for JPEGs.
+    if (originalSize.isValid()
+            && (originalSize.width() > MAX_IMAGE_SIZE || originalSize.height() > MAX_IMAGE_SIZE))
+        reader.setScaledSize(originalSize.scaled(MAX_IMAGE_SIZE, MAX_IMAGE_SIZE, Qt::KeepAspectRatio));
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qCWarning(imageNormalizer) << "Failed to read image:" << imageUrl << reader.errorString();
+        return NormalizedImage();
+    }
+
+    if (image.width() > MAX_IMAGE_SIZE || image.height() > MAX_IMAGE_SIZE)
+        image = image.scaled(MAX_IMAGE_SIZE, MAX_IMAGE_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    const NormalizedImage normalizedImage{ encode(image), encode(thumbnail(image)) };
+    qCDebug(imageNormalizer) << "Image normalized:" << imageUrl << originalSize << "->" << image.size()
+                             << normalizedImage.image.size() << "bytes in" << timer.elapsed() << "ms";
+    return normalizedImage;
+}
+
+QImage ImageNormalizer::thumbnail(const QImage &image)
+{
+    if (image.isNull() || (image.width() <= THUMBNAIL_SIZE && image.height() <= THUMBNAIL_SIZE))
+        return image;
+
+    return image.scaled(THUMBNAIL_SIZE, THUMBNAIL_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+QByteArray ImageNormalizer::encode(const QImage &image)
+{
+    if (image.isNull())
+        return QByteArray();
+
+    // NOTE: Photos are much smaller as JPEG; keep PNG only when transparency matters.
+    QByteArray ba;
+    QBuffer buffer(&ba);
+    buffer.open(QIODevice::WriteOnly);
+    if (image.hasAlphaChannel())
+        image.save(&buffer, "PNG");
+    else
+        image.save(&buffer, "JPG", JPEG_QUALITY);
+
+    return ba;
+}
@@ -0,0 +1,57 @@
+#ifndef IMAGENORMALIZER_H
+#define IMAGENORMALIZER_H
+
+#include <QHash>
+#include <QUrl>
+#include <QMutex>
+#include <QFuture>
+#include <QThreadPool>
+#include <QByteArray>
+#include <QLoggingCategory>
+
+class QImage;
+
+struct NormalizedImage {
+    QByteArray image;
+    QByteArray thumbnail;
+};
+
+// Decodes, downscales and re-encodes images picked by the user.
+// Executors call prefetch() when they are created, so that the work runs on a
+// thread pool while the request waits in the queue, take() once they execute,
+// and release() when they are destroyed, whether or not they ever executed.
+class ImageNormalizer
+{
+public:
+    static const int MAX_IMAGE_SIZE = 1024;
+    static const int THUMBNAIL_SIZE = 128;
+
+    static ImageNormalizer &instance();
+
+    ImageNormalizer(ImageNormalizer const &) = delete;
+    void operator=(ImageNormalizer const &) = delete;
+
+    void prefetch(const QUrl &imageUrl);
+    NormalizedImage take(const QUrl &imageUrl);
+    void release(const QUrl &imageUrl);
+    int pendingCount() const;
+
+    static NormalizedImage normalize(const QUrl &imageUrl);
+    static QImage thumbnail(const QImage &image);
+    static QByteArray encode(const QImage &image);
+private:
+    struct PendingImage {
+        QFuture<NormalizedImage> future;
+        int users;
+    };
+
+    explicit ImageNormalizer();
+
+    QThreadPool m_threadPool;
+    QHash<QUrl, PendingImage> m_pending;
+    mutable QMutex m_mutex;
+};
+
+Q_DECLARE_LOGGING_CATEGORY(imageNormalizer);
+
+#endif // IMAGENORMALIZER_H
@@ -0,0 +1,185 @@
+#include "indexadvisor.h"
+#include "databaseexception.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QRegularExpression>
+
+Q_LOGGING_CATEGORY(indexAdvisor, "rrcore.database.indexadvisor");
+
+QVariantList IndexAdvisor::advise(const QString &connectionName)
+{
+    QSqlDatabase connection = QSqlDatabase::database(connectionName);
+    if (!connection.isOpen())
+        throw DatabaseException(DatabaseError::QueryErrorCode::NoValidConnection,
+                                QString(),
+                                QStringLiteral("Cannot check indexes without a connection."));
+
+    QSqlQuery query(connection);
+    if (!query.exec(QStringLiteral("SELECT SPECIFIC_NAME, PARAMETER_NAME, DATA_TYPE FROM information_schema.PARAMETERS "
+                                   "WHERE SPECIFIC_SCHEMA = DATABASE() AND ROUTINE_TYPE = 'PROCEDURE' "
+                                   "AND PARAMETER_NAME IS NOT NULL")))
+        throw DatabaseException(DatabaseError::QueryErrorCode::ProcedureFailed,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to read procedure parameters."));
+
+    QHash<QString, QHash<QString, QString>> parameters;
+    while (query.next())
+        parameters[query.value(0).toString()].insert(query.value(1).toString(), query.value(2).toString());
+
+    if (!query.exec(QStringLiteral("SELECT ROUTINE_NAME, ROUTINE_DEFINITION FROM information_schema.ROUTINES "
+                                   "WHERE ROUTINE_SCHEMA = DATABASE() AND ROUTINE_TYPE = 'PROCEDURE' "
+                                   "ORDER BY ROUTINE_NAME")))
+        throw DatabaseException(DatabaseError::QueryErrorCode::ProcedureFailed,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to read procedure definitions."));
+
+    QList<QPair<QString, QString>> procedures;
+    while (query.next())
+        procedures.append(qMakePair(query.value(0).toString(), query.value(1).toString()));
+
+    QVariantList findings;
+    int statementCount = 0;
+    for (const auto &procedure : procedures) {
+        QHash<QString, QString> variableTypes = declaredVariables(procedure.second);
+        const QHash<QString, QString> &parameterTypes = parameters.value(procedure.first);
+        for (auto iter = parameterTypes.cbegin(); iter != parameterTypes.cend(); ++iter)
+            variableTypes.insert(iter.key(), iter.value());
+
+        for (const QString &statement : statements(procedure.second, variableTypes)) {
+            // NOTE: Bookkeeping queries on the catalogue are not worth indexing.
+            if (statement.contains(QStringLiteral("information_schema"), Qt::CaseInsensitive))
+                continue;
+
+            ++statementCount;
+            if (!query.exec(QStringLiteral("EXPLAIN ") + statement)) {
+                findings.append(QVariantMap {
+                                    { "procedure", procedure.first },
+                                    { "statement", statement },
+                                    { "finding", UNEXPLAINED },
+                                    { "error", query.lastError().text() }
+                                });
+                continue;
+            }
+
+            while (query.next()) {
+                const QSqlRecord &record = query.record();
+                const QString &table = record.value("table").toString();
+                const QString &finding = findingFor(record.value("type").toString(),
+                                                    record.value("possible_keys").toString());
+                if (finding.isEmpty() || table.isEmpty() || table.startsWith('<'))
+                    continue;
+
+                findings.append(QVariantMap {
+                                    { "procedure", procedure.first },
+                                    { "statement", statement },
+                                    { "table", table },
+                                    { "type", record.value("type") },
+                                    { "possible_keys", record.value("possible_keys") },
+                                    { "rows", record.value("rows") },
+                                    { "finding", finding }
+                                });
+            }
+        }
+    }
+
+    qCInfo(indexAdvisor) << "Explained" << statementCount << "statements in" << procedures.count()
+                         << "procedures," << findings.count() << "findings.";
+    return findings;
+}
+
+QStringList IndexAdvisor::statements(const QString &body, const QHash<QString, QString> &variableTypes)
+{
+    static const QRegularExpression commentPattern(QStringLiteral("/\\*.*?\\*/|--[^\\n]*"),
+                                                   QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression statementPattern(QStringLiteral("(?:^|\\b(?:BEGIN|THEN|ELSE|DO|LOOP|REPEAT)\\s+)"
+                                                                    "((?:SELECT|UPDATE|DELETE)\\b.*)$"),
+                                                     QRegularExpression::CaseInsensitiveOption
+                                                     | QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression intoPattern(QStringLiteral("\\bINTO\\s+@?\\w+(?:\\s*,\\s*@?\\w+)*"),
+                                                QRegularExpression::CaseInsensitiveOption);
+
+    QString source = body;
+    source.replace(commentPattern, QStringLiteral(" "));
+
+    QStringList statements;
+    for (QString chunk : source.split(';')) {
+        chunk = chunk.simplified();
+        const QRegularExpressionMatch &match = statementPattern.match(chunk);
+        if (!match.hasMatch())
+            continue;
+
+        QString statement = match.captured(1);
+
+        // NOTE: EXPLAIN does not accept "SELECT ... INTO", and the plan is the same without it.
+        if (statement.startsWith(QStringLiteral("SELECT"), Qt::CaseInsensitive))
+            statement.replace(intoPattern, QString());
+
+        for (auto iter = variableTypes.cbegin(); iter != variableTypes.cend(); ++iter)
+            statement.replace(QRegularExpression(QStringLiteral("(?<![@.\\w])%1\\b")
+                                                 .arg(QRegularExpression::escape(iter.key())),
+                                                 QRegularExpression::CaseInsensitiveOption),
+                              placeholderFor(iter.value()));
+
+        statements.append(statement.simplified());
+    }
+
+    return statements;
+}
+
+QHash<QString, QString> IndexAdvisor::declaredVariables(const QString &body)
+{
+    static const QRegularExpression declarePattern(QStringLiteral("\\bDECLARE\\s+(\\w+(?:\\s*,\\s*\\w+)*)\\s+(\\w+)"),
+                                                   QRegularExpression::CaseInsensitiveOption);
+    static const QStringList notVariables {
+        QStringLiteral("CURSOR"), QStringLiteral("HANDLER"), QStringLiteral("CONDITION")
+    };
+
+    QHash<QString, QString> variableTypes;
+    QRegularExpressionMatchIterator iter = declarePattern.globalMatch(body);
+    while (iter.hasNext()) {
+        const QRegularExpressionMatch &match = iter.next();
+        const QString &dataType = match.captured(2);
+        if (notVariables.contains(dataType, Qt::CaseInsensitive)
+                || match.captured(1).compare(QStringLiteral("CONTINUE"), Qt::CaseInsensitive) == 0
+                || match.captured(1).compare(QStringLiteral("EXIT"), Qt::CaseInsensitive) == 0)
+            continue;
+
+        for (const QString &name : match.captured(1).split(',')) {
+            variableTypes.insert(name.trimmed(), dataType);
+        }
+    }
+
+    return variableTypes;
+}
+
+QString IndexAdvisor::placeholderFor(const QString &dataType)
+{
+    // NOTE: NULL would make MySQL see an impossible WHERE and skip the tables altogether,
+    // and a constant of the wrong type would stop it from using an index.
+    const QString &type = dataType.toLower();
+    if (type.endsWith(QStringLiteral("int")) || type == QStringLiteral("integer")
+            || type == QStringLiteral("decimal") || type == QStringLiteral("numeric")
+            || type == QStringLiteral("float") || type == QStringLiteral("double")
+            || type == QStringLiteral("bit") || type == QStringLiteral("boolean"))
+        return QStringLiteral("1");
+    else if (type == QStringLiteral("date"))
+        return QStringLiteral("'2000-01-01'");
+    else if (type == QStringLiteral("datetime") || type == QStringLiteral("timestamp"))
+        return QStringLiteral("'2000-01-01 00:00:00'");
+    else if (type == QStringLiteral("time"))
+        return QStringLiteral("'00:00:00'");
+
+    return QStringLiteral("'a'");
+}
+
+QString IndexAdvisor::findingFor(const QString &accessType, const QString &possibleKeys)
+{
+    // NOTE: "ALL" reads every row, "index" reads every entry of an index.
+    if (accessType != QStringLiteral("ALL") && accessType != QStringLiteral("index"))
+        return QString();
+
+    return possibleKeys.trimmed().isEmpty() ? MISSING_INDEX : UNUSED_INDEX;
+}
@@ -0,0 +1,34 @@
+#ifndef INDEXADVISOR_H
+#define INDEXADVISOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QHash>
+#include <QLoggingCategory>
+
+// Looks for full table scans in the stored procedures.
+// The body of every procedure is read from information_schema, and each
+// SELECT, UPDATE and DELETE in it is run through EXPLAIN with its parameters
+// and local variables replaced by constants of the same type. Every table the
+// plan reads from start to end is reported, with the indexes MySQL could have
+// used, if any. Statements built at run time (PREPARE) are not checked.
+class IndexAdvisor
+{
+public:
+    static inline const QString MISSING_INDEX = QStringLiteral("missing_index");
+    static inline const QString UNUSED_INDEX = QStringLiteral("unused_index");
+    static inline const QString UNEXPLAINED = QStringLiteral("unexplained");
+
+    // Run on the thread that owns the connection.
+    static QVariantList advise(const QString &connectionName); // throws DatabaseException
+
+    static QStringList statements(const QString &body, const QHash<QString, QString> &variableTypes);
+    static QHash<QString, QString> declaredVariables(const QString &body);
+    static QString placeholderFor(const QString &dataType);
+    static QString findingFor(const QString &accessType, const QString &possibleKeys);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(indexAdvisor);
+
+#endif // INDEXADVISOR_H
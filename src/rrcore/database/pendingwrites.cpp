@@ -0,0 +1,32 @@
+#include "pendingwrites.h"
+#include "queryresultcache.h"
+
+void PendingWrites::begin(QueryRequest::QueryGroup queryGroup)
+{
+    m_counts[queryGroup]++;
+}
+
+void PendingWrites::end(QueryRequest::QueryGroup queryGroup)
+{
+    const auto iter = m_counts.find(queryGroup);
+    if (iter == m_counts.end())
+        return;
+
+    if (--iter.value() <= 0)
+        m_counts.erase(iter);
+}
+
+int PendingWrites::count(QueryRequest::QueryGroup queryGroup) const
+{
+    return m_counts.value(queryGroup);
+}
+
+bool PendingWrites::affects(QueryRequest::QueryGroup readGroup) const
+{
+    for (auto iter = m_counts.cbegin(); iter != m_counts.cend(); ++iter) {
+        if (iter.key() == readGroup || QueryResultCache::dependentGroups(iter.key()).contains(readGroup))
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,25 @@
+#ifndef PENDINGWRITES_H
+#define PENDINGWRITES_H
+
+#include <QMap>
+#include "queryrequest.h"
+
+// Writes queued on the write connection that have not finished yet.
+// A read must wait behind them when it belongs to the group written to, or to
+// a group whose reads the write can change (see QueryResultCache::dependentGroups),
+// e.g. a stock read issued while a sale is pending.
+class PendingWrites
+{
+public:
+    explicit PendingWrites() = default;
+
+    void begin(QueryRequest::QueryGroup queryGroup);
+    void end(QueryRequest::QueryGroup queryGroup);
+
+    int count(QueryRequest::QueryGroup queryGroup) const;
+    bool affects(QueryRequest::QueryGroup readGroup) const;
+private:
+    QMap<QueryRequest::QueryGroup, int> m_counts;
+};
+
+#endif // PENDINGWRITES_H
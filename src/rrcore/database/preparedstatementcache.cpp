@@ -0,0 +1,69 @@
+#include "preparedstatementcache.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QMutexLocker>
+
+#include "database/databaseexception.h"
+
+Q_LOGGING_CATEGORY(preparedStatementCache, "rrcore.database.preparedstatementcache");
+
+PreparedStatementCache &PreparedStatementCache::instance()
+{
+    static PreparedStatementCache instance;
+    return instance;
+}
+
+PreparedStatementCache::~PreparedStatementCache()
+{
+    for (const auto &statements : qAsConst(m_statements))
+        qDeleteAll(statements);
+}
+
+QSqlQuery *PreparedStatementCache::find(const QString &connectionName, const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_statements.value(connectionName).value(key);
+}
+
+QSqlQuery *PreparedStatementCache::prepare(const QString &connectionName,
+                                           const QString &key,
+                                           const QString &sql)
+{
+    // NOTE: A connection is only ever used by the thread that owns it,
+    // so preparing outside the lock cannot race for the same key.
+    QSqlQuery *query = new QSqlQuery(QSqlDatabase::database(connectionName));
+    if (!query->prepare(sql)) {
+        const QSqlError error = query->lastError();
+        delete query;
+        throw DatabaseException(DatabaseError::QueryErrorCode::ProcedureFailed,
+                                error.text(),
+                                QStringLiteral("Failed to prepare statement '%1'.").arg(sql));
+    }
+
+    qCDebug(preparedStatementCache) << "Statement prepared:" << sql << "on" << connectionName;
+
+    QMutexLocker locker(&m_mutex);
+    m_statements[connectionName].insert(key, query);
+    return query;
+}
+
+void PreparedStatementCache::invalidate(const QString &connectionName, const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    auto iter = m_statements.find(connectionName);
+    if (iter != m_statements.end())
+        delete iter.value().take(key);
+}
+
+void PreparedStatementCache::clear(const QString &connectionName)
+{
+    QMutexLocker locker(&m_mutex);
+    qDeleteAll(m_statements.take(connectionName));
+}
+
+int PreparedStatementCache::count(const QString &connectionName) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_statements.value(connectionName).count();
+}
@@ -0,0 +1,37 @@
+#ifndef PREPAREDSTATEMENTCACHE_H
+#define PREPAREDSTATEMENTCACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QLoggingCategory>
+
+class QSqlQuery;
+
+class PreparedStatementCache
+{
+public:
+    static PreparedStatementCache &instance();
+
+    PreparedStatementCache(PreparedStatementCache const &) = delete;
+    void operator=(PreparedStatementCache const &) = delete;
+    ~PreparedStatementCache();
+
+    QSqlQuery *find(const QString &connectionName, const QString &key) const;
+    QSqlQuery *prepare(const QString &connectionName,
+                       const QString &key,
+                       const QString &sql); // throws DatabaseException
+    void invalidate(const QString &connectionName, const QString &key);
+    void clear(const QString &connectionName);
+
+    int count(const QString &connectionName) const;
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, QHash<QString, QSqlQuery *>> m_statements;
+
+    explicit PreparedStatementCache() = default;
+};
+
+Q_DECLARE_LOGGING_CATEGORY(preparedStatementCache);
+
+#endif // PREPAREDSTATEMENTCACHE_H
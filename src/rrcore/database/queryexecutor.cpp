@@ -1,11 +1,14 @@
 #include "queryexecutor.h"
 
 #include "database/databaseexception.h"
+#include "database/preparedstatementcache.h"
 #include "user/userprofile.h"
 
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlField>
+#include <QSqlDriver>
 #include <QDateTime>
 #include <QJsonDocument>
 #include <QJsonArray>
@@ -152,11 +155,9 @@ QList<QSqlRecord> QueryExecutor::callProcedure(const QString &procedure, std::in
         return QList<QSqlRecord>();
 
     QSqlDatabase connection = QSqlDatabase::database(m_connectionName);
-    QSqlQuery q(connection);
     QList<QSqlRecord> records;
     QStringList sqlArguments;
     QStringList outArguments;
-    QStringList selectStatementSuffixes;
 
     auto areAllArgumentsNull = [](const QSqlRecord &record, const QStringList &arguments) {
         int nullArgumentCount = 0;
@@ -168,57 +169,48 @@ QList<QSqlRecord> QueryExecutor::callProcedure(const QString &procedure, std::in
         return nullArgumentCount == arguments.count();
     };
 
+    // NOTE: A CALL answers with one result set per SELECT plus a status, and a prepared
+    // statement leaves the ones it does not read pending, so the next statement on the
+    // connection fails with "Commands out of sync". CALLs therefore go over the text
+    // protocol, with IN values escaped by the driver; only SET and SELECT are prepared.
     for (const auto &argument : arguments) {
         switch (argument.type) {
         case ProcedureArgument::Type::In:
-            if (argument.value.isNull())
-                sqlArguments.append(QStringLiteral("NULL"));
-            else if (argument.value.type() == QVariant::Bool)
-                sqlArguments.append(argument.value.toBool() ? "1" : "0");
-            else if (argument.value.type() == QVariant::String)
-                sqlArguments.append(QStringLiteral("'%1'").arg(argument.value.toString().replace("'", "\\'")));
-            else if (argument.value.type() == QVariant::ByteArray)
-                sqlArguments.append(QStringLiteral("'%1'").arg(QString(argument.value.toByteArray().toHex())));
-            else if (argument.value.type() == QVariant::DateTime)
-                sqlArguments.append(QStringLiteral("'%1'").arg(argument.value.toDateTime().toString("yyyy-MM-dd hh:mm:ss").replace("'", "\\'")));
-            else if (argument.value.type() == QVariant::Date)
-                sqlArguments.append(QStringLiteral("'%1'").arg(argument.value.toDateTime().toString("yyyy-MM-dd").replace("'", "\\'")));
-            else if (argument.value.type() == QVariant::Time)
-                sqlArguments.append(QStringLiteral("'%1'").arg(argument.value.toDateTime().toString("hh:mm:ss").replace("'", "\\'")));
-            else if (argument.value.type() == QVariant::Map)
-                sqlArguments.append(QStringLiteral("'%1'").arg(QString(QJsonDocument(QJsonObject::fromVariantMap(argument.value.toMap())).toJson())));
-            else if (argument.value.type() == QVariant::List)
-                sqlArguments.append(QStringLiteral("'%1'").arg(QString(QJsonDocument(QJsonArray::fromVariantList(argument.value.toList())).toJson())));
-            else
-                sqlArguments.append(argument.value.toString());
+        {
+            const QVariant &inValue = toBindableValue(argument.value);
+            QSqlField field(argument.name, inValue.type());
+            field.setValue(inValue);
+            sqlArguments.append(connection.driver()->formatValue(field));
+        }
             break;
         case ProcedureArgument::Type::Out:
-            sqlArguments.append(QString("@") + argument.name);
+            sqlArguments.append(QStringLiteral("@") + argument.name);
             outArguments.append(argument.name);
-            selectStatementSuffixes.append(QString("@%1 AS %1").arg(argument.name));
             break;
         case ProcedureArgument::Type::InOut:
         {
-            QString inArgument;
-            if (argument.value.type() == QVariant::String || argument.value.type() == QVariant::ByteArray)
-                inArgument = QStringLiteral("'%1'").arg(argument.value.toString().replace("'", "\\'"));
-            else
-                inArgument = QStringLiteral("%1").arg(argument.value.toString());
-
-            if (!q.exec(QStringLiteral("SET @%1 = %2").arg(argument.name, inArgument)))
+            // NOTE: INOUT byte arrays were always passed as text, not hex, and procedures expect that.
+            const QVariant &inValue = argument.value.type() == QVariant::ByteArray
+                    ? QVariant(argument.value.toString())
+                    : toBindableValue(argument.value);
+            const QString &setKey = QStringLiteral("SET @") + argument.name;
+            QSqlQuery *setQuery = execPreparedStatement(setKey,
+                                                        [&setKey]() { return setKey + QStringLiteral(" = ?"); },
+                                                        { inValue });
+            if (!setQuery->isActive())
                 throw DatabaseException(DatabaseError::QueryErrorCode::ProcedureFailed,
                                         QStringLiteral("Failed to SET variable @%1").arg(argument.name));
 
-            sqlArguments.append(QString("@") + argument.name);
+            sqlArguments.append(QStringLiteral("@") + argument.name);
             outArguments.append(argument.name);
-            selectStatementSuffixes.append(QString("@%1 AS %1").arg(argument.name));
         }
             break;
         }
     }
 
-    const QString &storedProcedure = QString("CALL %1(%2)").arg(procedure, sqlArguments.join(", "));
-    qCInfo(queryExecutor) << "Procedure syntax:" << storedProcedure;
+    const QString &storedProcedure = QStringLiteral("CALL %1(%2)").arg(procedure, sqlArguments.join(", "));
+    qCInfo(queryExecutor) << "Procedure call:" << procedure;
+    QSqlQuery q(connection);
     if (!q.exec(storedProcedure)) {
         if (q.lastError().nativeErrorCode().toInt() >= static_cast<int>(DatabaseError::MySqlErrorCode::UserDefinedException))
             throw DatabaseException(q.lastError().nativeErrorCode().toInt(),
@@ -230,27 +222,97 @@ QList<QSqlRecord> QueryExecutor::callProcedure(const QString &procedure, std::in
                                     QStringLiteral("Procedure '%1' failed.").arg(procedure));
     }
 
-    if (!selectStatementSuffixes.isEmpty()) {
-        if (!q.exec(QStringLiteral("SELECT %1").arg(selectStatementSuffixes.join(", "))))
+    if (outArguments.isEmpty()) {
+        while (q.next())
+            records.append(q.record());
+        q.finish();
+    } else {
+        q.finish();
+
+        auto buildSelectStatement = [&outArguments]() {
+            QStringList selectStatementSuffixes;
+            for (const QString &outArgument : outArguments)
+                selectStatementSuffixes.append(QStringLiteral("@%1 AS %1").arg(outArgument));
+
+            return QStringLiteral("SELECT %1").arg(selectStatementSuffixes.join(", "));
+        };
+
+        const QString &selectKey = QStringLiteral("SELECT@") + outArguments.join(QLatin1String(",@"));
+        QSqlQuery *selectQuery = execPreparedStatement(selectKey, buildSelectStatement, QVariantList());
+        if (!selectQuery->isActive())
             throw DatabaseException(DatabaseError::QueryErrorCode::ProcedureFailed,
-                                    q.lastError().text(),
+                                    selectQuery->lastError().text(),
                                     QStringLiteral("Failed to select out arguments for procedure '%1'.").arg(procedure));
 
-        while (q.next()) {
-            if (areAllArgumentsNull(q.record(), outArguments))
+        while (selectQuery->next()) {
+            if (areAllArgumentsNull(selectQuery->record(), outArguments)) {
+                selectQuery->finish();
                 return QList<QSqlRecord>();
+            }
 
-            records.append(q.record());
-        }
-    } else if (outArguments.isEmpty()) {
-        while (q.next()) {
-            records.append(q.record());
+            records.append(selectQuery->record());
         }
+        selectQuery->finish();
     }
 
     return records;
 }
 
+QSqlQuery *QueryExecutor::execPreparedStatement(const QString &key,
+                                                const std::function<QString()> &buildStatement,
+                                                const QVariantList &values)
+{
+    PreparedStatementCache &cache = PreparedStatementCache::instance();
+    QSqlQuery *q = nullptr;
+
+    // NOTE: A statement handle does not survive a reconnect, so a stale
+    // handle is dropped and prepared again once before giving up.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        q = cache.find(m_connectionName, key);
+        if (!q)
+            q = cache.prepare(m_connectionName, key, buildStatement());
+
+        for (int i = 0; i < values.count(); ++i)
+            q->bindValue(i, values.at(i));
+
+        if (q->exec())
+            break;
+
+        const int errorCode = q->lastError().nativeErrorCode().toInt();
+        if (attempt > 0
+                || (errorCode != static_cast<int>(DatabaseError::MySqlErrorCode::UnknownStatementHandlerError)
+                    && errorCode != static_cast<int>(DatabaseError::MySqlErrorCode::ServerGoneError)
+                    && errorCode != static_cast<int>(DatabaseError::MySqlErrorCode::ServerLostError)))
+            break;
+
+        qCWarning(queryExecutor) << "Re-preparing stale statement:" << key;
+        cache.invalidate(m_connectionName, key);
+    }
+
+    return q;
+}
+
+QVariant QueryExecutor::toBindableValue(const QVariant &value)
+{
+    if (value.isNull())
+        return value;
+
+    switch (value.type()) {
+    case QVariant::Bool:
+        return value.toBool() ? 1 : 0;
+    case QVariant::ByteArray:
+        return value.toByteArray().toHex();
+    case QVariant::Map:
+        return QString(QJsonDocument(QJsonObject::fromVariantMap(value.toMap())).toJson(QJsonDocument::Compact));
+    case QVariant::List:
+        return QString(QJsonDocument(QJsonArray::fromVariantList(value.toList())).toJson(QJsonDocument::Compact));
+    default:
+        break;
+    }
+
+    return value;
+}
+
 int QueryExecutor::addNote(const QString &note, const QString &tableName) {
     if (note.trimmed().isEmpty() || tableName.trimmed().isEmpty())
         return 0;
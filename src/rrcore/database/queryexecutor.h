@@ -5,7 +5,9 @@
 #include <QString>
 #include <QVariantMap>
 #include <QSqlRecord>
+#include <QSqlQuery>
 #include <initializer_list>
+#include <functional>
 #include <QLoggingCategory>
 
 #include "database/queryrequest.h"
@@ -68,6 +70,11 @@ protected:
 private:
     QueryRequest m_request;
     QString m_connectionName;
+
+    QSqlQuery *execPreparedStatement(const QString &key,
+                                     const std::function<QString()> &buildStatement,
+                                     const QVariantList &values); // throw DatabaseException
+    static QVariant toBindableValue(const QVariant &value);
 };
 
 Q_DECLARE_LOGGING_CATEGORY(queryExecutor);
@@ -0,0 +1,309 @@
+#include "querymetrics.h"
+#include "queryresult.h"
+
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QMetaEnum>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <cmath>
+
+Q_LOGGING_CATEGORY(queryMetrics, "rrcore.database.querymetrics");
+
+const qint64 FIRST_BUCKET_BOUND = 50; // microseconds
+const int BUCKETS_PER_DOUBLING = 4;
+
+LatencyHistogram::LatencyHistogram() :
+    m_count(0),
+    m_total(0)
+{
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+        m_buckets[i].storeRelease(0);
+}
+
+void LatencyHistogram::record(qint64 microseconds)
+{
+    m_buckets[bucketFor(microseconds)].fetchAndAddRelaxed(1);
+    m_count.fetchAndAddRelaxed(1);
+    m_total.fetchAndAddRelaxed(microseconds);
+}
+
+qint64 LatencyHistogram::count() const
+{
+    return m_count.loadAcquire();
+}
+
+qint64 LatencyHistogram::total() const
+{
+    return m_total.loadAcquire();
+}
+
+qint64 LatencyHistogram::percentile(qreal percentile) const
+{
+    qint64 count = 0;
+    qint64 buckets[BUCKET_COUNT];
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] = m_buckets[i].loadAcquire();
+        count += buckets[i];
+    }
+
+    if (count == 0)
+        return 0;
+
+    const qint64 rank = qMax<qint64>(1, static_cast<qint64>(std::ceil(percentile * count)));
+    qint64 cumulativeCount = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        cumulativeCount += buckets[i];
+        if (cumulativeCount >= rank)
+            return upperBound(i);
+    }
+
+    return upperBound(BUCKET_COUNT - 1);
+}
+
+void LatencyHistogram::reset()
+{
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+        m_buckets[i].storeRelease(0);
+
+    m_count.storeRelease(0);
+    m_total.storeRelease(0);
+}
+
+int LatencyHistogram::bucketFor(qint64 microseconds)
+{
+    if (microseconds <= FIRST_BUCKET_BOUND)
+        return 0;
+
+    const int bucket = static_cast<int>(std::ceil(BUCKETS_PER_DOUBLING
+                                                  * std::log2(static_cast<double>(microseconds) / FIRST_BUCKET_BOUND)));
+    return qMin(bucket, BUCKET_COUNT - 1);
+}
+
+qint64 LatencyHistogram::upperBound(int bucket)
+{
+    return static_cast<qint64>(std::ceil(FIRST_BUCKET_BOUND
+                                         * std::exp2(static_cast<double>(bucket) / BUCKETS_PER_DOUBLING)));
+}
+
+QueryStatistics::QueryStatistics() :
+    failureCount(0),
+    rowCount(0),
+    byteCount(0)
+{
+
+}
+
+QVariantMap QueryStatistics::toVariantMap() const
+{
+    const qint64 count = latency.count();
+    return {
+        { "count", count },
+        { "failure_count", failureCount.loadAcquire() },
+        { "mean_us", count > 0 ? latency.total() / count : 0 },
+        { "p50_us", latency.percentile(.5) },
+        { "p95_us", latency.percentile(.95) },
+        { "p99_us", latency.percentile(.99) },
+        { "queue_wait_p50_us", queueWait.percentile(.5) },
+        { "queue_wait_p95_us", queueWait.percentile(.95) },
+        { "queue_wait_p99_us", queueWait.percentile(.99) },
+        { "row_count", rowCount.loadAcquire() },
+        { "byte_count", byteCount.loadAcquire() }
+    };
+}
+
+void QueryStatistics::reset()
+{
+    latency.reset();
+    queueWait.reset();
+    failureCount.storeRelease(0);
+    rowCount.storeRelease(0);
+    byteCount.storeRelease(0);
+}
+
+QueryMetrics::QueryMetrics()
+{
+
+}
+
+QueryMetrics::~QueryMetrics()
+{
+    qDeleteAll(m_commands);
+}
+
+QueryMetrics &QueryMetrics::instance()
+{
+    static QueryMetrics instance;
+    return instance;
+}
+
+void QueryMetrics::recordQueueWait(const QueryRequest &request, qint64 microseconds)
+{
+    statisticsFor(request.command()).queueWait.record(microseconds);
+    statisticsFor(request.queryGroup()).queueWait.record(microseconds);
+}
+
+void QueryMetrics::recordResult(const QueryResult &result, qint64 microseconds)
+{
+    const QVariantMap &outcome = result.outcome().toMap();
+    const qint64 rowCount = outcome.value("record_count").toLongLong();
+    const qint64 byteCount = estimateSize(result.outcome());
+
+    record(statisticsFor(result.request().command()), result, microseconds, rowCount, byteCount);
+    record(statisticsFor(result.request().queryGroup()), result, microseconds, rowCount, byteCount);
+}
+
+void QueryMetrics::clear()
+{
+    QReadLocker locker(&m_lock);
+    for (QueryStatistics *statistics : m_commands)
+        statistics->reset();
+
+    for (int i = 0; i < QUERY_GROUP_COUNT; ++i)
+        m_queryGroups[i].reset();
+}
+
+QVariantList QueryMetrics::commandStatistics() const
+{
+    QReadLocker locker(&m_lock);
+    QVariantList statistics;
+    for (auto iter = m_commands.cbegin(); iter != m_commands.cend(); ++iter) {
+        QVariantMap record{ iter.value()->toVariantMap() };
+        record.insert("name", iter.key());
+        statistics.append(record);
+    }
+
+    return statistics;
+}
+
+QVariantList QueryMetrics::queryGroupStatistics() const
+{
+    QVariantList statistics;
+    for (int i = 0; i < QUERY_GROUP_COUNT; ++i) {
+        if (m_queryGroups[i].latency.count() == 0 && m_queryGroups[i].queueWait.count() == 0)
+            continue;
+
+        QVariantMap record{ m_queryGroups[i].toVariantMap() };
+        record.insert("name", queryGroupName(static_cast<QueryRequest::QueryGroup>(i)));
+        statistics.append(record);
+    }
+
+    return statistics;
+}
+
+QJsonObject QueryMetrics::toJson() const
+{
+    return QJsonObject {
+        { "generated", QDateTime::currentDateTime().toString(Qt::ISODate) },
+        { "commands", QJsonArray::fromVariantList(commandStatistics()) },
+        { "query_groups", QJsonArray::fromVariantList(queryGroupStatistics()) }
+    };
+}
+
+bool QueryMetrics::dump(const QString &filePath) const
+{
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath()))
+        return false;
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(queryMetrics) << "Failed to open" << filePath << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(toJson()).toJson());
+    if (!file.commit()) {
+        qCWarning(queryMetrics) << "Failed to write" << filePath << file.errorString();
+        return false;
+    }
+
+    qCInfo(queryMetrics) << "Query metrics written to" << filePath;
+    return true;
+}
+
+QString QueryMetrics::defaultDumpPath()
+{
+    return QStringLiteral("%1/diagnostics/query_metrics_%2.json")
+            .arg(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation),
+                 QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+}
+
+qint64 QueryMetrics::estimateSize(const QVariant &value)
+{
+    // NOTE: This walks the outcome instead of serializing it, which would cost
+    // more than most of the queries being measured.
+    switch (static_cast<int>(value.type())) {
+    case QMetaType::QVariantMap: {
+        const QVariantMap &map = value.toMap();
+        qint64 size = 0;
+        for (auto iter = map.cbegin(); iter != map.cend(); ++iter)
+            size += iter.key().size() * 2 + estimateSize(iter.value());
+        return size;
+    }
+    case QMetaType::QVariantList: {
+        // NOTE: Rows of the same list are much alike, so a long list is sampled at even
+        // intervals and its size extrapolated; the cost does not grow with the row count.
+        const QVariantList &list = value.toList();
+        const int sampleCount = qMin(list.count(), SIZE_SAMPLE_COUNT);
+        if (sampleCount == 0)
+            return 0;
+
+        qint64 size = 0;
+        for (int i = 0; i < sampleCount; ++i)
+            size += estimateSize(list.at(static_cast<int>(static_cast<qint64>(i) * list.count() / sampleCount)));
+        return size * list.count() / sampleCount;
+    }
+    case QMetaType::QString:
+        return value.toString().size() * 2;
+    case QMetaType::QByteArray:
+        return value.toByteArray().size();
+    case QMetaType::UnknownType:
+        return 0;
+    default:
+        return 8;
+    }
+}
+
+QString QueryMetrics::queryGroupName(QueryRequest::QueryGroup queryGroup)
+{
+    return QString(QMetaEnum::fromType<QueryRequest::QueryGroup>().valueToKey(static_cast<int>(queryGroup)));
+}
+
+QueryStatistics &QueryMetrics::statisticsFor(const QString &command)
+{
+    {
+        QReadLocker locker(&m_lock);
+        const auto iter = m_commands.constFind(command);
+        if (iter != m_commands.cend())
+            return **iter;
+    }
+
+    QWriteLocker locker(&m_lock);
+    QueryStatistics *&statistics = m_commands[command];
+    if (!statistics)
+        statistics = new QueryStatistics;
+
+    return *statistics;
+}
+
+QueryStatistics &QueryMetrics::statisticsFor(QueryRequest::QueryGroup queryGroup)
+{
+    const int index = static_cast<int>(queryGroup);
+    if (index < 0 || index >= QUERY_GROUP_COUNT)
+        return m_queryGroups[static_cast<int>(QueryRequest::QueryGroup::Unknown)];
+
+    return m_queryGroups[index];
+}
+
+void QueryMetrics::record(QueryStatistics &statistics, const QueryResult &result,
+                          qint64 microseconds, qint64 rowCount, qint64 byteCount)
+{
+    statistics.latency.record(microseconds);
+    statistics.rowCount.fetchAndAddRelaxed(rowCount);
+    statistics.byteCount.fetchAndAddRelaxed(byteCount);
+    if (!result.isSuccessful())
+        statistics.failureCount.fetchAndAddRelaxed(1);
+}
@@ -0,0 +1,96 @@
+#ifndef QUERYMETRICS_H
+#define QUERYMETRICS_H
+
+#include <QString>
+#include <QHash>
+#include <QVariant>
+#include <QJsonObject>
+#include <QAtomicInteger>
+#include <QReadWriteLock>
+#include <QLoggingCategory>
+#include "queryrequest.h"
+
+class QueryResult;
+
+// Log-scale histogram of durations in microseconds. Each bucket is about 19%
+// wider than the previous one, which bounds the error of a percentile.
+class LatencyHistogram
+{
+public:
+    static const int BUCKET_COUNT = 80;
+
+    LatencyHistogram();
+
+    void record(qint64 microseconds);
+    qint64 count() const;
+    qint64 total() const;
+    qint64 percentile(qreal percentile) const;
+    void reset();
+
+    static int bucketFor(qint64 microseconds);
+    static qint64 upperBound(int bucket);
+private:
+    QAtomicInteger<qint64> m_buckets[BUCKET_COUNT];
+    QAtomicInteger<qint64> m_count;
+    QAtomicInteger<qint64> m_total;
+};
+
+struct QueryStatistics
+{
+    LatencyHistogram latency;
+    LatencyHistogram queueWait;
+    QAtomicInteger<qint64> failureCount;
+    QAtomicInteger<qint64> rowCount;
+    QAtomicInteger<qint64> byteCount;
+
+    QueryStatistics();
+    QVariantMap toVariantMap() const;
+    void reset();
+};
+
+// Latency, queue wait and outcome size of every request run by the database
+// workers, by command and by query group. Counters are only ever updated
+// atomically and are never freed, so a lookup only holds the lock for as
+// long as it takes to find them.
+class QueryMetrics
+{
+public:
+    static const int SIZE_SAMPLE_COUNT = 32;
+
+    static QueryMetrics &instance();
+
+    explicit QueryMetrics();
+    ~QueryMetrics();
+
+    QueryMetrics(QueryMetrics const &) = delete;
+    void operator=(QueryMetrics const &) = delete;
+
+    void recordQueueWait(const QueryRequest &request, qint64 microseconds);
+    void recordResult(const QueryResult &result, qint64 microseconds);
+    void clear();
+
+    QVariantList commandStatistics() const;
+    QVariantList queryGroupStatistics() const;
+
+    QJsonObject toJson() const;
+    bool dump(const QString &filePath) const;
+
+    static QString defaultDumpPath();
+    static qint64 estimateSize(const QVariant &value);
+    static QString queryGroupName(QueryRequest::QueryGroup queryGroup);
+private:
+    static const int QUERY_GROUP_COUNT = static_cast<int>(QueryRequest::QueryGroup::Debtor) + 1;
+
+    QHash<QString, QueryStatistics *> m_commands;
+    QueryStatistics m_queryGroups[QUERY_GROUP_COUNT];
+    mutable QReadWriteLock m_lock;
+
+    QueryStatistics &statisticsFor(const QString &command);
+    QueryStatistics &statisticsFor(QueryRequest::QueryGroup queryGroup);
+    static void record(QueryStatistics &statistics, const QueryResult &result,
+                       qint64 microseconds, qint64 rowCount, qint64 byteCount);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(queryMetrics);
+
+#endif // QUERYMETRICS_H
@@ -2,6 +2,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QCborValue>
 
 QueryRequest::QueryRequest(QObject *receiver) :
     m_receiver(receiver),
@@ -85,15 +86,33 @@ QueryRequest::CommandVerb QueryRequest::commandVerb() const
     return CommandVerb::Create;
 }
 
-QByteArray QueryRequest::toJson() const
+QVariantMap QueryRequest::toVariantMap() const
 {
-    QJsonObject jsonObject {
+    return {
         { "command", m_command },
-        { "params", QJsonObject::fromVariantMap(m_params) },
+        { "params", m_params },
         { "query_group", queryGroupToString(m_queryGroup) }
     };
+}
+
+QByteArray QueryRequest::toJson() const
+{
+    return QJsonDocument(QJsonObject::fromVariantMap(toVariantMap())).toJson(QJsonDocument::Compact);
+}
 
-    return QJsonDocument(jsonObject).toJson();
+QByteArray QueryRequest::toCbor() const
+{
+    return QCborValue::fromVariant(toVariantMap()).toCbor();
+}
+
+QueryRequest QueryRequest::fromVariantMap(const QVariantMap &map)
+{
+    QueryRequest request;
+    request.setCommand(map.value("command").toString(),
+                       map.value("params").toMap(),
+                       queryGroupToEnum(map.value("query_group").toString()));
+
+    return request;
 }
 
 QueryRequest QueryRequest::fromJson(const QByteArray &json)
@@ -101,13 +120,15 @@ QueryRequest QueryRequest::fromJson(const QByteArray &json)
     if (json.isEmpty())
         return QueryRequest();
 
-    const QJsonObject &object = QJsonDocument::fromJson(json).object();
-    QueryRequest request;
-    request.setCommand(object.value("command").toString(),
-                       object.value("params").toVariant().toMap(),
-                       queryGroupToEnum(object.value("query_group").toString()));
+    return fromVariantMap(QJsonDocument::fromJson(json).object().toVariantMap());
+}
 
-    return request;
+QueryRequest QueryRequest::fromCbor(const QByteArray &cbor)
+{
+    if (cbor.isEmpty())
+        return QueryRequest();
+
+    return fromVariantMap(QCborValue::fromCbor(cbor).toMap().toVariantMap());
 }
 
 QueryRequest::QueryGroup QueryRequest::queryGroupToEnum(const QString &queryGroupString)
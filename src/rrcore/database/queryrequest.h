@@ -52,9 +52,13 @@ public:
     QVariantMap params() const;
     QueryGroup queryGroup() const;
     CommandVerb commandVerb() const;
+    QVariantMap toVariantMap() const;
     QByteArray toJson() const;
+    QByteArray toCbor() const;
 
+    static QueryRequest fromVariantMap(const QVariantMap &map);
     static QueryRequest fromJson(const QByteArray &json);
+    static QueryRequest fromCbor(const QByteArray &cbor);
 
     friend QDebug operator<<(QDebug debug, const QueryRequest &request)
     {
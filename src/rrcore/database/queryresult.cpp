@@ -2,6 +2,8 @@
 
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QCborValue>
+#include <QCborMap>
 
 QueryResult::QueryResult(QObject *parent) :
     QObject(parent),
@@ -103,17 +105,31 @@ QVariant QueryResult::outcome() const
     return m_outcome;
 }
 
-QueryResult QueryResult::fromJson(const QByteArray &json, const QueryRequest &request)
+QueryResult QueryResult::fromVariantMap(const QVariantMap &map, const QueryRequest &request)
 {
-    QJsonObject jsonObject{ QJsonDocument::fromJson(json).object() };
+    const QVariantMap &error = map.value("error").toMap();
+    const QVariant &errorNumber = error.value("errno");
     QueryResult result;
-    result.setSuccessful(jsonObject.value("successful").toBool());
-    result.setOutcome(jsonObject.value("outcome").toObject().toVariantMap());
-    result.setErrorMessage(jsonObject.value("error").toObject().value("message").toString());
+    result.setSuccessful(map.value("successful").toBool());
+    result.setOutcome(map.value("outcome").toMap());
+    result.setErrorMessage(error.value("message").toString());
     result.setRequest(request);
-    if (jsonObject.value("error").toObject().contains("errno")
-            && jsonObject.value("error").toObject().value("errno").isDouble())
-        result.setErrorCode(jsonObject.value("error").toObject().value("errno").toInt());
+    // NOTE: JSON numbers arrive as doubles, CBOR integers as qlonglong.
+    if (errorNumber.type() == QVariant::Double
+            || errorNumber.type() == QVariant::LongLong
+            || errorNumber.type() == QVariant::ULongLong
+            || errorNumber.type() == QVariant::Int)
+        result.setErrorCode(errorNumber.toInt());
 
     return result;
 }
+
+QueryResult QueryResult::fromJson(const QByteArray &json, const QueryRequest &request)
+{
+    return fromVariantMap(QJsonDocument::fromJson(json).object().toVariantMap(), request);
+}
+
+QueryResult QueryResult::fromCbor(const QByteArray &cbor, const QueryRequest &request)
+{
+    return fromVariantMap(QCborValue::fromCbor(cbor).toMap().toVariantMap(), request);
+}
@@ -34,7 +34,9 @@ public:
     void setOutcome(const QVariant &outcome);
     QVariant outcome() const;
 
+    static QueryResult fromVariantMap(const QVariantMap &map, const QueryRequest &request = QueryRequest());
     static QueryResult fromJson(const QByteArray &json, const QueryRequest &request = QueryRequest());
+    static QueryResult fromCbor(const QByteArray &cbor, const QueryRequest &request = QueryRequest());
 
     friend QDebug operator<<(QDebug debug, const QueryResult &result)
     {
@@ -0,0 +1,199 @@
+#include "queryresultcache.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <limits>
+
+#include "queryresult.h"
+#include "querymetrics.h"
+
+Q_LOGGING_CATEGORY(queryResultCache, "rrcore.database.queryresultcache");
+
+// Groups whose reads can change when a write in the key group succeeds,
+// e.g. a sale deducts stock quantities and may add a debtor.
+static const QMap<QueryRequest::QueryGroup, QList<QueryRequest::QueryGroup>> DEPENDENT_GROUPS {
+    { QueryRequest::QueryGroup::Client, {
+            QueryRequest::QueryGroup::Debtor,
+            QueryRequest::QueryGroup::Sales,
+            QueryRequest::QueryGroup::Purchase
+        }
+    },
+    { QueryRequest::QueryGroup::Stock, {
+            QueryRequest::QueryGroup::Sales,
+            QueryRequest::QueryGroup::Purchase,
+            QueryRequest::QueryGroup::Dashboard
+        }
+    },
+    { QueryRequest::QueryGroup::Sales, {
+            QueryRequest::QueryGroup::Stock,
+            QueryRequest::QueryGroup::Client,
+            QueryRequest::QueryGroup::Debtor,
+            QueryRequest::QueryGroup::Dashboard
+        }
+    },
+    { QueryRequest::QueryGroup::Purchase, {
+            QueryRequest::QueryGroup::Stock,
+            QueryRequest::QueryGroup::Client,
+            QueryRequest::QueryGroup::Dashboard
+        }
+    },
+    { QueryRequest::QueryGroup::Income, { QueryRequest::QueryGroup::Dashboard } },
+    { QueryRequest::QueryGroup::Expense, { QueryRequest::QueryGroup::Dashboard } },
+    { QueryRequest::QueryGroup::Debtor, {
+            QueryRequest::QueryGroup::Client,
+            QueryRequest::QueryGroup::Sales,
+            QueryRequest::QueryGroup::Dashboard
+        }
+    }
+};
+
+QueryResultCache::QueryResultCache(int capacity) :
+    m_entries(qMax(0, capacity)),
+    m_epoch(0),
+    m_hitCount(0),
+    m_missCount(0)
+{
+}
+
+int QueryResultCache::capacity() const
+{
+    return m_entries.maxCost();
+}
+
+void QueryResultCache::setCapacity(int capacity)
+{
+    m_entries.setMaxCost(qMax(0, capacity));
+}
+
+int QueryResultCache::count() const
+{
+    return m_entries.count();
+}
+
+int QueryResultCache::totalCost() const
+{
+    return m_entries.totalCost();
+}
+
+bool QueryResultCache::isCacheable(const QueryRequest &request) const
+{
+    return capacity() > 0
+            && request.commandVerb() == QueryRequest::CommandVerb::Read
+            && request.queryGroup() != QueryRequest::QueryGroup::Unknown;
+}
+
+bool QueryResultCache::lookup(const QueryRequest &request, QVariant &outcome)
+{
+    if (!isCacheable(request))
+        return false;
+
+    const Entry *entry = m_entries.object(keyFor(request));
+    if (!entry) {
+        m_missCount.ref();
+        return false;
+    }
+
+    m_hitCount.ref();
+    outcome = entry->outcome;
+    return true;
+}
+
+void QueryResultCache::beginRead(const QueryRequest &request)
+{
+    if (!isCacheable(request))
+        return;
+
+    const QString key = keyFor(request);
+    const quint64 generation = this->generation(request.queryGroup());
+    auto iter = m_pendingReads.find(key);
+    if (iter == m_pendingReads.end()) {
+        m_pendingReads.insert(key, PendingRead{ 1, generation });
+    } else {
+        iter->count++;
+        iter->generation = qMin(iter->generation, generation);
+    }
+}
+
+void QueryResultCache::endRead(const QueryResult &result)
+{
+    const QueryRequest &request(result.request());
+    if (!isCacheable(request))
+        return;
+
+    const QString key = keyFor(request);
+    auto iter = m_pendingReads.find(key);
+    if (iter == m_pendingReads.end())
+        return;
+
+    // NOTE: A read is only kept if every read in flight for the same key was issued
+    // after the last invalidation, otherwise a stale outcome could be cached.
+    const bool fresh = iter->generation == generation(request.queryGroup());
+    if (--iter->count == 0)
+        m_pendingReads.erase(iter);
+
+    if (fresh && result.isSuccessful())
+        m_entries.insert(key, new Entry{ request.queryGroup(), result.outcome() }, costOf(key, result.outcome()));
+}
+
+void QueryResultCache::invalidate(QueryRequest::QueryGroup queryGroup)
+{
+    if (queryGroup == QueryRequest::QueryGroup::Unknown) {
+        clear();
+        return;
+    }
+
+    QList<QueryRequest::QueryGroup> queryGroups(dependentGroups(queryGroup));
+    queryGroups.prepend(queryGroup);
+
+    for (const auto group : queryGroups)
+        m_generations[group]++;
+
+    for (const QString &key : m_entries.keys()) {
+        const Entry *entry = m_entries.object(key);
+        if (entry && queryGroups.contains(entry->queryGroup))
+            m_entries.remove(key);
+    }
+
+    qCDebug(queryResultCache) << "Invalidated" << queryGroups;
+}
+
+void QueryResultCache::clear()
+{
+    m_epoch++;
+    m_entries.clear();
+}
+
+int QueryResultCache::hitCount() const
+{
+    return m_hitCount.loadAcquire();
+}
+
+int QueryResultCache::missCount() const
+{
+    return m_missCount.loadAcquire();
+}
+
+QList<QueryRequest::QueryGroup> QueryResultCache::dependentGroups(QueryRequest::QueryGroup queryGroup)
+{
+    return DEPENDENT_GROUPS.value(queryGroup);
+}
+
+quint64 QueryResultCache::generation(QueryRequest::QueryGroup queryGroup) const
+{
+    // NOTE: Both counters only grow, so their sum changes whenever either of them does.
+    return m_epoch + m_generations.value(queryGroup);
+}
+
+QString QueryResultCache::keyFor(const QueryRequest &request)
+{
+    // NOTE: QJsonObject keeps its keys sorted, so equal params always yield the same key.
+    return QStringLiteral("%1:%2:%3").arg(static_cast<int>(request.queryGroup()))
+            .arg(request.command(),
+                 QString::fromUtf8(QJsonDocument(QJsonObject::fromVariantMap(request.params()))
+                                   .toJson(QJsonDocument::Compact)));
+}
+
+int QueryResultCache::costOf(const QString &key, const QVariant &outcome)
+{
+    const qint64 cost = key.size() * 2 + QueryMetrics::estimateSize(outcome);
+    return static_cast<int>(qMin<qint64>(cost, std::numeric_limits<int>::max()));
+}
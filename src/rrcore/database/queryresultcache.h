@@ -0,0 +1,69 @@
+#ifndef QUERYRESULTCACHE_H
+#define QUERYRESULTCACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QMap>
+#include <QCache>
+#include <QVariant>
+#include <QAtomicInt>
+#include <QLoggingCategory>
+#include "queryrequest.h"
+
+class QueryResult;
+
+// Outcomes of reads, kept until a write invalidates their query group.
+// The capacity is a budget in bytes: each entry costs an estimate of the
+// size of its outcome, and the least recently used entries are dropped
+// first. An outcome larger than the whole budget is never kept.
+class QueryResultCache
+{
+public:
+    static const int DEFAULT_CAPACITY = 32 * 1024 * 1024; // bytes
+
+    explicit QueryResultCache(int capacity = DEFAULT_CAPACITY);
+
+    int capacity() const;
+    void setCapacity(int capacity);
+    int count() const;
+    int totalCost() const;
+
+    bool isCacheable(const QueryRequest &request) const;
+    bool lookup(const QueryRequest &request, QVariant &outcome);
+
+    void beginRead(const QueryRequest &request);
+    void endRead(const QueryResult &result);
+
+    void invalidate(QueryRequest::QueryGroup queryGroup);
+    void clear();
+
+    int hitCount() const;
+    int missCount() const;
+
+    static QList<QueryRequest::QueryGroup> dependentGroups(QueryRequest::QueryGroup queryGroup);
+private:
+    struct Entry {
+        QueryRequest::QueryGroup queryGroup;
+        QVariant outcome;
+    };
+
+    struct PendingRead {
+        int count;
+        quint64 generation;
+    };
+
+    QCache<QString, Entry> m_entries;
+    quint64 m_epoch;
+    QMap<QueryRequest::QueryGroup, quint64> m_generations;
+    QHash<QString, PendingRead> m_pendingReads;
+    QAtomicInt m_hitCount;
+    QAtomicInt m_missCount;
+
+    quint64 generation(QueryRequest::QueryGroup queryGroup) const;
+    static QString keyFor(const QueryRequest &request);
+    static int costOf(const QString &key, const QVariant &outcome);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(queryResultCache);
+
+#endif // QUERYRESULTCACHE_H
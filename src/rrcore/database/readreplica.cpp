@@ -0,0 +1,380 @@
+#include "readreplica.h"
+#include "databaseexception.h"
+#include "databaseutils.h"
+#include "changelog.h"
+#include "queryresult.h"
+#include "config/config.h"
+#include "network/serverrequest.h"
+#include "network/serverresponse.h"
+#include "queryexecutors/client.h"
+#include "queryexecutors/stock.h"
+
+#include <QTimer>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+
+Q_LOGGING_CATEGORY(readReplica, "rrcore.database.readreplica");
+
+const QString WATERMARK_TABLE(QStringLiteral("replica_watermark"));
+
+ReadReplica::ReadReplica(QObject *worker, const QString &connectionName, QObject *parent) :
+    QObject(parent),
+    m_worker(worker),
+    m_connectionName(connectionName),
+    m_refreshTimer(new QTimer(this)),
+    m_writeRefreshTimer(new QTimer(this)),
+    m_started(false),
+    m_ready(false),
+    m_pulling(false),
+    m_repullNeeded(false),
+    m_pendingWriteCount(0),
+    m_writeGeneration(0),
+    m_pullGeneration(0),
+    m_syncedGeneration(0)
+{
+    m_refreshTimer->setInterval(REFRESH_INTERVAL);
+    connect(m_refreshTimer, &QTimer::timeout, this, &ReadReplica::refresh);
+
+    // NOTE: Writes that finish close together share a single pull.
+    m_writeRefreshTimer->setSingleShot(true);
+    m_writeRefreshTimer->setInterval(WRITE_REFRESH_DELAY);
+    connect(m_writeRefreshTimer, &QTimer::timeout, this, &ReadReplica::refresh);
+}
+
+QStringList ReadReplica::tables()
+{
+    return {
+        QStringLiteral("category"),
+        QStringLiteral("item"),
+        QStringLiteral("unit"),
+        QStringLiteral("current_quantity"),
+        QStringLiteral("client")
+    };
+}
+
+bool ReadReplica::isReplicated(const QueryRequest &request)
+{
+    // NOTE: Only commands that read nothing but the replicated tables are listed here.
+    // Item details and reports also read notes, users and transactions.
+    static const QStringList commands {
+        StockQuery::ViewStockCategories::COMMAND,
+        StockQuery::FilterStockCategories::COMMAND,
+        StockQuery::FilterStockCategoriesByItem::COMMAND,
+        StockQuery::ViewStockItems::COMMAND,
+        StockQuery::FilterStockItems::COMMAND,
+        StockQuery::ViewStockItemCount::COMMAND,
+        StockQuery::FilterStockItemCount::COMMAND,
+        StockQuery::ViewStockCatalog::COMMAND,
+        ClientQuery::ViewClients::COMMAND
+    };
+
+    return request.commandVerb() == QueryRequest::CommandVerb::Read && commands.contains(request.command());
+}
+
+bool ReadReplica::isReady() const
+{
+    return m_ready;
+}
+
+bool ReadReplica::isFresh() const
+{
+    return m_ready && m_pendingWriteCount == 0 && m_syncedGeneration == m_writeGeneration;
+}
+
+bool ReadReplica::canServe(const QueryRequest &request) const
+{
+    return isReplicated(request) && isFresh();
+}
+
+void ReadReplica::start()
+{
+    if (m_started)
+        return;
+
+    m_started = true;
+    QMetaObject::invokeMethod(m_worker, [this]() {
+        try {
+            openConnection(m_connectionName);
+            const QVariantMap &watermarks = readWatermarks(m_connectionName);
+
+            QStringList uncopiedTables;
+            for (const QString &table : tables()) {
+                if (!watermarks.contains(table))
+                    uncopiedTables.append(table);
+            }
+            checkUnsyncedRows(m_connectionName, uncopiedTables);
+
+            QMetaObject::invokeMethod(this, [this, watermarks]() {
+                m_watermarks = watermarks;
+                m_refreshTimer->start();
+                pull();
+            }, Qt::QueuedConnection);
+        } catch (DatabaseException &e) {
+            qCCritical(readReplica) << e;
+            QMetaObject::invokeMethod(this, [this, e]() {
+                m_started = false;
+                failPull(e.message());
+            }, Qt::QueuedConnection);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void ReadReplica::refresh()
+{
+    if (!m_started) {
+        start();
+        return;
+    }
+
+    if (m_pulling) {
+        m_repullNeeded = true;
+        return;
+    }
+
+    pull();
+}
+
+void ReadReplica::beginWrite(const QueryRequest &request)
+{
+    if (!isWrite(request))
+        return;
+
+    ++m_pendingWriteCount;
+}
+
+void ReadReplica::endWrite(const QueryResult &result)
+{
+    if (!isWrite(result.request()))
+        return;
+
+    m_pendingWriteCount = qMax(0, m_pendingWriteCount - 1);
+    if (!result.isSuccessful())
+        return;
+
+    ++m_writeGeneration;
+    m_writeRefreshTimer->start();
+}
+
+void ReadReplica::processServerResponse(const ServerResponse &response)
+{
+    if (response.request().receiver() != this)
+        return;
+
+    if (!response.isSuccessful()) {
+        failPull(response.errorMessage());
+        return;
+    }
+
+    const QVariantMap &changes = response.data();
+    const QVariantMap &watermarks = m_watermarks;
+    QMetaObject::invokeMethod(m_worker, [this, changes, watermarks]() {
+        try {
+            const QVariantMap &appliedWatermarks = applyChanges(m_connectionName, changes, watermarks);
+            const bool hasMore = changes.value("has_more").toBool();
+            QMetaObject::invokeMethod(this, [this, appliedWatermarks, hasMore]() {
+                finishPull(appliedWatermarks, hasMore);
+            }, Qt::QueuedConnection);
+        } catch (DatabaseException &e) {
+            qCCritical(readReplica) << e;
+            QMetaObject::invokeMethod(this, [this, e]() {
+                failPull(e.message());
+            }, Qt::QueuedConnection);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void ReadReplica::pull()
+{
+    QVariantMap tableWatermarks;
+    for (const QString &table : tables())
+        tableWatermarks.insert(table, m_watermarks.value(table, QVariantMap()));
+
+    ServerRequest request(this);
+    request.setAction(PULL_ACTION, QVariantMap {
+                          { "tables", tableWatermarks },
+                          { "limit", MAX_PULL_ROW_COUNT }
+                      });
+
+    m_pulling = true;
+    m_pullGeneration = m_writeGeneration;
+    emit pullRequested(request);
+}
+
+void ReadReplica::finishPull(const QVariantMap &watermarks, bool hasMore)
+{
+    m_watermarks = watermarks;
+    emit changed();
+
+    if (hasMore) {
+        pull();
+        return;
+    }
+
+    m_pulling = false;
+    m_syncedGeneration = m_pullGeneration;
+    if (!m_ready) {
+        m_ready = true;
+        qCInfo(readReplica) << "Replica is up to date, serving reads locally.";
+    }
+
+    if (m_repullNeeded) {
+        m_repullNeeded = false;
+        pull();
+    }
+}
+
+void ReadReplica::failPull(const QString &reason)
+{
+    // NOTE: Reads are tunnelled until the next pull succeeds; the refresh timer retries.
+    qCWarning(readReplica) << "Failed to pull replica changes:" << reason;
+    m_pulling = false;
+    m_repullNeeded = false;
+}
+
+void ReadReplica::openConnection(const QString &connectionName)
+{
+    if (QSqlDatabase::contains(connectionName) && QSqlDatabase::database(connectionName, false).isOpen())
+        return;
+
+    QSqlDatabase connection = QSqlDatabase::contains(connectionName)
+            ? QSqlDatabase::database(connectionName, false)
+            : QSqlDatabase::addDatabase("QMYSQL", connectionName);
+
+    connection.setDatabaseName(Config::instance().databaseName());
+    connection.setHostName(Config::instance().hostName());
+    connection.setPort(Config::instance().port());
+    connection.setUserName(Config::instance().userName());
+    connection.setPassword(Config::instance().password());
+    connection.setConnectOptions("MYSQL_OPT_RECONNECT = 1");
+
+    if (!connection.open())
+        throw DatabaseException(DatabaseError::QueryErrorCode::NoValidConnection,
+                                connection.lastError().text(),
+                                QStringLiteral("Failed to open replica connection '%1'.").arg(connectionName));
+}
+
+QVariantMap ReadReplica::readWatermarks(const QString &connectionName)
+{
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    if (!query.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS %1 ("
+                                   "table_name VARCHAR(64) NOT NULL, "
+                                   "last_edited DATETIME NOT NULL, "
+                                   "last_id INT(11) NOT NULL, "
+                                   "PRIMARY KEY (table_name)"
+                                   ") ENGINE=InnoDB DEFAULT CHARSET=utf8").arg(WATERMARK_TABLE)))
+        throw DatabaseException(DatabaseError::QueryErrorCode::CreateTableFailed,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to create replica watermark table."));
+
+    if (!query.exec(QStringLiteral("SELECT table_name, last_edited, last_id FROM %1").arg(WATERMARK_TABLE)))
+        throw DatabaseException(DatabaseError::QueryErrorCode::ReplicaSyncFailure,
+                                query.lastError().text(),
+                                QStringLiteral("Failed to read replica watermarks."));
+
+    QVariantMap watermarks;
+    while (query.next()) {
+        watermarks.insert(query.value("table_name").toString(), QVariantMap {
+                              { "last_edited", query.value("last_edited").toDateTime().toString(Qt::ISODate) },
+                              { "last_id", query.value("last_id").toInt() }
+                          });
+    }
+
+    return watermarks;
+}
+
+void ReadReplica::checkUnsyncedRows(const QString &connectionName, const QStringList &tables)
+{
+    if (tables.isEmpty())
+        return;
+
+    // NOTE: Rows written locally are unsynced until their change log entries are pushed.
+    // Rows of a database that was never synced at all predate the change log.
+    const bool isSynced = ChangeLog::watermark(connectionName, ChangeLog::PUSHED_WATERMARK) > 0
+            || ChangeLog::watermark(connectionName, ChangeLog::PULLED_WATERMARK) > 0;
+
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    for (const QString &table : tables) {
+        query.prepare(QStringLiteral("SELECT EXISTS (SELECT 1 FROM change_log WHERE table_name = ?), "
+                                     "EXISTS (SELECT 1 FROM %1)").arg(table));
+        query.addBindValue(table);
+        if (!query.exec() || !query.next())
+            throw DatabaseException(DatabaseError::QueryErrorCode::ReplicaSyncFailure,
+                                    query.lastError().text(),
+                                    QStringLiteral("Failed to check for unsynced rows in '%1'.").arg(table));
+
+        const bool hasPendingChanges = query.value(0).toBool();
+        const bool hasRows = query.value(1).toBool();
+        if (hasPendingChanges || (hasRows && !isSynced))
+            throw DatabaseException(DatabaseError::QueryErrorCode::ReplicaSyncFailure,
+                                    QStringLiteral("Table '%1' has rows that were never synced.").arg(table),
+                                    QStringLiteral("Local rows of '%1' must be synced before they can be "
+                                                   "replaced by the server's.").arg(table));
+    }
+}
+
+QVariantMap ReadReplica::applyChanges(const QString &connectionName,
+                                      const QVariantMap &changes,
+                                      const QVariantMap &watermarks)
+{
+    const QVariantMap &tableChanges = changes.value("tables").toMap();
+    QVariantMap appliedWatermarks{ watermarks };
+
+    QSqlQuery query(QSqlDatabase::database(connectionName));
+    DatabaseUtils::beginTransaction(query);
+
+    try {
+        // NOTE: Rows copied from the server are not local changes.
+        ChangeLog::setCaptureSuppressed(query, true);
+        for (const QString &table : tables()) {
+            const QVariantMap &change = tableChanges.value(table).toMap();
+            const QVariantList &rows = change.value("rows").toList();
+            const QVariantList &deletedIds = change.value("deleted").toList();
+
+            // NOTE: The first page of a table without a watermark is the start of a full copy.
+            // start() made sure that the rows it replaces were all synced with the server.
+            if (!watermarks.contains(table) && !query.exec(QStringLiteral("DELETE FROM %1").arg(table)))
+                throw DatabaseException(DatabaseError::QueryErrorCode::ReplicaSyncFailure,
+                                        query.lastError().text(),
+                                        QStringLiteral("Failed to clear replica table '%1'.").arg(table));
+
+            ChangeLog::applyRows(query, table, rows, deletedIds);
+
+            if (rows.isEmpty())
+                continue;
+
+            // NOTE: Rows arrive ordered by (last_edited, id), so the last one is where the next pull starts.
+            const QVariantMap &lastRecord = rows.last().toMap();
+            query.prepare(QStringLiteral("REPLACE INTO %1 (table_name, last_edited, last_id) VALUES (?, ?, ?)")
+                          .arg(WATERMARK_TABLE));
+            query.addBindValue(table);
+            query.addBindValue(lastRecord.value("last_edited"));
+            query.addBindValue(lastRecord.value("id"));
+            if (!query.exec())
+                throw DatabaseException(DatabaseError::QueryErrorCode::ReplicaSyncFailure,
+                                        query.lastError().text(),
+                                        QStringLiteral("Failed to store watermark for replica table '%1'.").arg(table));
+
+            appliedWatermarks.insert(table, QVariantMap {
+                                         { "last_edited", lastRecord.value("last_edited") },
+                                         { "last_id", lastRecord.value("id") }
+                                     });
+        }
+
+        ChangeLog::setCaptureSuppressed(query, false);
+        DatabaseUtils::commitTransaction(query);
+    } catch (DatabaseException &) {
+        DatabaseUtils::rollbackTransaction(query);
+        query.exec(QStringLiteral("SET @rr_capture_suppressed = NULL"));
+        throw;
+    }
+
+    return appliedWatermarks;
+}
+
+bool ReadReplica::isWrite(const QueryRequest &request)
+{
+    return request.commandVerb() != QueryRequest::CommandVerb::Read
+            && request.commandVerb() != QueryRequest::CommandVerb::Authenticate;
+}
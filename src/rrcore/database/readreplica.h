@@ -0,0 +1,83 @@
+#ifndef READREPLICA_H
+#define READREPLICA_H
+
+#include <QObject>
+#include <QVariantMap>
+#include <QLoggingCategory>
+#include "queryrequest.h"
+
+class QTimer;
+class QueryResult;
+class ServerRequest;
+class ServerResponse;
+
+// Local copy of the tables behind stock and client lookups, kept while
+// requests are tunnelled to the server. Rows changed on the server are pulled
+// in pages, ordered by (last_edited, id), and the last row applied to each
+// table is stored with the rows in the same transaction, so a pull that is
+// cut short resumes where it stopped.
+// Reads are only served from the replica once it has caught up with the
+// server, and not between a tunnelled write and the next pull that follows
+// it, so a till always sees the outcome of its own writes.
+// The first pull of a table replaces its rows with the server's, so the
+// replica is not started while a replicated table holds rows that were never
+// synced with the server; requests are tunnelled instead until they are.
+class ReadReplica : public QObject
+{
+    Q_OBJECT
+public:
+    static inline const QString PULL_ACTION = QStringLiteral("pull_replica");
+    static const int REFRESH_INTERVAL = 30 * 1000; // milliseconds
+    static const int WRITE_REFRESH_DELAY = 200; // milliseconds
+    static const int MAX_PULL_ROW_COUNT = 500;
+
+    explicit ReadReplica(QObject *worker, const QString &connectionName, QObject *parent = nullptr);
+
+    static QStringList tables();
+    static bool isReplicated(const QueryRequest &request);
+
+    bool isReady() const;
+    bool isFresh() const;
+    bool canServe(const QueryRequest &request) const;
+
+    void start();
+    void refresh();
+    void beginWrite(const QueryRequest &request);
+    void endWrite(const QueryResult &result);
+    void processServerResponse(const ServerResponse &response);
+
+    // Run on the thread that owns the connection.
+    static void openConnection(const QString &connectionName); // throws DatabaseException
+    static QVariantMap readWatermarks(const QString &connectionName); // throws DatabaseException
+    static void checkUnsyncedRows(const QString &connectionName, const QStringList &tables); // throws DatabaseException
+    static QVariantMap applyChanges(const QString &connectionName,
+                                    const QVariantMap &changes,
+                                    const QVariantMap &watermarks); // throws DatabaseException
+signals:
+    void pullRequested(const ServerRequest request);
+    void changed();
+private:
+    QObject *m_worker;
+    QString m_connectionName;
+    QTimer *m_refreshTimer;
+    QTimer *m_writeRefreshTimer;
+    QVariantMap m_watermarks;
+    bool m_started;
+    bool m_ready;
+    bool m_pulling;
+    bool m_repullNeeded;
+    int m_pendingWriteCount;
+    quint64 m_writeGeneration;
+    quint64 m_pullGeneration;
+    quint64 m_syncedGeneration;
+
+    void pull();
+    void finishPull(const QVariantMap &watermarks, bool hasMore);
+    void failPull(const QString &reason);
+
+    static bool isWrite(const QueryRequest &request);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(readReplica);
+
+#endif // READREPLICA_H
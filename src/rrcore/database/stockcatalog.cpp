@@ -0,0 +1,200 @@
+#include "stockcatalog.h"
+#include "databasethread.h"
+#include "queryresult.h"
+#include "queryresultcache.h"
+#include "singletons/startupprofiler.h"
+#include "queryexecutors/stock/viewstockcatalog.h"
+
+#include <QTimer>
+
+Q_LOGGING_CATEGORY(stockCatalog, "rrcore.database.stockcatalog");
+
+StockCatalog::StockCatalog(DatabaseThread &thread, QObject *parent) :
+    QObject(parent),
+    m_refreshTimer(new QTimer(this)),
+    m_started(false),
+    m_ready(false),
+    m_loading(false),
+    m_reloadNeeded(false)
+{
+    // NOTE: Writes that finish close together (e.g. the items of a sale) share a single refresh.
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(REFRESH_DELAY);
+    connect(m_refreshTimer, &QTimer::timeout, this, &StockCatalog::refresh);
+
+    connect(this, &StockCatalog::execute, &thread, &DatabaseThread::execute);
+    connect(&thread, &DatabaseThread::resultReady, this, &StockCatalog::notifyWrite);
+    connect(&thread, &DatabaseThread::changesPulled, this, &StockCatalog::reload);
+    thread.addReceiver(this, [this](const QueryResult &result) {
+        processResult(result);
+    });
+}
+
+StockCatalog &StockCatalog::instance()
+{
+    static StockCatalog instance(DatabaseThread::instance());
+    instance.load();
+    return instance;
+}
+
+bool StockCatalog::isReady() const
+{
+    return m_ready;
+}
+
+bool StockCatalog::hasPendingRefresh() const
+{
+    return m_loading || m_reloadNeeded || !m_staleItemIds.isEmpty() || m_refreshTimer->isActive();
+}
+
+const StockCatalogIndex &StockCatalog::index() const
+{
+    return m_index;
+}
+
+void StockCatalog::load()
+{
+    if (m_started)
+        return;
+
+    // NOTE: The stock views query the database until the catalogue is ready,
+    // so loading it need not hold up the first frame.
+    m_started = true;
+    StartupProfiler::instance().runAfterFirstFrame(this, [this]() {
+        reload();
+    });
+}
+
+void StockCatalog::loadNow()
+{
+    // NOTE: For callers that have no first frame to wait for (e.g. tests).
+    m_started = true;
+    reload();
+}
+
+void StockCatalog::reload()
+{
+    if (!m_started)
+        return;
+
+    m_reloadNeeded = true;
+    m_staleItemIds.clear();
+    refresh();
+}
+
+void StockCatalog::notifyWrite(const QueryResult &result)
+{
+    if (!m_started
+            || !result.isSuccessful()
+            || result.request().commandVerb() == QueryRequest::CommandVerb::Read
+            || result.request().commandVerb() == QueryRequest::CommandVerb::Authenticate)
+        return;
+
+    const QueryRequest::QueryGroup queryGroup = result.request().queryGroup();
+    if (queryGroup != QueryRequest::QueryGroup::Stock
+            && !QueryResultCache::dependentGroups(queryGroup).contains(QueryRequest::QueryGroup::Stock))
+        return;
+
+    const QList<int> &itemIds = affectedItemIds(result);
+    if (itemIds.isEmpty()) {
+        m_reloadNeeded = true;
+    } else {
+        for (const int itemId : itemIds)
+            m_staleItemIds.insert(itemId);
+    }
+
+    m_refreshTimer->start();
+}
+
+QList<int> StockCatalog::affectedItemIds(const QueryResult &result)
+{
+    const QVariantMap &params = result.request().params();
+    QList<int> itemIds;
+
+    if (params.value("item_id").toInt() > 0)
+        itemIds.append(params.value("item_id").toInt());
+    for (const QVariant &item : params.value("items").toList()) {
+        const int itemId = item.toMap().value("item_id").toInt();
+        if (itemId > 0 && !itemIds.contains(itemId))
+            itemIds.append(itemId);
+    }
+
+    const int outcomeItemId = result.outcome().toMap().value("item_id").toInt();
+    if (outcomeItemId > 0 && !itemIds.contains(outcomeItemId))
+        itemIds.append(outcomeItemId);
+
+    return itemIds;
+}
+
+void StockCatalog::refresh()
+{
+    // NOTE: A single request is kept in flight; anything that goes stale meanwhile
+    // is picked up when it returns.
+    if (m_loading || !m_started)
+        return;
+
+    m_loading = true;
+    m_loadTimer.start();
+
+    if (m_reloadNeeded || !m_ready) {
+        m_reloadNeeded = false;
+        m_staleItemIds.clear();
+        m_requestedItemIds.clear();
+        emit execute(new StockQuery::ViewStockCatalog(this));
+    } else if (!m_staleItemIds.isEmpty()) {
+        m_requestedItemIds = m_staleItemIds;
+        m_staleItemIds.clear();
+
+        QVariantList itemIds;
+        for (const int itemId : m_requestedItemIds)
+            itemIds.append(itemId);
+
+        emit execute(new StockQuery::ViewStockCatalog(itemIds, this));
+    } else {
+        m_loading = false;
+    }
+}
+
+void StockCatalog::processResult(const QueryResult &result)
+{
+    if (result.request().receiver() != this
+            || result.request().command() != StockQuery::ViewStockCatalog::COMMAND)
+        return;
+
+    m_loading = false;
+    const bool partial = result.request().params().contains("item_ids");
+
+    if (!result.isSuccessful()) {
+        qCWarning(stockCatalog) << "Failed to load the stock catalogue:" << result.errorMessage();
+        if (partial)
+            m_staleItemIds.unite(m_requestedItemIds);
+        else
+            m_reloadNeeded = true;
+
+        m_requestedItemIds.clear();
+        QTimer::singleShot(RETRY_INTERVAL, this, &StockCatalog::refresh);
+        return;
+    }
+
+    const QVariantList &items = result.outcome().toMap().value("items").toList();
+    if (partial) {
+        // NOTE: Items that were archived are not returned, so every requested item is dropped first.
+        for (const int itemId : m_requestedItemIds)
+            m_index.remove(itemId);
+    } else {
+        m_index.clear();
+    }
+
+    for (const QVariant &item : items)
+        m_index.insert(StockCatalogItem(item.toMap()));
+
+    m_requestedItemIds.clear();
+    m_ready = true;
+
+    qCInfo(stockCatalog) << (partial ? "Refreshed" : "Loaded") << items.count() << "item(s) in"
+                         << m_loadTimer.elapsed() << "ms," << m_index.count() << "in the catalogue.";
+    emit changed();
+
+    if (m_reloadNeeded || !m_staleItemIds.isEmpty())
+        m_refreshTimer->start();
+}
@@ -0,0 +1,65 @@
+#ifndef STOCKCATALOG_H
+#define STOCKCATALOG_H
+
+#include <QObject>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include "stockcatalogindex.h"
+
+class QTimer;
+class QueryExecutor;
+class QueryResult;
+class DatabaseThread;
+
+// Keeps a StockCatalogIndex of every stock item in step with the database,
+// so that the stock views can search as the user types without a query per
+// keystroke. The catalogue is loaded once, after the first frame. Writes that
+// name the items they touched (e.g. a sale) only refresh those items; any
+// other stock write, or rows pulled from the server, reload the catalogue.
+// Until the first load completes, the models keep querying the database.
+class StockCatalog : public QObject
+{
+    Q_OBJECT
+public:
+    static const int REFRESH_DELAY = 200; // milliseconds
+    static const int RETRY_INTERVAL = 10 * 1000; // milliseconds
+
+    static StockCatalog &instance();
+
+    explicit StockCatalog(DatabaseThread &thread, QObject *parent = nullptr);
+
+    StockCatalog(StockCatalog const &) = delete;
+    void operator=(StockCatalog const &) = delete;
+
+    bool isReady() const;
+    bool hasPendingRefresh() const;
+    const StockCatalogIndex &index() const;
+
+    void load();
+    void loadNow();
+    void reload();
+    void notifyWrite(const QueryResult &result);
+
+    static QList<int> affectedItemIds(const QueryResult &result);
+signals:
+    void execute(QueryExecutor *queryExecutor);
+    void changed();
+private:
+    StockCatalogIndex m_index;
+    QTimer *m_refreshTimer;
+    QSet<int> m_staleItemIds;
+    QSet<int> m_requestedItemIds;
+    QElapsedTimer m_loadTimer;
+    bool m_started;
+    bool m_ready;
+    bool m_loading;
+    bool m_reloadNeeded;
+
+    void refresh();
+    void processResult(const QueryResult &result);
+};
+
+Q_DECLARE_LOGGING_CATEGORY(stockCatalog);
+
+#endif // STOCKCATALOG_H
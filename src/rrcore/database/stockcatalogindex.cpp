@@ -0,0 +1,260 @@
+#include "stockcatalogindex.h"
+
+#include <algorithm>
+
+StockCatalogItem::StockCatalogItem(const QVariantMap &record) :
+    itemId(record.value("item_id").toInt()),
+    categoryId(record.value("category_id").toInt()),
+    category(record.value("category").toString()),
+    item(record.value("item").toString()),
+    description(record.value("description").toString()),
+    barcode(record.value("barcode").toString()),
+    divisible(record.value("divisible").toBool()),
+    unitId(record.value("unit_id").toInt()),
+    unit(record.value("unit").toString()),
+    quantity(record.value("quantity").toDouble()),
+    costPrice(record.value("cost_price").toDouble()),
+    retailPrice(record.value("retail_price").toDouble()),
+    currency(record.value("currency").toString())
+{
+
+}
+
+QVariantMap StockCatalogItem::toVariantMap() const
+{
+    return {
+        { "item_id", itemId },
+        { "category_id", categoryId },
+        { "category", category },
+        { "item", item },
+        { "description", description },
+        { "barcode", barcode },
+        { "divisible", divisible },
+        { "unit_id", unitId },
+        { "unit", unit },
+        { "quantity", quantity },
+        { "cost_price", costPrice },
+        { "retail_price", retailPrice },
+        { "currency", currency }
+    };
+}
+
+StockCatalogIndex::StockCatalogIndex() :
+    m_deadCount(0)
+{
+
+}
+
+int StockCatalogIndex::count() const
+{
+    return m_slots.count();
+}
+
+bool StockCatalogIndex::isEmpty() const
+{
+    return m_slots.isEmpty();
+}
+
+bool StockCatalogIndex::contains(int itemId) const
+{
+    return m_slots.contains(itemId);
+}
+
+StockCatalogItem StockCatalogIndex::item(int itemId) const
+{
+    const int slot = m_slots.value(itemId, -1);
+    if (slot < 0)
+        return StockCatalogItem();
+
+    return m_items.at(slot);
+}
+
+int StockCatalogIndex::itemIdForBarcode(const QString &barcode) const
+{
+    return m_barcodes.value(barcode.trimmed(), 0);
+}
+
+void StockCatalogIndex::clear()
+{
+    m_items.clear();
+    m_foldedNames.clear();
+    m_slots.clear();
+    m_grams.clear();
+    m_words.clear();
+    m_barcodes.clear();
+    m_deadCount = 0;
+}
+
+void StockCatalogIndex::insert(const StockCatalogItem &item)
+{
+    if (item.itemId <= 0)
+        return;
+
+    remove(item.itemId);
+
+    const int slot = m_items.count();
+    m_items.append(item);
+    m_foldedNames.append(fold(item.item));
+    m_slots.insert(item.itemId, slot);
+    if (!item.barcode.trimmed().isEmpty())
+        m_barcodes.insert(item.barcode.trimmed(), item.itemId);
+    index(slot);
+}
+
+bool StockCatalogIndex::remove(int itemId)
+{
+    const auto iter = m_slots.find(itemId);
+    if (iter == m_slots.end())
+        return false;
+
+    const int slot = iter.value();
+    m_slots.erase(iter);
+
+    const QString &barcode = m_items.at(slot).barcode.trimmed();
+    if (!barcode.isEmpty() && m_barcodes.value(barcode) == itemId)
+        m_barcodes.remove(barcode);
+
+    // NOTE: Posting lists still point at the slot, so it is only marked dead here.
+    m_items[slot].itemId = 0;
+    ++m_deadCount;
+
+    if (m_deadCount > 64 && m_deadCount * 4 > m_slots.count())
+        compact();
+
+    return true;
+}
+
+QVector<int> StockCatalogIndex::search(const QString &text, int categoryId) const
+{
+    const QString &foldedText = fold(text);
+
+    QVector<int> slots;
+    if (foldedText.isEmpty()) {
+        slots.reserve(m_items.count());
+        for (int slot = 0; slot < m_items.count(); ++slot)
+            slots.append(slot);
+    } else if (foldedText.length() < GRAM_SIZE) {
+        slots = searchWords(foldedText);
+    } else {
+        slots = searchGrams(foldedText);
+    }
+
+    QVector<int> itemIds;
+    for (const int slot : slots) {
+        if (!isLive(slot))
+            continue;
+        if (categoryId > -1 && m_items.at(slot).categoryId != categoryId)
+            continue;
+
+        itemIds.append(m_items.at(slot).itemId);
+    }
+
+    return itemIds;
+}
+
+QVector<StockCatalogItem> StockCatalogIndex::items(const QVector<int> &itemIds) const
+{
+    QVector<StockCatalogItem> items;
+    items.reserve(itemIds.count());
+    for (const int itemId : itemIds) {
+        const int slot = m_slots.value(itemId, -1);
+        if (slot > -1)
+            items.append(m_items.at(slot));
+    }
+
+    return items;
+}
+
+QString StockCatalogIndex::fold(const QString &text)
+{
+    return text.toLower().simplified();
+}
+
+bool StockCatalogIndex::isLive(int slot) const
+{
+    return m_items.at(slot).itemId > 0;
+}
+
+void StockCatalogIndex::index(int slot)
+{
+    const QString &foldedName = m_foldedNames.at(slot);
+
+    for (int position = 0; position + GRAM_SIZE <= foldedName.length(); ++position) {
+        QVector<int> &postings = m_grams[gramKey(foldedName, position)];
+        // NOTE: A trigram that occurs twice in a name is only posted once.
+        if (postings.isEmpty() || postings.last() != slot)
+            postings.append(slot);
+    }
+
+    for (const QString &word : foldedName.split(' ', QString::SkipEmptyParts)) {
+        QVector<int> &postings = m_words[word];
+        if (postings.isEmpty() || postings.last() != slot)
+            postings.append(slot);
+    }
+}
+
+void StockCatalogIndex::compact()
+{
+    const QVector<StockCatalogItem> items(m_items);
+    clear();
+
+    for (const StockCatalogItem &item : items) {
+        if (item.itemId > 0)
+            insert(item);
+    }
+}
+
+QVector<int> StockCatalogIndex::searchWords(const QString &prefix) const
+{
+    QVector<int> slots;
+    for (auto iter = m_words.lowerBound(prefix); iter != m_words.cend() && iter.key().startsWith(prefix); ++iter)
+        slots.append(iter.value());
+
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    return slots;
+}
+
+QVector<int> StockCatalogIndex::searchGrams(const QString &text) const
+{
+    QVector<const QVector<int> *> postingLists;
+    for (int position = 0; position + GRAM_SIZE <= text.length(); ++position) {
+        const auto iter = m_grams.constFind(gramKey(text, position));
+        if (iter == m_grams.cend())
+            return QVector<int>();
+
+        postingLists.append(&iter.value());
+    }
+
+    // NOTE: Starting with the shortest list keeps every intersection as small as it can be.
+    std::sort(postingLists.begin(), postingLists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->count() < b->count();
+    });
+
+    QVector<int> slots(*postingLists.first());
+    for (int i = 1; i < postingLists.count() && !slots.isEmpty(); ++i) {
+        QVector<int> intersection;
+        std::set_intersection(slots.cbegin(), slots.cend(),
+                              postingLists.at(i)->cbegin(), postingLists.at(i)->cend(),
+                              std::back_inserter(intersection));
+        slots.swap(intersection);
+    }
+
+    // NOTE: Sharing every trigram does not make the text a substring, so each name is checked.
+    QVector<int> matches;
+    for (const int slot : slots) {
+        if (m_foldedNames.at(slot).contains(text))
+            matches.append(slot);
+    }
+
+    return matches;
+}
+
+quint64 StockCatalogIndex::gramKey(const QString &text, int position)
+{
+    quint64 key = 0;
+    for (int i = 0; i < GRAM_SIZE; ++i)
+        key = (key << 16) | text.at(position + i).unicode();
+
+    return key;
+}
@@ -0,0 +1,81 @@
+#ifndef STOCKCATALOGINDEX_H
+#define STOCKCATALOGINDEX_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QVariantMap>
+
+struct StockCatalogItem {
+    int itemId = 0;
+    int categoryId = 0;
+    QString category;
+    QString item;
+    QString description;
+    QString barcode;
+    bool divisible = false;
+    int unitId = 0;
+    QString unit;
+    double quantity = 0.0;
+    double costPrice = 0.0;
+    double retailPrice = 0.0;
+    QString currency;
+
+    StockCatalogItem() = default;
+    explicit StockCatalogItem(const QVariantMap &record);
+    QVariantMap toVariantMap() const;
+};
+
+// Searchable copy of the stock catalogue, without images.
+// Item names are folded to lower case and indexed twice: every word by its
+// prefix, in a sorted map, and the whole name by its trigrams. Text shorter
+// than a trigram matches the start of any word in a name; longer text matches
+// anywhere in a name, by intersecting the posting lists of its trigrams and
+// checking the few names that remain.
+// Slots are only ever appended, so posting lists stay sorted without effort.
+// Barcodes are kept in a hash of their own, so a scanned barcode is found
+// without a search.
+// A changed item takes a new slot and its old slot is left dead until dead
+// slots outnumber a quarter of the live ones, when the index is rebuilt.
+class StockCatalogIndex
+{
+public:
+    static const int GRAM_SIZE = 3;
+
+    StockCatalogIndex();
+
+    int count() const;
+    bool isEmpty() const;
+    bool contains(int itemId) const;
+    StockCatalogItem item(int itemId) const;
+    int itemIdForBarcode(const QString &barcode) const;
+
+    void clear();
+    void insert(const StockCatalogItem &item);
+    bool remove(int itemId);
+
+    // Item IDs in the order items were inserted. A "categoryId" of -1 matches all categories.
+    QVector<int> search(const QString &text, int categoryId = -1) const;
+    QVector<StockCatalogItem> items(const QVector<int> &itemIds) const;
+
+    static QString fold(const QString &text);
+private:
+    QVector<StockCatalogItem> m_items;
+    QVector<QString> m_foldedNames;
+    QHash<int, int> m_slots;
+    QHash<quint64, QVector<int>> m_grams;
+    QMap<QString, QVector<int>> m_words;
+    QHash<QString, int> m_barcodes;
+    int m_deadCount;
+
+    bool isLive(int slot) const;
+    void index(int slot);
+    void compact();
+    QVector<int> searchWords(const QString &prefix) const;
+    QVector<int> searchGrams(const QString &text) const;
+
+    static quint64 gramKey(const QString &text, int position);
+};
+
+#endif // STOCKCATALOGINDEX_H
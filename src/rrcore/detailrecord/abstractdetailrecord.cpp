@@ -1,6 +1,7 @@
 #include "abstractdetailrecord.h"
 #include "database/databasethread.h"
 #include "database/queryexecutor.h"
+#include "singletons/startupprofiler.h"
 
 AbstractDetailRecord::AbstractDetailRecord(QObject *parent) :
     AbstractDetailRecord(DatabaseThread::instance(), parent)
@@ -12,7 +13,10 @@ AbstractDetailRecord::AbstractDetailRecord(DatabaseThread &thread, QObject *pare
     m_busy(false)
 {
     connect(this, &AbstractDetailRecord::execute, &thread, &DatabaseThread::execute);
-    connect(&thread, &DatabaseThread::resultReady, this, &AbstractDetailRecord::processResult);
+    thread.addReceiver(this, [this](const QueryResult &result) {
+        StartupProfiler::instance().endQuery(this);
+        processResult(result);
+    });
 }
 
 AbstractDetailRecord::~AbstractDetailRecord()
@@ -46,8 +50,10 @@ void AbstractDetailRecord::classBegin()
 
 void AbstractDetailRecord::componentComplete()
 {
-    if (m_autoQuery)
+    if (m_autoQuery) {
+        StartupProfiler::instance().beginQuery(this, metaObject()->className());
         tryQuery();
+    }
 }
 
 void AbstractDetailRecord::refresh()
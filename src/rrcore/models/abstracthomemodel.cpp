@@ -6,7 +6,16 @@ AbstractHomeModel::AbstractHomeModel(QObject *parent) :
 {}
 
 AbstractHomeModel::AbstractHomeModel(DatabaseThread &thread, QObject *parent) :
-    AbstractVisualListModel(thread, parent)
+    AbstractVisualListModel(thread, parent),
+    m_records({
+              { TitleRole, "title", QMetaType::QString },
+              { ImageUrlRole, "image_url", QMetaType::QString },
+              { IconUrlRole, "icon_url", QMetaType::QString },
+              { ShortDescriptionRole, "short_description", QMetaType::QString },
+              { LongDescriptionRole, "long_description", QMetaType::QString },
+              { BreadcrumbsRole, "breadcrumbs", QMetaType::QVariantList },
+              { ChartTypeRole, "chart_type", QMetaType::QVariantList }
+              })
 {
 
 }
@@ -18,7 +27,7 @@ AbstractHomeModel::~AbstractHomeModel()
 
 QVariantList AbstractHomeModel::records() const
 {
-    return m_records;
+    return m_records.toVariantList();
 }
 
 int AbstractHomeModel::rowCount(const QModelIndex &parent) const
@@ -34,24 +43,7 @@ QVariant AbstractHomeModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    switch (role) {
-    case TitleRole:
-        return m_records.at(index.row()).toMap().value("title").toString();
-    case ImageUrlRole:
-        return m_records.at(index.row()).toMap().value("image_url").toString();
-    case IconUrlRole:
-        return m_records.at(index.row()).toMap().value("icon_url").toString();
-    case ShortDescriptionRole:
-        return m_records.at(index.row()).toMap().value("short_description").toString();
-    case LongDescriptionRole:
-        return m_records.at(index.row()).toMap().value("long_description").toString();
-    case BreadcrumbsRole:
-        return m_records.at(index.row()).toMap().value("breadcrumbs").toList();
-    case ChartTypeRole:
-        return m_records.at(index.row()).toMap().value("chart_type").toList();
-    }
-
-    return QVariant();
+    return m_records.value(index.row(), role);
 }
 
 QHash<int, QByteArray> AbstractHomeModel::roleNames() const
@@ -76,7 +68,7 @@ void AbstractHomeModel::processResult(const QueryResult result)
     setBusy(false);
     beginResetModel();
     if (result.isSuccessful()) {
-        m_records = result.outcome().toMap().value("records").toList();
+        m_records.setRecords(result.outcome().toMap().value("records").toList());
         emit success();
     } else {
         emit error();
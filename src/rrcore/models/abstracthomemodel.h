@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include "abstractvisuallistmodel.h"
+#include "recordtable.h"
 
 class DatabaseThread;
 
@@ -31,7 +32,7 @@ protected:
     QVariantList records() const;
     void processResult(const QueryResult result) override;
 private:
-    QVariantList m_records;
+    RecordTable m_records;
 };
 
 #endif // ABSTRACTHOMEMODEL_H
@@ -3,6 +3,7 @@
 #include "database/queryexecutor.h"
 
 #include "queryexecutors/sales.h"
+#include "singletons/startupprofiler.h"
 
 #include <QLoggingCategory>
 
@@ -16,14 +17,17 @@ AbstractVisualListModel::AbstractVisualListModel(DatabaseThread &thread, QObject
     QAbstractListModel(parent),
     m_autoQuery(true),
     m_busy(false),
+    m_hasMoreRecords(false),
     m_filterColumn(-1),
     m_sortOrder(Qt::AscendingOrder),
     m_sortColumn(-1)
 {
     connect(this, &AbstractVisualListModel::execute, &thread, &DatabaseThread::execute);
-    connect(&thread, &DatabaseThread::resultReady, this, &AbstractVisualListModel::processResult);
-
-    connect(&thread, &DatabaseThread::resultReady, this, &AbstractVisualListModel::saveRequest);
+    thread.addReceiver(this, [this](const QueryResult &result) {
+        StartupProfiler::instance().endQuery(this);
+        processResult(result);
+        saveRequest(result);
+    });
 
     connect(this, &AbstractVisualListModel::filterTextChanged, this, &AbstractVisualListModel::filter);
     connect(this, &AbstractVisualListModel::filterColumnChanged, this, &AbstractVisualListModel::filter);
@@ -79,13 +83,15 @@ int AbstractVisualListModel::filterColumn() const
 
 QVariant AbstractVisualListModel::get(int row) const
 {
-    QVariantMap record;
-    QHashIterator<int, QByteArray> iter(roleNames());
-    while (iter.hasNext()) {
-        auto pair = iter.next();
+    // NOTE: roleNames() builds a new hash on every call, but it never changes for a model.
+    if (m_roleNames.isEmpty())
+        m_roleNames = roleNames();
 
-        if (pair.key() >= Qt::UserRole)
-            record.insert(pair.value(), data(index(row), pair.key()));
+    QVariantMap record;
+    const QModelIndex modelIndex = index(row);
+    for (auto iter = m_roleNames.cbegin(); iter != m_roleNames.cend(); ++iter) {
+        if (iter.key() >= Qt::UserRole)
+            record.insert(iter.value(), data(modelIndex, iter.key()));
     }
 
     return QVariant(record);
@@ -135,8 +141,10 @@ void AbstractVisualListModel::classBegin()
 
 void AbstractVisualListModel::componentComplete()
 {
-    if (m_autoQuery)
+    if (m_autoQuery) {
+        StartupProfiler::instance().beginQuery(this, metaObject()->className());
         tryQuery();
+    }
 }
 
 void AbstractVisualListModel::undoLastCommit()
@@ -149,6 +157,37 @@ void AbstractVisualListModel::filter()
 
 }
 
+bool AbstractVisualListModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return false;
+
+    return m_hasMoreRecords && !m_busy;
+}
+
+void AbstractVisualListModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent))
+        return;
+
+    tryFetchMore();
+}
+
+void AbstractVisualListModel::tryFetchMore()
+{
+
+}
+
+bool AbstractVisualListModel::hasMoreRecords() const
+{
+    return m_hasMoreRecords;
+}
+
+void AbstractVisualListModel::setHasMoreRecords(bool hasMoreRecords)
+{
+    m_hasMoreRecords = hasMoreRecords;
+}
+
 const QueryRequest &AbstractVisualListModel::lastSuccessfulRequest() const
 {
     return m_lastSuccessfulRequest;
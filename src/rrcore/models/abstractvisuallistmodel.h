@@ -49,6 +49,9 @@ public:
 
     Q_INVOKABLE QVariant get(int row) const;
 
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
     void classBegin() override;
     void componentComplete() override;
 public slots:
@@ -58,7 +61,10 @@ protected:
     virtual void tryQuery() = 0;
     virtual void processResult(const QueryResult result) = 0;
     virtual void filter();
+    virtual void tryFetchMore();
     void setBusy(bool);
+    bool hasMoreRecords() const;
+    void setHasMoreRecords(bool hasMoreRecords);
     const QueryRequest &lastSuccessfulRequest() const;
 signals:
     void execute(QueryExecutor *);
@@ -76,11 +82,13 @@ signals:
 private:
     bool m_autoQuery;
     bool m_busy;
+    bool m_hasMoreRecords;
     QString m_filterText;
     int m_filterColumn;
     Qt::SortOrder m_sortOrder;
     int m_sortColumn;
     QueryRequest m_lastSuccessfulRequest;
+    mutable QHash<int, QByteArray> m_roleNames;
 
     void saveRequest(const QueryResult &result);
 };
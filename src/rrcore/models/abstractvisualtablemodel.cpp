@@ -1,6 +1,7 @@
 #include "abstractvisualtablemodel.h"
 #include "database/databasethread.h"
 #include "database/queryexecutor.h"
+#include "singletons/startupprofiler.h"
 
 #include <QLoggingCategory>
 
@@ -14,15 +15,18 @@ AbstractVisualTableModel::AbstractVisualTableModel(DatabaseThread &thread, QObje
     QAbstractTableModel(parent),
     m_autoQuery(true),
     m_busy(false),
+    m_hasMoreRecords(false),
     m_filterColumn(-1),
     m_sortOrder(Qt::AscendingOrder),
     m_sortColumn(-1),
     m_tableViewWidth(0.0)
 {
     connect(this, &AbstractVisualTableModel::execute, &thread, &DatabaseThread::execute);
-    connect(&thread, &DatabaseThread::resultReady, this, &AbstractVisualTableModel::processResult);
-
-    connect(&thread, &DatabaseThread::resultReady, this, &AbstractVisualTableModel::saveRequest);
+    thread.addReceiver(this, [this](const QueryResult &result) {
+        StartupProfiler::instance().endQuery(this);
+        processResult(result);
+        saveRequest(result);
+    });
 
     connect(this, &AbstractVisualTableModel::filterTextChanged, this, &AbstractVisualTableModel::filter);
     connect(this, &AbstractVisualTableModel::filterColumnChanged, this, &AbstractVisualTableModel::filter);
@@ -74,13 +78,15 @@ int AbstractVisualTableModel::filterColumn() const
 
 QVariant AbstractVisualTableModel::get(int row, int column) const
 {
-    QVariantMap record;
-    QHashIterator<int, QByteArray> iter(roleNames());
-    while (iter.hasNext()) {
-        auto pair = iter.next();
+    // NOTE: roleNames() builds a new hash on every call, but it never changes for a model.
+    if (m_roleNames.isEmpty())
+        m_roleNames = roleNames();
 
-        if (pair.key() >= Qt::UserRole)
-            record.insert(pair.value(), data(index(row, column), pair.key()));
+    QVariantMap record;
+    const QModelIndex modelIndex = index(row, column);
+    for (auto iter = m_roleNames.cbegin(); iter != m_roleNames.cend(); ++iter) {
+        if (iter.key() >= Qt::UserRole)
+            record.insert(iter.value(), data(modelIndex, iter.key()));
     }
 
     return QVariant(record);
@@ -144,8 +150,10 @@ void AbstractVisualTableModel::classBegin()
 
 void AbstractVisualTableModel::componentComplete()
 {
-    if (m_autoQuery)
+    if (m_autoQuery) {
+        StartupProfiler::instance().beginQuery(this, metaObject()->className());
         tryQuery();
+    }
 }
 
 void AbstractVisualTableModel::undoLastCommit()
@@ -179,6 +187,37 @@ void AbstractVisualTableModel::setBusy(bool busy)
     emit busyChanged();
 }
 
+bool AbstractVisualTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return false;
+
+    return m_hasMoreRecords && !m_busy;
+}
+
+void AbstractVisualTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent))
+        return;
+
+    tryFetchMore();
+}
+
+void AbstractVisualTableModel::tryFetchMore()
+{
+
+}
+
+bool AbstractVisualTableModel::hasMoreRecords() const
+{
+    return m_hasMoreRecords;
+}
+
+void AbstractVisualTableModel::setHasMoreRecords(bool hasMoreRecords)
+{
+    m_hasMoreRecords = hasMoreRecords;
+}
+
 const QueryRequest &AbstractVisualTableModel::lastSuccessfulRequest() const
 {
     return m_lastSuccessfulRequest;
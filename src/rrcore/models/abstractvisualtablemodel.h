@@ -53,6 +53,9 @@ public:
 
     Q_INVOKABLE QVariant get(int row, int column) const;
 
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
     void classBegin() override;
     void componentComplete() override;
 public slots:
@@ -63,7 +66,10 @@ protected:
     virtual void processResult(const QueryResult result) = 0;
     virtual QString columnName(int column) const;
     virtual void filter();
+    virtual void tryFetchMore();
     void setBusy(bool);
+    bool hasMoreRecords() const;
+    void setHasMoreRecords(bool hasMoreRecords);
     const QueryRequest &lastSuccessfulRequest() const;
 signals:
     void execute(QueryExecutor *);
@@ -83,12 +89,14 @@ signals:
 private:
     bool m_autoQuery;
     bool m_busy;
+    bool m_hasMoreRecords;
     QString m_filterText;
     int m_filterColumn;
     Qt::SortOrder m_sortOrder;
     int m_sortColumn;
     qreal m_tableViewWidth;
     QueryRequest m_lastSuccessfulRequest;
+    mutable QHash<int, QByteArray> m_roleNames;
 
     void saveRequest(const QueryResult &result);
 };
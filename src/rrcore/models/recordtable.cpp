@@ -0,0 +1,173 @@
+#include "recordtable.h"
+#include <QDateTime>
+#include <QUrl>
+#include <climits>
+
+const QVariant RecordTable::m_null;
+
+RecordTable::RecordTable(std::initializer_list<Column> columns) :
+    m_columns(columns),
+    m_firstRole(INT_MAX),
+    m_rowCount(0)
+{
+    int lastRole = INT_MIN;
+    for (const Column &column : m_columns) {
+        m_firstRole = qMin(m_firstRole, column.role);
+        lastRole = qMax(lastRole, column.role);
+    }
+
+    if (m_columns.isEmpty())
+        return;
+
+    m_offsets.fill(-1, lastRole - m_firstRole + 1);
+    for (int i = 0; i < m_columns.count(); ++i)
+        m_offsets[m_columns.at(i).role - m_firstRole] = i;
+}
+
+int RecordTable::count() const
+{
+    return m_rowCount;
+}
+
+bool RecordTable::isEmpty() const
+{
+    return m_rowCount == 0;
+}
+
+void RecordTable::setRecords(const QVariantList &records)
+{
+    m_values.clear();
+    m_values.reserve(records.count() * m_columns.count());
+    for (const QVariant &record : records)
+        m_values.append(toRow(record.toMap()));
+
+    m_rowCount = records.count();
+}
+
+void RecordTable::appendRecords(const QVariantList &records)
+{
+    m_values.reserve((m_rowCount + records.count()) * m_columns.count());
+    for (const QVariant &record : records)
+        m_values.append(toRow(record.toMap()));
+
+    m_rowCount += records.count();
+}
+
+void RecordTable::append(const QVariantMap &record)
+{
+    insert(m_rowCount, record);
+}
+
+void RecordTable::insert(int row, const QVariantMap &record)
+{
+    if (row < 0 || row > m_rowCount)
+        return;
+
+    const QVector<QVariant> values(toRow(record));
+    const int offset = row * m_columns.count();
+    m_values.insert(offset, values.count(), QVariant());
+    for (int i = 0; i < values.count(); ++i)
+        m_values[offset + i] = values.at(i);
+
+    m_rowCount++;
+}
+
+void RecordTable::removeAt(int row)
+{
+    if (row < 0 || row >= m_rowCount)
+        return;
+
+    m_values.remove(row * m_columns.count(), m_columns.count());
+    m_rowCount--;
+}
+
+void RecordTable::clear()
+{
+    m_values.clear();
+    m_rowCount = 0;
+}
+
+void RecordTable::setValue(int row, int role, const QVariant &value)
+{
+    const int column = columnForRole(role);
+    if (row < 0 || row >= m_rowCount || column < 0)
+        return;
+
+    m_values[row * m_columns.count() + column] = toColumnType(value, m_columns.at(column).type);
+}
+
+int RecordTable::indexOf(int role, const QVariant &value) const
+{
+    const int column = columnForRole(role);
+    if (column < 0)
+        return -1;
+
+    const QVariant &typedValue = toColumnType(value, m_columns.at(column).type);
+    for (int row = 0; row < m_rowCount; ++row)
+        if (m_values.at(row * m_columns.count() + column) == typedValue)
+            return row;
+
+    return -1;
+}
+
+QVariantMap RecordTable::toVariantMap(int row) const
+{
+    QVariantMap record;
+    if (row < 0 || row >= m_rowCount)
+        return record;
+
+    for (int i = 0; i < m_columns.count(); ++i)
+        record.insert(m_columns.at(i).key, m_values.at(row * m_columns.count() + i));
+
+    return record;
+}
+
+QVariantList RecordTable::toVariantList() const
+{
+    QVariantList records;
+    records.reserve(m_rowCount);
+    for (int row = 0; row < m_rowCount; ++row)
+        records.append(toVariantMap(row));
+
+    return records;
+}
+
+QVector<QVariant> RecordTable::toRow(const QVariantMap &record) const
+{
+    QVector<QVariant> values;
+    values.reserve(m_columns.count());
+    for (const Column &column : m_columns)
+        values.append(toColumnType(record.value(column.key), column.type));
+
+    return values;
+}
+
+QVariant RecordTable::toColumnType(const QVariant &value, int type)
+{
+    // NOTE: A missing or NULL value is kept as it came, so that it is not mistaken for 0, "" or false.
+    if (value.isNull())
+        return value;
+
+    switch (type) {
+    case QMetaType::Int:
+        return value.toInt();
+    case QMetaType::LongLong:
+        return value.toLongLong();
+    case QMetaType::Double:
+        return value.toDouble();
+    case QMetaType::Bool:
+        return value.toBool();
+    case QMetaType::QString:
+        return value.toString();
+    case QMetaType::QUrl:
+        return value.toUrl();
+    case QMetaType::QDateTime:
+        return value.toDateTime();
+    case QMetaType::QVariantList:
+        return value.toList();
+    case QMetaType::QVariantMap:
+        return value.toMap();
+    }
+
+    return value;
+}
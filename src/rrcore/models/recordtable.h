@@ -0,0 +1,65 @@
+#ifndef RECORDTABLE_H
+#define RECORDTABLE_H
+
+#include <QVector>
+#include <QVariant>
+#include <QVariantMap>
+#include <QVariantList>
+#include <initializer_list>
+
+// Row storage for the visual models. Each record is converted once, when it is
+// loaded, into a fixed row of typed values; a role is mapped to its column through
+// an offset table, so reading a cell is an indexed load instead of a map lookup.
+// A missing or NULL value stays null instead of taking the default of its column type.
+class RecordTable
+{
+public:
+    struct Column {
+        int role;
+        QString key;
+        int type; // QMetaType::Type
+    };
+
+    explicit RecordTable(std::initializer_list<Column> columns);
+
+    int count() const;
+    bool isEmpty() const;
+
+    void setRecords(const QVariantList &records);
+    void appendRecords(const QVariantList &records);
+    void append(const QVariantMap &record);
+    void insert(int row, const QVariantMap &record);
+    void removeAt(int row);
+    void clear();
+
+    inline const QVariant &value(int row, int role) const {
+        const int column = columnForRole(role);
+        if (row < 0 || row >= m_rowCount || column < 0)
+            return m_null;
+
+        return m_values.at(row * m_columns.count() + column);
+    }
+
+    void setValue(int row, int role, const QVariant &value);
+    int indexOf(int role, const QVariant &value) const;
+
+    QVariantMap toVariantMap(int row) const;
+    QVariantList toVariantList() const;
+private:
+    QVector<Column> m_columns;
+    QVector<int> m_offsets;
+    int m_firstRole;
+    int m_rowCount;
+    QVector<QVariant> m_values;
+    static const QVariant m_null;
+
+    inline int columnForRole(int role) const {
+        const int offset = role - m_firstRole;
+        return offset >= 0 && offset < m_offsets.count() ? m_offsets.at(offset) : -1;
+    }
+
+    QVector<QVariant> toRow(const QVariantMap &record) const;
+    static QVariant toColumnType(const QVariant &value, int type);
+};
+
+#endif // RECORDTABLE_H
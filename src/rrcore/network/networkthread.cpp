@@ -9,109 +9,241 @@
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QEventLoop>
+#include <QTimer>
 #include "networkurl.h"
 #include "networkerror.h"
+#include "wireformat.h"
 #include "database/queryexecutor.h"
+#include "database/querymetrics.h"
+#include "database/readreplica.h"
+#include "database/changesync.h"
+#include "singletons/startupprofiler.h"
 
 Q_LOGGING_CATEGORY(networkThread, "rrcore.network.networkthread");
 
 NetworkWorker::NetworkWorker(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_networkManager(nullptr),
+    m_requestLogger(nullptr),
+    m_inFlightCount{ 0, 0 },
+    m_requestEncoding(WireFormat::Encoding::Json),
+    m_retryTimer(new QTimer(this)),
+    m_retryInterval(MIN_RETRY_INTERVAL),
+    m_replayFailed(false),
+    m_replayedCount(0)
 {
+    m_retryTimer->setSingleShot(true);
+    connect(m_retryTimer, &QTimer::timeout, this, &NetworkWorker::replayLoggedRequests);
+}
+
+NetworkWorker::NetworkWorker(QNetworkAccessManager *networkManager,
+                             RequestLogger *requestLogger,
+                             QObject *parent) :
+    NetworkWorker(parent)
+{
+    m_networkManager = networkManager;
+    m_networkManager->setParent(this);
+    m_requestLogger = requestLogger;
+    m_requestLogger->setParent(this);
+}
+
+void NetworkWorker::start()
+{
+    // NOTE: The network manager and the request log are created on the network thread,
+    // so that opening them does not hold up the thread that starts it.
     m_networkManager = new QNetworkAccessManager(this);
     m_requestLogger = new RequestLogger(this);
+
+    // NOTE: Requests logged in a previous session are replayed as soon as the event loop runs.
+    if (m_requestLogger->hasNext())
+        m_retryTimer->start(0);
 }
 
 void NetworkWorker::execute(const QueryRequest request)
 {
-    qCInfo(networkThread) << request;
-    ServerResponse response(QueryResult{ request }); // Always know your sender, even if an exception is thrown
-    QNetworkRequest networkRequest;
-    ServerRequest serverRequest(request);
+    submit(Lane::Interactive, ServerRequest(request), true);
+}
 
-    QElapsedTimer timer;
-    timer.start();
+void NetworkWorker::execute(const ServerRequest request)
+{
+    submit(Lane::Interactive, request, false);
+}
+
+void NetworkWorker::sync(const ServerRequest request)
+{
+    submit(Lane::Sync, request, false);
+}
+
+void NetworkWorker::submit(Lane lane, const ServerRequest &serverRequest, bool isQueryRequest)
+{
+    PendingRequest pendingRequest{ lane, serverRequest, QNetworkRequest(), QByteArray(), isQueryRequest, false, QElapsedTimer() };
+    pendingRequest.timer.start();
+
+    if (isQueryRequest) {
+        const QueryRequest &request = serverRequest.queryRequest();
+        qCInfo(networkThread) << request;
+
+        pendingRequest.isLoggable = request.commandVerb() != QueryRequest::CommandVerb::Authenticate
+                && request.commandVerb() != QueryRequest::CommandVerb::Read; // Don't store authentication or read commands
+        if (pendingRequest.isLoggable)
+            pendingRequest.serverRequest.setIdempotencyKey(ServerRequest::createIdempotencyKey());
+    } else {
+        qCInfo(networkThread) << serverRequest;
+    }
 
     try {
-        networkRequest.setUrl(determineUrl(request));
-        networkRequest.setRawHeader("Content-Type", "application/json");
-        networkRequest.setRawHeader("Content-Length", QByteArray::number(serverRequest.toJson().size()));
-        if (!UserProfile::instance().accessToken().trimmed().isEmpty())
-            networkRequest.setRawHeader("Authorization", QByteArray("Bearer ")
-                                        .append(UserProfile::instance().accessToken()));
+        const QUrl &url = isQueryRequest ? determineUrl(pendingRequest.serverRequest.queryRequest())
+                                         : determineUrl(pendingRequest.serverRequest);
+        pendingRequest.networkRequest = createNetworkRequest(url,
+                                                             lane == Lane::Interactive ? QNetworkRequest::HighPriority
+                                                                                       : QNetworkRequest::LowPriority);
+        pendingRequest.body = encodeBody(pendingRequest.serverRequest.toVariantMap(), pendingRequest.networkRequest);
+        if (!pendingRequest.serverRequest.idempotencyKey().isEmpty())
+            pendingRequest.networkRequest.setRawHeader("Idempotency-Key",
+                                                       pendingRequest.serverRequest.idempotencyKey().toUtf8());
+    } catch (NetworkException &e) {
+        fail(pendingRequest,
+             isQueryRequest ? ServerResponse(QueryResult{ pendingRequest.serverRequest.queryRequest() })
+                            : ServerResponse(pendingRequest.serverRequest),
+             e);
+        return;
+    }
+
+    m_queues[static_cast<int>(lane)].enqueue(pendingRequest);
+    dispatchRequests();
+}
 
-        flushLoggedRequests();
+void NetworkWorker::dispatchRequests()
+{
+    // NOTE: The interactive lane is always served first. Its requests are also marked as
+    // high priority, so they overtake sync traffic queued inside QNetworkAccessManager.
+    for (const Lane lane : { Lane::Interactive, Lane::Sync }) {
+        const int index = static_cast<int>(lane);
+        const int maxInFlightCount = lane == Lane::Interactive ? MAX_INTERACTIVE_IN_FLIGHT : MAX_SYNC_IN_FLIGHT;
+        while (!m_queues[index].isEmpty() && m_inFlightCount[index] < maxInFlightCount) {
+            const PendingRequest &pendingRequest = m_queues[index].dequeue();
+            QNetworkReply *networkReply = m_networkManager->post(pendingRequest.networkRequest, pendingRequest.body);
+            connect(networkReply, &QNetworkReply::finished, this, [this, networkReply]() {
+                finishRequest(networkReply);
+            });
+
+            m_inFlightRequests.insert(networkReply, pendingRequest);
+            ++m_inFlightCount[index];
+        }
+    }
+}
 
-        QNetworkReply *networkReply = m_networkManager->post(networkRequest, serverRequest.toJson());
-        waitForFinished(networkReply);
+void NetworkWorker::finishRequest(QNetworkReply *reply)
+{
+    const PendingRequest &pendingRequest = m_inFlightRequests.take(reply);
+    --m_inFlightCount[static_cast<int>(pendingRequest.lane)];
+    reply->deleteLater();
+
+    qCDebug(networkThread) << "Reply received for" << reply->request().url();
+
+    // NOTE: A server that does not understand CBOR bodies gets the request again, as JSON.
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == UNSUPPORTED_MEDIA_TYPE
+            && WireFormat::encodingFor(pendingRequest.networkRequest.rawHeader("Content-Type")) == WireFormat::Encoding::Cbor) {
+        qCInfo(networkThread) << "Server rejected CBOR request body, falling back to JSON.";
+        m_requestEncoding = WireFormat::Encoding::Json;
+
+        PendingRequest retriedRequest = pendingRequest;
+        retriedRequest.body = encodeBody(retriedRequest.serverRequest.toVariantMap(), retriedRequest.networkRequest);
+        m_queues[static_cast<int>(retriedRequest.lane)].prepend(retriedRequest);
+        dispatchRequests();
+        return;
+    }
 
-        response = ServerResponse::fromJson(networkReply->readAll(), request);
-        QueryResult result{ response.queryResult() };
-        response.setQueryResult(result);
+    const QVariantMap &body = WireFormat::decode(reply->readAll(), negotiateEncoding(reply));
+    ServerResponse response = pendingRequest.isQueryRequest
+            ? ServerResponse::fromVariantMap(body, pendingRequest.serverRequest.queryRequest())
+            : ServerResponse::fromVariantMap(body, pendingRequest.serverRequest);
 
-        if (networkReply->error() != QNetworkReply::NoError)
+    try {
+        if (reply->error() != QNetworkReply::NoError)
             throw NetworkException(response.errorCode(),
                                    response.errorMessage(),
-                                   networkReply->error(),
-                                   networkReply->errorString());
-    } catch (NetworkException &e) {
-        response.setErrorCode(e.code());
-        response.setErrorMessage(e.message());
-        response.setStatusCode(e.statusCode());
-        response.setStatusMessage(e.statusMessage());
+                                   reply->error(),
+                                   reply->errorString());
 
-        if (request.commandVerb() != QueryRequest::CommandVerb::Authenticate
-                && request.commandVerb() != QueryRequest::CommandVerb::Read) // Don't store authentication or read commands
-            m_requestLogger->push(serverRequest);
+        // NOTE: The server is reachable again, so there is no point waiting for the next retry.
+        if (m_requestLogger->hasNext() && m_retryTimer->isActive()) {
+            m_retryTimer->stop();
+            replayLoggedRequests();
+        }
 
-        qCWarning(networkThread).nospace() << e;
+        deliver(pendingRequest, response);
+    } catch (NetworkException &e) {
+        fail(pendingRequest, response, e);
     }
 
-    emit resultReady(response.queryResult());
-    qCInfo(networkThread) << response << " [elapsed = " << timer.elapsed() << " ms]";
+    dispatchRequests();
 }
 
-void NetworkWorker::execute(const ServerRequest request)
+void NetworkWorker::fail(const PendingRequest &pendingRequest, ServerResponse response, const NetworkException &e)
 {
-    qCInfo(networkThread) << request;
-    ServerResponse response(request); // Always know the sender
-    QNetworkRequest networkRequest;
+    response.setErrorCode(e.code());
+    response.setErrorMessage(e.message());
+    response.setStatusCode(e.statusCode());
+    response.setStatusMessage(e.statusMessage());
 
-    QElapsedTimer timer;
-    timer.start();
+    if (pendingRequest.isLoggable)
+        logRequest(pendingRequest.serverRequest);
 
-    try {
-        networkRequest.setUrl(determineUrl(request));
-        networkRequest.setRawHeader("Content-Type", "application/json");
-        networkRequest.setRawHeader("Content-Length", QByteArray::number(request.toJson().size()));
-        if (!UserProfile::instance().accessToken().trimmed().isEmpty())
-            networkRequest.setRawHeader("Authorization", QByteArray("Bearer ")
-                                        .append(UserProfile::instance().accessToken()));
+    qCWarning(networkThread).nospace() << e;
+    deliver(pendingRequest, response);
+}
+
+void NetworkWorker::deliver(const PendingRequest &pendingRequest, const ServerResponse &response)
+{
+    if (pendingRequest.isQueryRequest)
+        emit resultReady(response.queryResult());
+    else
+        emit responseReady(response);
 
-        QNetworkReply *networkReply = m_networkManager->post(networkRequest, request.toJson());
-        waitForFinished(networkReply);
+    qCInfo(networkThread) << response << " [elapsed = " << pendingRequest.timer.elapsed() << " ms]";
+}
 
-        response = ServerResponse::fromJson(networkReply->readAll(), request);
+QNetworkRequest NetworkWorker::createNetworkRequest(const QUrl &url, QNetworkRequest::Priority priority) const
+{
+    QNetworkRequest networkRequest(url);
+    networkRequest.setPriority(priority);
+    networkRequest.setRawHeader("Accept", WireFormat::acceptHeader());
+    if (!UserProfile::instance().accessToken().trimmed().isEmpty())
+        networkRequest.setRawHeader("Authorization", QByteArray("Bearer ")
+                                    .append(UserProfile::instance().accessToken()));
+
+    return networkRequest;
+}
 
-        if (networkReply->error() != QNetworkReply::NoError)
-            throw NetworkException(response.errorCode(),
-                                   response.errorMessage(),
-                                   networkReply->error(),
-                                   networkReply->errorString());
-    } catch (NetworkException &e) {
-        response.setErrorCode(e.code());
-        response.setErrorMessage(e.message());
-        response.setStatusCode(e.statusCode());
-        response.setStatusMessage(e.statusMessage());
+QByteArray NetworkWorker::encodeBody(const QVariantMap &map, QNetworkRequest &networkRequest) const
+{
+    QByteArray body = WireFormat::encode(map, m_requestEncoding);
+    networkRequest.setRawHeader("Content-Type", WireFormat::contentType(m_requestEncoding));
+
+    // NOTE: Only a server that speaks CBOR is known to accept compressed request bodies.
+    if (m_requestEncoding == WireFormat::Encoding::Cbor && body.size() >= WireFormat::MIN_COMPRESSED_SIZE) {
+        body = WireFormat::compress(body);
+        networkRequest.setRawHeader("Content-Encoding", "deflate");
+    } else {
+        networkRequest.setRawHeader("Content-Encoding", QByteArray());
+    }
+
+    networkRequest.setRawHeader("Content-Length", QByteArray::number(body.size()));
+    return body;
+}
 
-        qCWarning(networkThread).nospace() << e;
+WireFormat::Encoding NetworkWorker::negotiateEncoding(QNetworkReply *reply)
+{
+    // NOTE: QNetworkAccessManager asks for and undoes "deflate" and "gzip" response encodings by itself.
+    const WireFormat::Encoding encoding =
+            WireFormat::encodingFor(reply->header(QNetworkRequest::ContentTypeHeader).toByteArray());
+    if (encoding == WireFormat::Encoding::Cbor && m_requestEncoding != WireFormat::Encoding::Cbor) {
+        qCInfo(networkThread) << "Server accepts CBOR, switching request bodies to CBOR.";
+        m_requestEncoding = WireFormat::Encoding::Cbor;
     }
 
-    emit responseReady(response);
-    qCInfo(networkThread) << response << " [elapsed = " << timer.elapsed() << " ms]";
+    return encoding;
 }
 
 QUrl NetworkWorker::determineUrl(const QueryRequest &request) const
@@ -147,56 +279,126 @@ QUrl NetworkWorker::determineUrl(const ServerRequest &request) const
         return QUrl(NetworkUrl::LINK_ACCOUNT_URL);
     else if (request.action() == "link_business_store")
         return QUrl(NetworkUrl::LINK_BUSINESS_STORE_URL);
+    else if (request.action() == ReadReplica::PULL_ACTION)
+        return QUrl(NetworkUrl::REPLICA_API_URL);
+    else if (request.action() == ChangeSync::PUSH_ACTION)
+        return QUrl(NetworkUrl::PUSH_CHANGES_API_URL);
+    else if (request.action() == ChangeSync::PULL_ACTION)
+        return QUrl(NetworkUrl::PULL_CHANGES_API_URL);
 
     throw NetworkException(NetworkError::ServerErrorCode::UnableToDetermineDestinationUrl,
                            QStringLiteral("Unable to determine destination URL for action '%1'").arg(request.action()));
 }
 
-void NetworkWorker::waitForFinished(QNetworkReply *reply)
+void NetworkWorker::logRequest(const ServerRequest &request)
 {
-    if (!reply)
-        return;
-
-    QEventLoop loop(this);
-    connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
+    m_requestLogger->push(request);
+    if (m_replayBatches.isEmpty() && !m_retryTimer->isActive())
+        m_retryTimer->start(m_retryInterval);
 
-    qCDebug(networkThread) << "NetworkWorker-> Reply received for" << reply->request().url();
+    reportSyncStatus();
 }
 
-void NetworkWorker::flushLoggedRequests()
+void NetworkWorker::replayLoggedRequests()
 {
-    ServerResponse response;
-    QNetworkRequest networkRequest;
+    // NOTE: After a failure, nothing new is sent until every batch in flight has returned.
+    if (m_replayFailed)
+        return;
 
-    try {
-        while (m_requestLogger->hasNext()) {
-            const ServerRequest &request = m_requestLogger->nextRequest();
+    if (m_replayBatches.isEmpty() && m_requestLogger->unreadCount() > 0) {
+        m_replayClock.start();
+        m_replayedCount = 0;
+    }
+
+    while (m_replayBatches.count() < MAX_IN_FLIGHT_BATCHES && m_requestLogger->unreadCount() > 0) {
+        QVariantList requests;
+        qint64 batchSize = 0;
+        while (requests.count() < MAX_BATCH_REQUEST_COUNT
+               && batchSize < MAX_BATCH_SIZE
+               && m_requestLogger->unreadCount() > 0) {
+            const QVariantMap &request = m_requestLogger->readAhead().toVariantMap();
+            batchSize += QueryMetrics::estimateSize(request);
+            requests.append(request);
+        }
+
+        QNetworkRequest networkRequest = createNetworkRequest(QUrl(NetworkUrl::SYNC_API_URL), QNetworkRequest::LowPriority);
+        const QByteArray &body = encodeBody(QVariantMap{ { "requests", requests } }, networkRequest);
+        QNetworkReply *networkReply = m_networkManager->post(networkRequest, body);
+        connect(networkReply, &QNetworkReply::finished, this, [this, networkReply]() {
+            finishReplayBatch(networkReply);
+        });
 
-            networkRequest.setUrl(determineUrl(request.queryRequest()));
-            networkRequest.setRawHeader("Content-Type", "application/json");
-            networkRequest.setRawHeader("Content-Length", QByteArray::number(request.toJson().size()));
-            if (!UserProfile::instance().accessToken().trimmed().isEmpty())
-                networkRequest.setRawHeader("Authorization", QByteArray("Bearer ")
-                                            .append(UserProfile::instance().accessToken()));
+        m_replayBatches.append(ReplayBatch{ networkReply, requests.count(), false, false });
+        qCDebug(networkThread) << "Replaying" << requests.count() << "logged requests," << body.size() << "bytes.";
+    }
+
+    reportSyncStatus();
+}
+
+void NetworkWorker::finishReplayBatch(QNetworkReply *reply)
+{
+    for (ReplayBatch &batch : m_replayBatches) {
+        if (batch.reply == reply) {
+            batch.finished = true;
+            batch.successful = reply->error() == QNetworkReply::NoError;
+            negotiateEncoding(reply);
+            if (!batch.successful)
+                qCWarning(networkThread) << "Failed to replay logged requests:" << reply->errorString();
+            break;
+        }
+    }
 
-            QNetworkReply *networkReply = m_networkManager->post(networkRequest, request.toJson());
-            waitForFinished(networkReply);
+    reply->deleteLater();
 
-            response = ServerResponse::fromJson(networkReply->readAll(), request);
+    // NOTE: Requests leave the log in order, so a batch is only acknowledged once every batch
+    // sent before it has been. Batches that succeeded after a failed one are sent again; the
+    // idempotency keys let the server ignore the copies.
+    while (!m_replayBatches.isEmpty() && m_replayBatches.first().finished) {
+        const ReplayBatch batch = m_replayBatches.takeFirst();
+        if (!batch.successful || m_replayFailed) {
+            m_replayFailed = true;
+            continue;
+        }
 
-            if (networkReply->error() != QNetworkReply::NoError)
-                throw NetworkException(response.errorCode(),
-                                       response.errorMessage(),
-                                       networkReply->error(),
-                                       networkReply->errorString());
+        m_requestLogger->pop(batch.requestCount);
+        m_replayedCount += batch.requestCount;
+    }
 
-            m_requestLogger->pop();
+    if (m_replayFailed) {
+        if (m_replayBatches.isEmpty()) {
+            m_requestLogger->rewind();
+            m_replayFailed = false;
+            m_retryTimer->start(m_retryInterval);
+            qCInfo(networkThread) << "Retrying replay of" << m_requestLogger->count() << "logged requests in"
+                                  << m_retryInterval << "ms.";
+            m_retryInterval = qMin(m_retryInterval * 2, MAX_RETRY_INTERVAL);
         }
-    } catch (NetworkException &e) {
-        qCWarning(networkThread) << "Exception caught while flushing backup:" << e.message() << e.statusMessage();
-        throw;
+    } else {
+        m_retryInterval = MIN_RETRY_INTERVAL;
+        if (m_requestLogger->hasNext())
+            replayLoggedRequests();
+        else if (m_replayBatches.isEmpty())
+            qCInfo(networkThread) << "Replayed" << m_replayedCount << "logged requests in"
+                                  << m_replayClock.elapsed() << "ms.";
     }
+
+    reportSyncStatus();
+}
+
+void NetworkWorker::reportSyncStatus()
+{
+    int inFlightCount = 0;
+    for (const ReplayBatch &batch : m_replayBatches)
+        inFlightCount += batch.requestCount;
+
+    const qint64 elapsed = m_replayClock.isValid() ? m_replayClock.elapsed() : 0;
+    emit syncStatusChanged(QVariantMap {
+                               { "backlog_count", m_requestLogger->count() },
+                               { "backlog_size", m_requestLogger->size() },
+                               { "in_flight_count", inFlightCount },
+                               { "replayed_count", m_replayedCount },
+                               { "requests_per_second", elapsed > 0 ? m_replayedCount * 1000.0 / elapsed : 0.0 }
+                           });
 }
 
 NetworkThread::~NetworkThread()
@@ -210,14 +412,6 @@ void NetworkThread::run()
     exec();
 }
 
-void NetworkThread::syncWithServer(const QueryResult result)
-{
-    if (!result.isSuccessful() || result.request().commandVerb() == QueryRequest::CommandVerb::Read)
-        return;
-
-    emit execute(result.request());
-}
-
 void NetworkThread::tunnelToServer(QueryExecutor *queryExecutor)
 {
     emit execute(queryExecutor->request());
@@ -227,14 +421,18 @@ NetworkThread::NetworkThread(QObject *parent) :
     QThread(parent)
 {
     if (!isRunning()) {
+        StartupProfiler::Phase phase(QStringLiteral("start_network_thread"));
         NetworkWorker *worker = new NetworkWorker;
 
         connect(worker, &NetworkWorker::responseReady, this, &NetworkThread::responseReady);
         connect(worker, &NetworkWorker::resultReady, this, &NetworkThread::resultReady);
+        connect(worker, &NetworkWorker::syncStatusChanged, this, &NetworkThread::syncStatusChanged);
         connect(this, QOverload<ServerRequest>::of(&NetworkThread::execute),
                 worker, QOverload<ServerRequest>::of(&NetworkWorker::execute));
         connect(this, QOverload<QueryRequest>::of(&NetworkThread::execute),
                 worker, QOverload<QueryRequest>::of(&NetworkWorker::execute));
+        connect(this, &NetworkThread::sync, worker, &NetworkWorker::sync);
+        connect(this, &NetworkThread::started, worker, &NetworkWorker::start, Qt::DirectConnection);
         connect(this, &NetworkThread::finished, worker, &NetworkWorker::deleteLater);
 
         worker->moveToThread(this);
@@ -2,13 +2,20 @@
 #define NETWORKTHREAD_H
 
 #include <QThread>
+#include <QElapsedTimer>
+#include <QNetworkRequest>
+#include <QQueue>
+#include <QHash>
 #include <QLoggingCategory>
 #include "serverrequest.h"
 #include "serverresponse.h"
+#include "wireformat.h"
 #include "database/queryresult.h"
 
 class QNetworkAccessManager;
 class QNetworkReply;
+class QTimer;
+class NetworkException;
 class RequestLogger;
 class QueryExecutor;
 
@@ -16,22 +23,82 @@ class NetworkWorker : public QObject
 {
     Q_OBJECT
 public:
+    static const int MAX_BATCH_REQUEST_COUNT = 50;
+    static const qint64 MAX_BATCH_SIZE = 256 * 1024;
+    static const int MAX_INTERACTIVE_IN_FLIGHT = 6;
+    static const int MAX_SYNC_IN_FLIGHT = 2;
+    static const int MAX_IN_FLIGHT_BATCHES = 2;
+    static const int MIN_RETRY_INTERVAL = 5000; // milliseconds
+    static const int MAX_RETRY_INTERVAL = 5 * 60 * 1000; // milliseconds
+    static const int UNSUPPORTED_MEDIA_TYPE = 415;
+
     explicit NetworkWorker(QObject *parent = nullptr);
+    explicit NetworkWorker(QNetworkAccessManager *networkManager,
+                           RequestLogger *requestLogger,
+                           QObject *parent = nullptr); // For testing
     ~NetworkWorker() = default;
 
+    void start();
     void execute(const QueryRequest request);
     void execute(const ServerRequest request);
+    void sync(const ServerRequest request);
 signals:
     void resultReady(const QueryResult result);
     void responseReady(const ServerResponse response);
+    void syncStatusChanged(const QVariantMap status);
 private:
+    // Requests from the user interface (tunnelled queries, sign-in, account
+    // linking) go through the interactive lane; change log pushes and pulls,
+    // and read replica pulls, go through the sync lane.
+    enum class Lane {
+        Interactive,
+        Sync
+    };
+
+    struct PendingRequest {
+        Lane lane;
+        ServerRequest serverRequest;
+        QNetworkRequest networkRequest;
+        QByteArray body;
+        bool isQueryRequest;
+        bool isLoggable;
+        QElapsedTimer timer;
+    };
+
+    struct ReplayBatch {
+        QNetworkReply *reply;
+        int requestCount;
+        bool finished;
+        bool successful;
+    };
+
     QNetworkAccessManager *m_networkManager;
     RequestLogger *m_requestLogger;
+    QQueue<PendingRequest> m_queues[2];
+    QHash<QNetworkReply *, PendingRequest> m_inFlightRequests;
+    int m_inFlightCount[2];
+    WireFormat::Encoding m_requestEncoding;
+    QList<ReplayBatch> m_replayBatches;
+    QTimer *m_retryTimer;
+    int m_retryInterval;
+    bool m_replayFailed;
+    QElapsedTimer m_replayClock;
+    int m_replayedCount;
 
     QUrl determineUrl(const QueryRequest &request) const; // throws NetworkException
     QUrl determineUrl(const ServerRequest &request) const; // throws NetworkException
-    void waitForFinished(QNetworkReply *reply);
-    void flushLoggedRequests(); // throws NetworkException
+    void submit(Lane lane, const ServerRequest &serverRequest, bool isQueryRequest);
+    void dispatchRequests();
+    void finishRequest(QNetworkReply *reply);
+    void fail(const PendingRequest &pendingRequest, ServerResponse response, const NetworkException &e);
+    void deliver(const PendingRequest &pendingRequest, const ServerResponse &response);
+    QNetworkRequest createNetworkRequest(const QUrl &url, QNetworkRequest::Priority priority) const;
+    QByteArray encodeBody(const QVariantMap &map, QNetworkRequest &networkRequest) const;
+    WireFormat::Encoding negotiateEncoding(QNetworkReply *reply);
+    void logRequest(const ServerRequest &request);
+    void replayLoggedRequests();
+    void finishReplayBatch(QNetworkReply *reply);
+    void reportSyncStatus();
 };
 
 class NetworkThread : public QThread
@@ -45,13 +112,14 @@ public:
     void operator=(NetworkThread const &) = delete;
 
     void run() override final;
-    void syncWithServer(const QueryResult result);
     void tunnelToServer(QueryExecutor *queryExecutor);
 signals:
     void execute(const QueryRequest request);
     void execute(const ServerRequest request);
+    void sync(const ServerRequest request);
     void responseReady(const ServerResponse response);
     void resultReady(const QueryResult result);
+    void syncStatusChanged(const QVariantMap status);
 private:
     explicit NetworkThread(QObject *parent = nullptr);
 };
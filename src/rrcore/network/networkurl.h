@@ -25,6 +25,10 @@ namespace NetworkUrl {
         inline static const QString DEBTOR_API_URL = SERVER_URL + QStringLiteral("/api/database/debtor");
         inline static const QString CREDITOR_API_URL = SERVER_URL + QStringLiteral("/api/database/creditor");
         inline static const QString USER_API_URL = SERVER_URL + QStringLiteral("/api/database/user");
+        inline static const QString SYNC_API_URL = SERVER_URL + QStringLiteral("/api/database/sync");
+        inline static const QString REPLICA_API_URL = SERVER_URL + QStringLiteral("/api/database/replica");
+        inline static const QString PUSH_CHANGES_API_URL = SERVER_URL + QStringLiteral("/api/database/changes/push");
+        inline static const QString PULL_CHANGES_API_URL = SERVER_URL + QStringLiteral("/api/database/changes/pull");
     }
 
     inline namespace View {
@@ -2,93 +2,505 @@
 
 #include <QStandardPaths>
 #include <QDir>
+#include <QFileInfo>
+#include <QTimer>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QSettings>
+#include <QtEndian>
 #include <QLoggingCategory>
 #include <QDebug>
+#include <array>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "serverrequest.h"
 
 Q_LOGGING_CATEGORY(requestLogger, "rrcore.network.requestlogger", QtWarningMsg);
 
 const QString BACKUP_LOCATION = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/RecordRack/backup";
-const QString BACKUP_FILEPATH = BACKUP_LOCATION + "/rr.json";
-const int MAX_BACKUP_SIZE = 1024 * 1000 * 5; // 5 MB
+const QString JOURNAL_LOCATION = BACKUP_LOCATION + "/journal";
+const QString LEGACY_BACKUP_FILEPATH = BACKUP_LOCATION + "/rr.json";
+const QString CURSOR_FILE_NAME("cursor");
+const QByteArray SEGMENT_MAGIC("RRJ1");
+const quint32 SEGMENT_VERSION = 1;
+const qint64 SEGMENT_HEADER_SIZE = 8; // magic, version
+const qint64 RECORD_HEADER_SIZE = 8; // length, checksum
+const qint64 CURSOR_SIZE = 20; // segment, offset, checksum
+const qint64 MAX_RECORD_SIZE = 64 * 1024 * 1024;
+const qint64 BACKLOG_WARNING_SIZE = 1024 * 1000 * 5; // 5 MB
+
+static bool syncFile(QFile &file)
+{
+    if (!file.isOpen() || !file.flush())
+        return false;
+
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
 
 RequestLogger::RequestLogger(QObject *parent) :
-    QObject(parent)
+    RequestLogger(JOURNAL_LOCATION, DEFAULT_SEGMENT_SIZE, parent)
 {
-    QDir(BACKUP_LOCATION).mkpath(BACKUP_LOCATION);
-    m_backupArray = readBackupArray();
+    migrateLegacyBackup(LEGACY_BACKUP_FILEPATH);
 }
 
-void RequestLogger::push(const ServerRequest &request)
+RequestLogger::RequestLogger(const QString &directory, qint64 segmentSize, QObject *parent) :
+    QObject(parent),
+    m_directory(directory),
+    m_segmentSize(segmentSize),
+    m_cursor{ 0, SEGMENT_HEADER_SIZE },
+    m_readAhead{ 0, SEGMENT_HEADER_SIZE },
+    m_count(0),
+    m_readAheadCount(0),
+    m_size(0),
+    m_syncPending(false),
+    m_syncTimer(new QTimer(this))
 {
-    const QJsonObject &jsonObject{ QJsonDocument::fromJson(request.toJson()).object() };
+    m_syncTimer->setSingleShot(true);
+    m_syncTimer->setInterval(SYNC_INTERVAL);
+    connect(m_syncTimer, &QTimer::timeout, this, &RequestLogger::sync);
 
-    m_backupArray.append(jsonObject);
+    open();
+}
 
-    writeBackupArray();
+RequestLogger::~RequestLogger()
+{
+    sync();
+}
+
+QString RequestLogger::directory() const
+{
+    return m_directory;
 }
 
 bool RequestLogger::hasNext() const
 {
-    return !m_backupArray.isEmpty();
+    return m_count > 0;
+}
+
+int RequestLogger::count() const
+{
+    return m_count;
+}
+
+int RequestLogger::segmentCount() const
+{
+    return m_segments.count();
+}
+
+qint64 RequestLogger::size() const
+{
+    return m_size;
+}
+
+void RequestLogger::push(const ServerRequest &request)
+{
+    ServerRequest loggedRequest(request);
+    if (loggedRequest.idempotencyKey().isEmpty())
+        loggedRequest.setIdempotencyKey(ServerRequest::createIdempotencyKey());
+
+    const QByteArray &payload = loggedRequest.toJson();
+    uchar header[RECORD_HEADER_SIZE];
+    qToLittleEndian<quint32>(static_cast<quint32>(payload.size()), header);
+    qToLittleEndian<quint32>(checksum(payload), header + 4);
+
+    if (m_writer.size() > SEGMENT_HEADER_SIZE
+            && m_writer.size() + RECORD_HEADER_SIZE + payload.size() > m_segmentSize) {
+        syncFile(m_writer);
+        openWriter(m_segments.last() + 1);
+    }
+
+    if (m_writer.write(reinterpret_cast<const char *>(header), RECORD_HEADER_SIZE) != RECORD_HEADER_SIZE
+            || m_writer.write(payload) != payload.size()
+            || !m_writer.flush()) {
+        qCCritical(requestLogger) << "Failed to log request:" << m_writer.errorString();
+        return;
+    }
+
+    const qint64 previousSize = m_size;
+    m_size += RECORD_HEADER_SIZE + payload.size();
+    ++m_count;
+
+    // NOTE: There is no limit on the backlog; a large one is only worth a warning.
+    if (previousSize < BACKLOG_WARNING_SIZE && m_size >= BACKLOG_WARNING_SIZE)
+        qCWarning(requestLogger) << "Backlog is larger than" << BACKLOG_WARNING_SIZE << "bytes.";
+
+    scheduleSync();
+}
+
+void RequestLogger::pop(int count)
+{
+    count = qMin(count, m_count);
+    if (count <= 0)
+        return;
+
+    // NOTE: Records were checked when they were logged or scanned on open, so only their length is read here.
+    for (int i = 0; i < count; ++i) {
+        qint64 length = 0;
+        if (!readRecordLengthAt(m_cursor, length)) {
+            qCCritical(requestLogger) << "Failed to read request at" << m_cursor.offset << "in" << m_reader.fileName();
+            break;
+        }
+
+        m_cursor.offset += RECORD_HEADER_SIZE + length;
+        --m_count;
+        m_readAheadCount = qMax(0, m_readAheadCount - 1);
+        advanceCursor();
+    }
+
+    // NOTE: Once the backlog has been replayed, logging starts over in a new segment
+    // so that the requests already sent do not stay on disk.
+    if (m_count == 0 && m_writer.size() > SEGMENT_HEADER_SIZE) {
+        const quint64 replayedSegment = m_segments.last();
+        openWriter(replayedSegment + 1);
+        m_cursor = Position{ replayedSegment + 1, SEGMENT_HEADER_SIZE };
+        writeCursor();
+        removeSegment(replayedSegment);
+    } else {
+        writeCursor();
+    }
+
+    if (m_readAheadCount == 0)
+        m_readAhead = m_cursor;
+
+    scheduleSync();
 }
 
 ServerRequest RequestLogger::nextRequest()
 {
-    if (!m_backupArray.isEmpty())
-        return ServerRequest::fromJson(QJsonDocument(m_backupArray.first().toObject()).toJson());
+    if (!hasNext())
+        return ServerRequest();
+
+    QByteArray payload;
+    if (!readRecordAt(m_cursor, payload)) {
+        qCCritical(requestLogger) << "Failed to read request at" << m_cursor.offset << "in" << m_reader.fileName();
+        return ServerRequest();
+    }
+
+    return ServerRequest::fromJson(payload);
+}
+
+ServerRequest RequestLogger::readAhead()
+{
+    if (unreadCount() <= 0)
+        return ServerRequest();
+
+    while (m_readAhead.offset >= QFileInfo(segmentPath(m_readAhead.segment)).size()
+           && m_readAhead.segment != m_segments.last())
+        m_readAhead = Position{ m_segments.at(m_segments.indexOf(m_readAhead.segment) + 1), SEGMENT_HEADER_SIZE };
+
+    QByteArray payload;
+    if (!readRecordAt(m_readAhead, payload)) {
+        qCCritical(requestLogger) << "Failed to read request at" << m_readAhead.offset << "in" << m_reader.fileName();
+        return ServerRequest();
+    }
+
+    m_readAhead.offset += RECORD_HEADER_SIZE + payload.size();
+    ++m_readAheadCount;
+    return ServerRequest::fromJson(payload);
+}
+
+int RequestLogger::unreadCount() const
+{
+    return m_count - m_readAheadCount;
+}
+
+void RequestLogger::rewind()
+{
+    m_readAhead = m_cursor;
+    m_readAheadCount = 0;
+}
+
+void RequestLogger::sync()
+{
+    m_syncTimer->stop();
+    if (!m_syncPending)
+        return;
+
+    m_syncPending = false;
+    if (!syncFile(m_writer) || !syncFile(m_cursorFile))
+        qCWarning(requestLogger) << "Failed to sync request log in" << m_directory;
+}
+
+void RequestLogger::open()
+{
+    if (!QDir().mkpath(m_directory)) {
+        qCCritical(requestLogger) << "Failed to create request log directory:" << m_directory;
+        return;
+    }
+
+    const QStringList &fileNames = QDir(m_directory).entryList({ QStringLiteral("segment_*.rrj") },
+                                                              QDir::Files,
+                                                              QDir::Name);
+    for (const QString &fileName : fileNames) {
+        bool ok = false;
+        const quint64 segment = fileName.mid(8, 16).toULongLong(&ok);
+        if (ok)
+            m_segments.append(segment);
+    }
+
+    m_cursorFile.setFileName(QStringLiteral("%1/%2").arg(m_directory, CURSOR_FILE_NAME));
+    if (!m_cursorFile.open(QIODevice::ReadWrite))
+        qCCritical(requestLogger) << "Failed to open request log cursor:" << m_cursorFile.errorString();
+
+    m_cursor = readCursor();
+
+    // NOTE: Segments before the cursor were replayed, but the application stopped before they were removed.
+    while (!m_segments.isEmpty() && m_segments.first() < m_cursor.segment)
+        removeSegment(m_segments.first());
+
+    if (m_segments.isEmpty() || m_segments.first() != m_cursor.segment)
+        m_cursor = Position{ m_segments.isEmpty() ? 1 : m_segments.first(), SEGMENT_HEADER_SIZE };
 
-    return ServerRequest();
+    for (const quint64 segment : QList<quint64>(m_segments)) {
+        const qint64 offset = segment == m_cursor.segment ? m_cursor.offset : SEGMENT_HEADER_SIZE;
+        const qint64 recordCount = scanSegment(segment, offset, segment == m_segments.last());
+        if (recordCount < 0) {
+            removeSegment(segment);
+            continue;
+        }
+
+        m_count += static_cast<int>(recordCount);
+        m_size += QFileInfo(segmentPath(segment)).size();
+    }
+
+    if (m_segments.isEmpty() || m_segments.first() != m_cursor.segment)
+        m_cursor = Position{ m_segments.isEmpty() ? m_cursor.segment : m_segments.first(), SEGMENT_HEADER_SIZE };
+
+    openWriter(m_segments.isEmpty() ? m_cursor.segment : m_segments.last());
+    m_cursor.offset = qMin(m_cursor.offset, QFileInfo(segmentPath(m_cursor.segment)).size());
+    advanceCursor();
+    writeCursor();
+    m_readAhead = m_cursor;
+
+    if (m_count > 0)
+        qCInfo(requestLogger) << m_count << "logged requests in" << m_segments.count() << "segments.";
 }
 
-void RequestLogger::pop()
+RequestLogger::Position RequestLogger::readCursor()
 {
-    if (!m_backupArray.isEmpty())
-        m_backupArray.removeFirst();
+    const Position start{ m_segments.isEmpty() ? 1 : m_segments.first(), SEGMENT_HEADER_SIZE };
+    if (!m_cursorFile.seek(0))
+        return start;
+
+    const QByteArray &cursor = m_cursorFile.read(CURSOR_SIZE);
+    if (cursor.size() != CURSOR_SIZE)
+        return start;
+
+    const uchar *data = reinterpret_cast<const uchar *>(cursor.constData());
+    if (qFromLittleEndian<quint32>(data + 16) != checksum(cursor.left(16))) {
+        // NOTE: Replaying from the oldest segment sends some requests twice, rather than losing any.
+        qCWarning(requestLogger) << "Request log cursor is corrupt, replaying from the oldest segment.";
+        return start;
+    }
 
-    writeBackupArray();
+    return Position{ qFromLittleEndian<quint64>(data), qFromLittleEndian<qint64>(data + 8) };
 }
 
-bool RequestLogger::isFull() const
+void RequestLogger::writeCursor()
 {
-    return QJsonDocument(m_backupArray).toJson().size() >= MAX_BACKUP_SIZE;
+    uchar cursor[CURSOR_SIZE];
+    qToLittleEndian<quint64>(m_cursor.segment, cursor);
+    qToLittleEndian<qint64>(m_cursor.offset, cursor + 8);
+    qToLittleEndian<quint32>(checksum(QByteArray::fromRawData(reinterpret_cast<const char *>(cursor), 16)),
+                             cursor + 16);
+
+    if (!m_cursorFile.seek(0)
+            || m_cursorFile.write(reinterpret_cast<const char *>(cursor), CURSOR_SIZE) != CURSOR_SIZE
+            || !m_cursorFile.flush())
+        qCCritical(requestLogger) << "Failed to write request log cursor:" << m_cursorFile.errorString();
 }
 
-bool RequestLogger::dumpRequired() const
+void RequestLogger::advanceCursor()
 {
-    return m_settings.value("sql_dump_needed").toBool();
+    // NOTE: The cursor is moved past a segment before the segment is removed, so that
+    // a crash in between leaves a segment that is removed on the next start.
+    while (m_cursor.offset >= QFileInfo(segmentPath(m_cursor.segment)).size()
+           && m_segments.count() > 1 && m_cursor.segment == m_segments.first()) {
+        const quint64 replayedSegment = m_cursor.segment;
+        m_cursor = Position{ m_segments.at(1), SEGMENT_HEADER_SIZE };
+        writeCursor();
+        removeSegment(replayedSegment);
+    }
 }
 
-QJsonArray RequestLogger::readBackupArray() const
+qint64 RequestLogger::scanSegment(quint64 segment, qint64 offset, bool isLastSegment)
 {
-    if (!m_settings.value("sql_dump_needed").toBool())
-        return QJsonArray();
+    QFile file(segmentPath(segment));
+    if (!file.open(QIODevice::ReadWrite) || file.read(SEGMENT_HEADER_SIZE).left(4) != SEGMENT_MAGIC) {
+        // NOTE: An empty last segment was created just before the application stopped.
+        if (isLastSegment && file.size() < SEGMENT_HEADER_SIZE) {
+            file.resize(0);
+            return 0;
+        }
+
+        qCWarning(requestLogger) << "Discarding invalid request log segment:" << file.fileName();
+        return -1;
+    }
+
+    if (offset > file.size() || !file.seek(qMax(offset, SEGMENT_HEADER_SIZE)))
+        return 0;
 
-    QFile file(BACKUP_FILEPATH);
-    file.open(QFile::ReadOnly);
+    qint64 recordCount = 0;
+    qint64 position = file.pos();
+    QByteArray payload;
+    while (position < file.size()) {
+        if (!readRecord(file, payload)) {
+            // NOTE: A record cut short by a crash (or damaged on disk) and everything after it is dropped.
+            qCWarning(requestLogger) << "Discarding" << file.size() - position << "bytes of damaged records in"
+                                     << file.fileName();
+            file.resize(position);
+            break;
+        }
 
-    if (isFull()) {
-        qCWarning(requestLogger) << "Backup size is larger than" << MAX_BACKUP_SIZE << "MB.";
+        ++recordCount;
+        position = file.pos();
     }
 
-    return QJsonDocument::fromJson(file.readAll()).array();
+    return recordCount;
 }
 
-void RequestLogger::writeBackupArray()
+void RequestLogger::openWriter(quint64 segment)
 {
-    QFile file(BACKUP_FILEPATH);
-    file.open(QFile::WriteOnly);
+    m_writer.close();
+    m_writer.setFileName(segmentPath(segment));
+    if (!m_writer.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCCritical(requestLogger) << "Failed to open request log segment:" << m_writer.errorString();
+        return;
+    }
+
+    if (m_writer.size() == 0) {
+        uchar header[SEGMENT_HEADER_SIZE];
+        memcpy(header, SEGMENT_MAGIC.constData(), 4);
+        qToLittleEndian<quint32>(SEGMENT_VERSION, header + 4);
+        m_writer.write(reinterpret_cast<const char *>(header), SEGMENT_HEADER_SIZE);
+        m_writer.flush();
+        m_size += SEGMENT_HEADER_SIZE;
+    }
 
-    if (file.size() > MAX_BACKUP_SIZE) {
-        qWarning(requestLogger) << "Backup size is larger than" << MAX_BACKUP_SIZE << "MB.";
-        m_settings.setValue("sql_dump_needed", true);
+    if (!m_segments.contains(segment))
+        m_segments.append(segment);
+}
+
+void RequestLogger::removeSegment(quint64 segment)
+{
+    const QString &filePath = segmentPath(segment);
+    if (m_reader.fileName() == filePath)
+        m_reader.close();
+
+    const qint64 segmentSize = QFileInfo(filePath).size();
+    if (!QFile::remove(filePath)) {
+        qCWarning(requestLogger) << "Failed to remove request log segment:" << filePath;
         return;
     }
 
-    file.write(QJsonDocument(m_backupArray).toJson());
+    if (m_segments.removeOne(segment))
+        m_size -= qMin(m_size, segmentSize);
+}
+
+bool RequestLogger::readRecord(QFile &file, QByteArray &payload) const
+{
+    uchar header[RECORD_HEADER_SIZE];
+    if (file.read(reinterpret_cast<char *>(header), RECORD_HEADER_SIZE) != RECORD_HEADER_SIZE)
+        return false;
+
+    const qint64 length = qFromLittleEndian<quint32>(header);
+    if (length > MAX_RECORD_SIZE || file.pos() + length > file.size())
+        return false;
+
+    payload = file.read(length);
+    return payload.size() == length && checksum(payload) == qFromLittleEndian<quint32>(header + 4);
+}
+
+bool RequestLogger::readRecordAt(const Position &position, QByteArray &payload)
+{
+    return openReader(position.segment) && m_reader.seek(position.offset) && readRecord(m_reader, payload);
+}
+
+bool RequestLogger::readRecordLengthAt(const Position &position, qint64 &length)
+{
+    uchar header[RECORD_HEADER_SIZE];
+    if (!openReader(position.segment)
+            || !m_reader.seek(position.offset)
+            || m_reader.read(reinterpret_cast<char *>(header), RECORD_HEADER_SIZE) != RECORD_HEADER_SIZE)
+        return false;
+
+    length = qFromLittleEndian<quint32>(header);
+    return length <= MAX_RECORD_SIZE && m_reader.pos() + length <= m_reader.size();
+}
+
+bool RequestLogger::openReader(quint64 segment)
+{
+    if (m_reader.isOpen() && m_reader.fileName() == segmentPath(segment))
+        return true;
+
+    m_reader.close();
+    m_reader.setFileName(segmentPath(segment));
+    return m_reader.open(QIODevice::ReadOnly);
+}
+
+void RequestLogger::scheduleSync()
+{
+    m_syncPending = true;
+    if (!m_syncTimer->isActive())
+        m_syncTimer->start();
+}
+
+void RequestLogger::migrateLegacyBackup(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.exists())
+        return;
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(requestLogger) << "Failed to open legacy backup:" << file.errorString();
+        return;
+    }
+
+    const QJsonArray &backupArray = QJsonDocument::fromJson(file.readAll()).array();
+    for (const QJsonValue &request : backupArray)
+        push(ServerRequest::fromJson(QJsonDocument(request.toObject()).toJson()));
+
+    sync();
+    file.close();
+    file.remove();
+    QSettings().remove("sql_dump_needed");
+
+    qCInfo(requestLogger) << "Moved" << backupArray.count() << "requests from" << filePath << "to the request log.";
+}
+
+QString RequestLogger::segmentPath(quint64 segment) const
+{
+    return QStringLiteral("%1/segment_%2.rrj").arg(m_directory).arg(segment, 16, 10, QLatin1Char('0'));
+}
+
+quint32 RequestLogger::checksum(const QByteArray &data)
+{
+    // CRC-32 (IEEE 802.3)
+    static const auto table = []() {
+        std::array<quint32, 256> table{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    for (const char byte : data)
+        crc = table[(crc ^ static_cast<uchar>(byte)) & 0xFF] ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFFu;
 }
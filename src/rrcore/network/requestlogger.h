@@ -3,29 +3,89 @@
 
 #include <QObject>
 #include <QByteArray>
-#include <QJsonArray>
-#include <QSettings>
+#include <QFile>
+#include <QList>
 #include <QLoggingCategory>
 #include "serverrequest.h"
 
+class QTimer;
+
+// Journal of requests that could not be sent to the server, replayed in order
+// once the server is reachable again.
+// Requests are appended to segment files as length-prefixed, checksummed
+// records, and a small cursor file records how far the journal has been
+// replayed, so both push() and pop() cost the same however long the backlog
+// grows. Each request is given an idempotency key when it is logged, so that
+// the server can ignore a request that is replayed twice. Segments that have
+// been fully replayed are deleted. Writes reach the OS immediately but are
+// only synced to disk once per SYNC_INTERVAL, so a burst of requests shares a
+// single fsync.
 class RequestLogger : public QObject
 {
+    Q_OBJECT
 public:
+    static const qint64 DEFAULT_SEGMENT_SIZE = 1024 * 1024;
+    static const int SYNC_INTERVAL = 50; // milliseconds
+
     explicit RequestLogger(QObject *parent = nullptr);
+    explicit RequestLogger(const QString &directory,
+                           qint64 segmentSize = DEFAULT_SEGMENT_SIZE,
+                           QObject *parent = nullptr);
+    ~RequestLogger() override;
 
-    bool dumpRequired() const;
-    bool isFull() const;
+    QString directory() const;
     bool hasNext() const;
+    int count() const;
+    int segmentCount() const;
+    qint64 size() const;
 
     void push(const ServerRequest &request);
-    void pop();
+    void pop(int count = 1);
     ServerRequest nextRequest();
+    void sync();
+
+    // Hands out the requests after the ones already handed out, so that several
+    // batches can be sent before the first is acknowledged with pop().
+    // rewind() hands them out again from the oldest request.
+    ServerRequest readAhead();
+    int unreadCount() const;
+    void rewind();
 private:
-    QJsonArray m_backupArray;
-    QSettings m_settings;
+    struct Position {
+        quint64 segment;
+        qint64 offset;
+    };
+
+    QString m_directory;
+    qint64 m_segmentSize;
+    QList<quint64> m_segments;
+    QFile m_writer;
+    QFile m_reader;
+    QFile m_cursorFile;
+    Position m_cursor;
+    Position m_readAhead;
+    int m_count;
+    int m_readAheadCount;
+    qint64 m_size;
+    bool m_syncPending;
+    QTimer *m_syncTimer;
+
+    void open();
+    Position readCursor();
+    void writeCursor();
+    void advanceCursor();
+    qint64 scanSegment(quint64 segment, qint64 offset, bool isLastSegment);
+    void openWriter(quint64 segment);
+    void removeSegment(quint64 segment);
+    bool readRecord(QFile &file, QByteArray &payload) const;
+    bool readRecordAt(const Position &position, QByteArray &payload);
+    bool readRecordLengthAt(const Position &position, qint64 &length);
+    bool openReader(quint64 segment);
+    void scheduleSync();
+    void migrateLegacyBackup(const QString &filePath);
+    QString segmentPath(quint64 segment) const;
 
-    QJsonArray readBackupArray() const;
-    void writeBackupArray();
+    static quint32 checksum(const QByteArray &data);
 };
 
 Q_DECLARE_LOGGING_CATEGORY(requestLogger);
@@ -4,6 +4,9 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QCborValue>
+#include <QCborMap>
+#include <QUuid>
 
 ServerRequest::ServerRequest(QObject *receiver) :
     m_receiver(receiver)
@@ -12,6 +15,7 @@ ServerRequest::ServerRequest(QObject *receiver) :
 }
 
 ServerRequest::ServerRequest(const QueryRequest &queryRequest) :
+    m_receiver(nullptr),
     m_queryRequest(queryRequest)
 {
 
@@ -24,6 +28,7 @@ ServerRequest::ServerRequest(const ServerRequest &other) :
     setData(other.data());
     setReceiver(other.receiver());
     m_queryRequest = other.queryRequest();
+    m_idempotencyKey = other.idempotencyKey();
 }
 
 ServerRequest &ServerRequest::operator=(const ServerRequest &other)
@@ -32,6 +37,7 @@ ServerRequest &ServerRequest::operator=(const ServerRequest &other)
     setData(other.data());
     setReceiver(other.receiver());
     m_queryRequest = other.queryRequest();
+    m_idempotencyKey = other.idempotencyKey();
 
     return *this;
 }
@@ -78,34 +84,69 @@ QueryRequest ServerRequest::queryRequest() const
     return m_queryRequest;
 }
 
-ServerRequest ServerRequest::fromJson(const QByteArray &json)
+QString ServerRequest::idempotencyKey() const
+{
+    return m_idempotencyKey;
+}
+
+void ServerRequest::setIdempotencyKey(const QString &idempotencyKey)
+{
+    m_idempotencyKey = idempotencyKey;
+}
+
+QString ServerRequest::createIdempotencyKey()
+{
+    return QUuid::createUuid().toString(QUuid::WithoutBraces);
+}
+
+ServerRequest ServerRequest::fromVariantMap(const QVariantMap &map)
 {
     ServerRequest request;
-    const QJsonObject serverRequestObject{ QJsonDocument::fromJson(json).object() };
-    if (serverRequestObject.contains("action")) {
-        request.setAction(serverRequestObject.value("action").toString());
-        request.setData(serverRequestObject.value("data").toObject().toVariantMap());
-    } else if (serverRequestObject.contains("command")) {
-        request.setQueryRequest(QueryRequest::fromJson(QJsonDocument(serverRequestObject).toJson()));
+    if (map.contains("action")) {
+        request.setAction(map.value("action").toString());
+        request.setData(map.value("data").toMap());
+    } else if (map.contains("command")) {
+        request.setQueryRequest(QueryRequest::fromVariantMap(map));
     }
 
+    request.setIdempotencyKey(map.value("idempotency_key").toString());
+
     return request;
 }
 
-QByteArray ServerRequest::toJson() const
+ServerRequest ServerRequest::fromJson(const QByteArray &json)
 {
-    QJsonObject serverRequestObject;
-    QJsonObject queryRequestObject;
+    return fromVariantMap(QJsonDocument::fromJson(json).object().toVariantMap());
+}
 
-    if (!m_queryRequest.command().isEmpty()) {
-        queryRequestObject = QJsonDocument::fromJson(m_queryRequest.toJson()).object();
-        serverRequestObject = queryRequestObject;
-    }
+ServerRequest ServerRequest::fromCbor(const QByteArray &cbor)
+{
+    return fromVariantMap(QCborValue::fromCbor(cbor).toMap().toVariantMap());
+}
+
+QVariantMap ServerRequest::toVariantMap() const
+{
+    QVariantMap serverRequestMap;
+
+    if (!m_queryRequest.command().isEmpty())
+        serverRequestMap = m_queryRequest.toVariantMap();
 
     if (!m_action.isEmpty())
-        serverRequestObject.insert("action", m_action);
+        serverRequestMap.insert("action", m_action);
     if (!m_data.isEmpty())
-        serverRequestObject.insert("data", QJsonObject::fromVariantMap(m_data));
+        serverRequestMap.insert("data", m_data);
+    if (!m_idempotencyKey.isEmpty())
+        serverRequestMap.insert("idempotency_key", m_idempotencyKey);
 
-    return QJsonDocument(serverRequestObject).toJson();
+    return serverRequestMap;
+}
+
+QByteArray ServerRequest::toJson() const
+{
+    return QJsonDocument(QJsonObject::fromVariantMap(toVariantMap())).toJson(QJsonDocument::Compact);
+}
+
+QByteArray ServerRequest::toCbor() const
+{
+    return QCborValue::fromVariant(toVariantMap()).toCbor();
 }
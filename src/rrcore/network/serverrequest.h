@@ -26,8 +26,16 @@ public:
     void setQueryRequest(const QueryRequest &queryRequest);
     QueryRequest queryRequest() const;
 
+    QString idempotencyKey() const;
+    void setIdempotencyKey(const QString &idempotencyKey);
+    static QString createIdempotencyKey();
+
+    static ServerRequest fromVariantMap(const QVariantMap &map);
     static ServerRequest fromJson(const QByteArray &json);
+    static ServerRequest fromCbor(const QByteArray &cbor);
+    QVariantMap toVariantMap() const;
     QByteArray toJson() const;
+    QByteArray toCbor() const;
 
     friend QDebug operator<<(QDebug debug, const ServerRequest &request)
     {
@@ -50,6 +58,7 @@ private:
     QueryRequest m_queryRequest;
     QString m_action;
     QVariantMap m_data;
+    QString m_idempotencyKey;
 };
 
 #endif // SERVERREQUEST_H
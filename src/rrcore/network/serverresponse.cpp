@@ -2,6 +2,8 @@
 #include "serverrequest.h"
 #include <QJsonObject>
 #include <QJsonDocument>
+#include <QCborValue>
+#include <QCborMap>
 #include "database/queryresult.h"
 #include "database/databaseerror.h"
 #include "network/networkerror.h"
@@ -165,37 +167,36 @@ void ServerResponse::setQueryResult(const QueryResult &queryResult)
     m_queryResult = queryResult;
 }
 
-ServerResponse ServerResponse::fromJson(const QByteArray &json, const ServerRequest &request)
+ServerResponse ServerResponse::fromVariantMap(const QVariantMap &map, const ServerRequest &request)
 {
+    const QVariantMap &error = map.value("error").toMap();
     ServerResponse response;
-    QJsonObject jsonObject{ QJsonDocument::fromJson(json).object() };
 
-    response.setSuccessful(jsonObject.value("successful").toBool());
+    response.setSuccessful(map.value("successful").toBool());
     response.setRequest(request);
-    response.setData(jsonObject.value("data").toObject().toVariantMap());
-    response.setServerErrorCode(jsonObject.value("error").toObject().value("code").toString());
-    response.setErrorCode(serverErrorCodeAsInteger(jsonObject.value("error").toObject().value("code").toString()));
-    response.setErrorMessage(jsonObject.value("error").toObject().value("message").toString());
+    response.setData(map.value("data").toMap());
+    response.setServerErrorCode(error.value("code").toString());
+    response.setErrorCode(serverErrorCodeAsInteger(error.value("code").toString()));
+    response.setErrorMessage(error.value("message").toString());
 
     return response;
 }
 
-ServerResponse ServerResponse::fromJson(const QByteArray &json, const QueryRequest &request)
+ServerResponse ServerResponse::fromVariantMap(const QVariantMap &map, const QueryRequest &request)
 {
+    const QVariantMap &error = map.value("error").toMap();
     ServerResponse response;
-    QJsonObject jsonObject{ QJsonDocument::fromJson(json).object() };
-
-    response.setSuccessful(jsonObject.value("successful").toBool());
-    response.setData(jsonObject.value("data").toObject().toVariantMap());
-    response.setServerErrorCode(jsonObject.value("error").toObject().value("code").toString());
-    response.setErrorCode(queryErrorCodeAsInteger(jsonObject.value("error").toObject().value("code").toString()));
-    response.setErrorMessage(jsonObject.value("error").toObject().value("message").toString());
-
-    const QJsonObject queryResultObject {
-        { "successful", jsonObject.value("successful") },
-        { "outcome", jsonObject.value("outcome") }
-    };
-    QueryResult result(QueryResult::fromJson(QJsonDocument(queryResultObject).toJson(), request));
+
+    response.setSuccessful(map.value("successful").toBool());
+    response.setData(map.value("data").toMap());
+    response.setServerErrorCode(error.value("code").toString());
+    response.setErrorCode(queryErrorCodeAsInteger(error.value("code").toString()));
+    response.setErrorMessage(error.value("message").toString());
+
+    QueryResult result(QueryResult::fromVariantMap(QVariantMap {
+                                                       { "successful", map.value("successful") },
+                                                       { "outcome", map.value("outcome") }
+                                                   }, request));
     result.setErrorCode(response.errorCode());
     result.setErrorMessage(response.errorMessage());
     response.setQueryResult(result);
@@ -203,6 +204,26 @@ ServerResponse ServerResponse::fromJson(const QByteArray &json, const QueryReque
     return response;
 }
 
+ServerResponse ServerResponse::fromJson(const QByteArray &json, const ServerRequest &request)
+{
+    return fromVariantMap(QJsonDocument::fromJson(json).object().toVariantMap(), request);
+}
+
+ServerResponse ServerResponse::fromJson(const QByteArray &json, const QueryRequest &request)
+{
+    return fromVariantMap(QJsonDocument::fromJson(json).object().toVariantMap(), request);
+}
+
+ServerResponse ServerResponse::fromCbor(const QByteArray &cbor, const ServerRequest &request)
+{
+    return fromVariantMap(QCborValue::fromCbor(cbor).toMap().toVariantMap(), request);
+}
+
+ServerResponse ServerResponse::fromCbor(const QByteArray &cbor, const QueryRequest &request)
+{
+    return fromVariantMap(QCborValue::fromCbor(cbor).toMap().toVariantMap(), request);
+}
+
 int ServerResponse::serverErrorCodeAsInteger(const QString &errorCode)
 {
     if (errorCode.trimmed().isEmpty())
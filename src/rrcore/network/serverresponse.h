@@ -66,8 +66,12 @@ public:
     QueryResult queryResult() const;
     void setQueryResult(const QueryResult &queryResult);
 
+    static ServerResponse fromVariantMap(const QVariantMap &map, const ServerRequest &request = ServerRequest());
+    static ServerResponse fromVariantMap(const QVariantMap &map, const QueryRequest &request);
     static ServerResponse fromJson(const QByteArray &json, const ServerRequest &request = ServerRequest());
     static ServerResponse fromJson(const QByteArray &json, const QueryRequest &request);
+    static ServerResponse fromCbor(const QByteArray &cbor, const ServerRequest &request = ServerRequest());
+    static ServerResponse fromCbor(const QByteArray &cbor, const QueryRequest &request);
 private:
     ServerRequest m_request;
     QueryResult m_queryResult;
@@ -0,0 +1,57 @@
+#include "wireformat.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QCborValue>
+#include <QCborMap>
+#include <QtEndian>
+
+const QByteArray JSON_CONTENT_TYPE("application/json");
+const QByteArray CBOR_CONTENT_TYPE("application/cbor");
+
+QByteArray WireFormat::contentType(Encoding encoding)
+{
+    return encoding == Encoding::Cbor ? CBOR_CONTENT_TYPE : JSON_CONTENT_TYPE;
+}
+
+WireFormat::Encoding WireFormat::encodingFor(const QByteArray &contentType)
+{
+    // NOTE: Parameters such as "; charset=utf-8" are ignored.
+    const QByteArray &mimeType = contentType.split(';').first().trimmed().toLower();
+    return mimeType == CBOR_CONTENT_TYPE ? Encoding::Cbor : Encoding::Json;
+}
+
+QByteArray WireFormat::acceptHeader()
+{
+    return CBOR_CONTENT_TYPE + ", " + JSON_CONTENT_TYPE + ";q=0.9";
+}
+
+QByteArray WireFormat::encode(const QVariantMap &map, Encoding encoding)
+{
+    if (encoding == Encoding::Cbor)
+        return QCborValue::fromVariant(map).toCbor();
+
+    return QJsonDocument(QJsonObject::fromVariantMap(map)).toJson(QJsonDocument::Compact);
+}
+
+QVariantMap WireFormat::decode(const QByteArray &body, Encoding encoding)
+{
+    if (encoding == Encoding::Cbor)
+        return QCborValue::fromCbor(body).toMap().toVariantMap();
+
+    return QJsonDocument::fromJson(body).object().toVariantMap();
+}
+
+QByteArray WireFormat::compress(const QByteArray &data)
+{
+    // NOTE: qCompress() puts the uncompressed size in front of the zlib stream.
+    return qCompress(data).mid(4);
+}
+
+QByteArray WireFormat::uncompress(const QByteArray &data)
+{
+    // NOTE: qUncompress() only uses the size as a first guess and grows its buffer as needed.
+    QByteArray sizedData(4, '\0');
+    qToBigEndian<quint32>(static_cast<quint32>(data.size() * 4), sizedData.data());
+    return qUncompress(sizedData + data);
+}
@@ -0,0 +1,34 @@
+#ifndef WIREFORMAT_H
+#define WIREFORMAT_H
+
+#include <QByteArray>
+#include <QVariantMap>
+
+// Encoding of request and response bodies exchanged with the server.
+// Every request advertises CBOR in its Accept header; the server answers in
+// CBOR if it can, and in JSON otherwise. Request bodies are only sent as
+// CBOR (deflated when large enough to be worth it) once the server has
+// answered in CBOR at least once, so an older server keeps getting JSON.
+class WireFormat
+{
+public:
+    enum class Encoding {
+        Json,
+        Cbor
+    };
+
+    static const int MIN_COMPRESSED_SIZE = 1024; // bytes
+
+    static QByteArray contentType(Encoding encoding);
+    static Encoding encodingFor(const QByteArray &contentType);
+    static QByteArray acceptHeader();
+
+    static QByteArray encode(const QVariantMap &map, Encoding encoding);
+    static QVariantMap decode(const QByteArray &body, Encoding encoding);
+
+    // Produces and reads a zlib stream, which is what HTTP calls "deflate".
+    static QByteArray compress(const QByteArray &data);
+    static QByteArray uncompress(const QByteArray &data);
+};
+
+#endif // WIREFORMAT_H
@@ -19,8 +19,10 @@ AbstractPusher::AbstractPusher(DatabaseThread &thread, QObject *parent) :
 {
     connect(this, &AbstractPusher::execute, &thread, &DatabaseThread::execute);
 
-    connect(&thread, &DatabaseThread::resultReady, this, &AbstractPusher::processResult);
-    connect(&thread, &DatabaseThread::resultReady, this, &AbstractPusher::saveRequest);
+    thread.addReceiver(this, [this](const QueryResult &result) {
+        processResult(result);
+        saveRequest(result);
+    });
 }
 
 bool AbstractPusher::isBusy() const
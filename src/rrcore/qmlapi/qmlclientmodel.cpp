@@ -49,7 +49,17 @@ QHash<int, QByteArray> QMLClientModel::roleNames() const
 void QMLClientModel::tryQuery()
 {
     setBusy(true);
-    emit execute(new ClientQuery::ViewClients(this));
+    emit execute(new ClientQuery::ViewClients(PageCursor(), this));
+}
+
+void QMLClientModel::tryFetchMore()
+{
+    if (m_records.isEmpty())
+        return;
+
+    const QVariantMap &lastRecord = m_records.last().toMap();
+    queryPage(PageCursor(lastRecord.value("created").toDateTime(),
+                         lastRecord.value("client_id").toInt()));
 }
 
 void QMLClientModel::processResult(const QueryResult result)
@@ -60,9 +70,18 @@ void QMLClientModel::processResult(const QueryResult result)
     setBusy(false);
 
     if (result.isSuccessful()) {
-        beginResetModel();
-        m_records = result.outcome().toMap().value("clients").toList();
-        endResetModel();
+        const QVariantList &clients = result.outcome().toMap().value("clients").toList();
+        if (PageCursor{ result.request().params() }.isFirstPage()) {
+            beginResetModel();
+            m_records = clients;
+            endResetModel();
+        } else if (!clients.isEmpty()) {
+            beginInsertRows(QModelIndex(), m_records.count(), m_records.count() + clients.count() - 1);
+            m_records.append(clients);
+            endInsertRows();
+        }
+
+        setHasMoreRecords(result.outcome().toMap().value("has_more").toBool());
 
         emit success(ViewClientsSuccess);
     } else {
@@ -75,11 +94,20 @@ void QMLClientModel::filter()
     if (filterColumn() == -1)
         return;
 
+    queryPage(PageCursor());
+}
+
+void QMLClientModel::queryPage(const PageCursor &cursor)
+{
     setBusy(true);
-    emit execute(new ClientQuery::ViewClients(
-                     filterText(),
-                     columnName(),
-                     this));
+    if (filterColumn() == -1)
+        emit execute(new ClientQuery::ViewClients(cursor, this));
+    else
+        emit execute(new ClientQuery::ViewClients(
+                         filterText(),
+                         columnName(),
+                         cursor,
+                         this));
 }
 
 QString QMLClientModel::columnName() const
@@ -2,6 +2,7 @@
 #define QMLCLIENTMODEL_H
 
 #include "models/abstractvisuallistmodel.h"
+#include "utility/pageutils.h"
 
 class QMLClientModel : public AbstractVisualListModel
 {
@@ -37,10 +38,12 @@ protected:
     void tryQuery() override;
     void processResult(const QueryResult result) override;
     void filter() override final;
+    void tryFetchMore() override;
 private:
     QVariantList m_records;
 
     QString columnName() const;
+    void queryPage(const PageCursor &cursor);
 };
 
 #endif // QMLCLIENTMODEL_H
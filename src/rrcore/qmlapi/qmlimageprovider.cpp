@@ -0,0 +1,47 @@
+#include "qmlimageprovider.h"
+#include "database/imagecache.h"
+#include "database/imagenormalizer.h"
+
+#include <QImage>
+
+QMLImageProvider::QMLImageProvider() :
+    QMLImageProvider(ImageCache::instance())
+{
+
+}
+
+QMLImageProvider::QMLImageProvider(ImageCache &imageCache) :
+    QQuickImageProvider(QQuickImageProvider::Image, QQmlImageProviderBase::ForceAsynchronousImageLoading),
+    m_imageCache(imageCache)
+{
+
+}
+
+QImage QMLImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    // NOTE: List views ask for small images; they never need to decode the full one.
+    const QString &hash = ImageCache::hashFromId(id);
+    const QString &key = ImageCache::keyFromId(id);
+    const bool thumbnailRequested = requestedSize.width() > 0 && requestedSize.height() > 0
+            && requestedSize.width() <= ImageNormalizer::THUMBNAIL_SIZE
+            && requestedSize.height() <= ImageNormalizer::THUMBNAIL_SIZE;
+
+    QImage image;
+    image.loadFromData(thumbnailRequested ? m_imageCache.thumbnailData(hash, key)
+                                         : m_imageCache.imageData(hash, key));
+
+    if (size)
+        *size = image.size();
+
+    if (image.isNull())
+        return image;
+
+    if (requestedSize.width() > 0 && requestedSize.height() > 0)
+        return image.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    else if (requestedSize.width() > 0)
+        return image.scaledToWidth(requestedSize.width(), Qt::SmoothTransformation);
+    else if (requestedSize.height() > 0)
+        return image.scaledToHeight(requestedSize.height(), Qt::SmoothTransformation);
+
+    return image;
+}
@@ -0,0 +1,21 @@
+#ifndef QMLIMAGEPROVIDER_H
+#define QMLIMAGEPROVIDER_H
+
+#include <QQuickImageProvider>
+
+class ImageCache;
+
+// Serves "image://rrcore/<key>/<hash>" URLs from the image cache, which reads
+// images it does not hold from the database.
+class QMLImageProvider : public QQuickImageProvider
+{
+public:
+    explicit QMLImageProvider();
+    explicit QMLImageProvider(ImageCache &imageCache);
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+private:
+    ImageCache &m_imageCache;
+};
+
+#endif // QMLIMAGEPROVIDER_H
@@ -0,0 +1,85 @@
+#include "qmlindexadvicemodel.h"
+#include "database/databasethread.h"
+#include "queryexecutors/dashboard.h"
+
+QMLIndexAdviceModel::QMLIndexAdviceModel(QObject *parent) :
+    QMLIndexAdviceModel(DatabaseThread::instance(), parent)
+{}
+
+QMLIndexAdviceModel::QMLIndexAdviceModel(DatabaseThread &thread, QObject *parent) :
+    AbstractVisualListModel(thread, parent)
+{
+
+}
+
+int QMLIndexAdviceModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return m_records.count();
+}
+
+QVariant QMLIndexAdviceModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    const QVariantMap &record = m_records.at(index.row()).toMap();
+    switch (role) {
+    case ProcedureRole:
+        return record.value("procedure").toString();
+    case StatementRole:
+        return record.value("statement").toString();
+    case TableRole:
+        return record.value("table").toString();
+    case TypeRole:
+        return record.value("type").toString();
+    case PossibleKeysRole:
+        return record.value("possible_keys").toString();
+    case RowsRole:
+        return record.value("rows").toLongLong();
+    case FindingRole:
+        return record.value("finding").toString();
+    case ErrorRole:
+        return record.value("error").toString();
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> QMLIndexAdviceModel::roleNames() const
+{
+    return {
+        { ProcedureRole, "procedure" },
+        { StatementRole, "statement" },
+        { TableRole, "table" },
+        { TypeRole, "type" },
+        { PossibleKeysRole, "possible_keys" },
+        { RowsRole, "rows" },
+        { FindingRole, "finding" },
+        { ErrorRole, "error" }
+    };
+}
+
+void QMLIndexAdviceModel::tryQuery()
+{
+    setBusy(true);
+    emit execute(new DashboardQuery::ViewIndexAdvice(this));
+}
+
+void QMLIndexAdviceModel::processResult(const QueryResult result)
+{
+    if (this != result.request().receiver())
+        return;
+
+    setBusy(false);
+    if (result.isSuccessful()) {
+        beginResetModel();
+        m_records = result.outcome().toMap().value("findings").toList();
+        endResetModel();
+        emit success();
+    } else {
+        emit error();
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef QMLINDEXADVICEMODEL_H
+#define QMLINDEXADVICEMODEL_H
+
+#include "models/abstractvisuallistmodel.h"
+
+class QMLIndexAdviceModel : public AbstractVisualListModel
+{
+    Q_OBJECT
+public:
+    enum Roles {
+        ProcedureRole = Qt::UserRole,
+        StatementRole,
+        TableRole,
+        TypeRole,
+        PossibleKeysRole,
+        RowsRole,
+        FindingRole,
+        ErrorRole
+    };
+
+    explicit QMLIndexAdviceModel(QObject *parent = nullptr);
+    explicit QMLIndexAdviceModel(DatabaseThread &thread, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+protected:
+    void tryQuery() override;
+    void processResult(const QueryResult result) override;
+private:
+    QVariantList m_records;
+};
+
+#endif // QMLINDEXADVICEMODEL_H
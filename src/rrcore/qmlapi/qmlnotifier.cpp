@@ -3,6 +3,9 @@
 #include <QProcess>
 #include <QLoggingCategory>
 #include "network/networkthread.h"
+#include "database/readreplica.h"
+#include "database/changesync.h"
+#include "singletons/startupprofiler.h"
 
 // Urgency (u) - Low, Normal, Critical
 // Expire-time (t) - Timeout in ms
@@ -19,8 +22,11 @@ const QString LOGO_FILE(":/images/rr_logo.png");
 QMLNotifier::QMLNotifier(QObject *parent) :
     QObject(parent)
 {
-    connect(&NetworkThread::instance(), &NetworkThread::responseReady,
-            this, &QMLNotifier::displayServerStatus);
+    // NOTE: Server status is only reported after the first frame, so the network thread is not started before it.
+    StartupProfiler::instance().runAfterFirstFrame(this, [this]() {
+        connect(&NetworkThread::instance(), &NetworkThread::responseReady,
+                this, &QMLNotifier::displayServerStatus);
+    });
 }
 
 void QMLNotifier::show(QMLNotifier::Category category, const QString &title, const QString &message,
@@ -91,6 +97,12 @@ void QMLNotifier::displayNotificationOnLinux(QMLNotifier::Category category, con
 
 void QMLNotifier::displayServerStatus(const ServerResponse response)
 {
+    // NOTE: Background replica pulls and change log syncs are not the user's business.
+    if (response.request().action() == ReadReplica::PULL_ACTION
+            || response.request().action() == ChangeSync::PUSH_ACTION
+            || response.request().action() == ChangeSync::PULL_ACTION)
+        return;
+
     if (response.isSuccessful())
         show(Category::Stock, "There was no error", "No error at all!");
     else
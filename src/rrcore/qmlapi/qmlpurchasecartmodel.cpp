@@ -4,6 +4,7 @@
 #include "database/queryrequest.h"
 #include "database/queryresult.h"
 #include "database/databasethread.h"
+#include "database/stockcatalog.h"
 #include "models/purchasepaymentmodel.h"
 #include "queryexecutors/purchase.h"
 #include "utility/purchaseutils.h"
@@ -16,7 +17,7 @@ const int CASH_PAYMENT_LIMIT = 1;
 const int CARD_PAYMENT_LIMIT = 2;
 
 QMLPurchaseCartModel::QMLPurchaseCartModel(QObject *parent) :
-    AbstractVisualListModel(DatabaseThread::instance(), parent)
+    QMLPurchaseCartModel(DatabaseThread::instance(), StockCatalog::instance(), parent)
 {}
 
 QMLPurchaseCartModel::QMLPurchaseCartModel(DatabaseThread &thread, QObject *parent) :
@@ -31,7 +32,9 @@ QMLPurchaseCartModel::QMLPurchaseCartModel(DatabaseThread &thread, QObject *pare
     m_balance(0.0),
     m_canAcceptCash(true),
     m_canAcceptCard(false), // Toggle to disable, genius
-    m_records(QVariantList())
+    m_records(QVariantList()),
+    m_paymentModel(nullptr),
+    m_catalog(nullptr)
 {
     m_paymentModel = new PurchasePaymentModel(this);
 
@@ -41,6 +44,13 @@ QMLPurchaseCartModel::QMLPurchaseCartModel(DatabaseThread &thread, QObject *pare
     connect(this, &QMLPurchaseCartModel::transactionIdChanged, this, &QMLPurchaseCartModel::tryQuery);
 }
 
+QMLPurchaseCartModel::QMLPurchaseCartModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent) :
+    QMLPurchaseCartModel(thread, parent)
+{
+    m_catalog = &catalog;
+    connect(m_catalog, &StockCatalog::changed, this, &QMLPurchaseCartModel::addPendingBarcodes);
+}
+
 int QMLPurchaseCartModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
@@ -479,9 +489,7 @@ void QMLPurchaseCartModel::addItem(const QVariantMap &itemInfo)
     const double retailPrice = itemInfo.value("retail_price").toDouble();
     const double unitPrice = itemInfo.value("unit_price", retailPrice).toDouble();
 
-    if (availableQuantity == 0.0)
-        return;
-
+    // NOTE: Items are bought to restock them, so the quantity in stock never limits a line.
     if (!containsItem(itemId)) {
         beginInsertRows(QModelIndex(), m_records.count(), m_records.count());
 
@@ -491,7 +499,7 @@ void QMLPurchaseCartModel::addItem(const QVariantMap &itemInfo)
         record.insert("item_id", itemId);
         record.insert("item", item);
         record.insert("available_quantity", availableQuantity);
-        record.insert("quantity", qMin(1.0, availableQuantity));
+        record.insert("quantity", 1.0);
         record.insert("unit_id", unitId);
         record.insert("unit", unit);
         record.insert("cost_price", costPrice);
@@ -507,7 +515,7 @@ void QMLPurchaseCartModel::addItem(const QVariantMap &itemInfo)
         const double oldQuantity = record.value("quantity").toDouble();
         const double newQuantity = oldQuantity + 1;
 
-        record.insert("quantity", qMin(newQuantity, availableQuantity));
+        record.insert("quantity", newQuantity);
         record.insert("cost", record.value("quantity").toDouble() * unitPrice);
         m_records.replace(row, record);
 
@@ -517,6 +525,20 @@ void QMLPurchaseCartModel::addItem(const QVariantMap &itemInfo)
     calculateTotal();
 }
 
+void QMLPurchaseCartModel::addItemByBarcode(const QString &barcode)
+{
+    if (barcode.trimmed().isEmpty())
+        return;
+
+    if (!m_catalog) {
+        emit error(UnknownBarcodeError);
+        return;
+    }
+
+    m_pendingBarcodes.append(barcode);
+    addPendingBarcodes();
+}
+
 void QMLPurchaseCartModel::updateItem(int itemId, const QVariantMap &itemInfo)
 {
     if (itemId <= 0 || itemInfo.isEmpty())
@@ -573,8 +595,7 @@ void QMLPurchaseCartModel::incrementItemQuantity(int itemId, double quantity)
     const int row = indexOfItem(itemId);
     QVariantMap record(m_records[row].toMap());
     const double oldQuantity = record.value("quantity").toDouble();
-    const double availableQuantity = record.value("available_quantity").toDouble();
-    const double newQuantity = qMin(oldQuantity + quantity, availableQuantity);
+    const double newQuantity = oldQuantity + quantity;
     const double unitPrice = record.value("unit_price").toDouble();
 
     record.insert("quantity", newQuantity);
@@ -655,6 +676,22 @@ int QMLPurchaseCartModel::indexOfItem(int itemId)
     return -1;
 }
 
+void QMLPurchaseCartModel::addPendingBarcodes()
+{
+    while (!m_pendingBarcodes.isEmpty() && m_catalog->isReady()) {
+        const StockCatalogIndex &catalogIndex = m_catalog->index();
+        const int itemId = catalogIndex.itemIdForBarcode(m_pendingBarcodes.first());
+        if (itemId <= 0 && m_catalog->hasPendingRefresh())
+            return;
+
+        m_pendingBarcodes.removeFirst();
+        if (itemId <= 0)
+            emit error(UnknownBarcodeError);
+        else
+            addItem(catalogIndex.item(itemId).toVariantMap());
+    }
+}
+
 void QMLPurchaseCartModel::calculateTotal()
 {
     double totalCost = 0.0;
@@ -9,6 +9,7 @@
 
 class PurchasePayment;
 class PurchasePaymentModel;
+class StockCatalog;
 
 class QMLPurchaseCartModel : public AbstractVisualListModel
 {
@@ -27,6 +28,7 @@ class QMLPurchaseCartModel : public AbstractVisualListModel
 public:
     explicit QMLPurchaseCartModel(QObject *parent = nullptr);
     explicit QMLPurchaseCartModel(DatabaseThread &thread, QObject *parent = nullptr);
+    explicit QMLPurchaseCartModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent = nullptr);
     ~QMLPurchaseCartModel() override = default;
 
     enum Roles {
@@ -65,7 +67,8 @@ public:
         RetrieveTransactionError,
         SubmitTransactionError,
         EmptyCartError,
-        NoDueDateSetError
+        NoDueDateSetError,
+        UnknownBarcodeError
     }; Q_ENUM(ErrorCode)
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override final;
@@ -122,6 +125,7 @@ signals:
     void paymentModelChanged();
 public slots:
     void addItem(const QVariantMap &itemInfo);
+    void addItemByBarcode(const QString &barcode);
     void updateItem(int itemId, const QVariantMap &itemInfo);
     void setItemQuantity(int itemId, double quantity);
     void removeItem(int itemId);
@@ -139,9 +143,12 @@ private:
     QVariantList m_records;
     PurchasePaymentList m_purchasePayments;
     PurchasePaymentModel *m_paymentModel;
+    StockCatalog *m_catalog;
+    QStringList m_pendingBarcodes;
 
     bool containsItem(int itemId);
     int indexOfItem(int itemId);
+    void addPendingBarcodes();
     void addTransaction(const QVariantMap &transactionInfo);
     void updateSuspendedTransaction(const QVariantMap &transactionInfo);
 
@@ -14,7 +14,23 @@ QMLPurchaseTransactionModel::QMLPurchaseTransactionModel(QObject *parent) :
 {}
 
 QMLPurchaseTransactionModel::QMLPurchaseTransactionModel(DatabaseThread &thread, QObject *parent) :
-    AbstractTransactionModel(thread, parent)
+    AbstractTransactionModel(thread, parent),
+    m_records({
+              { TransactionIdRole, "transaction_id", QMetaType::Int },
+              { ClientIdRole, "client_id", QMetaType::Int },
+              { CustomerNameRole, "customer_name", QMetaType::QString },
+              { TotalCostRole, "total_cost", QMetaType::Double },
+              { AmountPaidRole, "amount_paid", QMetaType::Double },
+              { BalanceRole, "balance", QMetaType::Double },
+              { DiscountRole, "discount", QMetaType::Double },
+              { NoteIdRole, "note_id", QMetaType::Int },
+              { NoteRole, "note", QMetaType::QString },
+              { SuspendedRole, "suspended", QMetaType::Bool },
+              { ArchivedRole, "archived", QMetaType::Bool },
+              { CreatedRole, "created", QMetaType::QDateTime },
+              { LastEditedRole, "last_edited", QMetaType::QDateTime },
+              { UserIdRole, "user_id", QMetaType::Int }
+              })
 {
 
 }
@@ -24,38 +40,7 @@ QVariant QMLPurchaseTransactionModel::data(const QModelIndex &index, int role) c
     if (!index.isValid())
         return QVariant();
 
-    switch (role) {
-    case TransactionIdRole:
-        return m_records.at(index.row()).toMap().value("transaction_id").toInt();
-    case ClientIdRole:
-        return m_records.at(index.row()).toMap().value("client_id").toInt();
-    case CustomerNameRole:
-        return m_records.at(index.row()).toMap().value("customer_name").toString();
-    case TotalCostRole:
-        return m_records.at(index.row()).toMap().value("total_cost").toDouble();
-    case AmountPaidRole:
-        return m_records.at(index.row()).toMap().value("amount_paid").toDouble();
-    case BalanceRole:
-        return m_records.at(index.row()).toMap().value("balance").toDouble();
-    case DiscountRole:
-        return m_records.at(index.row()).toMap().value("discount").toDouble();
-    case NoteIdRole:
-        return m_records.at(index.row()).toMap().value("note_id").toInt();
-    case NoteRole:
-        return m_records.at(index.row()).toMap().value("note").toString();
-    case SuspendedRole:
-        return m_records.at(index.row()).toMap().value("suspended").toBool();
-    case ArchivedRole:
-        return m_records.at(index.row()).toMap().value("archived").toBool();
-    case CreatedRole:
-        return m_records.at(index.row()).toMap().value("created").toDateTime();
-    case LastEditedRole:
-        return m_records.at(index.row()).toMap().value("last_edited").toDateTime();
-    case UserIdRole:
-        return m_records.at(index.row()).toMap().value("user_id").toInt();
-    }
-
-    return QVariant();
+    return m_records.value(index.row(), role);
 }
 
 int QMLPurchaseTransactionModel::rowCount(const QModelIndex &parent) const
@@ -136,12 +121,25 @@ QVariant QMLPurchaseTransactionModel::headerData(int section, Qt::Orientation or
 }
 
 void QMLPurchaseTransactionModel::tryQuery()
+{
+    queryPage(PageCursor());
+}
+
+void QMLPurchaseTransactionModel::tryFetchMore()
+{
+    if (m_records.isEmpty())
+        return;
+
+    const int lastRow = m_records.count() - 1;
+    queryPage(PageCursor(m_records.value(lastRow, CreatedRole).toDateTime(),
+                         m_records.value(lastRow, TransactionIdRole).toInt()));
+}
+
+void QMLPurchaseTransactionModel::queryPage(const PageCursor &cursor)
 {
     setBusy(true);
     bool suspended = false;
     bool archived = false;
-    QueryRequest request(this);
-    QVariantMap params;
 
     if (keys() == Completed) {
         suspended = false;
@@ -161,6 +159,7 @@ void QMLPurchaseTransactionModel::tryQuery()
                                                              to(),
                                                              suspended,
                                                              archived,
+                                                             cursor,
                                                              this));
 }
 
@@ -172,9 +171,18 @@ void QMLPurchaseTransactionModel::processResult(const QueryResult result)
     setBusy(false);
     if (result.isSuccessful()) {
         if (result.request().command() == PurchaseQuery::ViewPurchaseTransactions::COMMAND) {
-            beginResetModel();
-            m_records = result.outcome().toMap().value("transactions").toList();
-            endResetModel();
+            const QVariantList &transactions = result.outcome().toMap().value("transactions").toList();
+            if (PageCursor{ result.request().params() }.isFirstPage()) {
+                beginResetModel();
+                m_records.setRecords(transactions);
+                endResetModel();
+            } else if (!transactions.isEmpty()) {
+                beginInsertRows(QModelIndex(), m_records.count(), m_records.count() + transactions.count() - 1);
+                m_records.appendRecords(transactions);
+                endInsertRows();
+            }
+
+            setHasMoreRecords(result.outcome().toMap().value("has_more").toBool());
 
             emit success(ViewTransactionSuccess);
         } else if (result.request().command() == PurchaseQuery::RemovePurchaseTransaction::COMMAND) {
@@ -203,7 +211,7 @@ void QMLPurchaseTransactionModel::removeTransaction(int row)
     setBusy(true);
     emit execute(new PurchaseQuery::RemovePurchaseTransaction(data(index(row, 0), TransactionIdRole).toInt(),
                                                               row,
-                                                              PurchaseTransaction{ m_records.at(row).toMap() },
+                                                              PurchaseTransaction{ m_records.toVariantMap(row) },
                                                               this));
 }
 
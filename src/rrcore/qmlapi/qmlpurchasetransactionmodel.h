@@ -2,6 +2,8 @@
 #define QMLPURCHASETRANSACTIONMODEL_H
 
 #include "models/abstracttransactionmodel.h"
+#include "models/recordtable.h"
+#include "utility/pageutils.h"
 
 class QMLPurchaseTransactionModel : public AbstractTransactionModel
 {
@@ -57,10 +59,13 @@ public:
 protected:
     void tryQuery() override;
     void processResult(const QueryResult result) override;
+    void tryFetchMore() override;
 public slots:
     void removeTransaction(int row);
 private:
-    QVariantList m_records;
+    RecordTable m_records;
+
+    void queryPage(const PageCursor &cursor);
 
     void removeTransactionFromModel(int row);
     void undoRemoveTransactionFromModel(int row, const QVariantMap &record);
@@ -0,0 +1,127 @@
+#include "qmlquerymetricsmodel.h"
+#include "database/databasethread.h"
+#include "database/querymetrics.h"
+
+#include <algorithm>
+
+QMLQueryMetricsModel::QMLQueryMetricsModel(QObject *parent) :
+    QMLQueryMetricsModel(DatabaseThread::instance(), QueryMetrics::instance(), parent)
+{}
+
+QMLQueryMetricsModel::QMLQueryMetricsModel(DatabaseThread &thread, QueryMetrics &queryMetrics, QObject *parent) :
+    AbstractVisualListModel(thread, parent),
+    m_queryMetrics(queryMetrics),
+    m_groupBy(Command)
+{
+    connect(this, &QMLQueryMetricsModel::groupByChanged, this, &QMLQueryMetricsModel::tryQuery);
+}
+
+QMLQueryMetricsModel::GroupBy QMLQueryMetricsModel::groupBy() const
+{
+    return m_groupBy;
+}
+
+void QMLQueryMetricsModel::setGroupBy(GroupBy groupBy)
+{
+    if (m_groupBy == groupBy)
+        return;
+
+    m_groupBy = groupBy;
+    emit groupByChanged();
+}
+
+int QMLQueryMetricsModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return m_records.count();
+}
+
+QVariant QMLQueryMetricsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    const QVariantMap &record = m_records.at(index.row()).toMap();
+    switch (role) {
+    case NameRole:
+        return record.value("name").toString();
+    case CountRole:
+        return record.value("count").toLongLong();
+    case FailureCountRole:
+        return record.value("failure_count").toLongLong();
+    case MeanRole:
+        return record.value("mean_us").toLongLong();
+    case P50Role:
+        return record.value("p50_us").toLongLong();
+    case P95Role:
+        return record.value("p95_us").toLongLong();
+    case P99Role:
+        return record.value("p99_us").toLongLong();
+    case QueueWaitP50Role:
+        return record.value("queue_wait_p50_us").toLongLong();
+    case QueueWaitP95Role:
+        return record.value("queue_wait_p95_us").toLongLong();
+    case QueueWaitP99Role:
+        return record.value("queue_wait_p99_us").toLongLong();
+    case RowCountRole:
+        return record.value("row_count").toLongLong();
+    case ByteCountRole:
+        return record.value("byte_count").toLongLong();
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> QMLQueryMetricsModel::roleNames() const
+{
+    return {
+        { NameRole, "name" },
+        { CountRole, "count" },
+        { FailureCountRole, "failure_count" },
+        { MeanRole, "mean_us" },
+        { P50Role, "p50_us" },
+        { P95Role, "p95_us" },
+        { P99Role, "p99_us" },
+        { QueueWaitP50Role, "queue_wait_p50_us" },
+        { QueueWaitP95Role, "queue_wait_p95_us" },
+        { QueueWaitP99Role, "queue_wait_p99_us" },
+        { RowCountRole, "row_count" },
+        { ByteCountRole, "byte_count" }
+    };
+}
+
+QString QMLQueryMetricsModel::dump()
+{
+    const QString &filePath = QueryMetrics::defaultDumpPath();
+    if (!m_queryMetrics.dump(filePath))
+        return QString();
+
+    return filePath;
+}
+
+void QMLQueryMetricsModel::clear()
+{
+    m_queryMetrics.clear();
+    tryQuery();
+}
+
+void QMLQueryMetricsModel::tryQuery()
+{
+    // NOTE: Metrics live in memory, so there is nothing to ask the database for.
+    beginResetModel();
+    m_records = m_groupBy == QueryGroup ? m_queryMetrics.queryGroupStatistics()
+                                        : m_queryMetrics.commandStatistics();
+    std::sort(m_records.begin(), m_records.end(), [](const QVariant &left, const QVariant &right) {
+        return left.toMap().value("p95_us").toLongLong() > right.toMap().value("p95_us").toLongLong();
+    });
+    endResetModel();
+
+    emit success();
+}
+
+void QMLQueryMetricsModel::processResult(const QueryResult result)
+{
+    Q_UNUSED(result)
+}
@@ -0,0 +1,56 @@
+#ifndef QMLQUERYMETRICSMODEL_H
+#define QMLQUERYMETRICSMODEL_H
+
+#include "models/abstractvisuallistmodel.h"
+
+class QueryMetrics;
+
+class QMLQueryMetricsModel : public AbstractVisualListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(GroupBy groupBy READ groupBy WRITE setGroupBy NOTIFY groupByChanged)
+public:
+    enum Roles {
+        NameRole = Qt::UserRole,
+        CountRole,
+        FailureCountRole,
+        MeanRole,
+        P50Role,
+        P95Role,
+        P99Role,
+        QueueWaitP50Role,
+        QueueWaitP95Role,
+        QueueWaitP99Role,
+        RowCountRole,
+        ByteCountRole
+    };
+
+    enum GroupBy {
+        Command,
+        QueryGroup
+    }; Q_ENUM(GroupBy)
+
+    explicit QMLQueryMetricsModel(QObject *parent = nullptr);
+    explicit QMLQueryMetricsModel(DatabaseThread &thread, QueryMetrics &queryMetrics, QObject *parent = nullptr);
+
+    GroupBy groupBy() const;
+    void setGroupBy(GroupBy groupBy);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE QString dump();
+    Q_INVOKABLE void clear();
+signals:
+    void groupByChanged();
+protected:
+    void tryQuery() override;
+    void processResult(const QueryResult result) override;
+private:
+    QueryMetrics &m_queryMetrics;
+    GroupBy m_groupBy;
+    QVariantList m_records;
+};
+
+#endif // QMLQUERYMETRICSMODEL_H
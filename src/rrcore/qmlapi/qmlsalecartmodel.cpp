@@ -7,6 +7,7 @@
 #include "database/queryrequest.h"
 #include "database/queryresult.h"
 #include "database/databasethread.h"
+#include "database/stockcatalog.h"
 #include "models/salepaymentmodel.h"
 #include "queryexecutors/sales.h"
 #include "queryexecutors/stock.h"
@@ -17,7 +18,7 @@ const int CASH_PAYMENT_LIMIT = 1;
 const int CARD_PAYMENT_LIMIT = 2;
 
 QMLSaleCartModel::QMLSaleCartModel(QObject *parent) :
-    QMLSaleCartModel(DatabaseThread::instance(), parent)
+    QMLSaleCartModel(DatabaseThread::instance(), StockCatalog::instance(), parent)
 {}
 
 QMLSaleCartModel::QMLSaleCartModel(DatabaseThread &thread, QObject *parent) :
@@ -28,7 +29,29 @@ QMLSaleCartModel::QMLSaleCartModel(DatabaseThread &thread, QObject *parent) :
     m_amountPaid(0.0),
     m_balance(0.0),
     m_canAcceptCash(true),
-    m_canAcceptCard(false) // NOTE: Toggle to disable, genius
+    m_canAcceptCard(false), // NOTE: Toggle to disable, genius
+    m_records({
+              { CategoryIdRole, "category_id", QMetaType::Int },
+              { CategoryRole, "category", QMetaType::QString },
+              { ItemIdRole, "item_id", QMetaType::Int },
+              { ItemRole, "item", QMetaType::QString },
+              { QuantityRole, "quantity", QMetaType::Double },
+              { AvailableQuantityRole, "available_quantity", QMetaType::Double },
+              { UnitRole, "unit", QMetaType::QString },
+              { UnitIdRole, "unit_id", QMetaType::Int },
+              { CostPriceRole, "cost_price", QMetaType::Double },
+              { RetailPriceRole, "retail_price", QMetaType::Double },
+              { UnitPriceRole, "unit_price", QMetaType::Double },
+              { CostRole, "cost", QMetaType::Double },
+              // NOTE: Not shown, but passed back when a suspended transaction is saved or printed.
+              { AmountPaidRole, "amount_paid", QMetaType::Double },
+              { NoteRole, "note", QMetaType::QString },
+              { ClientIdRole, "client_id", QMetaType::Int },
+              { CustomerNameRole, "customer_name", QMetaType::QString },
+              { CustomerPhoneNumberRole, "customer_phone_number", QMetaType::QString }
+              }),
+    m_paymentModel(nullptr),
+    m_catalog(nullptr)
 {
     m_paymentModel = new SalePaymentModel(this);
 
@@ -38,6 +61,13 @@ QMLSaleCartModel::QMLSaleCartModel(DatabaseThread &thread, QObject *parent) :
     connect(this, &QMLSaleCartModel::transactionIdChanged, this, &QMLSaleCartModel::tryQuery);
 }
 
+QMLSaleCartModel::QMLSaleCartModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent) :
+    QMLSaleCartModel(thread, parent)
+{
+    m_catalog = &catalog;
+    connect(m_catalog, &StockCatalog::changed, this, &QMLSaleCartModel::addPendingBarcodes);
+}
+
 int QMLSaleCartModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
@@ -51,34 +81,7 @@ QVariant QMLSaleCartModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    switch (role) {
-    case CategoryIdRole:
-        return m_records.at(index.row()).toMap().value("category_id").toInt();
-    case CategoryRole:
-        return m_records.at(index.row()).toMap().value("category").toString();
-    case ItemIdRole:
-        return m_records.at(index.row()).toMap().value("item_id").toInt();
-    case ItemRole:
-        return m_records.at(index.row()).toMap().value("item").toString();
-    case AvailableQuantityRole:
-        return m_records.at(index.row()).toMap().value("available_quantity").toDouble();
-    case QuantityRole:
-        return m_records.at(index.row()).toMap().value("quantity").toDouble();
-    case UnitRole:
-        return m_records.at(index.row()).toMap().value("unit").toString();
-    case UnitIdRole:
-        return m_records.at(index.row()).toMap().value("unit_id").toInt();
-    case CostPriceRole:
-        return m_records.at(index.row()).toMap().value("cost_price").toDouble();
-    case RetailPriceRole:
-        return m_records.at(index.row()).toMap().value("retail_price").toDouble();
-    case UnitPriceRole:
-        return m_records.at(index.row()).toMap().value("unit_price").toDouble();
-    case CostRole:
-        return m_records.at(index.row()).toMap().value("cost").toDouble();
-    }
-
-    return QVariant();
+    return m_records.value(index.row(), role);
 }
 
 QHash<int, QByteArray> QMLSaleCartModel::roleNames() const
@@ -294,7 +297,7 @@ QString QMLSaleCartModel::toPrintableFormat() const
     rootObject.insert("name", m_customerName);
     rootObject.insert("phone_number", m_customerPhoneNumber);
     rootObject.insert("query_group", "sales");
-    rootObject.insert("records", QJsonArray::fromVariantList(m_records));
+    rootObject.insert("records", QJsonArray::fromVariantList(m_records.toVariantList()));
 
     return QJsonDocument(rootObject).toJson();
 }
@@ -303,17 +306,17 @@ void QMLSaleCartModel::addTransaction(const QVariantMap &transactionInfo)
 {
     if (!m_records.isEmpty()) {
         StockItemList items;
-        for (const QVariant &record : m_records) {
+        for (int row = 0; row < m_records.count(); ++row) {
             items.append(StockItem{
-                             record.toMap().value("category_id").toInt(),
-                             record.toMap().value("item_id").toInt(),
-                             record.toMap().value("quantity").toDouble(),
-                             record.toMap().value("unit_id").toInt(),
-                             record.toMap().value("retail_price").toDouble(),
-                             record.toMap().value("unit_price").toDouble(),
-                             record.toMap().value("cost").toDouble(),
-                             record.toMap().value("amount_paid").toDouble(),
-                             record.toMap().value("note").toString()
+                             m_records.value(row, CategoryIdRole).toInt(),
+                             m_records.value(row, ItemIdRole).toInt(),
+                             m_records.value(row, QuantityRole).toDouble(),
+                             m_records.value(row, UnitIdRole).toInt(),
+                             m_records.value(row, RetailPriceRole).toDouble(),
+                             m_records.value(row, UnitPriceRole).toDouble(),
+                             m_records.value(row, CostRole).toDouble(),
+                             m_records.value(row, AmountPaidRole).toDouble(),
+                             m_records.value(row, NoteRole).toString()
                          });
         }
 
@@ -341,17 +344,17 @@ void QMLSaleCartModel::updateSuspendedTransaction(const QVariantMap &transaction
 {
     if (!m_records.isEmpty()) {
         StockItemList items;
-        for (const QVariant &record : m_records) {
+        for (int row = 0; row < m_records.count(); ++row) {
             items.append(StockItem{
-                             record.toMap().value("category_id").toInt(),
-                             record.toMap().value("item_id").toInt(),
-                             record.toMap().value("quantity").toDouble(),
-                             record.toMap().value("unit_id").toInt(),
-                             record.toMap().value("retail_price").toDouble(),
-                             record.toMap().value("unit_price").toDouble(),
-                             record.toMap().value("cost").toDouble(),
-                             record.toMap().value("amount_paid").toDouble(),
-                             record.toMap().value("note").toString()
+                             m_records.value(row, CategoryIdRole).toInt(),
+                             m_records.value(row, ItemIdRole).toInt(),
+                             m_records.value(row, QuantityRole).toDouble(),
+                             m_records.value(row, UnitIdRole).toInt(),
+                             m_records.value(row, RetailPriceRole).toDouble(),
+                             m_records.value(row, UnitPriceRole).toDouble(),
+                             m_records.value(row, CostRole).toDouble(),
+                             m_records.value(row, AmountPaidRole).toDouble(),
+                             m_records.value(row, NoteRole).toString()
                          });
         }
 
@@ -401,7 +404,7 @@ void QMLSaleCartModel::processResult(const QueryResult result)
         beginResetModel();
 
         clearPayments();
-        m_records = result.outcome().toMap().value("items").toList();
+        m_records.setRecords(result.outcome().toMap().value("items").toList());
         calculateTotal();
 
         endResetModel();
@@ -512,13 +515,11 @@ void QMLSaleCartModel::addItem(const QVariantMap &itemInfo)
         endInsertRows();
     } else {
         const int row = indexOfItem(itemId);
-        QVariantMap record(m_records.at(row).toMap());
-        const double oldQuantity = record.value("quantity").toDouble();
-        const double newQuantity = oldQuantity + 1;
+        const double oldQuantity = m_records.value(row, QuantityRole).toDouble();
+        const double newQuantity = qMin(oldQuantity + 1, availableQuantity);
 
-        record.insert("quantity", qMin(newQuantity, availableQuantity));
-        record.insert("cost", record.value("quantity").toDouble() * unitPrice);
-        m_records.replace(row, record);
+        m_records.setValue(row, QuantityRole, newQuantity);
+        m_records.setValue(row, CostRole, newQuantity * unitPrice);
 
         emit dataChanged(index(row), index(row));
     }
@@ -526,29 +527,41 @@ void QMLSaleCartModel::addItem(const QVariantMap &itemInfo)
     calculateTotal();
 }
 
+void QMLSaleCartModel::addItemByBarcode(const QString &barcode)
+{
+    if (barcode.trimmed().isEmpty())
+        return;
+
+    if (!m_catalog) {
+        emit error(UnknownBarcodeError);
+        return;
+    }
+
+    m_pendingBarcodes.append(barcode);
+    addPendingBarcodes();
+}
+
 void QMLSaleCartModel::updateItem(int itemId, const QVariantMap &itemInfo)
 {
     if (itemId <= 0 || itemInfo.isEmpty())
         return;
 
     const int row = indexOfItem(itemId);
-    QVariantMap record(m_records[row].toMap());
-    const double oldQuantity = record.value("quantity").toDouble();
-    const double availableQuantity = record.value("available_quantity").toDouble();
+    const double oldQuantity = m_records.value(row, QuantityRole).toDouble();
+    const double availableQuantity = m_records.value(row, AvailableQuantityRole).toDouble();
     const double quantity = itemInfo.value("quantity").toDouble();
-    const double oldUnitPrice = record.value("unit_price").toDouble();
-    const double oldCost = record.value("cost").toDouble();
+    const double oldUnitPrice = m_records.value(row, UnitPriceRole).toDouble();
+    const double oldCost = m_records.value(row, CostRole).toDouble();
     const double newQuantity = qMin(quantity, availableQuantity);
     const double newUnitPrice = itemInfo.value("unit_price").toDouble();
     const double newCost = itemInfo.value("cost").toDouble();
 
     if (itemInfo.contains("quantity"))
-        record.insert("quantity", newQuantity);
+        m_records.setValue(row, QuantityRole, newQuantity);
     if (itemInfo.contains("cost"))
-        record.insert("cost", newCost);
+        m_records.setValue(row, CostRole, newCost);
     if (itemInfo.contains("unit_price"))
-        record.insert("unit_price", newUnitPrice);
-    m_records.replace(row, record);
+        m_records.setValue(row, UnitPriceRole, newUnitPrice);
 
     if (oldQuantity != newQuantity || oldUnitPrice != newUnitPrice || oldCost != newCost) {
         emit dataChanged(index(row), index(row));
@@ -562,15 +575,13 @@ void QMLSaleCartModel::setItemQuantity(int itemId, double quantity)
         return;
 
     const int row = indexOfItem(itemId);
-    QVariantMap record(m_records[row].toMap());
-    const double oldQuantity = record.value("quantity").toDouble();
-    const double availableQuantity = record.value("available_quantity").toDouble();
+    const double oldQuantity = m_records.value(row, QuantityRole).toDouble();
+    const double availableQuantity = m_records.value(row, AvailableQuantityRole).toDouble();
     const double newQuantity = qMin(quantity, availableQuantity);
-    const double unitPrice = record.value("unit_price").toDouble();
+    const double unitPrice = m_records.value(row, UnitPriceRole).toDouble();
 
-    record.insert("quantity", newQuantity);
-    record.insert("cost", newQuantity * unitPrice);
-    m_records.replace(row, record);
+    m_records.setValue(row, QuantityRole, newQuantity);
+    m_records.setValue(row, CostRole, newQuantity * unitPrice);
 
     if (oldQuantity != newQuantity) {
         emit dataChanged(index(row), index(row));
@@ -584,15 +595,13 @@ void QMLSaleCartModel::incrementItemQuantity(int itemId, double quantity)
         return;
 
     const int row = indexOfItem(itemId);
-    QVariantMap record(m_records[row].toMap());
-    const double oldQuantity = record.value("quantity").toDouble();
-    const double availableQuantity = record.value("available_quantity").toDouble();
+    const double oldQuantity = m_records.value(row, QuantityRole).toDouble();
+    const double availableQuantity = m_records.value(row, AvailableQuantityRole).toDouble();
     const double newQuantity = qMin(oldQuantity + quantity, availableQuantity);
-    const double unitPrice = record.value("unit_price").toDouble();
+    const double unitPrice = m_records.value(row, UnitPriceRole).toDouble();
 
-    record.insert("quantity", newQuantity);
-    record.insert("cost", newQuantity * unitPrice);
-    m_records.replace(row, record);
+    m_records.setValue(row, QuantityRole, newQuantity);
+    m_records.setValue(row, CostRole, newQuantity * unitPrice);
 
     emit dataChanged(index(row), index(row));
 
@@ -605,14 +614,12 @@ void QMLSaleCartModel::decrementItemQuantity(int itemId, double quantity)
         return;
 
     const int row = indexOfItem(itemId);
-    QVariantMap record(m_records[row].toMap());
-    const double oldQuantity = record.value("quantity").toDouble();
+    const double oldQuantity = m_records.value(row, QuantityRole).toDouble();
     const double newQuantity = qMax(oldQuantity - quantity, 0.0);
-    const double unitPrice = record.value("unit_price").toDouble();
+    const double unitPrice = m_records.value(row, UnitPriceRole).toDouble();
 
-    record.insert("quantity", newQuantity);
-    record.insert("cost", newQuantity * unitPrice);
-    m_records.replace(row, record);
+    m_records.setValue(row, QuantityRole, newQuantity);
+    m_records.setValue(row, CostRole, newQuantity * unitPrice);
 
     emit dataChanged(index(row), index(row));
 
@@ -649,11 +656,7 @@ void QMLSaleCartModel::removeItem(int itemId)
 
 bool QMLSaleCartModel::containsItem(int itemId)
 {
-    for (const QVariant &record : m_records)
-        if (record.toMap().value("item_id").toInt() == itemId)
-            return true;
-
-    return false;
+    return m_records.indexOf(ItemIdRole, itemId) > -1;
 }
 
 int QMLSaleCartModel::indexOfItem(int itemId)
@@ -661,18 +664,42 @@ int QMLSaleCartModel::indexOfItem(int itemId)
     if (itemId <= 0)
         return -1;
 
-    for (int i = 0; i < m_records.count(); ++i)
-        if (m_records.at(i).toMap().value("item_id").toInt() == itemId)
-            return i;
+    return m_records.indexOf(ItemIdRole, itemId);
+}
 
-    return -1;
+void QMLSaleCartModel::addPendingBarcodes()
+{
+    // NOTE: Scans are added in the order they were made. A scan waits while the catalogue is
+    // still loading, or while it is being refreshed and does not know the barcode yet
+    // (e.g. an item that was just added), and so does every scan after it.
+    while (!m_pendingBarcodes.isEmpty() && m_catalog->isReady()) {
+        const StockCatalogIndex &catalogIndex = m_catalog->index();
+        const int itemId = catalogIndex.itemIdForBarcode(m_pendingBarcodes.first());
+        if (itemId <= 0 && m_catalog->hasPendingRefresh())
+            return;
+
+        m_pendingBarcodes.removeFirst();
+        if (itemId <= 0) {
+            emit error(UnknownBarcodeError);
+            continue;
+        }
+
+        // NOTE: addItem() ignores items that have run out, so the scan is reported instead.
+        const StockCatalogItem &item = catalogIndex.item(itemId);
+        const int row = indexOfItem(itemId);
+        const double quantityInCart = row < 0 ? 0.0 : m_records.value(row, QuantityRole).toDouble();
+        if (item.quantity - quantityInCart <= 0.0)
+            emit error(OutOfStockError);
+        else
+            addItem(item.toVariantMap());
+    }
 }
 
 void QMLSaleCartModel::calculateTotal()
 {
     double totalCost = 0.0;
-    for (const QVariant &record : m_records)
-        totalCost += record.toMap().value("cost").toDouble();
+    for (int row = 0; row < m_records.count(); ++row)
+        totalCost += m_records.value(row, CostRole).toDouble();
 
     setTotalCost(totalCost);
     setBalance(m_totalCost - m_amountPaid);
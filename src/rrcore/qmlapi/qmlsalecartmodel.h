@@ -5,9 +5,11 @@
 #include <QDateTime>
 
 #include "models/abstractvisuallistmodel.h"
+#include "models/recordtable.h"
 #include "utility/saleutils.h"
 
 class SalePaymentModel;
+class StockCatalog;
 
 class QMLSaleCartModel : public AbstractVisualListModel
 {
@@ -26,6 +28,7 @@ class QMLSaleCartModel : public AbstractVisualListModel
 public:
     explicit QMLSaleCartModel(QObject *parent = nullptr);
     explicit QMLSaleCartModel(DatabaseThread &thread, QObject *parent = nullptr);
+    explicit QMLSaleCartModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent = nullptr);
     ~QMLSaleCartModel() override = default;
 
     enum Roles {
@@ -40,7 +43,12 @@ public:
         CostPriceRole,
         RetailPriceRole,
         UnitPriceRole,
-        CostRole
+        CostRole,
+        AmountPaidRole,
+        NoteRole,
+        ClientIdRole,
+        CustomerNameRole,
+        CustomerPhoneNumberRole
     };
 
     enum PaymentMethod {
@@ -65,7 +73,9 @@ public:
         SubmitTransactionError,
         UndoSubmitTransactionError,
         EmptyCartError,
-        NoDueDateSetError
+        NoDueDateSetError,
+        UnknownBarcodeError,
+        OutOfStockError
     }; Q_ENUM(ErrorCode)
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override final;
@@ -125,6 +135,7 @@ signals:
     void paymentModelChanged();
 public slots:
     void addItem(const QVariantMap &itemInfo);
+    void addItemByBarcode(const QString &barcode);
     void updateItem(int itemId, const QVariantMap &itemInfo);
     void setItemQuantity(int itemId, double quantity);
     void removeItem(int itemId);
@@ -139,12 +150,15 @@ private:
     double m_balance;
     bool m_canAcceptCash;
     bool m_canAcceptCard;
-    QVariantList m_records;
+    RecordTable m_records;
     SalePaymentList m_salePayments;
     SalePaymentModel *m_paymentModel;
+    StockCatalog *m_catalog;
+    QStringList m_pendingBarcodes;
 
     bool containsItem(int itemId);
     int indexOfItem(int itemId);
+    void addPendingBarcodes();
     void addTransaction(const QVariantMap &transactionInfo);
     void updateSuspendedTransaction(const QVariantMap &transactionInfo);
 
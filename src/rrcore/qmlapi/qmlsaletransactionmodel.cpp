@@ -14,7 +14,23 @@ QMLSaleTransactionModel::QMLSaleTransactionModel(QObject *parent) :
 {}
 
 QMLSaleTransactionModel::QMLSaleTransactionModel(DatabaseThread &thread, QObject *parent) :
-    AbstractTransactionModel(thread, parent)
+    AbstractTransactionModel(thread, parent),
+    m_records({
+              { TransactionIdRole, "transaction_id", QMetaType::Int },
+              { ClientIdRole, "client_id", QMetaType::Int },
+              { CustomerNameRole, "customer_name", QMetaType::QString },
+              { TotalCostRole, "total_cost", QMetaType::Double },
+              { AmountPaidRole, "amount_paid", QMetaType::Double },
+              { BalanceRole, "balance", QMetaType::Double },
+              { DiscountRole, "discount", QMetaType::Double },
+              { NoteIdRole, "note_id", QMetaType::Int },
+              { NoteRole, "note", QMetaType::QString },
+              { SuspendedRole, "suspended", QMetaType::Bool },
+              { ArchivedRole, "archived", QMetaType::Bool },
+              { CreatedRole, "created", QMetaType::QDateTime },
+              { LastEditedRole, "last_edited", QMetaType::QDateTime },
+              { UserIdRole, "user_id", QMetaType::Int }
+              })
 {
 
 }
@@ -24,40 +40,10 @@ QVariant QMLSaleTransactionModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    switch (role) {
-    case TransactionIdRole:
-        return m_records.at(index.row()).toMap().value("transaction_id").toInt();
-    case ClientIdRole:
-        return m_records.at(index.row()).toMap().value("client_id").toInt();
-    case CustomerNameRole:
-        return m_records.at(index.row()).toMap().value("customer_name").toString();
-    case TotalCostRole:
-        return m_records.at(index.row()).toMap().value("total_cost").toDouble();
-    case AmountPaidRole:
-        return m_records.at(index.row()).toMap().value("amount_paid").toDouble();
-    case BalanceRole:
-        return m_records.at(index.row()).toMap().value("balance").toDouble();
-    case DiscountRole:
-        return m_records.at(index.row()).toMap().value("discount").toDouble();
-    case NoteIdRole:
-        return m_records.at(index.row()).toMap().value("note_id").toInt();
-    case NoteRole:
-        return m_records.at(index.row()).toMap().value("note").toString();
-    case SuspendedRole:
-        return m_records.at(index.row()).toMap().value("suspended").toBool();
-    case ArchivedRole:
-        return m_records.at(index.row()).toMap().value("archived").toBool();
-    case CreatedRole:
-        return m_records.at(index.row()).toMap().value("created").toDateTime();
-    case LastEditedRole:
-        return m_records.at(index.row()).toMap().value("last_edited").toDateTime();
-    case UserIdRole:
-        return m_records.at(index.row()).toMap().value("user_id").toInt();
-    case Qt::DisplayRole:
-        return m_records.at(index.row()).toMap();
-    }
+    if (role == Qt::DisplayRole)
+        return m_records.toVariantMap(index.row());
 
-    return QVariant();
+    return m_records.value(index.row(), role);
 }
 
 int QMLSaleTransactionModel::rowCount(const QModelIndex &parent) const
@@ -138,6 +124,21 @@ QVariant QMLSaleTransactionModel::headerData(int section, Qt::Orientation orient
 }
 
 void QMLSaleTransactionModel::tryQuery()
+{
+    queryPage(PageCursor());
+}
+
+void QMLSaleTransactionModel::tryFetchMore()
+{
+    if (m_records.isEmpty())
+        return;
+
+    const int lastRow = m_records.count() - 1;
+    queryPage(PageCursor(m_records.value(lastRow, CreatedRole).toDateTime(),
+                         m_records.value(lastRow, TransactionIdRole).toInt()));
+}
+
+void QMLSaleTransactionModel::queryPage(const PageCursor &cursor)
 {
     setBusy(true);
     bool suspended = false;
@@ -158,10 +159,11 @@ void QMLSaleTransactionModel::tryQuery()
     }
 
     emit execute(new SaleQuery::ViewSaleTransactions(from(),
-                                                 to(),
-                                                 suspended,
-                                                 archived,
-                                                 this));
+                                                     to(),
+                                                     suspended,
+                                                     archived,
+                                                     cursor,
+                                                     this));
 }
 
 void QMLSaleTransactionModel::processResult(const QueryResult result)
@@ -172,9 +174,18 @@ void QMLSaleTransactionModel::processResult(const QueryResult result)
     setBusy(false);
     if (result.isSuccessful()) {
         if (result.request().command() == "view_sale_transactions") {
-            beginResetModel();
-            m_records = result.outcome().toMap().value("transactions").toList();
-            endResetModel();
+            const QVariantList &transactions = result.outcome().toMap().value("transactions").toList();
+            if (PageCursor{ result.request().params() }.isFirstPage()) {
+                beginResetModel();
+                m_records.setRecords(transactions);
+                endResetModel();
+            } else if (!transactions.isEmpty()) {
+                beginInsertRows(QModelIndex(), m_records.count(), m_records.count() + transactions.count() - 1);
+                m_records.appendRecords(transactions);
+                endInsertRows();
+            }
+
+            setHasMoreRecords(result.outcome().toMap().value("has_more").toBool());
 
             emit success(ViewTransactionSuccess);
         } else {
@@ -3,19 +3,31 @@
 #include "database/queryrequest.h"
 #include "database/queryresult.h"
 #include "database/databasethread.h"
+#include "database/stockcatalog.h"
 #include "queryexecutors/stock.h"
 #include <QDebug>
+#include <QSet>
+#include <algorithm>
 
 QMLStockCategoryModel::QMLStockCategoryModel(QObject *parent) :
-    QMLStockCategoryModel(DatabaseThread::instance(), parent)
+    QMLStockCategoryModel(DatabaseThread::instance(), StockCatalog::instance(), parent)
 {}
 
 QMLStockCategoryModel::QMLStockCategoryModel(DatabaseThread &thread, QObject *parent) :
-    AbstractVisualListModel(thread, parent)
+    AbstractVisualListModel(thread, parent),
+    m_catalog(nullptr),
+    m_generation(0),
+    m_readGeneration(0)
 {
     connect(this, &QMLStockCategoryModel::itemFilterTextChanged, this, &QMLStockCategoryModel::filter);
 }
 
+QMLStockCategoryModel::QMLStockCategoryModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent) :
+    QMLStockCategoryModel(thread, parent)
+{
+    m_catalog = &catalog;
+}
+
 QString QMLStockCategoryModel::itemFilterText() const
 {
     return m_itemFilterText;
@@ -168,23 +180,75 @@ void QMLStockCategoryModel::undoRemoveCategoryFromModel(int row, const QVariantM
 
 void QMLStockCategoryModel::tryQuery()
 {
+    ++m_generation;
+    if (!m_itemFilterText.trimmed().isEmpty() && filterByItemFromCatalog())
+        return;
+
     setBusy(true);
 
+    QueryExecutor *queryExecutor = nullptr;
     if (!m_itemFilterText.trimmed().isEmpty()) {
-        emit execute(new StockQuery::FilterStockCategoriesByItem(m_itemFilterText,
-                                                             sortOrder(),
-                                                             false,
-                                                             this));
+        queryExecutor = new StockQuery::FilterStockCategoriesByItem(m_itemFilterText,
+                                                                    sortOrder(),
+                                                                    false,
+                                                                    this);
     } else if (!filterText().trimmed().isEmpty()) {
-        emit execute(new StockQuery::FilterStockCategories(filterText(),
-                                                       sortOrder(),
-                                                       false,
-                                                       this));
+        queryExecutor = new StockQuery::FilterStockCategories(filterText(),
+                                                              sortOrder(),
+                                                              false,
+                                                              this);
     } else {
-        emit execute(new StockQuery::ViewStockCategories(sortOrder(),
-                                                     false,
-                                                     this));
+        queryExecutor = new StockQuery::ViewStockCategories(sortOrder(),
+                                                            false,
+                                                            this);
     }
+
+    m_readGeneration = m_generation;
+    m_readRequest = queryExecutor->request();
+    emit execute(queryExecutor);
+}
+
+bool QMLStockCategoryModel::filterByItemFromCatalog()
+{
+    if (!m_catalog || !m_catalog->isReady())
+        return false;
+
+    const StockCatalogIndex &index = m_catalog->index();
+    QSet<int> categoryIds;
+    QVariantList records;
+    for (const StockCatalogItem &item : index.items(index.search(m_itemFilterText))) {
+        if (categoryIds.contains(item.categoryId))
+            continue;
+
+        categoryIds.insert(item.categoryId);
+        records.append(QVariantMap {
+                           { "category_id", item.categoryId },
+                           { "category", item.category }
+                       });
+    }
+
+    const bool ascending = sortOrder() == Qt::AscendingOrder;
+    std::sort(records.begin(), records.end(), [ascending](const QVariant &a, const QVariant &b) {
+        const int comparison = a.toMap().value("category").toString()
+                .compare(b.toMap().value("category").toString(), Qt::CaseInsensitive);
+        return ascending ? comparison < 0 : comparison > 0;
+    });
+
+    beginResetModel();
+    m_records = records;
+    endResetModel();
+
+    setBusy(false);
+    emit success(ViewStockCategoriesSuccess);
+    return true;
+}
+
+bool QMLStockCategoryModel::isStaleRead(const QueryRequest &request) const
+{
+    // NOTE: Reads that were replaced, or answered by the catalogue meanwhile, are dropped.
+    return m_readGeneration != m_generation
+            || request.command() != m_readRequest.command()
+            || request.params() != m_readRequest.params();
 }
 
 void QMLStockCategoryModel::processResult(const QueryResult result)
@@ -192,12 +256,16 @@ void QMLStockCategoryModel::processResult(const QueryResult result)
     if (result.request().receiver() != this)
         return;
 
+    const bool isRead = result.request().command() == StockQuery::ViewStockCategories::COMMAND
+            || result.request().command() == StockQuery::FilterStockCategoriesByItem::COMMAND
+            || result.request().command() == StockQuery::FilterStockCategories::COMMAND;
+    if (isRead && isStaleRead(result.request()))
+        return;
+
     setBusy(false);
 
     if (result.isSuccessful()) {
-        if (result.request().command() == StockQuery::ViewStockCategories::COMMAND
-                || result.request().command() == StockQuery::FilterStockCategoriesByItem::COMMAND
-                || result.request().command() == StockQuery::FilterStockCategories::COMMAND) {
+        if (isRead) {
             beginResetModel();
             m_records = result.outcome().toMap().value("categories").toList();
             endResetModel();
@@ -5,6 +5,8 @@
 #include <QVariantList>
 #include "models/abstractvisuallistmodel.h"
 
+class StockCatalog;
+
 class QMLStockCategoryModel : public AbstractVisualListModel
 {
     Q_OBJECT
@@ -12,6 +14,7 @@ class QMLStockCategoryModel : public AbstractVisualListModel
 public:
     explicit QMLStockCategoryModel(QObject *parent = nullptr);
     explicit QMLStockCategoryModel(DatabaseThread &thread, QObject *parent = nullptr);
+    explicit QMLStockCategoryModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent = nullptr);
 
     enum Roles {
         CategoryIdRole = Qt::UserRole,
@@ -44,7 +47,13 @@ protected:
 private:
     QVariantList m_records;
     QString m_itemFilterText;
+    StockCatalog *m_catalog;
+    int m_generation;
+    int m_readGeneration;
+    QueryRequest m_readRequest;
 
+    bool filterByItemFromCatalog();
+    bool isStaleRead(const QueryRequest &request) const;
     void removeCategoryFromModel(int row);
     void undoRemoveCategoryFromModel(int row, const QVariantMap &categoryInfo);
     void updateCategory(int categoryId, const QVariantMap &categoryInfo);
@@ -1,22 +1,50 @@
 #include "qmlstockitemmodel.h"
 #include "database/databasethread.h"
+#include "database/stockcatalog.h"
+#include "database/imagecache.h"
 
 #include <QDateTime>
+#include <algorithm>
 #include "queryexecutors/stock.h"
 
 QMLStockItemModel::QMLStockItemModel(QObject *parent) :
-    QMLStockItemModel(DatabaseThread::instance(), parent)
-{
-
-}
+    QMLStockItemModel(DatabaseThread::instance(), StockCatalog::instance(), parent)
+{}
 
 QMLStockItemModel::QMLStockItemModel(DatabaseThread &thread, QObject *parent) :
     AbstractVisualTableModel(thread, parent),
-    m_categoryId(-1)
+    m_categoryId(-1),
+    m_records({
+              { CategoryIdRole, "category_id", QMetaType::Int },
+              { CategoryRole, "category", QMetaType::QString },
+              { ItemIdRole, "item_id", QMetaType::QString },
+              { ItemRole, "item", QMetaType::QString },
+              { DescriptionRole, "description", QMetaType::QString },
+              { DivisibleRole, "divisible", QMetaType::Bool },
+              { ImageUrlRole, "image_url", QMetaType::QUrl },
+              { QuantityRole, "quantity", QMetaType::Double },
+              { UnitRole, "unit", QMetaType::QString },
+              { UnitIdRole, "unit_id", QMetaType::Int },
+              { CostPriceRole, "cost_price", QMetaType::Double },
+              { RetailPriceRole, "retail_price", QMetaType::Double },
+              { CurrencyRole, "currency", QMetaType::QString },
+              { CreatedRole, "created", QMetaType::QDateTime },
+              { LastEditedRole, "last_edited", QMetaType::QDateTime },
+              { UserRole, "user", QMetaType::QString }
+              }),
+    m_catalog(nullptr),
+    m_generation(0),
+    m_readGeneration(0)
 {
     connect(this, &QMLStockItemModel::categoryIdChanged, this, &QMLStockItemModel::tryQuery);
 }
 
+QMLStockItemModel::QMLStockItemModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent) :
+    QMLStockItemModel(thread, parent)
+{
+    m_catalog = &catalog;
+}
+
 int QMLStockItemModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
@@ -38,42 +66,7 @@ QVariant QMLStockItemModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    switch (role) {
-    case CategoryIdRole:
-        return m_records.at(index.row()).toMap().value("category_id").toInt();
-    case CategoryRole:
-        return m_records.at(index.row()).toMap().value("category").toString();
-    case ItemIdRole:
-        return m_records.at(index.row()).toMap().value("item_id").toString();
-    case ItemRole:
-        return m_records.at(index.row()).toMap().value("item").toString();
-    case DescriptionRole:
-        return m_records.at(index.row()).toMap().value("description").toString();
-    case DivisibleRole:
-        return m_records.at(index.row()).toMap().value("divisible").toBool();
-    case ImageUrlRole:
-        return m_records.at(index.row()).toMap().value("image_url").toUrl();
-    case QuantityRole:
-        return m_records.at(index.row()).toMap().value("quantity").toDouble();
-    case UnitRole:
-        return m_records.at(index.row()).toMap().value("unit").toString();
-    case UnitIdRole:
-        return m_records.at(index.row()).toMap().value("unit_id").toInt();
-    case CostPriceRole:
-        return m_records.at(index.row()).toMap().value("cost_price").toDouble();
-    case RetailPriceRole:
-        return m_records.at(index.row()).toMap().value("retail_price").toDouble();
-    case CurrencyRole:
-        return m_records.at(index.row()).toMap().value("currency").toString();
-    case CreatedRole:
-        return m_records.at(index.row()).toMap().value("created").toDateTime();
-    case LastEditedRole:
-        return m_records.at(index.row()).toMap().value("last_edited").toDateTime();
-    case UserRole:
-        return m_records.at(index.row()).toMap().value("user").toString();
-    }
-
-    return QVariant();
+    return m_records.value(index.row(), role);
 }
 
 QHash<int, QByteArray> QMLStockItemModel::roleNames() const
@@ -168,7 +161,7 @@ void QMLStockItemModel::removeItem(int row)
     setBusy(true);
     emit execute(new StockQuery::RemoveStockItem(index(row, 0).data(ItemIdRole).toInt(),
                                                  row,
-                                                 StockItem{ m_records.at(row).toMap() },
+                                                 StockItem{ m_records.toVariantMap(row) },
                                                  this));
 }
 
@@ -177,20 +170,79 @@ void QMLStockItemModel::tryQuery()
     if (m_categoryId <= 0)
         return;
 
+    const bool filtering = !filterText().trimmed().isEmpty() && sortColumn() > -1 && filterColumn() > -1;
+    ++m_generation;
+    if (filtering && filterFromCatalog())
+        return;
+
     setBusy(true);
-    if (!filterText().trimmed().isEmpty() && sortColumn() > -1 && filterColumn() > -1) {
-        emit execute(new StockQuery::FilterStockItems(m_categoryId,
-                                                      filterText(),
-                                                      columnName(filterColumn()),
-                                                      sortOrder(),
-                                                      columnName(sortColumn()),
-                                                      this));
+    QueryExecutor *queryExecutor = nullptr;
+    if (filtering) {
+        queryExecutor = new StockQuery::FilterStockItems(m_categoryId,
+                                                         filterText(),
+                                                         columnName(filterColumn()),
+                                                         sortOrder(),
+                                                         columnName(sortColumn()),
+                                                         this);
 
     } else {
-        emit execute(new StockQuery::ViewStockItems(m_categoryId,
-                                                    sortOrder(),
-                                                    this));
+        queryExecutor = new StockQuery::ViewStockItems(m_categoryId,
+                                                       sortOrder(),
+                                                       this);
     }
+
+    m_readGeneration = m_generation;
+    m_readRequest = queryExecutor->request();
+    emit execute(queryExecutor);
+}
+
+bool QMLStockItemModel::filterFromCatalog()
+{
+    // NOTE: Only item names are indexed; other columns are still filtered by the database.
+    if (!m_catalog || !m_catalog->isReady() || columnName(filterColumn()) != QStringLiteral("item"))
+        return false;
+
+    const StockCatalogIndex &index = m_catalog->index();
+    QVector<StockCatalogItem> items(index.items(index.search(filterText(), m_categoryId)));
+
+    const QString &sortColumnName = columnName(sortColumn());
+    const bool ascending = sortOrder() == Qt::AscendingOrder;
+    std::stable_sort(items.begin(), items.end(), [&sortColumnName, ascending](const StockCatalogItem &a,
+                     const StockCatalogItem &b) {
+        if (sortColumnName == QStringLiteral("quantity"))
+            return ascending ? a.quantity < b.quantity : a.quantity > b.quantity;
+        if (sortColumnName == QStringLiteral("cost_price"))
+            return ascending ? a.costPrice < b.costPrice : a.costPrice > b.costPrice;
+
+        const int comparison = a.item.compare(b.item, Qt::CaseInsensitive);
+        return ascending ? comparison < 0 : comparison > 0;
+    });
+
+    QVariantList records;
+    records.reserve(items.count());
+    for (const StockCatalogItem &item : items) {
+        QVariantMap record(item.toVariantMap());
+        // NOTE: The catalogue holds no images, so only images already read from the database are shown.
+        record.insert("image_url", ImageCache::instance().urlForKey(QStringLiteral("stock_item/%1").arg(item.itemId)));
+        records.append(record);
+    }
+
+    beginResetModel();
+    m_records.setRecords(records);
+    endResetModel();
+
+    setBusy(false);
+    emit success(ViewStockItemsSuccess);
+    return true;
+}
+
+bool QMLStockItemModel::isStaleRead(const QueryRequest &request) const
+{
+    // NOTE: Only the latest read is shown. Reads it replaced, or that the catalogue
+    // answered since they were sent, would otherwise overwrite newer rows.
+    return m_readGeneration != m_generation
+            || request.command() != m_readRequest.command()
+            || request.params() != m_readRequest.params();
 }
 
 void QMLStockItemModel::processResult(const QueryResult result)
@@ -198,13 +250,18 @@ void QMLStockItemModel::processResult(const QueryResult result)
     if (this != result.request().receiver())
         return;
 
+    const bool isRead = result.request().command() == StockQuery::ViewStockItems::COMMAND
+            || result.request().command() == StockQuery::FilterStockItems::COMMAND;
+    if (isRead && isStaleRead(result.request()))
+        return;
+
     setBusy(false);
 
     if (result.isSuccessful()) {
         if (result.request().command() == StockQuery::ViewStockItems::COMMAND
                 || result.request().command() == StockQuery::FilterStockItems::COMMAND) {
             beginResetModel();
-            m_records = result.outcome().toMap().value("items").toList();
+            m_records.setRecords(result.outcome().toMap().value("items").toList());
             endResetModel();
 
             emit success(ViewStockItemsSuccess);
@@ -2,6 +2,9 @@
 #define QMLSTOCKITEMMODEL_H
 
 #include "models/abstractvisualtablemodel.h"
+#include "models/recordtable.h"
+
+class StockCatalog;
 
 class QMLStockItemModel : public AbstractVisualTableModel
 {
@@ -45,6 +48,7 @@ public:
 
     explicit QMLStockItemModel(QObject *parent = nullptr);
     explicit QMLStockItemModel(DatabaseThread &thread, QObject *parent = nullptr);
+    explicit QMLStockItemModel(DatabaseThread &thread, StockCatalog &catalog, QObject *parent = nullptr);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override final;
     int columnCount(const QModelIndex &parent = QModelIndex()) const override final;
@@ -68,8 +72,14 @@ public slots:
     void refresh() override;
 private:
     int m_categoryId;
-    QVariantList m_records;
+    RecordTable m_records;
+    StockCatalog *m_catalog;
+    int m_generation;
+    int m_readGeneration;
+    QueryRequest m_readRequest;
 
+    bool filterFromCatalog();
+    bool isStaleRead(const QueryRequest &request) const;
     void removeItemFromModel(int row);
     void undoRemoveItemFromModel(int row, const QVariantMap &itemInfo);
 };
@@ -31,7 +31,9 @@ QMLUserProfile::QMLUserProfile(DatabaseThread &thread, QObject *parent) :
     UserProfile::instance().setDatabaseReady(true);
     UserProfile::instance().setServerTunnelingEnabled(false);
     connect(this, &QMLUserProfile::execute, &thread, &DatabaseThread::execute);
-    connect(&thread, &DatabaseThread::resultReady, this, &QMLUserProfile::processResult);
+    thread.addReceiver(this, [this](const QueryResult &result) {
+        processResult(result);
+    });
 
     connect(this, &QMLUserProfile::executeRequest,
             &NetworkThread::instance(), QOverload<ServerRequest>::of(&NetworkThread::execute));
@@ -19,6 +19,23 @@ ViewClients::ViewClients(const QString &filterText, const QString &filterColumn,
 
 }
 
+ViewClients::ViewClients(const PageCursor &cursor, QObject *receiver) :
+    ClientExecutor(COMMAND, cursor.toVariantMap(), receiver)
+{
+
+}
+
+ViewClients::ViewClients(const QString &filterText,
+                         const QString &filterColumn,
+                         const PageCursor &cursor,
+                         QObject *receiver) :
+    ViewClients(filterText, filterColumn, receiver)
+{
+    QVariantMap params{ request().params() };
+    params.unite(cursor.toVariantMap());
+    request().setParams(params);
+}
+
 QueryResult ViewClients::execute()
 {
     QueryResult result{ request() };
@@ -26,46 +43,87 @@ QueryResult ViewClients::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> records(callProcedure("ViewClients", {
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::In,
-                                                              "filter_column",
-                                                              params.value("filter_column")
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::In,
-                                                              "filter_text",
-                                                              params.value("filter_text")
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::In,
-                                                              "archived",
-                                                              params.value("archived")
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::Out,
-                                                              "client_id",
-                                                              {}
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::Out,
-                                                              "preferred_name",
-                                                              {}
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::Out,
-                                                              "phone_number",
-                                                              {}
-                                                          }
-                                                      }));
-
+        const PageCursor cursor{ params };
+        QList<QSqlRecord> records;
+        if (cursor.isPaginated()) {
+            records = callProcedure("ViewClientsPage", {
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "filter_column",
+                                            params.value("filter_column")
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "filter_text",
+                                            params.value("filter_text")
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "archived",
+                                            params.value("archived", false)
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "after_created",
+                                            params.value("after_created")
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "after_id",
+                                            params.value("after_id")
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "limit",
+                                            cursor.fetchLimit()
+                                        }
+                                    });
+        } else {
+            records = callProcedure("ViewClients", {
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "filter_column",
+                                            params.value("filter_column")
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "filter_text",
+                                            params.value("filter_text")
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::In,
+                                            "archived",
+                                            params.value("archived")
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::Out,
+                                            "client_id",
+                                            {}
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::Out,
+                                            "preferred_name",
+                                            {}
+                                        },
+                                        ProcedureArgument {
+                                            ProcedureArgument::Type::Out,
+                                            "phone_number",
+                                            {}
+                                        }
+                                    });
+        }
 
         QVariantList clients;
         for (const QSqlRecord &record : records) {
             clients.append(recordToMap(record));
         }
 
-        result.setOutcome(QVariantMap { { "clients", clients }, { "record_count", clients.count() } });
+        const bool hasMore = cursor.isPaginated() && cursor.trim(clients);
+        result.setOutcome(QVariantMap {
+                              { "clients", clients },
+                              { "record_count", clients.count() },
+                              { "has_more", hasMore }
+                          });
         return result;
     } catch (DatabaseException &) {
         throw;
@@ -2,6 +2,7 @@
 #define VIEWCLIENTS_H
 
 #include "clientexecutor.h"
+#include "utility/pageutils.h"
 
 namespace ClientQuery {
 class ViewClients : public ClientExecutor
@@ -14,6 +15,12 @@ public:
     explicit ViewClients(const QString &filterText,
                          const QString &filterColumn,
                          QObject *receiver);
+    explicit ViewClients(const PageCursor &cursor,
+                         QObject *receiver);
+    explicit ViewClients(const QString &filterText,
+                         const QString &filterColumn,
+                         const PageCursor &cursor,
+                         QObject *receiver);
     QueryResult execute() override;
 };
 }
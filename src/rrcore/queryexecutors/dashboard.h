@@ -2,5 +2,6 @@
 #define DASHBOARD_H
 
 #include "dashboard/viewdashboard.h"
+#include "dashboard/viewindexadvice.h"
 
 #endif // DASHBOARD_H
@@ -0,0 +1,30 @@
+#include "viewindexadvice.h"
+#include "database/databaseexception.h"
+#include "database/indexadvisor.h"
+
+using namespace DashboardQuery;
+
+ViewIndexAdvice::ViewIndexAdvice(QObject *receiver) :
+    DashboardExecutor(COMMAND, { }, receiver)
+{
+
+}
+
+QueryResult ViewIndexAdvice::execute()
+{
+    QueryResult result{ request() };
+    result.setSuccessful(true);
+
+    try {
+        const QVariantList &findings = IndexAdvisor::advise(connectionName());
+
+        result.setOutcome(QVariantMap {
+                              { "findings", findings },
+                              { "record_count", findings.count() }
+                          });
+    } catch (DatabaseException &) {
+        throw;
+    }
+
+    return result;
+}
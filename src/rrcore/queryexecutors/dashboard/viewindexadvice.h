@@ -0,0 +1,18 @@
+#ifndef VIEWINDEXADVICE_H
+#define VIEWINDEXADVICE_H
+
+#include "dashboardexecutor.h"
+
+namespace DashboardQuery {
+class ViewIndexAdvice : public DashboardExecutor
+{
+    Q_OBJECT
+public:
+    static inline const QString COMMAND = QStringLiteral("view_index_advice");
+
+    explicit ViewIndexAdvice(QObject *receiver);
+    QueryResult execute() override;
+};
+}
+
+#endif // VIEWINDEXADVICE_H
@@ -27,7 +27,7 @@ UpdateDebtor::UpdateDebtor(int debtorId,
                         { "preferred_name", preferredName },
                         { "first_name", firstName },
                         { "last_name", lastName },
-                        { "image", DatabaseUtils::imageUrlToByteArray(imageUrl) },
+                        { "image_url", imageUrl },
                         { "primary_phone_number", primaryPhoneNumber },
                         { "new_debt_transactions", newDebtTransactions.toVariantList() },
                         { "updated_debt_transactions", updatedDebtTransactions.toVariantList() },
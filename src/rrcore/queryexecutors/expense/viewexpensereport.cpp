@@ -16,7 +16,7 @@ QueryResult ViewExpenseReport::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("ViewExpenseReport", {
+        const QList<QSqlRecord> &records(callProcedure("ViewExpenseRollupReport", {
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "from",
@@ -18,7 +18,7 @@ QueryResult IncomeQuery::ViewIncomeReport::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("ViewIncomeReport", {
+        const QList<QSqlRecord> &records(callProcedure("ViewIncomeRollupReport", {
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "from",
@@ -129,9 +129,10 @@ QueryResult PurchaseExecutor::addPurchaseTransaction(PurchaseExecutor::Transacti
         purchaseTransactionId = records.first().value("purchase_transaction_id").toInt();
 
         // STEP: Insert purchase payments.
-        for (const QVariant &payment : payments) {
-            const QVariantMap &paymentInfo = payment.toMap();
-            callProcedure("AddPurchasePayment", {
+        // NOTE: Payments and items are sent as a single JSON array each, so that a
+        // transaction costs the same number of round trips no matter how many lines it has.
+        if (!payments.isEmpty()) {
+            callProcedure("AddPurchasePayments", {
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
                                   "purchase_transaction_id",
@@ -139,13 +140,8 @@ QueryResult PurchaseExecutor::addPurchaseTransaction(PurchaseExecutor::Transacti
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "amount",
-                                  paymentInfo.value("amount")
-                              },
-                              ProcedureArgument {
-                                  ProcedureArgument::Type::In,
-                                  "method",
-                                  params.value("method")
+                                  "payments",
+                                  payments
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
@@ -165,42 +161,11 @@ QueryResult PurchaseExecutor::addPurchaseTransaction(PurchaseExecutor::Transacti
                           });
         }
 
-        for (const QVariant &item : items) {
-            QVariantMap itemInfo = item.toMap();
-            // STEP: Deduct quantity if:
-            // 1. This is a non-suspended transaction.
-            // 2. This is a suspended transaction and you want to reserve the goods for this customer.
-            if (!params.value("suspended", false).toBool()) {
-                callProcedure("AddStockQuantity", {
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "item_id",
-                                      itemInfo.value("item_id")
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "quantity",
-                                      itemInfo.value("quantity").toDouble()
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "unit_id",
-                                      itemInfo.value("unit_id")
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "reason",
-                                      request().command()
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "user_id",
-                                      UserProfile::instance().userId()
-                                  }
-                              });
-            }
-
-            callProcedure("AddPurchaseItem", {
+        // STEP: Insert purchase items, and update quantities if:
+        // 1. This is a non-suspended transaction.
+        // 2. This is a suspended transaction and you want to reserve the goods for this customer.
+        if (!items.isEmpty()) {
+            callProcedure("AddPurchaseItems", {
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
                                   "purchase_transaction_id",
@@ -208,33 +173,18 @@ QueryResult PurchaseExecutor::addPurchaseTransaction(PurchaseExecutor::Transacti
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "item_id",
-                                  itemInfo.value("item_id")
-                              },
-                              ProcedureArgument {
-                                  ProcedureArgument::Type::In,
-                                  "unit_id",
-                                  itemInfo.value("unit_id")
-                              },
-                              ProcedureArgument {
-                                  ProcedureArgument::Type::In,
-                                  "unit_price",
-                                  itemInfo.value("unit_price")
-                              },
-                              ProcedureArgument {
-                                  ProcedureArgument::Type::In,
-                                  "quantity",
-                                  itemInfo.value("quantity")
+                                  "items",
+                                  items
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "cost",
-                                  itemInfo.value("cost")
+                                  "add_quantity",
+                                  !params.value("suspended", false).toBool()
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "discount",
-                                  itemInfo.value("discount")
+                                  "reason",
+                                  request().command()
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
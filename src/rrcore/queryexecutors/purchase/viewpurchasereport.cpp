@@ -23,7 +23,7 @@ QueryResult ViewPurchaseReport::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("ViewPurchaseReport", {
+        const QList<QSqlRecord> &records(callProcedure("ViewPurchaseRollupReport", {
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "from",
@@ -22,6 +22,19 @@ ViewPurchaseTransactions::ViewPurchaseTransactions(const QDateTime &from,
 
 }
 
+ViewPurchaseTransactions::ViewPurchaseTransactions(const QDateTime &from,
+                                                   const QDateTime &to,
+                                                   bool suspended,
+                                                   bool archived,
+                                                   const PageCursor &cursor,
+                                                   QObject *receiver) :
+    ViewPurchaseTransactions(from, to, suspended, archived, receiver)
+{
+    QVariantMap params{ request().params() };
+    params.unite(cursor.toVariantMap());
+    request().setParams(params);
+}
+
 QueryResult PurchaseQuery::ViewPurchaseTransactions::execute()
 {
     QueryResult result{ request() };
@@ -31,35 +44,82 @@ QueryResult PurchaseQuery::ViewPurchaseTransactions::execute()
     QSqlQuery q(connection);
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("ViewPurchaseTransactions", {
-                                                           ProcedureArgument {
-                                                               ProcedureArgument::Type::In,
-                                                               "suspended",
-                                                               params.value("suspended")
-                                                           },
-                                                           ProcedureArgument {
-                                                               ProcedureArgument::Type::In,
-                                                               "archived",
-                                                               params.value("archived")
-                                                           },
-                                                           ProcedureArgument {
-                                                               ProcedureArgument::Type::In,
-                                                               "from",
-                                                               params.value("from")
-                                                           },
-                                                           ProcedureArgument {
-                                                               ProcedureArgument::Type::In,
-                                                               "to",
-                                                               params.value("to")
-                                                           }
-                                                       }));
+        const PageCursor cursor{ params };
+        QList<QSqlRecord> records;
+        if (cursor.isPaginated()) {
+            records = callProcedure("ViewPurchaseTransactionsPage", {
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "suspended",
+                                                params.value("suspended")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "archived",
+                                                params.value("archived")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "from",
+                                                params.value("from")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "to",
+                                                params.value("to")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "after_created",
+                                                params.value("after_created")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "after_id",
+                                                params.value("after_id")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "limit",
+                                                cursor.fetchLimit()
+                                            }
+                                        });
+        } else {
+            records = callProcedure("ViewPurchaseTransactions", {
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "suspended",
+                                                params.value("suspended")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "archived",
+                                                params.value("archived")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "from",
+                                                params.value("from")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "to",
+                                                params.value("to")
+                                            }
+                                        });
+        }
 
         QVariantList transactions;
         for (const QSqlRecord &record : records) {
             transactions.append(recordToMap(record));
         }
 
-        result.setOutcome(QVariantMap { { "transactions", transactions }, { "record_count", transactions.count() } });
+        const bool hasMore = cursor.isPaginated() && cursor.trim(transactions);
+        result.setOutcome(QVariantMap {
+                              { "transactions", transactions },
+                              { "record_count", transactions.count() },
+                              { "has_more", hasMore }
+                          });
         return result;
     } catch (DatabaseException &) {
         throw;
@@ -2,6 +2,7 @@
 #define VIEWPURCHASETRANSACTIONS_H
 
 #include "purchaseexecutor.h"
+#include "utility/pageutils.h"
 
 namespace PurchaseQuery {
 class ViewPurchaseTransactions : public PurchaseExecutor
@@ -15,6 +16,12 @@ public:
                                       bool suspended,
                                       bool archived,
                                       QObject *receiver);
+    explicit ViewPurchaseTransactions(const QDateTime &from,
+                                      const QDateTime &to,
+                                      bool suspended,
+                                      bool archived,
+                                      const PageCursor &cursor,
+                                      QObject *receiver);
     QueryResult execute() override;
 };
 }
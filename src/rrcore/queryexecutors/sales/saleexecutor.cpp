@@ -110,83 +110,10 @@ QueryResult SaleExecutor::addSaleTransaction(QueryExecutor::TransactionMode mode
         saleTransactionId = records.first().value("id").toInt();
 
         // STEP: Insert sale payments.
-        for (const QVariant &payment : payments) {
-            const QVariantMap &paymentInfo = payment.toMap();
-            const QList<QSqlRecord> records(callProcedure("AddSalePayment", {
-                                                              ProcedureArgument {
-                                                                  ProcedureArgument::Type::In,
-                                                                  "sale_transaction_id",
-                                                                  saleTransactionId
-                                                              },
-                                                              ProcedureArgument {
-                                                                  ProcedureArgument::Type::In,
-                                                                  "amount",
-                                                                  paymentInfo.value("amount")
-                                                              },
-                                                              ProcedureArgument {
-                                                                  ProcedureArgument::Type::In,
-                                                                  "method",
-                                                                  paymentInfo.value("method")
-                                                              },
-                                                              ProcedureArgument {
-                                                                  ProcedureArgument::Type::In,
-                                                                  "currency",
-                                                                  params.value("currency")
-                                                              },
-                                                              ProcedureArgument {
-                                                                  ProcedureArgument::Type::In,
-                                                                  "note",
-                                                                  params.value("note")
-                                                              },
-                                                              ProcedureArgument {
-                                                                  ProcedureArgument::Type::In,
-                                                                  "user_id",
-                                                                  params.value("user_id")
-                                                              }
-                                                          }));
-        }
-
-        for (const QVariant &item : items) {
-            QVariantMap itemInfo = item.toMap();
-            // STEP: Deduct quantity if:
-            // 1. This is a non-suspended transaction.
-            // 2. This is a suspended transaction and you want to reserve the goods for this customer.
-            if (!params.value("suspended", false).toBool()) {
-                callProcedure("DeductStockQuantity", {
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "item_id",
-                                      itemInfo.value("item_id")
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "quantity",
-                                      itemInfo.value("quantity").toDouble()
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "unit_id",
-                                      itemInfo.value("unit_id")
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "reason",
-                                      request().command()
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::In,
-                                      "user_id",
-                                      UserProfile::instance().userId()
-                                  },
-                                  ProcedureArgument {
-                                      ProcedureArgument::Type::Out,
-                                      "initial_quantity_id",
-                                      {}
-                                  }
-                              });
-            }
-
-            callProcedure("AddSaleItem", {
+        // NOTE: Payments and items are sent as a single JSON array each, so that a
+        // transaction costs the same number of round trips no matter how many lines it has.
+        if (!payments.isEmpty()) {
+            callProcedure("AddSalePayments", {
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
                                   "sale_transaction_id",
@@ -194,33 +121,51 @@ QueryResult SaleExecutor::addSaleTransaction(QueryExecutor::TransactionMode mode
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "item_id",
-                                  itemInfo.value("item_id")
+                                  "payments",
+                                  payments
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "unit_id",
-                                  itemInfo.value("unit_id")
+                                  "currency",
+                                  params.value("currency")
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "unit_price",
-                                  itemInfo.value("unit_price")
+                                  "note",
+                                  params.value("note", QVariant::String)
+                              },
+                              ProcedureArgument {
+                                  ProcedureArgument::Type::In,
+                                  "user_id",
+                                  UserProfile::instance().userId()
+                              }
+                          });
+        }
+
+        // STEP: Insert sale items, and update quantities if:
+        // 1. This is a non-suspended transaction.
+        // 2. This is a suspended transaction and you want to reserve the goods for this customer.
+        if (!items.isEmpty()) {
+            callProcedure("AddSaleItems", {
+                              ProcedureArgument {
+                                  ProcedureArgument::Type::In,
+                                  "sale_transaction_id",
+                                  saleTransactionId
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "quantity",
-                                  itemInfo.value("quantity")
+                                  "items",
+                                  items
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "cost",
-                                  itemInfo.value("cost")
+                                  "deduct_quantity",
+                                  !params.value("suspended", false).toBool()
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
-                                  "discount",
-                                  itemInfo.value("discount")
+                                  "reason",
+                                  request().command()
                               },
                               ProcedureArgument {
                                   ProcedureArgument::Type::In,
@@ -33,7 +33,7 @@ QueryResult ViewSaleHome::execute()
 
     try {
         /* Total Revenue */ {
-            const QList<QSqlRecord> records(callProcedure("GetTotalRevenue", {
+            const QList<QSqlRecord> records(callProcedure("GetRollupTotalRevenue", {
                                                               ProcedureArgument {
                                                                   ProcedureArgument::Type::In,
                                                                   "from_date",
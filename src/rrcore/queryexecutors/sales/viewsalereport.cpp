@@ -19,7 +19,7 @@ QueryResult ViewSaleReport::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("ViewSaleReport", {
+        const QList<QSqlRecord> &records(callProcedure("ViewSaleRollupReport", {
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "from",
@@ -22,6 +22,19 @@ ViewSaleTransactions::ViewSaleTransactions(const QDateTime &from,
 
 }
 
+ViewSaleTransactions::ViewSaleTransactions(const QDateTime &from,
+                                           const QDateTime &to,
+                                           bool suspended,
+                                           bool archived,
+                                           const PageCursor &cursor,
+                                           QObject *receiver) :
+    ViewSaleTransactions(from, to, suspended, archived, receiver)
+{
+    QVariantMap params{ request().params() };
+    params.unite(cursor.toVariantMap());
+    request().setParams(params);
+}
+
 QueryResult ViewSaleTransactions::execute()
 {
     QueryResult result{ request() };
@@ -31,37 +44,81 @@ QueryResult ViewSaleTransactions::execute()
     QSqlQuery q(connection);
 
     try {
-        const QList<QSqlRecord> records(callProcedure("ViewSaleTransactions", {
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::In,
-                                                              "suspended",
-                                                              params.value("suspended")
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::In,
-                                                              "archived",
-                                                              params.value("archived")
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::In,
-                                                              "from",
-                                                              params.value("from")
-                                                          },
-                                                          ProcedureArgument {
-                                                              ProcedureArgument::Type::In,
-                                                              "to",
-                                                              params.value("to")
-                                                          }
-                                                      }));
+        const PageCursor cursor{ params };
+        QList<QSqlRecord> records;
+        if (cursor.isPaginated()) {
+            records = callProcedure("ViewSaleTransactionsPage", {
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "suspended",
+                                                params.value("suspended")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "archived",
+                                                params.value("archived")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "from",
+                                                params.value("from")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "to",
+                                                params.value("to")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "after_created",
+                                                params.value("after_created")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "after_id",
+                                                params.value("after_id")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "limit",
+                                                cursor.fetchLimit()
+                                            }
+                                        });
+        } else {
+            records = callProcedure("ViewSaleTransactions", {
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "suspended",
+                                                params.value("suspended")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "archived",
+                                                params.value("archived")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "from",
+                                                params.value("from")
+                                            },
+                                            ProcedureArgument {
+                                                ProcedureArgument::Type::In,
+                                                "to",
+                                                params.value("to")
+                                            }
+                                        });
+        }
 
         QVariantList transactions;
         for (const QSqlRecord &record : records) {
             transactions.append(recordToMap(record));
         }
 
+        const bool hasMore = cursor.isPaginated() && cursor.trim(transactions);
         result.setOutcome(QVariantMap {
                               { "transactions", transactions },
-                              { "record_count", transactions.count() }
+                              { "record_count", transactions.count() },
+                              { "has_more", hasMore }
                           });
         return result;
     } catch (DatabaseException &) {
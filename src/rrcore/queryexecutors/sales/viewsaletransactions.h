@@ -2,6 +2,7 @@
 #define VIEWSALETRANSACTIONS_H
 
 #include "saleexecutor.h"
+#include "utility/pageutils.h"
 
 namespace SaleQuery {
 class ViewSaleTransactions : public SaleExecutor
@@ -15,6 +16,12 @@ public:
                                   bool suspended,
                                   bool archived,
                                   QObject *receiver);
+    explicit ViewSaleTransactions(const QDateTime &from,
+                                  const QDateTime &to,
+                                  bool suspended,
+                                  bool archived,
+                                  const PageCursor &cursor,
+                                  QObject *receiver);
     QueryResult execute() override;
 };
 }
@@ -13,5 +13,7 @@
 #include "stock/viewstockitems.h"
 #include "stock/filterstockitems.h"
 #include "stock/viewstockreport.h"
+#include "stock/viewstockcatalog.h"
+#include "stock/viewstockitemimage.h"
 
 #endif // STOCK_H
@@ -1,6 +1,7 @@
 #include "addstockitem.h"
 #include "database/databaseexception.h"
 #include "database/databaseutils.h"
+#include "database/imagenormalizer.h"
 #include "user/userprofile.h"
 
 #include <QSqlDatabase>
@@ -26,7 +27,7 @@ AddStockItem::AddStockItem(const QString &category,
                            const QString &itemNote,
                            QObject *receiver) :
     StockExecutor(COMMAND, {
-                    { "image", DatabaseUtils::imageUrlToByteArray(imageUrl) },
+                    { "image_url", imageUrl },
                     { "category", category },
                     { "item", item },
                     { "description", description },
@@ -44,7 +45,12 @@ AddStockItem::AddStockItem(const QString &category,
                     { "user_id", UserProfile::instance().userId() }
                   }, receiver)
 {
+    ImageNormalizer::instance().prefetch(imageUrl);
+}
 
+AddStockItem::~AddStockItem()
+{
+    ImageNormalizer::instance().release(request().params().value("image_url").toUrl());
 }
 
 QueryResult AddStockItem::execute()
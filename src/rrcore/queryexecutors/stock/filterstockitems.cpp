@@ -1,6 +1,6 @@
 #include "filterstockitems.h"
 #include "database/databaseexception.h"
-#include "database/databaseutils.h"
+#include "database/imagecache.h"
 
 #include <QUrl>
 
@@ -30,7 +30,8 @@ QueryResult FilterStockItems::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("FilterStockItems", {
+        // NOTE: Only the hash of each image is read; the image provider reads the image when it is shown.
+        const QList<QSqlRecord> &records(callProcedure("FilterStockItemList", {
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "category_id",
@@ -49,7 +50,8 @@ QueryResult FilterStockItems::execute()
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "sort_order",
-                                                               params.value("sort_order")
+                                                               params.value("sort_order").toInt() == Qt::DescendingOrder
+                                                               ? "descending" : "ascending"
                                                            },
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
@@ -61,8 +63,9 @@ QueryResult FilterStockItems::execute()
         QVariantList items;
         for (const auto &record : records) {
             QVariantMap itemRecord { recordToMap(record) };
-            itemRecord.insert("image_url", DatabaseUtils::byteArrayToImageUrl(record.value("image").toByteArray()));
-            itemRecord.remove("image");
+            itemRecord.insert("image_url", ImageCache::instance().insertHash(QStringLiteral("stock_item/%1").arg(record.value("item_id").toString()),
+                                                                             record.value("image_hash").toString()));
+            itemRecord.remove("image_hash");
 
             items.append(itemRecord);
         }
@@ -1,6 +1,7 @@
 #include "updatestockitem.h"
 #include "database/databaseexception.h"
 #include "database/databaseutils.h"
+#include "database/imagenormalizer.h"
 #include "user/userprofile.h"
 
 #include <QSqlError>
@@ -48,7 +49,12 @@ UpdateStockItem::UpdateStockItem(int itemId,
                     { "user_id", UserProfile::instance().userId() }
                   }, receiver)
 {
+    ImageNormalizer::instance().prefetch(imageUrl);
+}
 
+UpdateStockItem::~UpdateStockItem()
+{
+    ImageNormalizer::instance().release(request().params().value("image_url").toUrl());
 }
 
 QueryResult UpdateStockItem::execute()
@@ -26,6 +26,7 @@ public:
                              const QString &categoryNote,
                              const QString &itemNote,
                              QObject *receiver);
+    ~UpdateStockItem() override;
     QueryResult execute() override;
 };
 }
@@ -0,0 +1,49 @@
+#include "viewstockcatalog.h"
+#include "database/databaseexception.h"
+
+using namespace StockQuery;
+
+ViewStockCatalog::ViewStockCatalog(QObject *receiver) :
+    StockExecutor(COMMAND, { }, receiver)
+{
+
+}
+
+ViewStockCatalog::ViewStockCatalog(const QVariantList &itemIds,
+                                   QObject *receiver) :
+    StockExecutor(COMMAND, {
+                    { "item_ids", itemIds }
+                  }, receiver)
+{
+
+}
+
+QueryResult ViewStockCatalog::execute()
+{
+    QueryResult result{ request() };
+    result.setSuccessful(true);
+    const QVariantMap &params = request().params();
+
+    try {
+        // NOTE: Images are left out, the catalogue is only used for searching.
+        const QList<QSqlRecord> &records(callProcedure("ViewStockCatalog", {
+                                                           ProcedureArgument {
+                                                               ProcedureArgument::Type::In,
+                                                               "item_ids",
+                                                               params.value("item_ids")
+                                                           }
+                                                       }));
+
+        QVariantList items;
+        for (const auto &record : records)
+            items.append(recordToMap(record));
+
+        result.setOutcome(QVariantMap {
+                              { "items", items },
+                              { "record_count", items.count() }
+                          });
+        return result;
+    } catch (DatabaseException &) {
+        throw;
+    }
+}
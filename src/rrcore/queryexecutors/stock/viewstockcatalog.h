@@ -0,0 +1,20 @@
+#ifndef VIEWSTOCKCATALOG_H
+#define VIEWSTOCKCATALOG_H
+
+#include "stockexecutor.h"
+
+namespace StockQuery {
+class ViewStockCatalog : public StockExecutor
+{
+    Q_OBJECT
+public:
+    static inline const QString COMMAND = QStringLiteral("view_stock_catalog");
+
+    explicit ViewStockCatalog(QObject *receiver);
+    explicit ViewStockCatalog(const QVariantList &itemIds,
+                              QObject *receiver);
+    QueryResult execute() override;
+};
+}
+
+#endif // VIEWSTOCKCATALOG_H
@@ -1,6 +1,6 @@
 #include "viewstockitemdetails.h"
 #include "database/databaseexception.h"
-#include "database/databaseutils.h"
+#include "database/imagecache.h"
 
 #include <QUrl>
 
@@ -34,7 +34,8 @@ QueryResult ViewStockItemDetails::execute()
         QVariantMap itemInfo;
         if (!records.isEmpty()) {
             itemInfo = recordToMap(records.first());
-            itemInfo.insert("image_url", DatabaseUtils::byteArrayToImageUrl(itemInfo.value("image").toByteArray()));
+            itemInfo.insert("image_url", ImageCache::instance().insert(QStringLiteral("stock_item/%1").arg(params.value("item_id").toString()),
+                                                                       itemInfo.value("image").toByteArray()));
             itemInfo.remove("image");
         }
         else
@@ -0,0 +1,40 @@
+#include "viewstockitemimage.h"
+#include "database/databaseexception.h"
+
+using namespace StockQuery;
+
+ViewStockItemImage::ViewStockItemImage(int itemId,
+                                       QObject *receiver) :
+    StockExecutor(COMMAND, {
+                    { "item_id", itemId }
+                  }, receiver)
+{
+
+}
+
+QueryResult ViewStockItemImage::execute()
+{
+    QueryResult result{ request() };
+    result.setSuccessful(true);
+    const QVariantMap &params = request().params();
+
+    try {
+        enforceArguments({ "item_id" }, params);
+
+        const QList<QSqlRecord> &records(callProcedure("ViewStockItemImage", {
+                                                           ProcedureArgument {
+                                                               ProcedureArgument::Type::In,
+                                                               "item_id",
+                                                               params.value("item_id")
+                                                           }
+                                                       }));
+
+        result.setOutcome(QVariantMap {
+                              { "image", records.isEmpty() ? QByteArray() : records.first().value("image").toByteArray() },
+                              { "record_count", records.count() }
+                          });
+        return result;
+    } catch (DatabaseException &) {
+        throw;
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef VIEWSTOCKITEMIMAGE_H
+#define VIEWSTOCKITEMIMAGE_H
+
+#include "stockexecutor.h"
+
+namespace StockQuery {
+class ViewStockItemImage : public StockExecutor
+{
+    Q_OBJECT
+public:
+    static inline const QString COMMAND = QStringLiteral("view_stock_item_image");
+
+    explicit ViewStockItemImage(int itemId,
+                                QObject *receiver);
+    QueryResult execute() override;
+};
+}
+
+#endif // VIEWSTOCKITEMIMAGE_H
@@ -1,6 +1,6 @@
 #include "viewstockitems.h"
 #include "database/databaseexception.h"
-#include "database/databaseutils.h"
+#include "database/imagecache.h"
 
 #include <QUrl>
 
@@ -24,7 +24,8 @@ QueryResult ViewStockItems::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("ViewStockItems", {
+        // NOTE: Only the hash of each image is read; the image provider reads the image when it is shown.
+        const QList<QSqlRecord> &records(callProcedure("ViewStockItemList", {
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "category_id",
@@ -40,8 +41,9 @@ QueryResult ViewStockItems::execute()
         QVariantList items;
         for (const auto &record : records) {
             QVariantMap itemRecord{ recordToMap(record) };
-            itemRecord.insert("image_url", DatabaseUtils::byteArrayToImageUrl(record.value("image").toByteArray()));
-            itemRecord.remove("image");
+            itemRecord.insert("image_url", ImageCache::instance().insertHash(QStringLiteral("stock_item/%1").arg(record.value("item_id").toString()),
+                                                                             record.value("image_hash").toString()));
+            itemRecord.remove("image_hash");
 
             items.append(itemRecord);
         }
@@ -18,7 +18,7 @@ QueryResult ViewStockReport::execute()
     const QVariantMap &params = request().params();
 
     try {
-        const QList<QSqlRecord> &records(callProcedure("ViewStockReport", {
+        const QList<QSqlRecord> &records(callProcedure("ViewStockRollupReport", {
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "from",
@@ -47,7 +47,8 @@ QueryResult ViewStockReport::execute()
                                                            ProcedureArgument {
                                                                ProcedureArgument::Type::In,
                                                                "sort_order",
-                                                               params.value("sort_order")
+                                                               params.value("sort_order").toInt() == Qt::DescendingOrder
+                                                               ? "descending" : "ascending"
                                                            }
                                                        }));
 
@@ -1,6 +1,7 @@
 #include "adduser.h"
 #include "database/databaseexception.h"
 #include "database/databaseutils.h"
+#include "database/imagenormalizer.h"
 #include "user/userprofile.h"
 
 #include <QSqlDatabase>
@@ -28,7 +29,12 @@ AddUser::AddUser(const QString &firstName,
                         { "user_id", UserProfile::instance().userId() }
                  }, receiver)
 {
+    ImageNormalizer::instance().prefetch(imageUrl);
+}
 
+AddUser::~AddUser()
+{
+    ImageNormalizer::instance().release(request().params().value("image_url").toUrl());
 }
 
 QueryResult AddUser::execute()
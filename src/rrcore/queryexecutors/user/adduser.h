@@ -18,6 +18,7 @@ public:
                      const QString &emailAddress,
                      const QUrl &imageUrl,
                      QObject *receiver);
+    ~AddUser() override;
     QueryResult execute() override;
 };
 }
@@ -1,6 +1,6 @@
 TEMPLATE = lib
 
-QT += core qml quick quickcontrols2 sql svg printsupport
+QT += core qml quick quickcontrols2 sql svg printsupport concurrent
 
 CONFIG += c++17
 
@@ -12,19 +12,33 @@ INCLUDEPATH += .
 
 SOURCES += \
     database/queryexecutor.cpp \
+    database/preparedstatementcache.cpp \
+    database/queryresultcache.cpp \
+    database/pendingwrites.cpp \
+    database/readreplica.cpp \
+    database/changelog.cpp \
+    database/changesync.cpp \
+    database/indexadvisor.cpp \
+    database/stockcatalogindex.cpp \
+    database/stockcatalog.cpp \
     network/networkexception.cpp \
     network/networkthread.cpp \
     network/requestlogger.cpp \
     network/serverrequest.cpp \
     network/serverresponse.cpp \
+    network/wireformat.cpp \
     qmlapi/qmlexpensetransactionmodel.cpp \
     qmlapi/qmlstockitemcountrecord.cpp \
     qmlapi/qmlstockitemmodel.cpp \
+    qmlapi/qmlimageprovider.cpp \
+    qmlapi/qmlquerymetricsmodel.cpp \
+    qmlapi/qmlindexadvicemodel.cpp \
     qmlapi/qmluserprofile.cpp \
     queryexecutors/client/clientexecutor.cpp \
     queryexecutors/client/viewclients.cpp \
     queryexecutors/dashboard/dashboardexecutor.cpp \
     queryexecutors/dashboard/viewdashboard.cpp \
+    queryexecutors/dashboard/viewindexadvice.cpp \
     queryexecutors/debtor/adddebtor.cpp \
     queryexecutors/debtor/debtorexecutor.cpp \
     queryexecutors/debtor/removedebtor.cpp \
@@ -68,9 +82,11 @@ SOURCES += \
     queryexecutors/stock/stockexecutor.cpp \
     queryexecutors/stock/updatestockitem.cpp \
     queryexecutors/purchase/viewpurchasetransactionitems.cpp \
+    queryexecutors/stock/viewstockcatalog.cpp \
     queryexecutors/stock/viewstockcategories.cpp \
     queryexecutors/stock/viewstockitemcount.cpp \
     queryexecutors/stock/viewstockitemdetails.cpp \
+    queryexecutors/stock/viewstockitemimage.cpp \
     queryexecutors/stock/viewstockitems.cpp \
     queryexecutors/stock/viewstockreport.cpp \
     queryexecutors/user/activateuser.cpp \
@@ -102,7 +118,11 @@ SOURCES += \
     user/businessstoremodel.cpp \
     user/userprofile.cpp \
     database/databaseutils.cpp \
+    database/imagecache.cpp \
+    database/imagenormalizer.cpp \
+    database/querymetrics.cpp \
     models/abstractvisuallistmodel.cpp \
+    models/recordtable.cpp \
     pusher/abstractpusher.cpp \
     qmlapi/qmlsalecartmodel.cpp \
     sqlmanager/salesqlmanager.cpp \
@@ -157,6 +177,7 @@ SOURCES += \
     qmlapi/qmlreceiptprinter.cpp \
     models/receiptcartmodel.cpp \
     singletons/logger.cpp \
+    singletons/startupprofiler.cpp \
     qmlapi/qmlstockreportmodel.cpp \
     qmlapi/qmlsalereportmodel.cpp \
     qmlapi/qmlpurchasereportmodel.cpp \
@@ -166,6 +187,15 @@ SOURCES += \
 HEADERS += \
     database/databaseerror.h \
     database/queryexecutor.h \
+    database/preparedstatementcache.h \
+    database/queryresultcache.h \
+    database/pendingwrites.h \
+    database/readreplica.h \
+    database/changelog.h \
+    database/changesync.h \
+    database/indexadvisor.h \
+    database/stockcatalogindex.h \
+    database/stockcatalog.h \
     network/networkerror.h \
     network/networkexception.h \
     network/networkthread.h \
@@ -173,9 +203,13 @@ HEADERS += \
     network/requestlogger.h \
     network/serverrequest.h \
     network/serverresponse.h \
+    network/wireformat.h \
     qmlapi/qmlexpensetransactionmodel.h \
     qmlapi/qmlstockitemcountrecord.h \
     qmlapi/qmlstockitemmodel.h \
+    qmlapi/qmlimageprovider.h \
+    qmlapi/qmlquerymetricsmodel.h \
+    qmlapi/qmlindexadvicemodel.h \
     qmlapi/qmluserprofile.h \
     queryexecutors/client.h \
     queryexecutors/client/clientexecutor.h \
@@ -183,6 +217,7 @@ HEADERS += \
     queryexecutors/dashboard.h \
     queryexecutors/dashboard/dashboardexecutor.h \
     queryexecutors/dashboard/viewdashboard.h \
+    queryexecutors/dashboard/viewindexadvice.h \
     queryexecutors/debtor.h \
     queryexecutors/debtor/adddebtor.h \
     queryexecutors/debtor/debtorexecutor.h \
@@ -232,9 +267,11 @@ HEADERS += \
     queryexecutors/stock/stockexecutor.h \
     queryexecutors/stock/updatestockitem.h \
     queryexecutors/purchase/viewpurchasetransactionitems.h \
+    queryexecutors/stock/viewstockcatalog.h \
     queryexecutors/stock/viewstockcategories.h \
     queryexecutors/stock/viewstockitemcount.h \
     queryexecutors/stock/viewstockitemdetails.h \
+    queryexecutors/stock/viewstockitemimage.h \
     queryexecutors/stock/viewstockitems.h \
     queryexecutors/stock/viewstockreport.h \
     queryexecutors/user.h \
@@ -268,7 +305,11 @@ HEADERS += \
     user/businessstoremodel.h \
     user/userprofile.h \
     database/databaseutils.h \
+    database/imagecache.h \
+    database/imagenormalizer.h \
+    database/querymetrics.h \
     models/abstractvisuallistmodel.h \
+    models/recordtable.h \
     pusher/abstractpusher.h \
     qmlapi/qmlsalecartmodel.h \
     sqlmanager/salesqlmanager.h \
@@ -296,6 +337,7 @@ HEADERS += \
     qmlapi/qmldebtordetailrecord.h \
     utility/debtorutils.h \
     utility/saleutils.h \
+    utility/pageutils.h \
     models/salepaymentmodel.h \
     qmlapi/qmldatabasecreator.h \
     config/config.h \
@@ -327,6 +369,7 @@ HEADERS += \
     qmlapi/qmlreceiptprinter.h \
     models/receiptcartmodel.h \
     singletons/logger.h \
+    singletons/startupprofiler.h \
     qmlapi/qmlstockreportmodel.h \
     qmlapi/qmlsalereportmodel.h \
     qmlapi/qmlpurchasereportmodel.h \
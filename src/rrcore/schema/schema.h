@@ -7,6 +7,8 @@ namespace Schema {
     namespace Common {
         static inline const QString INIT_SQL_FILE(":/schema/rr-schema/sql/mysql/common/init.sql");
         static inline const QString PROCEDURE_DIR(":/schema/rr-schema/sql/mysql/common/procedures");
+        static inline const QString LOCAL_PROCEDURE_DIR(":/schema/sql/procedures");
+        static inline const QString MIGRATION_DIR(":/schema/sql/migrations");
     }
 
     namespace Client {
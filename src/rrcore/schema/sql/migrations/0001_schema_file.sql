@@ -0,0 +1,8 @@
+USE ###DATABASENAME###
+---
+CREATE TABLE IF NOT EXISTS schema_file (
+    file_name VARCHAR(255) NOT NULL,
+    checksum CHAR(64) NOT NULL,
+    last_edited DATETIME NOT NULL,
+    PRIMARY KEY (file_name)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
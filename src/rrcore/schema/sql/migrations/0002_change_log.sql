@@ -0,0 +1,17 @@
+USE ###DATABASENAME###
+---
+CREATE TABLE IF NOT EXISTS change_log (
+    id BIGINT NOT NULL AUTO_INCREMENT,
+    table_name VARCHAR(64) NOT NULL,
+    row_id INT(11) NOT NULL,
+    operation CHAR(1) NOT NULL,
+    created DATETIME(3) NOT NULL,
+    PRIMARY KEY (id)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
+---
+CREATE TABLE IF NOT EXISTS sync_watermark (
+    name VARCHAR(32) NOT NULL,
+    sequence BIGINT NOT NULL,
+    last_edited DATETIME(3) NOT NULL,
+    PRIMARY KEY (name)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
@@ -0,0 +1,67 @@
+USE ###DATABASENAME###
+---
+DROP PROCEDURE IF EXISTS CreateIndexIfMissing
+---
+CREATE PROCEDURE CreateIndexIfMissing (
+    IN iTableName VARCHAR(64),
+    IN iIndexName VARCHAR(64),
+    IN iColumns VARCHAR(200)
+)
+BEGIN
+    IF EXISTS (SELECT 1 FROM information_schema.TABLES
+                WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = iTableName)
+            AND NOT EXISTS (SELECT 1 FROM information_schema.STATISTICS
+                WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = iTableName
+                AND INDEX_NAME = iIndexName) THEN
+        SET @rr_create_index = CONCAT('CREATE INDEX ', iIndexName, ' ON ', iTableName, ' (', iColumns, ')');
+        PREPARE statement FROM @rr_create_index;
+        EXECUTE statement;
+        DEALLOCATE PREPARE statement;
+        SET @rr_create_index = NULL;
+    END IF;
+END
+---
+DROP PROCEDURE IF EXISTS CreateSecondaryIndexes
+---
+CREATE PROCEDURE CreateSecondaryIndexes ()
+BEGIN
+    CALL CreateIndexIfMissing('category', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('credit_payment', 'credit_transaction_id', 'credit_transaction_id');
+    CALL CreateIndexIfMissing('credit_transaction', 'creditor_id', 'creditor_id');
+    CALL CreateIndexIfMissing('credit_transaction', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('creditor', 'client_id', 'client_id');
+    CALL CreateIndexIfMissing('debt_payment', 'debt_transaction_id', 'debt_transaction_id');
+    CALL CreateIndexIfMissing('debt_payment', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('debt_transaction', 'debtor_id_archived', 'debtor_id, archived');
+    CALL CreateIndexIfMissing('debt_transaction', 'transaction_id', 'transaction_id');
+    CALL CreateIndexIfMissing('debt_transaction', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('debtor', 'client_id', 'client_id');
+    CALL CreateIndexIfMissing('debtor', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('expense', 'created', 'created');
+    CALL CreateIndexIfMissing('expense_payment', 'expense_id', 'expense_id');
+    CALL CreateIndexIfMissing('income', 'created', 'created');
+    CALL CreateIndexIfMissing('income_payment', 'income_id', 'income_id');
+    CALL CreateIndexIfMissing('initial_quantity', 'item_id', 'item_id');
+    CALL CreateIndexIfMissing('item', 'category_id_archived', 'category_id, archived');
+    CALL CreateIndexIfMissing('item', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('purchase_item', 'purchase_transaction_id', 'purchase_transaction_id');
+    CALL CreateIndexIfMissing('purchase_item', 'item_id_created', 'item_id, created');
+    CALL CreateIndexIfMissing('purchase_item', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('purchase_payment', 'purchase_transaction_id', 'purchase_transaction_id');
+    CALL CreateIndexIfMissing('purchase_transaction', 'created', 'created');
+    CALL CreateIndexIfMissing('purchase_transaction', 'client_id', 'client_id');
+    CALL CreateIndexIfMissing('purchase_transaction', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('sale_item', 'sale_transaction_id', 'sale_transaction_id');
+    CALL CreateIndexIfMissing('sale_item', 'item_id_created', 'item_id, created');
+    CALL CreateIndexIfMissing('sale_item', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('sale_payment', 'sale_transaction_id', 'sale_transaction_id');
+    CALL CreateIndexIfMissing('sale_transaction', 'created', 'created');
+    CALL CreateIndexIfMissing('sale_transaction', 'client_id', 'client_id');
+    CALL CreateIndexIfMissing('sale_transaction', 'note_id', 'note_id');
+    CALL CreateIndexIfMissing('unit', 'item_id_archived', 'item_id, archived');
+    CALL CreateIndexIfMissing('unit_relation', 'item_id', 'item_id');
+END
+---
+CALL CreateSecondaryIndexes()
+---
+DROP PROCEDURE IF EXISTS CreateSecondaryIndexes
@@ -0,0 +1,88 @@
+USE ###DATABASENAME###
+---
+CREATE TABLE IF NOT EXISTS sale_daily_rollup (
+    day DATE NOT NULL,
+    item_id INT(11) NOT NULL,
+    unit_id INT(11) NOT NULL,
+    category_id INT(11) NOT NULL,
+    quantity DOUBLE NOT NULL DEFAULT 0,
+    total_amount DECIMAL(19,2) NOT NULL DEFAULT 0,
+    PRIMARY KEY (day, item_id, unit_id),
+    KEY category_id_day (category_id, day)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
+---
+CREATE TABLE IF NOT EXISTS sale_revenue_daily_rollup (
+    day DATE NOT NULL,
+    amount_paid DECIMAL(19,2) NOT NULL DEFAULT 0,
+    PRIMARY KEY (day)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
+---
+CREATE TABLE IF NOT EXISTS purchase_daily_rollup (
+    day DATE NOT NULL,
+    item_id INT(11) NOT NULL,
+    category_id INT(11) NOT NULL,
+    quantity DOUBLE NOT NULL DEFAULT 0,
+    total_amount DECIMAL(19,2) NOT NULL DEFAULT 0,
+    PRIMARY KEY (day, item_id),
+    KEY category_id_day (category_id, day)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
+---
+CREATE TABLE IF NOT EXISTS income_daily_rollup (
+    day DATE NOT NULL,
+    purpose VARCHAR(100) NOT NULL,
+    amount DECIMAL(19,2) NOT NULL DEFAULT 0,
+    PRIMARY KEY (day, purpose)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
+---
+CREATE TABLE IF NOT EXISTS expense_daily_rollup (
+    day DATE NOT NULL,
+    purpose VARCHAR(100) NOT NULL,
+    amount DECIMAL(19,2) NOT NULL DEFAULT 0,
+    PRIMARY KEY (day, purpose)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
+---
+DELETE FROM sale_daily_rollup
+---
+INSERT INTO sale_daily_rollup (day, item_id, unit_id, category_id, quantity, total_amount)
+    SELECT DATE(sale_transaction.created), sale_item.item_id, sale_item.unit_id, item.category_id,
+        SUM(sale_item.quantity), SUM(sale_item.cost)
+    FROM sale_item
+    INNER JOIN sale_transaction ON sale_transaction.id = sale_item.sale_transaction_id
+    INNER JOIN item ON item.id = sale_item.item_id
+    WHERE sale_item.archived = 0 AND sale_transaction.archived = 0 AND sale_transaction.suspended = 0
+    GROUP BY DATE(sale_transaction.created), sale_item.item_id, sale_item.unit_id, item.category_id
+---
+DELETE FROM sale_revenue_daily_rollup
+---
+INSERT INTO sale_revenue_daily_rollup (day, amount_paid)
+    SELECT DATE(sale_transaction.created), SUM(sale_transaction.amount_paid)
+    FROM sale_transaction
+    WHERE sale_transaction.archived = 0 AND sale_transaction.suspended = 0
+    GROUP BY DATE(sale_transaction.created)
+---
+DELETE FROM purchase_daily_rollup
+---
+INSERT INTO purchase_daily_rollup (day, item_id, category_id, quantity, total_amount)
+    SELECT DATE(purchase_transaction.created), purchase_item.item_id, item.category_id,
+        SUM(purchase_item.quantity), SUM(purchase_item.cost)
+    FROM purchase_item
+    INNER JOIN purchase_transaction ON purchase_transaction.id = purchase_item.purchase_transaction_id
+    INNER JOIN item ON item.id = purchase_item.item_id
+    WHERE purchase_item.archived = 0 AND purchase_transaction.archived = 0 AND purchase_transaction.suspended = 0
+    GROUP BY DATE(purchase_transaction.created), purchase_item.item_id, item.category_id
+---
+DELETE FROM income_daily_rollup
+---
+INSERT INTO income_daily_rollup (day, purpose, amount)
+    SELECT DATE(income.created), income.purpose, SUM(income.amount_paid)
+    FROM income
+    WHERE income.archived = 0
+    GROUP BY DATE(income.created), income.purpose
+---
+DELETE FROM expense_daily_rollup
+---
+INSERT INTO expense_daily_rollup (day, purpose, amount)
+    SELECT DATE(expense.created), expense.purpose, SUM(expense.amount_paid)
+    FROM expense
+    WHERE expense.archived = 0
+    GROUP BY DATE(expense.created), expense.purpose
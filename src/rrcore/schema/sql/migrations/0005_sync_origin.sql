@@ -0,0 +1,10 @@
+USE ###DATABASENAME###
+---
+CREATE TABLE IF NOT EXISTS sync_origin (
+    table_name VARCHAR(64) NOT NULL,
+    origin_rack_id VARCHAR(64) NOT NULL,
+    origin_id INT(11) NOT NULL,
+    local_id INT(11) NOT NULL,
+    PRIMARY KEY (table_name, origin_rack_id, origin_id),
+    KEY table_name_local_id (table_name, local_id)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
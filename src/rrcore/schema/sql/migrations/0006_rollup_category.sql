@@ -0,0 +1,5 @@
+USE ###DATABASENAME###
+---
+ALTER TABLE sale_daily_rollup DROP INDEX category_id_day, DROP COLUMN category_id
+---
+ALTER TABLE purchase_daily_rollup DROP INDEX category_id_day, DROP COLUMN category_id
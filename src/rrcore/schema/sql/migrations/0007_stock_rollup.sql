@@ -0,0 +1,55 @@
+USE ###DATABASENAME###
+---
+ALTER TABLE purchase_daily_rollup
+    ADD COLUMN unit_id INT(11) NOT NULL DEFAULT 0 AFTER item_id,
+    DROP PRIMARY KEY,
+    ADD PRIMARY KEY (day, item_id, unit_id)
+---
+DELETE FROM purchase_daily_rollup
+---
+INSERT INTO purchase_daily_rollup (day, item_id, unit_id, quantity, total_amount)
+    SELECT DATE(purchase_transaction.created), purchase_item.item_id, purchase_item.unit_id,
+        SUM(purchase_item.quantity), SUM(purchase_item.cost)
+    FROM purchase_item
+    INNER JOIN purchase_transaction ON purchase_transaction.id = purchase_item.purchase_transaction_id
+    WHERE purchase_item.archived = 0 AND purchase_transaction.archived = 0 AND purchase_transaction.suspended = 0
+    GROUP BY DATE(purchase_transaction.created), purchase_item.item_id, purchase_item.unit_id
+---
+ALTER TABLE purchase_daily_rollup ALTER COLUMN unit_id DROP DEFAULT
+---
+CREATE TABLE IF NOT EXISTS stock_daily_rollup (
+    day DATE NOT NULL,
+    item_id INT(11) NOT NULL,
+    quantity DOUBLE NOT NULL DEFAULT 0,
+    PRIMARY KEY (day, item_id)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8
+---
+DELETE FROM stock_daily_rollup
+---
+INSERT INTO stock_daily_rollup (day, item_id, quantity)
+    SELECT stock_change.day, stock_change.item_id, SUM(stock_change.quantity)
+    FROM (
+        SELECT sale_daily_rollup.day, sale_daily_rollup.item_id,
+            -sale_daily_rollup.quantity * sold_unit.base_unit_equivalent AS quantity
+        FROM sale_daily_rollup
+        INNER JOIN unit AS sold_unit ON sold_unit.id = sale_daily_rollup.unit_id
+        UNION ALL
+        SELECT purchase_daily_rollup.day, purchase_daily_rollup.item_id,
+            purchase_daily_rollup.quantity * bought_unit.base_unit_equivalent AS quantity
+        FROM purchase_daily_rollup
+        INNER JOIN unit AS bought_unit ON bought_unit.id = purchase_daily_rollup.unit_id
+    ) AS stock_change
+    GROUP BY stock_change.day, stock_change.item_id
+---
+INSERT INTO stock_daily_rollup (day, item_id, quantity)
+    SELECT DATE(item.created), item.id,
+        current_quantity.quantity * current_unit.base_unit_equivalent - IFNULL(recorded.quantity, 0)
+    FROM item
+    INNER JOIN current_quantity ON current_quantity.item_id = item.id
+    INNER JOIN unit AS current_unit ON current_unit.id = current_quantity.unit_id
+    LEFT JOIN (
+        SELECT stock_daily_rollup.item_id, SUM(stock_daily_rollup.quantity) AS quantity
+        FROM stock_daily_rollup
+        GROUP BY stock_daily_rollup.item_id
+    ) AS recorded ON recorded.item_id = item.id
+    ON DUPLICATE KEY UPDATE quantity = quantity + VALUES(quantity)
@@ -0,0 +1,399 @@
+USE ###DATABASENAME###
+---
+DROP PROCEDURE IF EXISTS LogChange
+---
+CREATE PROCEDURE LogChange (
+    IN iTableName VARCHAR(64),
+    IN iRowId INTEGER,
+    IN iOperation CHAR(1)
+)
+BEGIN
+    IF @rr_capture_suppressed IS NULL THEN
+        INSERT INTO change_log (table_name, row_id, operation, created)
+            VALUES (iTableName, iRowId, iOperation, CURRENT_TIMESTAMP(3));
+    END IF;
+END
+---
+DROP PROCEDURE IF EXISTS ViewChangeLog
+---
+CREATE PROCEDURE ViewChangeLog (
+    IN iAfterSequence BIGINT,
+    IN iLimit INTEGER
+)
+BEGIN
+    SELECT id AS sequence, table_name, row_id, operation
+        FROM change_log
+        WHERE id > iAfterSequence
+        ORDER BY id
+        LIMIT iLimit;
+END
+---
+DROP PROCEDURE IF EXISTS UpdateSyncWatermark
+---
+CREATE PROCEDURE UpdateSyncWatermark (
+    IN iName VARCHAR(32),
+    IN iSequence BIGINT
+)
+BEGIN
+    INSERT INTO sync_watermark (name, sequence, last_edited)
+        VALUES (iName, iSequence, CURRENT_TIMESTAMP(3))
+        ON DUPLICATE KEY UPDATE sequence = iSequence, last_edited = CURRENT_TIMESTAMP(3);
+END
+---
+DROP PROCEDURE IF EXISTS AcknowledgeChangeLog
+---
+CREATE PROCEDURE AcknowledgeChangeLog (
+    IN iSequence BIGINT
+)
+BEGIN
+    CALL UpdateSyncWatermark('pushed', iSequence);
+    DELETE FROM change_log WHERE id <= iSequence;
+END
+---
+DROP TRIGGER IF EXISTS category_insert_change
+---
+CREATE TRIGGER category_insert_change AFTER INSERT ON category FOR EACH ROW CALL LogChange('category', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS category_update_change
+---
+CREATE TRIGGER category_update_change AFTER UPDATE ON category FOR EACH ROW CALL LogChange('category', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS category_delete_change
+---
+CREATE TRIGGER category_delete_change AFTER DELETE ON category FOR EACH ROW CALL LogChange('category', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS client_insert_change
+---
+CREATE TRIGGER client_insert_change AFTER INSERT ON client FOR EACH ROW CALL LogChange('client', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS client_update_change
+---
+CREATE TRIGGER client_update_change AFTER UPDATE ON client FOR EACH ROW CALL LogChange('client', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS client_delete_change
+---
+CREATE TRIGGER client_delete_change AFTER DELETE ON client FOR EACH ROW CALL LogChange('client', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS credit_payment_insert_change
+---
+CREATE TRIGGER credit_payment_insert_change AFTER INSERT ON credit_payment FOR EACH ROW CALL LogChange('credit_payment', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS credit_payment_update_change
+---
+CREATE TRIGGER credit_payment_update_change AFTER UPDATE ON credit_payment FOR EACH ROW CALL LogChange('credit_payment', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS credit_payment_delete_change
+---
+CREATE TRIGGER credit_payment_delete_change AFTER DELETE ON credit_payment FOR EACH ROW CALL LogChange('credit_payment', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS creditor_insert_change
+---
+CREATE TRIGGER creditor_insert_change AFTER INSERT ON creditor FOR EACH ROW CALL LogChange('creditor', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS creditor_update_change
+---
+CREATE TRIGGER creditor_update_change AFTER UPDATE ON creditor FOR EACH ROW CALL LogChange('creditor', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS creditor_delete_change
+---
+CREATE TRIGGER creditor_delete_change AFTER DELETE ON creditor FOR EACH ROW CALL LogChange('creditor', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS credit_transaction_insert_change
+---
+CREATE TRIGGER credit_transaction_insert_change AFTER INSERT ON credit_transaction FOR EACH ROW CALL LogChange('credit_transaction', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS credit_transaction_update_change
+---
+CREATE TRIGGER credit_transaction_update_change AFTER UPDATE ON credit_transaction FOR EACH ROW CALL LogChange('credit_transaction', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS credit_transaction_delete_change
+---
+CREATE TRIGGER credit_transaction_delete_change AFTER DELETE ON credit_transaction FOR EACH ROW CALL LogChange('credit_transaction', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS current_quantity_insert_change
+---
+CREATE TRIGGER current_quantity_insert_change AFTER INSERT ON current_quantity FOR EACH ROW CALL LogChange('current_quantity', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS current_quantity_update_change
+---
+CREATE TRIGGER current_quantity_update_change AFTER UPDATE ON current_quantity FOR EACH ROW CALL LogChange('current_quantity', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS current_quantity_delete_change
+---
+CREATE TRIGGER current_quantity_delete_change AFTER DELETE ON current_quantity FOR EACH ROW CALL LogChange('current_quantity', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS customer_insert_change
+---
+CREATE TRIGGER customer_insert_change AFTER INSERT ON customer FOR EACH ROW CALL LogChange('customer', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS customer_update_change
+---
+CREATE TRIGGER customer_update_change AFTER UPDATE ON customer FOR EACH ROW CALL LogChange('customer', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS customer_delete_change
+---
+CREATE TRIGGER customer_delete_change AFTER DELETE ON customer FOR EACH ROW CALL LogChange('customer', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS damaged_quantity_insert_change
+---
+CREATE TRIGGER damaged_quantity_insert_change AFTER INSERT ON damaged_quantity FOR EACH ROW CALL LogChange('damaged_quantity', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS damaged_quantity_update_change
+---
+CREATE TRIGGER damaged_quantity_update_change AFTER UPDATE ON damaged_quantity FOR EACH ROW CALL LogChange('damaged_quantity', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS damaged_quantity_delete_change
+---
+CREATE TRIGGER damaged_quantity_delete_change AFTER DELETE ON damaged_quantity FOR EACH ROW CALL LogChange('damaged_quantity', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS debt_payment_insert_change
+---
+CREATE TRIGGER debt_payment_insert_change AFTER INSERT ON debt_payment FOR EACH ROW CALL LogChange('debt_payment', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS debt_payment_update_change
+---
+CREATE TRIGGER debt_payment_update_change AFTER UPDATE ON debt_payment FOR EACH ROW CALL LogChange('debt_payment', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS debt_payment_delete_change
+---
+CREATE TRIGGER debt_payment_delete_change AFTER DELETE ON debt_payment FOR EACH ROW CALL LogChange('debt_payment', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS debt_transaction_insert_change
+---
+CREATE TRIGGER debt_transaction_insert_change AFTER INSERT ON debt_transaction FOR EACH ROW CALL LogChange('debt_transaction', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS debt_transaction_update_change
+---
+CREATE TRIGGER debt_transaction_update_change AFTER UPDATE ON debt_transaction FOR EACH ROW CALL LogChange('debt_transaction', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS debt_transaction_delete_change
+---
+CREATE TRIGGER debt_transaction_delete_change AFTER DELETE ON debt_transaction FOR EACH ROW CALL LogChange('debt_transaction', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS debtor_insert_change
+---
+CREATE TRIGGER debtor_insert_change AFTER INSERT ON debtor FOR EACH ROW CALL LogChange('debtor', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS debtor_update_change
+---
+CREATE TRIGGER debtor_update_change AFTER UPDATE ON debtor FOR EACH ROW CALL LogChange('debtor', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS debtor_delete_change
+---
+CREATE TRIGGER debtor_delete_change AFTER DELETE ON debtor FOR EACH ROW CALL LogChange('debtor', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS expense_insert_change
+---
+CREATE TRIGGER expense_insert_change AFTER INSERT ON expense FOR EACH ROW CALL LogChange('expense', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS expense_update_change
+---
+CREATE TRIGGER expense_update_change AFTER UPDATE ON expense FOR EACH ROW CALL LogChange('expense', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS expense_delete_change
+---
+CREATE TRIGGER expense_delete_change AFTER DELETE ON expense FOR EACH ROW CALL LogChange('expense', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS expense_payment_insert_change
+---
+CREATE TRIGGER expense_payment_insert_change AFTER INSERT ON expense_payment FOR EACH ROW CALL LogChange('expense_payment', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS expense_payment_update_change
+---
+CREATE TRIGGER expense_payment_update_change AFTER UPDATE ON expense_payment FOR EACH ROW CALL LogChange('expense_payment', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS expense_payment_delete_change
+---
+CREATE TRIGGER expense_payment_delete_change AFTER DELETE ON expense_payment FOR EACH ROW CALL LogChange('expense_payment', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS expense_purpose_insert_change
+---
+CREATE TRIGGER expense_purpose_insert_change AFTER INSERT ON expense_purpose FOR EACH ROW CALL LogChange('expense_purpose', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS expense_purpose_update_change
+---
+CREATE TRIGGER expense_purpose_update_change AFTER UPDATE ON expense_purpose FOR EACH ROW CALL LogChange('expense_purpose', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS expense_purpose_delete_change
+---
+CREATE TRIGGER expense_purpose_delete_change AFTER DELETE ON expense_purpose FOR EACH ROW CALL LogChange('expense_purpose', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS income_insert_change
+---
+CREATE TRIGGER income_insert_change AFTER INSERT ON income FOR EACH ROW CALL LogChange('income', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS income_update_change
+---
+CREATE TRIGGER income_update_change AFTER UPDATE ON income FOR EACH ROW CALL LogChange('income', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS income_delete_change
+---
+CREATE TRIGGER income_delete_change AFTER DELETE ON income FOR EACH ROW CALL LogChange('income', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS income_payment_insert_change
+---
+CREATE TRIGGER income_payment_insert_change AFTER INSERT ON income_payment FOR EACH ROW CALL LogChange('income_payment', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS income_payment_update_change
+---
+CREATE TRIGGER income_payment_update_change AFTER UPDATE ON income_payment FOR EACH ROW CALL LogChange('income_payment', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS income_payment_delete_change
+---
+CREATE TRIGGER income_payment_delete_change AFTER DELETE ON income_payment FOR EACH ROW CALL LogChange('income_payment', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS income_purpose_insert_change
+---
+CREATE TRIGGER income_purpose_insert_change AFTER INSERT ON income_purpose FOR EACH ROW CALL LogChange('income_purpose', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS income_purpose_update_change
+---
+CREATE TRIGGER income_purpose_update_change AFTER UPDATE ON income_purpose FOR EACH ROW CALL LogChange('income_purpose', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS income_purpose_delete_change
+---
+CREATE TRIGGER income_purpose_delete_change AFTER DELETE ON income_purpose FOR EACH ROW CALL LogChange('income_purpose', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS initial_quantity_insert_change
+---
+CREATE TRIGGER initial_quantity_insert_change AFTER INSERT ON initial_quantity FOR EACH ROW CALL LogChange('initial_quantity', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS initial_quantity_update_change
+---
+CREATE TRIGGER initial_quantity_update_change AFTER UPDATE ON initial_quantity FOR EACH ROW CALL LogChange('initial_quantity', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS initial_quantity_delete_change
+---
+CREATE TRIGGER initial_quantity_delete_change AFTER DELETE ON initial_quantity FOR EACH ROW CALL LogChange('initial_quantity', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS item_insert_change
+---
+CREATE TRIGGER item_insert_change AFTER INSERT ON item FOR EACH ROW CALL LogChange('item', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS item_update_change
+---
+CREATE TRIGGER item_update_change AFTER UPDATE ON item FOR EACH ROW CALL LogChange('item', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS item_delete_change
+---
+CREATE TRIGGER item_delete_change AFTER DELETE ON item FOR EACH ROW CALL LogChange('item', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS note_insert_change
+---
+CREATE TRIGGER note_insert_change AFTER INSERT ON note FOR EACH ROW CALL LogChange('note', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS note_update_change
+---
+CREATE TRIGGER note_update_change AFTER UPDATE ON note FOR EACH ROW CALL LogChange('note', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS note_delete_change
+---
+CREATE TRIGGER note_delete_change AFTER DELETE ON note FOR EACH ROW CALL LogChange('note', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS purchase_item_insert_change
+---
+CREATE TRIGGER purchase_item_insert_change AFTER INSERT ON purchase_item FOR EACH ROW CALL LogChange('purchase_item', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS purchase_item_update_change
+---
+CREATE TRIGGER purchase_item_update_change AFTER UPDATE ON purchase_item FOR EACH ROW CALL LogChange('purchase_item', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS purchase_item_delete_change
+---
+CREATE TRIGGER purchase_item_delete_change AFTER DELETE ON purchase_item FOR EACH ROW CALL LogChange('purchase_item', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS purchase_payment_insert_change
+---
+CREATE TRIGGER purchase_payment_insert_change AFTER INSERT ON purchase_payment FOR EACH ROW CALL LogChange('purchase_payment', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS purchase_payment_update_change
+---
+CREATE TRIGGER purchase_payment_update_change AFTER UPDATE ON purchase_payment FOR EACH ROW CALL LogChange('purchase_payment', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS purchase_payment_delete_change
+---
+CREATE TRIGGER purchase_payment_delete_change AFTER DELETE ON purchase_payment FOR EACH ROW CALL LogChange('purchase_payment', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS purchase_transaction_insert_change
+---
+CREATE TRIGGER purchase_transaction_insert_change AFTER INSERT ON purchase_transaction FOR EACH ROW CALL LogChange('purchase_transaction', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS purchase_transaction_update_change
+---
+CREATE TRIGGER purchase_transaction_update_change AFTER UPDATE ON purchase_transaction FOR EACH ROW CALL LogChange('purchase_transaction', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS purchase_transaction_delete_change
+---
+CREATE TRIGGER purchase_transaction_delete_change AFTER DELETE ON purchase_transaction FOR EACH ROW CALL LogChange('purchase_transaction', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS sale_item_insert_change
+---
+CREATE TRIGGER sale_item_insert_change AFTER INSERT ON sale_item FOR EACH ROW CALL LogChange('sale_item', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS sale_item_update_change
+---
+CREATE TRIGGER sale_item_update_change AFTER UPDATE ON sale_item FOR EACH ROW CALL LogChange('sale_item', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS sale_item_delete_change
+---
+CREATE TRIGGER sale_item_delete_change AFTER DELETE ON sale_item FOR EACH ROW CALL LogChange('sale_item', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS sale_payment_insert_change
+---
+CREATE TRIGGER sale_payment_insert_change AFTER INSERT ON sale_payment FOR EACH ROW CALL LogChange('sale_payment', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS sale_payment_update_change
+---
+CREATE TRIGGER sale_payment_update_change AFTER UPDATE ON sale_payment FOR EACH ROW CALL LogChange('sale_payment', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS sale_payment_delete_change
+---
+CREATE TRIGGER sale_payment_delete_change AFTER DELETE ON sale_payment FOR EACH ROW CALL LogChange('sale_payment', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS sale_transaction_insert_change
+---
+CREATE TRIGGER sale_transaction_insert_change AFTER INSERT ON sale_transaction FOR EACH ROW CALL LogChange('sale_transaction', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS sale_transaction_update_change
+---
+CREATE TRIGGER sale_transaction_update_change AFTER UPDATE ON sale_transaction FOR EACH ROW CALL LogChange('sale_transaction', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS sale_transaction_delete_change
+---
+CREATE TRIGGER sale_transaction_delete_change AFTER DELETE ON sale_transaction FOR EACH ROW CALL LogChange('sale_transaction', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS unit_insert_change
+---
+CREATE TRIGGER unit_insert_change AFTER INSERT ON unit FOR EACH ROW CALL LogChange('unit', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS unit_update_change
+---
+CREATE TRIGGER unit_update_change AFTER UPDATE ON unit FOR EACH ROW CALL LogChange('unit', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS unit_delete_change
+---
+CREATE TRIGGER unit_delete_change AFTER DELETE ON unit FOR EACH ROW CALL LogChange('unit', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS unit_relation_insert_change
+---
+CREATE TRIGGER unit_relation_insert_change AFTER INSERT ON unit_relation FOR EACH ROW CALL LogChange('unit_relation', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS unit_relation_update_change
+---
+CREATE TRIGGER unit_relation_update_change AFTER UPDATE ON unit_relation FOR EACH ROW CALL LogChange('unit_relation', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS unit_relation_delete_change
+---
+CREATE TRIGGER unit_relation_delete_change AFTER DELETE ON unit_relation FOR EACH ROW CALL LogChange('unit_relation', OLD.id, 'D')
+---
+DROP TRIGGER IF EXISTS vendor_insert_change
+---
+CREATE TRIGGER vendor_insert_change AFTER INSERT ON vendor FOR EACH ROW CALL LogChange('vendor', NEW.id, 'I')
+---
+DROP TRIGGER IF EXISTS vendor_update_change
+---
+CREATE TRIGGER vendor_update_change AFTER UPDATE ON vendor FOR EACH ROW CALL LogChange('vendor', NEW.id, 'U')
+---
+DROP TRIGGER IF EXISTS vendor_delete_change
+---
+CREATE TRIGGER vendor_delete_change AFTER DELETE ON vendor FOR EACH ROW CALL LogChange('vendor', OLD.id, 'D')
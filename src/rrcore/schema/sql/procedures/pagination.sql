@@ -0,0 +1,88 @@
+USE ###DATABASENAME###
+---
+DROP PROCEDURE IF EXISTS ViewSaleTransactionsPage
+---
+CREATE PROCEDURE ViewSaleTransactionsPage (
+    IN iSuspended TINYINT,
+    IN iArchived TINYINT,
+    IN iFrom DATETIME,
+    IN iTo DATETIME,
+    IN iAfterCreated DATETIME,
+    IN iAfterId INTEGER,
+    IN iLimit INTEGER
+)
+BEGIN
+    SELECT sale_transaction.id AS transaction_id, sale_transaction.client_id AS client_id,
+        sale_transaction.name AS customer_name, sale_transaction.total_cost AS total_cost,
+        sale_transaction.amount_paid AS amount_paid, sale_transaction.balance AS balance,
+        sale_transaction.discount AS discount, sale_transaction.note_id AS note_id, note.note AS note,
+        sale_transaction.suspended AS suspended, sale_transaction.archived AS archived,
+        sale_transaction.created AS created, sale_transaction.last_edited AS last_edited,
+        sale_transaction.user_id AS user_id
+    FROM sale_transaction
+    LEFT JOIN note ON sale_transaction.note_id = note.id
+    WHERE ((iSuspended = 1 AND iArchived = 1)
+            OR (sale_transaction.suspended = iSuspended AND sale_transaction.archived = iArchived))
+        AND sale_transaction.created BETWEEN IFNULL(iFrom, '1970-01-01 00:00:00') AND IFNULL(iTo, CURRENT_TIMESTAMP())
+        AND (iAfterCreated IS NULL
+            OR sale_transaction.created < iAfterCreated
+            OR (sale_transaction.created = iAfterCreated AND sale_transaction.id < iAfterId))
+    ORDER BY sale_transaction.created DESC, sale_transaction.id DESC
+    LIMIT iLimit;
+END
+---
+DROP PROCEDURE IF EXISTS ViewPurchaseTransactionsPage
+---
+CREATE PROCEDURE ViewPurchaseTransactionsPage (
+    IN iSuspended TINYINT,
+    IN iArchived TINYINT,
+    IN iFrom DATETIME,
+    IN iTo DATETIME,
+    IN iAfterCreated DATETIME,
+    IN iAfterId INTEGER,
+    IN iLimit INTEGER
+)
+BEGIN
+    SELECT purchase_transaction.id AS transaction_id, purchase_transaction.client_id AS client_id,
+        purchase_transaction.name AS customer_name, purchase_transaction.total_cost AS total_cost,
+        purchase_transaction.amount_paid AS amount_paid, purchase_transaction.balance AS balance,
+        purchase_transaction.discount AS discount, purchase_transaction.note_id AS note_id, note.note AS note,
+        purchase_transaction.suspended AS suspended, purchase_transaction.archived AS archived,
+        purchase_transaction.created AS created, purchase_transaction.last_edited AS last_edited,
+        purchase_transaction.user_id AS user_id
+    FROM purchase_transaction
+    LEFT JOIN note ON purchase_transaction.note_id = note.id
+    WHERE ((iSuspended = 1 AND iArchived = 1)
+            OR (purchase_transaction.suspended = iSuspended AND purchase_transaction.archived = iArchived))
+        AND purchase_transaction.created BETWEEN IFNULL(iFrom, '1970-01-01 00:00:00') AND IFNULL(iTo, CURRENT_TIMESTAMP())
+        AND (iAfterCreated IS NULL
+            OR purchase_transaction.created < iAfterCreated
+            OR (purchase_transaction.created = iAfterCreated AND purchase_transaction.id < iAfterId))
+    ORDER BY purchase_transaction.created DESC, purchase_transaction.id DESC
+    LIMIT iLimit;
+END
+---
+DROP PROCEDURE IF EXISTS ViewClientsPage
+---
+CREATE PROCEDURE ViewClientsPage (
+    IN iFilterColumn VARCHAR(20),
+    IN iFilterText VARCHAR(100),
+    IN iArchived TINYINT,
+    IN iAfterCreated DATETIME,
+    IN iAfterId INTEGER,
+    IN iLimit INTEGER
+)
+BEGIN
+    SELECT client.id AS client_id, client.preferred_name AS preferred_name,
+        client.phone_number AS phone_number, client.created AS created
+    FROM client
+    WHERE client.archived = IFNULL(iArchived, 0)
+        AND (iFilterText IS NULL OR iFilterText = ''
+            OR (iFilterColumn = 'preferred_name' AND client.preferred_name LIKE CONCAT('%', iFilterText, '%'))
+            OR (iFilterColumn = 'phone_number' AND client.phone_number LIKE CONCAT('%', iFilterText, '%')))
+        AND (iAfterCreated IS NULL
+            OR client.created < iAfterCreated
+            OR (client.created = iAfterCreated AND client.id < iAfterId))
+    ORDER BY client.created DESC, client.id DESC
+    LIMIT iLimit;
+END
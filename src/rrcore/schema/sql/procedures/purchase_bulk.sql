@@ -0,0 +1,81 @@
+USE ###DATABASENAME###
+---
+DROP PROCEDURE IF EXISTS AddPurchasePayments
+---
+CREATE PROCEDURE AddPurchasePayments (
+    IN iPurchaseTransactionId INTEGER,
+    IN iPayments JSON,
+    IN iCurrency VARCHAR(4),
+    IN iNote VARCHAR(200),
+    IN iUserId INTEGER
+)
+BEGIN
+    DECLARE noteId INTEGER DEFAULT NULL;
+
+    IF iNote IS NOT NULL AND TRIM(iNote) <> '' THEN
+        INSERT INTO note (note, table_name, created, last_edited, user_id)
+            VALUES (iNote, 'purchase_payment', CURRENT_TIMESTAMP(), CURRENT_TIMESTAMP(), iUserId);
+        SET noteId = LAST_INSERT_ID();
+    END IF;
+
+    INSERT INTO purchase_payment (purchase_transaction_id, amount, method, currency, note_id, created, last_edited, user_id)
+        SELECT iPurchaseTransactionId, payment.amount, payment.method, iCurrency, noteId,
+            CURRENT_TIMESTAMP(), CURRENT_TIMESTAMP(), iUserId
+        FROM JSON_TABLE(iPayments, '$[*]' COLUMNS (
+            amount DECIMAL(19,2) PATH '$.amount',
+            method VARCHAR(20) PATH '$.method'
+        )) AS payment;
+END
+---
+DROP PROCEDURE IF EXISTS AddPurchaseItems
+---
+CREATE PROCEDURE AddPurchaseItems (
+    IN iPurchaseTransactionId INTEGER,
+    IN iItems JSON,
+    IN iAddQuantity TINYINT,
+    IN iReason VARCHAR(30),
+    IN iCurrency VARCHAR(4),
+    IN iUserId INTEGER
+)
+BEGIN
+    IF iAddQuantity = 1 THEN
+        INSERT INTO initial_quantity (item_id, quantity, unit_id, reason, archived, created, last_edited, user_id)
+            SELECT current_quantity.item_id, current_quantity.quantity, current_quantity.unit_id, iReason, 0,
+                CURRENT_TIMESTAMP(), CURRENT_TIMESTAMP(), iUserId
+            FROM current_quantity
+            WHERE current_quantity.item_id IN (SELECT cart_item.item_id FROM JSON_TABLE(iItems, '$[*]' COLUMNS (
+                item_id INTEGER PATH '$.item_id'
+            )) AS cart_item)
+            FOR UPDATE;
+
+        UPDATE current_quantity
+            INNER JOIN unit AS current_unit ON current_unit.id = current_quantity.unit_id
+            INNER JOIN (
+                SELECT cart_item.item_id, SUM(cart_item.quantity * bought_unit.base_unit_equivalent) AS base_quantity
+                FROM JSON_TABLE(iItems, '$[*]' COLUMNS (
+                    item_id INTEGER PATH '$.item_id',
+                    unit_id INTEGER PATH '$.unit_id',
+                    quantity DOUBLE PATH '$.quantity'
+                )) AS cart_item
+                INNER JOIN unit AS bought_unit ON bought_unit.id = cart_item.unit_id
+                GROUP BY cart_item.item_id
+            ) AS addition ON addition.item_id = current_quantity.item_id
+            SET current_quantity.quantity = current_quantity.quantity + (addition.base_quantity / current_unit.base_unit_equivalent),
+                current_quantity.last_edited = CURRENT_TIMESTAMP(),
+                current_quantity.user_id = iUserId;
+    END IF;
+
+    INSERT INTO purchase_item (purchase_transaction_id, item_id, unit_price, quantity, unit_id, cost, discount,
+                                currency, note_id, archived, created, last_edited, user_id)
+        SELECT iPurchaseTransactionId, cart_item.item_id, cart_item.unit_price, cart_item.quantity, cart_item.unit_id,
+            cart_item.cost, IFNULL(cart_item.discount, 0), iCurrency, NULL, 0,
+            CURRENT_TIMESTAMP(), CURRENT_TIMESTAMP(), iUserId
+        FROM JSON_TABLE(iItems, '$[*]' COLUMNS (
+            item_id INTEGER PATH '$.item_id',
+            unit_id INTEGER PATH '$.unit_id',
+            unit_price DECIMAL(19,2) PATH '$.unit_price',
+            quantity DOUBLE PATH '$.quantity',
+            cost DECIMAL(19,2) PATH '$.cost',
+            discount DECIMAL(19,2) PATH '$.discount'
+        )) AS cart_item;
+END
@@ -0,0 +1,538 @@
+USE ###DATABASENAME###
+---
+DROP PROCEDURE IF EXISTS RollUpSaleItem
+---
+CREATE PROCEDURE RollUpSaleItem (
+    IN iSaleTransactionId INTEGER,
+    IN iItemId INTEGER,
+    IN iUnitId INTEGER,
+    IN iQuantity DOUBLE,
+    IN iAmount DECIMAL(19,2)
+)
+BEGIN
+    INSERT INTO sale_daily_rollup (day, item_id, unit_id, quantity, total_amount)
+        SELECT DATE(sale_transaction.created), iItemId, iUnitId, iQuantity, iAmount
+        FROM sale_transaction
+        WHERE sale_transaction.id = iSaleTransactionId
+            AND sale_transaction.archived = 0 AND sale_transaction.suspended = 0
+        ON DUPLICATE KEY UPDATE quantity = quantity + VALUES(quantity),
+            total_amount = total_amount + VALUES(total_amount);
+END
+---
+DROP PROCEDURE IF EXISTS RollUpSaleTransaction
+---
+CREATE PROCEDURE RollUpSaleTransaction (
+    IN iSaleTransactionId INTEGER,
+    IN iDay DATE,
+    IN iSign INTEGER
+)
+BEGIN
+    INSERT INTO sale_daily_rollup (day, item_id, unit_id, quantity, total_amount)
+        SELECT iDay, sale_item.item_id, sale_item.unit_id,
+            iSign * SUM(sale_item.quantity), iSign * SUM(sale_item.cost)
+        FROM sale_item
+        WHERE sale_item.sale_transaction_id = iSaleTransactionId AND sale_item.archived = 0
+        GROUP BY sale_item.item_id, sale_item.unit_id
+        ON DUPLICATE KEY UPDATE quantity = quantity + VALUES(quantity),
+            total_amount = total_amount + VALUES(total_amount);
+END
+---
+DROP PROCEDURE IF EXISTS RollUpSaleRevenue
+---
+CREATE PROCEDURE RollUpSaleRevenue (
+    IN iDay DATE,
+    IN iAmountPaid DECIMAL(19,2)
+)
+BEGIN
+    INSERT INTO sale_revenue_daily_rollup (day, amount_paid)
+        VALUES (iDay, iAmountPaid)
+        ON DUPLICATE KEY UPDATE amount_paid = amount_paid + VALUES(amount_paid);
+END
+---
+DROP PROCEDURE IF EXISTS RollUpPurchaseItem
+---
+CREATE PROCEDURE RollUpPurchaseItem (
+    IN iPurchaseTransactionId INTEGER,
+    IN iItemId INTEGER,
+    IN iUnitId INTEGER,
+    IN iQuantity DOUBLE,
+    IN iAmount DECIMAL(19,2)
+)
+BEGIN
+    INSERT INTO purchase_daily_rollup (day, item_id, unit_id, quantity, total_amount)
+        SELECT DATE(purchase_transaction.created), iItemId, iUnitId, iQuantity, iAmount
+        FROM purchase_transaction
+        WHERE purchase_transaction.id = iPurchaseTransactionId
+            AND purchase_transaction.archived = 0 AND purchase_transaction.suspended = 0
+        ON DUPLICATE KEY UPDATE quantity = quantity + VALUES(quantity),
+            total_amount = total_amount + VALUES(total_amount);
+END
+---
+DROP PROCEDURE IF EXISTS RollUpPurchaseTransaction
+---
+CREATE PROCEDURE RollUpPurchaseTransaction (
+    IN iPurchaseTransactionId INTEGER,
+    IN iDay DATE,
+    IN iSign INTEGER
+)
+BEGIN
+    INSERT INTO purchase_daily_rollup (day, item_id, unit_id, quantity, total_amount)
+        SELECT iDay, purchase_item.item_id, purchase_item.unit_id,
+            iSign * SUM(purchase_item.quantity), iSign * SUM(purchase_item.cost)
+        FROM purchase_item
+        WHERE purchase_item.purchase_transaction_id = iPurchaseTransactionId AND purchase_item.archived = 0
+        GROUP BY purchase_item.item_id, purchase_item.unit_id
+        ON DUPLICATE KEY UPDATE quantity = quantity + VALUES(quantity),
+            total_amount = total_amount + VALUES(total_amount);
+END
+---
+DROP PROCEDURE IF EXISTS RollUpStockChange
+---
+CREATE PROCEDURE RollUpStockChange (
+    IN iItemId INTEGER,
+    IN iUnitId INTEGER,
+    IN iQuantity DOUBLE
+)
+BEGIN
+    INSERT INTO stock_daily_rollup (day, item_id, quantity)
+        SELECT CURRENT_DATE(), iItemId, iQuantity * unit.base_unit_equivalent
+        FROM unit
+        WHERE unit.id = iUnitId AND iItemId IS NOT NULL
+        ON DUPLICATE KEY UPDATE quantity = quantity + VALUES(quantity);
+END
+---
+DROP PROCEDURE IF EXISTS RollUpIncome
+---
+CREATE PROCEDURE RollUpIncome (
+    IN iDay DATE,
+    IN iPurpose VARCHAR(100),
+    IN iAmount DECIMAL(19,2)
+)
+BEGIN
+    INSERT INTO income_daily_rollup (day, purpose, amount)
+        VALUES (iDay, iPurpose, iAmount)
+        ON DUPLICATE KEY UPDATE amount = amount + VALUES(amount);
+END
+---
+DROP PROCEDURE IF EXISTS RollUpExpense
+---
+CREATE PROCEDURE RollUpExpense (
+    IN iDay DATE,
+    IN iPurpose VARCHAR(100),
+    IN iAmount DECIMAL(19,2)
+)
+BEGIN
+    INSERT INTO expense_daily_rollup (day, purpose, amount)
+        VALUES (iDay, iPurpose, iAmount)
+        ON DUPLICATE KEY UPDATE amount = amount + VALUES(amount);
+END
+---
+DROP TRIGGER IF EXISTS sale_item_insert_rollup
+---
+CREATE TRIGGER sale_item_insert_rollup AFTER INSERT ON sale_item FOR EACH ROW
+BEGIN
+    IF NEW.archived = 0 THEN
+        CALL RollUpSaleItem(NEW.sale_transaction_id, NEW.item_id, NEW.unit_id, NEW.quantity, NEW.cost);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS sale_item_update_rollup
+---
+CREATE TRIGGER sale_item_update_rollup AFTER UPDATE ON sale_item FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpSaleItem(OLD.sale_transaction_id, OLD.item_id, OLD.unit_id, -OLD.quantity, -OLD.cost);
+    END IF;
+    IF NEW.archived = 0 THEN
+        CALL RollUpSaleItem(NEW.sale_transaction_id, NEW.item_id, NEW.unit_id, NEW.quantity, NEW.cost);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS sale_item_delete_rollup
+---
+CREATE TRIGGER sale_item_delete_rollup AFTER DELETE ON sale_item FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpSaleItem(OLD.sale_transaction_id, OLD.item_id, OLD.unit_id, -OLD.quantity, -OLD.cost);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS sale_transaction_insert_rollup
+---
+CREATE TRIGGER sale_transaction_insert_rollup AFTER INSERT ON sale_transaction FOR EACH ROW
+BEGIN
+    IF NEW.archived = 0 AND NEW.suspended = 0 THEN
+        CALL RollUpSaleRevenue(DATE(NEW.created), NEW.amount_paid);
+        CALL RollUpSaleTransaction(NEW.id, DATE(NEW.created), 1);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS sale_transaction_update_rollup
+---
+CREATE TRIGGER sale_transaction_update_rollup AFTER UPDATE ON sale_transaction FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 AND OLD.suspended = 0 THEN
+        CALL RollUpSaleRevenue(DATE(OLD.created), -OLD.amount_paid);
+    END IF;
+    IF NEW.archived = 0 AND NEW.suspended = 0 THEN
+        CALL RollUpSaleRevenue(DATE(NEW.created), NEW.amount_paid);
+    END IF;
+
+    IF (OLD.archived = 0 AND OLD.suspended = 0) <> (NEW.archived = 0 AND NEW.suspended = 0)
+            OR DATE(OLD.created) <> DATE(NEW.created) THEN
+        IF OLD.archived = 0 AND OLD.suspended = 0 THEN
+            CALL RollUpSaleTransaction(OLD.id, DATE(OLD.created), -1);
+        END IF;
+        IF NEW.archived = 0 AND NEW.suspended = 0 THEN
+            CALL RollUpSaleTransaction(NEW.id, DATE(NEW.created), 1);
+        END IF;
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS sale_transaction_delete_rollup
+---
+CREATE TRIGGER sale_transaction_delete_rollup AFTER DELETE ON sale_transaction FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 AND OLD.suspended = 0 THEN
+        CALL RollUpSaleRevenue(DATE(OLD.created), -OLD.amount_paid);
+        CALL RollUpSaleTransaction(OLD.id, DATE(OLD.created), -1);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS purchase_item_insert_rollup
+---
+CREATE TRIGGER purchase_item_insert_rollup AFTER INSERT ON purchase_item FOR EACH ROW
+BEGIN
+    IF NEW.archived = 0 THEN
+        CALL RollUpPurchaseItem(NEW.purchase_transaction_id, NEW.item_id, NEW.unit_id, NEW.quantity, NEW.cost);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS purchase_item_update_rollup
+---
+CREATE TRIGGER purchase_item_update_rollup AFTER UPDATE ON purchase_item FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpPurchaseItem(OLD.purchase_transaction_id, OLD.item_id, OLD.unit_id, -OLD.quantity, -OLD.cost);
+    END IF;
+    IF NEW.archived = 0 THEN
+        CALL RollUpPurchaseItem(NEW.purchase_transaction_id, NEW.item_id, NEW.unit_id, NEW.quantity, NEW.cost);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS purchase_item_delete_rollup
+---
+CREATE TRIGGER purchase_item_delete_rollup AFTER DELETE ON purchase_item FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpPurchaseItem(OLD.purchase_transaction_id, OLD.item_id, OLD.unit_id, -OLD.quantity, -OLD.cost);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS purchase_transaction_insert_rollup
+---
+CREATE TRIGGER purchase_transaction_insert_rollup AFTER INSERT ON purchase_transaction FOR EACH ROW
+BEGIN
+    IF NEW.archived = 0 AND NEW.suspended = 0 THEN
+        CALL RollUpPurchaseTransaction(NEW.id, DATE(NEW.created), 1);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS purchase_transaction_update_rollup
+---
+CREATE TRIGGER purchase_transaction_update_rollup AFTER UPDATE ON purchase_transaction FOR EACH ROW
+BEGIN
+    IF (OLD.archived = 0 AND OLD.suspended = 0) <> (NEW.archived = 0 AND NEW.suspended = 0)
+            OR DATE(OLD.created) <> DATE(NEW.created) THEN
+        IF OLD.archived = 0 AND OLD.suspended = 0 THEN
+            CALL RollUpPurchaseTransaction(OLD.id, DATE(OLD.created), -1);
+        END IF;
+        IF NEW.archived = 0 AND NEW.suspended = 0 THEN
+            CALL RollUpPurchaseTransaction(NEW.id, DATE(NEW.created), 1);
+        END IF;
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS purchase_transaction_delete_rollup
+---
+CREATE TRIGGER purchase_transaction_delete_rollup AFTER DELETE ON purchase_transaction FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 AND OLD.suspended = 0 THEN
+        CALL RollUpPurchaseTransaction(OLD.id, DATE(OLD.created), -1);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS current_quantity_insert_rollup
+---
+CREATE TRIGGER current_quantity_insert_rollup AFTER INSERT ON current_quantity FOR EACH ROW
+BEGIN
+    CALL RollUpStockChange(NEW.item_id, NEW.unit_id, NEW.quantity);
+END
+---
+DROP TRIGGER IF EXISTS current_quantity_update_rollup
+---
+CREATE TRIGGER current_quantity_update_rollup AFTER UPDATE ON current_quantity FOR EACH ROW
+BEGIN
+    IF NOT (OLD.item_id <=> NEW.item_id) OR OLD.unit_id <> NEW.unit_id OR OLD.quantity <> NEW.quantity THEN
+        CALL RollUpStockChange(OLD.item_id, OLD.unit_id, -OLD.quantity);
+        CALL RollUpStockChange(NEW.item_id, NEW.unit_id, NEW.quantity);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS current_quantity_delete_rollup
+---
+CREATE TRIGGER current_quantity_delete_rollup AFTER DELETE ON current_quantity FOR EACH ROW
+BEGIN
+    CALL RollUpStockChange(OLD.item_id, OLD.unit_id, -OLD.quantity);
+END
+---
+DROP TRIGGER IF EXISTS income_insert_rollup
+---
+CREATE TRIGGER income_insert_rollup AFTER INSERT ON income FOR EACH ROW
+BEGIN
+    IF NEW.archived = 0 THEN
+        CALL RollUpIncome(DATE(NEW.created), NEW.purpose, NEW.amount_paid);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS income_update_rollup
+---
+CREATE TRIGGER income_update_rollup AFTER UPDATE ON income FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpIncome(DATE(OLD.created), OLD.purpose, -OLD.amount_paid);
+    END IF;
+    IF NEW.archived = 0 THEN
+        CALL RollUpIncome(DATE(NEW.created), NEW.purpose, NEW.amount_paid);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS income_delete_rollup
+---
+CREATE TRIGGER income_delete_rollup AFTER DELETE ON income FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpIncome(DATE(OLD.created), OLD.purpose, -OLD.amount_paid);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS expense_insert_rollup
+---
+CREATE TRIGGER expense_insert_rollup AFTER INSERT ON expense FOR EACH ROW
+BEGIN
+    IF NEW.archived = 0 THEN
+        CALL RollUpExpense(DATE(NEW.created), NEW.purpose, NEW.amount_paid);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS expense_update_rollup
+---
+CREATE TRIGGER expense_update_rollup AFTER UPDATE ON expense FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpExpense(DATE(OLD.created), OLD.purpose, -OLD.amount_paid);
+    END IF;
+    IF NEW.archived = 0 THEN
+        CALL RollUpExpense(DATE(NEW.created), NEW.purpose, NEW.amount_paid);
+    END IF;
+END
+---
+DROP TRIGGER IF EXISTS expense_delete_rollup
+---
+CREATE TRIGGER expense_delete_rollup AFTER DELETE ON expense FOR EACH ROW
+BEGIN
+    IF OLD.archived = 0 THEN
+        CALL RollUpExpense(DATE(OLD.created), OLD.purpose, -OLD.amount_paid);
+    END IF;
+END
+---
+DROP PROCEDURE IF EXISTS ViewSaleRollupReport
+---
+CREATE PROCEDURE ViewSaleRollupReport (
+    IN iFrom DATETIME,
+    IN iTo DATETIME,
+    IN iFilterColumn VARCHAR(20),
+    IN iFilterText VARCHAR(100),
+    IN iSortColumn VARCHAR(20),
+    IN iSortOrder VARCHAR(15)
+)
+BEGIN
+    SELECT category.id AS category_id, category.category AS category,
+        item.id AS item_id, item.item AS item, unit.id AS unit_id, unit.unit AS unit,
+        SUM(sale_daily_rollup.quantity) AS quantity_sold,
+        SUM(sale_daily_rollup.total_amount) AS total_amount
+    FROM sale_daily_rollup
+    INNER JOIN item ON item.id = sale_daily_rollup.item_id
+    INNER JOIN category ON category.id = item.category_id
+    INNER JOIN unit ON unit.id = sale_daily_rollup.unit_id
+    WHERE sale_daily_rollup.day BETWEEN DATE(IFNULL(iFrom, '1970-01-01 00:00:00')) AND DATE(IFNULL(iTo, CURRENT_TIMESTAMP()))
+        AND (iFilterText IS NULL OR iFilterText = ''
+            OR (iFilterColumn = 'category' AND category.category LIKE CONCAT('%', iFilterText, '%'))
+            OR (iFilterColumn = 'item' AND item.item LIKE CONCAT('%', iFilterText, '%')))
+    GROUP BY category.id, item.id, unit.id
+    HAVING total_amount <> 0 OR ROUND(quantity_sold, 6) <> 0
+    ORDER BY
+        CASE WHEN iSortOrder = 'descending' THEN NULL
+            WHEN iSortColumn = 'item' THEN item.item ELSE category.category END ASC,
+        CASE WHEN iSortOrder = 'descending' THEN
+            CASE WHEN iSortColumn = 'item' THEN item.item ELSE category.category END END DESC,
+        item.item ASC;
+END
+---
+DROP PROCEDURE IF EXISTS ViewPurchaseRollupReport
+---
+CREATE PROCEDURE ViewPurchaseRollupReport (
+    IN iFrom DATETIME,
+    IN iTo DATETIME,
+    IN iFilterColumn VARCHAR(20),
+    IN iFilterText VARCHAR(100),
+    IN iSortColumn VARCHAR(20),
+    IN iSortOrder VARCHAR(15)
+)
+BEGIN
+    SELECT category.id AS category_id, category.category AS category,
+        item.id AS item_id, item.item AS item, unit.id AS unit_id, unit.unit AS unit,
+        SUM(purchase_daily_rollup.quantity) AS quantity_bought,
+        SUM(purchase_daily_rollup.total_amount) AS total_amount
+    FROM purchase_daily_rollup
+    INNER JOIN item ON item.id = purchase_daily_rollup.item_id
+    INNER JOIN category ON category.id = item.category_id
+    INNER JOIN unit ON unit.id = purchase_daily_rollup.unit_id
+    WHERE purchase_daily_rollup.day BETWEEN DATE(IFNULL(iFrom, '1970-01-01 00:00:00')) AND DATE(IFNULL(iTo, CURRENT_TIMESTAMP()))
+        AND (iFilterText IS NULL OR iFilterText = ''
+            OR (iFilterColumn = 'category' AND category.category LIKE CONCAT('%', iFilterText, '%'))
+            OR (iFilterColumn = 'item' AND item.item LIKE CONCAT('%', iFilterText, '%')))
+    GROUP BY category.id, item.id, unit.id
+    HAVING total_amount <> 0 OR ROUND(quantity_bought, 6) <> 0
+    ORDER BY
+        CASE WHEN iSortOrder = 'descending' THEN NULL
+            WHEN iSortColumn = 'item' THEN item.item ELSE category.category END ASC,
+        CASE WHEN iSortOrder = 'descending' THEN
+            CASE WHEN iSortColumn = 'item' THEN item.item ELSE category.category END END DESC,
+        item.item ASC;
+END
+---
+DROP PROCEDURE IF EXISTS ViewIncomeRollupReport
+---
+CREATE PROCEDURE ViewIncomeRollupReport (
+    IN iFrom DATETIME,
+    IN iTo DATETIME,
+    IN iFilterColumn VARCHAR(20),
+    IN iFilterText VARCHAR(100),
+    IN iSortColumn VARCHAR(20),
+    IN iSortOrder VARCHAR(15)
+)
+BEGIN
+    SELECT income_daily_rollup.purpose AS purpose, SUM(income_daily_rollup.amount) AS amount
+    FROM income_daily_rollup
+    WHERE income_daily_rollup.day BETWEEN DATE(IFNULL(iFrom, '1970-01-01 00:00:00')) AND DATE(IFNULL(iTo, CURRENT_TIMESTAMP()))
+        AND (iFilterText IS NULL OR iFilterText = ''
+            OR (iFilterColumn = 'purpose' AND income_daily_rollup.purpose LIKE CONCAT('%', iFilterText, '%')))
+    GROUP BY income_daily_rollup.purpose
+    HAVING amount <> 0
+    ORDER BY
+        CASE WHEN iSortOrder = 'descending' OR iSortColumn <> 'amount' THEN NULL
+            ELSE SUM(income_daily_rollup.amount) END ASC,
+        CASE WHEN iSortOrder = 'descending' AND iSortColumn = 'amount' THEN SUM(income_daily_rollup.amount) END DESC,
+        CASE WHEN iSortOrder = 'descending' THEN NULL ELSE income_daily_rollup.purpose END ASC,
+        CASE WHEN iSortOrder = 'descending' THEN income_daily_rollup.purpose END DESC;
+END
+---
+DROP PROCEDURE IF EXISTS ViewExpenseRollupReport
+---
+CREATE PROCEDURE ViewExpenseRollupReport (
+    IN iFrom DATETIME,
+    IN iTo DATETIME,
+    IN iFilterColumn VARCHAR(20),
+    IN iFilterText VARCHAR(100),
+    IN iSortColumn VARCHAR(20),
+    IN iSortOrder VARCHAR(15)
+)
+BEGIN
+    SELECT expense_daily_rollup.purpose AS purpose, SUM(expense_daily_rollup.amount) AS amount
+    FROM expense_daily_rollup
+    WHERE expense_daily_rollup.day BETWEEN DATE(IFNULL(iFrom, '1970-01-01 00:00:00')) AND DATE(IFNULL(iTo, CURRENT_TIMESTAMP()))
+        AND (iFilterText IS NULL OR iFilterText = ''
+            OR (iFilterColumn = 'purpose' AND expense_daily_rollup.purpose LIKE CONCAT('%', iFilterText, '%')))
+    GROUP BY expense_daily_rollup.purpose
+    HAVING amount <> 0
+    ORDER BY
+        CASE WHEN iSortOrder = 'descending' OR iSortColumn <> 'amount' THEN NULL
+            ELSE SUM(expense_daily_rollup.amount) END ASC,
+        CASE WHEN iSortOrder = 'descending' AND iSortColumn = 'amount' THEN SUM(expense_daily_rollup.amount) END DESC,
+        CASE WHEN iSortOrder = 'descending' THEN NULL ELSE expense_daily_rollup.purpose END ASC,
+        CASE WHEN iSortOrder = 'descending' THEN expense_daily_rollup.purpose END DESC;
+END
+---
+DROP PROCEDURE IF EXISTS ViewStockRollupReport
+---
+CREATE PROCEDURE ViewStockRollupReport (
+    IN iFrom DATETIME,
+    IN iTo DATETIME,
+    IN iFilterColumn VARCHAR(20),
+    IN iFilterText VARCHAR(100),
+    IN iSortColumn VARCHAR(20),
+    IN iSortOrder VARCHAR(15)
+)
+BEGIN
+    DECLARE fromDay DATE DEFAULT DATE(IFNULL(iFrom, '1970-01-01 00:00:00'));
+    DECLARE toDay DATE DEFAULT DATE(IFNULL(iTo, CURRENT_TIMESTAMP()));
+
+    SELECT category.id AS category_id, category.category AS category,
+        item.id AS item_id, item.item AS item, unit.id AS unit_id, unit.unit AS unit,
+        current_quantity.quantity - IFNULL(stock_change.since_from, 0) / unit.base_unit_equivalent
+            AS opening_stock_quantity,
+        IFNULL(sold.in_range, 0) / unit.base_unit_equivalent AS quantity_sold,
+        IFNULL(bought.in_range, 0) / unit.base_unit_equivalent AS quantity_bought,
+        current_quantity.quantity AS quantity_in_stock
+    FROM item
+    INNER JOIN category ON category.id = item.category_id
+    INNER JOIN current_quantity ON current_quantity.item_id = item.id
+    INNER JOIN unit ON unit.id = current_quantity.unit_id
+    LEFT JOIN (
+        SELECT stock_daily_rollup.item_id, SUM(stock_daily_rollup.quantity) AS since_from
+        FROM stock_daily_rollup
+        WHERE stock_daily_rollup.day >= fromDay
+        GROUP BY stock_daily_rollup.item_id
+    ) AS stock_change ON stock_change.item_id = item.id
+    LEFT JOIN (
+        SELECT sale_daily_rollup.item_id,
+            SUM(sale_daily_rollup.quantity * sold_unit.base_unit_equivalent) AS in_range
+        FROM sale_daily_rollup
+        INNER JOIN unit AS sold_unit ON sold_unit.id = sale_daily_rollup.unit_id
+        WHERE sale_daily_rollup.day BETWEEN fromDay AND toDay
+        GROUP BY sale_daily_rollup.item_id
+    ) AS sold ON sold.item_id = item.id
+    LEFT JOIN (
+        SELECT purchase_daily_rollup.item_id,
+            SUM(purchase_daily_rollup.quantity * bought_unit.base_unit_equivalent) AS in_range
+        FROM purchase_daily_rollup
+        INNER JOIN unit AS bought_unit ON bought_unit.id = purchase_daily_rollup.unit_id
+        WHERE purchase_daily_rollup.day BETWEEN fromDay AND toDay
+        GROUP BY purchase_daily_rollup.item_id
+    ) AS bought ON bought.item_id = item.id
+    WHERE item.archived = 0
+        AND (iFilterText IS NULL OR iFilterText = ''
+            OR (iFilterColumn = 'category' AND category.category LIKE CONCAT('%', iFilterText, '%'))
+            OR (iFilterColumn = 'item' AND item.item LIKE CONCAT('%', iFilterText, '%')))
+    ORDER BY
+        CASE WHEN iSortOrder = 'descending' THEN NULL
+            WHEN iSortColumn = 'item' THEN item.item ELSE category.category END ASC,
+        CASE WHEN iSortOrder = 'descending' THEN
+            CASE WHEN iSortColumn = 'item' THEN item.item ELSE category.category END END DESC,
+        item.item ASC;
+END
+---
+DROP PROCEDURE IF EXISTS GetRollupTotalRevenue
+---
+CREATE PROCEDURE GetRollupTotalRevenue (
+    IN iFromDate DATE,
+    IN iToDate DATE
+)
+BEGIN
+    SELECT sale_revenue_daily_rollup.day AS created, sale_revenue_daily_rollup.amount_paid AS amount_paid
+    FROM sale_revenue_daily_rollup
+    WHERE sale_revenue_daily_rollup.day BETWEEN IFNULL(iFromDate, '1970-01-01') AND IFNULL(iToDate, CURRENT_DATE())
+        AND sale_revenue_daily_rollup.amount_paid <> 0
+    ORDER BY sale_revenue_daily_rollup.day;
+END
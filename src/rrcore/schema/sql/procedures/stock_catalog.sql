@@ -0,0 +1,23 @@
+USE ###DATABASENAME###
+---
+DROP PROCEDURE IF EXISTS ViewStockCatalog
+---
+CREATE PROCEDURE ViewStockCatalog (
+    IN iItemIds JSON
+)
+BEGIN
+    SELECT item.id AS item_id, item.category_id AS category_id, category.category AS category,
+        item.item AS item, item.description AS description, item.barcode AS barcode,
+        item.divisible AS divisible, unit.id AS unit_id, unit.unit AS unit,
+        current_quantity.quantity AS quantity, unit.cost_price AS cost_price,
+        unit.retail_price AS retail_price, unit.currency AS currency
+    FROM item
+    INNER JOIN category ON category.id = item.category_id
+    INNER JOIN current_quantity ON current_quantity.item_id = item.id
+    INNER JOIN unit ON unit.id = current_quantity.unit_id
+    WHERE item.archived = 0
+        AND (iItemIds IS NULL
+            OR item.id IN (SELECT requested_item.item_id FROM JSON_TABLE(iItemIds, '$[*]' COLUMNS (
+                item_id INTEGER PATH '$'
+            )) AS requested_item));
+END
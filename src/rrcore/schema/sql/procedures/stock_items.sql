@@ -0,0 +1,74 @@
+USE ###DATABASENAME###
+---
+DROP PROCEDURE IF EXISTS ViewStockItemList
+---
+CREATE PROCEDURE ViewStockItemList (
+    IN iCategoryId INTEGER,
+    IN iSortOrder VARCHAR(15)
+)
+BEGIN
+    SELECT item.id AS item_id, item.category_id AS category_id, category.category AS category,
+        item.item AS item, item.description AS description, item.divisible AS divisible,
+        SHA1(item.image) AS image_hash, current_quantity.quantity AS quantity,
+        unit.id AS unit_id, unit.unit AS unit, unit.cost_price AS cost_price,
+        unit.retail_price AS retail_price, unit.currency AS currency,
+        item.created AS created, item.last_edited AS last_edited, user.user AS user
+    FROM item
+    INNER JOIN category ON category.id = item.category_id
+    INNER JOIN current_quantity ON current_quantity.item_id = item.id
+    INNER JOIN unit ON unit.id = current_quantity.unit_id
+    LEFT JOIN user ON user.id = item.user_id
+    WHERE item.archived = 0
+        AND item.category_id = iCategoryId
+    ORDER BY
+        CASE WHEN iSortOrder = 'descending' THEN NULL ELSE item.item END ASC,
+        CASE WHEN iSortOrder = 'descending' THEN item.item END DESC;
+END
+---
+DROP PROCEDURE IF EXISTS FilterStockItemList
+---
+CREATE PROCEDURE FilterStockItemList (
+    IN iCategoryId INTEGER,
+    IN iFilterText VARCHAR(200),
+    IN iFilterColumn VARCHAR(20),
+    IN iSortOrder VARCHAR(15),
+    IN iSortColumn VARCHAR(20)
+)
+BEGIN
+    SELECT item.id AS item_id, item.category_id AS category_id, category.category AS category,
+        item.item AS item, item.description AS description, item.divisible AS divisible,
+        SHA1(item.image) AS image_hash, current_quantity.quantity AS quantity,
+        unit.id AS unit_id, unit.unit AS unit, unit.cost_price AS cost_price,
+        unit.retail_price AS retail_price, unit.currency AS currency,
+        item.created AS created, item.last_edited AS last_edited, user.user AS user
+    FROM item
+    INNER JOIN category ON category.id = item.category_id
+    INNER JOIN current_quantity ON current_quantity.item_id = item.id
+    INNER JOIN unit ON unit.id = current_quantity.unit_id
+    LEFT JOIN user ON user.id = item.user_id
+    WHERE item.archived = 0
+        AND item.category_id = iCategoryId
+        AND CASE iFilterColumn
+            WHEN 'category' THEN category.category
+            WHEN 'description' THEN item.description
+            ELSE item.item
+        END LIKE CONCAT('%', iFilterText, '%')
+    ORDER BY
+        CASE WHEN iSortColumn = 'quantity' AND iSortOrder <> 'descending' THEN current_quantity.quantity END ASC,
+        CASE WHEN iSortColumn = 'quantity' AND iSortOrder = 'descending' THEN current_quantity.quantity END DESC,
+        CASE WHEN iSortColumn = 'cost_price' AND iSortOrder <> 'descending' THEN unit.cost_price END ASC,
+        CASE WHEN iSortColumn = 'cost_price' AND iSortOrder = 'descending' THEN unit.cost_price END DESC,
+        CASE WHEN iSortOrder = 'descending' THEN NULL ELSE item.item END ASC,
+        CASE WHEN iSortOrder = 'descending' THEN item.item END DESC;
+END
+---
+DROP PROCEDURE IF EXISTS ViewStockItemImage
+---
+CREATE PROCEDURE ViewStockItemImage (
+    IN iItemId INTEGER
+)
+BEGIN
+    SELECT HEX(item.image) AS image
+    FROM item
+    WHERE item.id = iItemId;
+END
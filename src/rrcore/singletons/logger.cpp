@@ -41,10 +41,7 @@ void messageHandler(QtMsgType type, const QMessageLogContext &context, const QSt
 Logger::Logger() :
     m_enabled(true)
 {
-    const QString &logFileName = m_settings.value("log_file_name", LOG_FILE).toString();
-    m_logFile.setFileName(logFileName);
-    m_logFile.open(QFile::WriteOnly);
-    m_logFile.resize(0);
+    m_logFile.setFileName(m_settings.value("log_file_name", LOG_FILE).toString());
 }
 
 Logger &Logger::instance()
@@ -92,5 +89,13 @@ void Logger::logToFile(const QByteArray &log)
 
     static QMutex mutex;
     QMutexLocker lock(&mutex);
+
+    // NOTE: The file is opened (and truncated) with the first message, not at launch.
+    // If that fails, it is not tried again.
+    if (!m_logFile.isOpen()) {
+        if (m_logFile.error() != QFile::NoError || !m_logFile.open(QFile::WriteOnly | QFile::Truncate))
+            return;
+    }
+
     m_logFile.write(log);
 }
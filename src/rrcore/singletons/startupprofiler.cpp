@@ -0,0 +1,229 @@
+#include "startupprofiler.h"
+
+#include <QQuickWindow>
+#include <QTimer>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+
+Q_LOGGING_CATEGORY(startupProfiler, "rrcore.singletons.startupprofiler");
+
+StartupProfiler::Phase::Phase(const QString &name) :
+    m_name(name),
+    m_start(StartupProfiler::instance().elapsed())
+{
+
+}
+
+StartupProfiler::Phase::~Phase()
+{
+    StartupProfiler::instance().recordPhase(m_name, m_start, StartupProfiler::instance().elapsed());
+}
+
+StartupProfiler::StartupProfiler(QObject *parent) :
+    StartupProfiler(FIRST_FRAME_TIMEOUT, parent)
+{
+
+}
+
+StartupProfiler::StartupProfiler(int firstFrameTimeout, QObject *parent) :
+    QObject(parent),
+    m_lastMark(0),
+    m_firstFrameTimer(nullptr),
+    m_firstFrameTimeout(firstFrameTimeout),
+    m_firstFrameShown(false),
+    m_finished(false)
+{
+    m_clock.start();
+}
+
+StartupProfiler &StartupProfiler::instance()
+{
+    static StartupProfiler instance;
+    return instance;
+}
+
+qint64 StartupProfiler::elapsed() const
+{
+    return m_clock.elapsed();
+}
+
+void StartupProfiler::mark(const QString &phase)
+{
+    const qint64 now = elapsed();
+    recordPhase(phase, m_lastMark, now);
+    m_lastMark = now;
+}
+
+void StartupProfiler::recordPhase(const QString &phase, qint64 start, qint64 end)
+{
+    if (m_finished)
+        return;
+
+    m_spans.append(Span{ phase, QStringLiteral("phase"), start, end });
+}
+
+void StartupProfiler::beginQuery(QObject *receiver, const QString &name)
+{
+    if (m_finished || !receiver)
+        return;
+
+    m_pendingQueries.insert(receiver, Span{ name, QStringLiteral("query"), elapsed(), -1 });
+}
+
+void StartupProfiler::endQuery(QObject *receiver)
+{
+    if (m_finished || m_pendingQueries.isEmpty())
+        return;
+
+    auto iter = m_pendingQueries.find(receiver);
+    if (iter == m_pendingQueries.end())
+        return;
+
+    Span span = iter.value();
+    span.end = elapsed();
+    m_spans.append(span);
+    m_pendingQueries.erase(iter);
+
+    if (m_firstFrameShown && m_pendingQueries.isEmpty())
+        finish();
+}
+
+void StartupProfiler::watch(QQuickWindow *window)
+{
+    if (!window || m_firstFrameShown)
+        return;
+
+    // NOTE: frameSwapped is emitted on the render thread, so this is a queued connection.
+    auto connection = QSharedPointer<QMetaObject::Connection>::create();
+    *connection = connect(window, &QQuickWindow::frameSwapped, this, [this, connection]() {
+        QObject::disconnect(*connection);
+        showFirstFrame(QStringLiteral("first_frame"));
+    }, Qt::QueuedConnection);
+}
+
+void StartupProfiler::runAfterFirstFrame(QObject *context, std::function<void()> task)
+{
+    if (m_firstFrameShown) {
+        QTimer::singleShot(0, context, task);
+        return;
+    }
+
+    m_deferredTasks.append(qMakePair(QPointer<QObject>(context), task));
+
+    // NOTE: Without a window (e.g. in tests) there is no first frame to wait for.
+    if (!m_firstFrameTimer) {
+        m_firstFrameTimer = new QTimer(this);
+        m_firstFrameTimer->setSingleShot(true);
+        connect(m_firstFrameTimer, &QTimer::timeout, this, [this]() {
+            showFirstFrame(QStringLiteral("first_frame_timeout"));
+        });
+        m_firstFrameTimer->start(m_firstFrameTimeout);
+    }
+}
+
+bool StartupProfiler::isFirstFrameShown() const
+{
+    return m_firstFrameShown;
+}
+
+bool StartupProfiler::isFinished() const
+{
+    return m_finished;
+}
+
+QJsonObject StartupProfiler::toJson() const
+{
+    QJsonArray spans;
+    for (const Span &span : m_spans)
+        spans.append(QJsonObject {
+                         { "name", span.name },
+                         { "category", span.category },
+                         { "start_ms", span.start },
+                         { "duration_ms", span.end - span.start }
+                     });
+
+    QJsonArray pendingQueries;
+    for (const Span &span : m_pendingQueries)
+        pendingQueries.append(span.name);
+
+    return QJsonObject {
+        { "generated", QDateTime::currentDateTime().toString(Qt::ISODate) },
+        { "spans", spans },
+        { "pending_queries", pendingQueries }
+    };
+}
+
+bool StartupProfiler::dump(const QString &filePath) const
+{
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath()))
+        return false;
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(startupProfiler) << "Failed to open" << filePath << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(toJson()).toJson());
+    if (!file.commit()) {
+        qCWarning(startupProfiler) << "Failed to write" << filePath << file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+QString StartupProfiler::defaultDumpPath()
+{
+    return QStringLiteral("%1/diagnostics/startup_trace.json")
+            .arg(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+}
+
+void StartupProfiler::showFirstFrame(const QString &reason)
+{
+    if (m_firstFrameShown)
+        return;
+
+    m_firstFrameShown = true;
+    if (m_firstFrameTimer)
+        m_firstFrameTimer->stop();
+
+    recordPhase(reason, 0, elapsed());
+    qCInfo(startupProfiler) << "First frame after" << elapsed() << "ms.";
+    emit firstFrameShown();
+
+    // NOTE: Deferred work starts from the event loop, so the frame is not held up any longer.
+    const auto deferredTasks = m_deferredTasks;
+    m_deferredTasks.clear();
+    for (const auto &deferredTask : deferredTasks) {
+        if (deferredTask.first)
+            QTimer::singleShot(0, deferredTask.first.data(), deferredTask.second);
+    }
+
+    if (m_pendingQueries.isEmpty())
+        finish();
+    else
+        QTimer::singleShot(MAX_TRACE_DURATION, this, &StartupProfiler::finish);
+}
+
+void StartupProfiler::finish()
+{
+    if (m_finished)
+        return;
+
+    m_finished = true;
+    for (const Span &span : m_spans)
+        qCInfo(startupProfiler).nospace() << span.category << " " << span.name << ": start=" << span.start
+                                          << "ms, duration=" << span.end - span.start << "ms";
+    for (const Span &span : m_pendingQueries)
+        qCInfo(startupProfiler) << "Query still pending:" << span.name;
+
+    dump(defaultDumpPath());
+    m_pendingQueries.clear();
+}
@@ -0,0 +1,89 @@
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QPointer>
+#include <QHash>
+#include <QList>
+#include <QLoggingCategory>
+#include <functional>
+
+class QQuickWindow;
+class QTimer;
+
+// Trace of the time from launch to the first frame.
+// Sequential phases of main() are recorded with mark(), nested ones with a
+// Phase on the stack, and every query a model runs from componentComplete()
+// is recorded from the moment it is issued to the moment its result arrives.
+// The trace is logged and written to disk once the first frame is shown and
+// those queries have returned.
+// Work that is not needed to show the first frame is queued with
+// runAfterFirstFrame(). Only use this class on the GUI thread.
+class StartupProfiler : public QObject
+{
+    Q_OBJECT
+public:
+    static const int FIRST_FRAME_TIMEOUT = 10 * 1000; // milliseconds
+    static const int MAX_TRACE_DURATION = 30 * 1000; // milliseconds
+
+    class Phase
+    {
+    public:
+        explicit Phase(const QString &name);
+        ~Phase();
+    private:
+        QString m_name;
+        qint64 m_start;
+    };
+
+    explicit StartupProfiler(int firstFrameTimeout, QObject *parent = nullptr); // For testing
+
+    static StartupProfiler &instance();
+
+    StartupProfiler(StartupProfiler const &) = delete;
+    void operator=(StartupProfiler const &) = delete;
+
+    qint64 elapsed() const;
+    void mark(const QString &phase);
+    void recordPhase(const QString &phase, qint64 start, qint64 end);
+    void beginQuery(QObject *receiver, const QString &name);
+    void endQuery(QObject *receiver);
+
+    void watch(QQuickWindow *window);
+    void runAfterFirstFrame(QObject *context, std::function<void()> task);
+    bool isFirstFrameShown() const;
+    bool isFinished() const;
+
+    QJsonObject toJson() const;
+    bool dump(const QString &filePath) const;
+    static QString defaultDumpPath();
+signals:
+    void firstFrameShown();
+private:
+    struct Span {
+        QString name;
+        QString category;
+        qint64 start;
+        qint64 end;
+    };
+
+    QElapsedTimer m_clock;
+    qint64 m_lastMark;
+    QList<Span> m_spans;
+    QHash<QObject *, Span> m_pendingQueries;
+    QList<QPair<QPointer<QObject>, std::function<void()>>> m_deferredTasks;
+    QTimer *m_firstFrameTimer;
+    int m_firstFrameTimeout;
+    bool m_firstFrameShown;
+    bool m_finished;
+
+    explicit StartupProfiler(QObject *parent = nullptr);
+    void showFirstFrame(const QString &reason);
+    void finish();
+};
+
+Q_DECLARE_LOGGING_CATEGORY(startupProfiler);
+
+#endif // STARTUPPROFILER_H
@@ -0,0 +1,59 @@
+#ifndef PAGEUTILS_H
+#define PAGEUTILS_H
+
+#include <QDateTime>
+#include <QVariantList>
+#include <QVariantMap>
+
+// Position of a page in a result set ordered by (created, id), newest first.
+// The first page has no position; every following page starts after the last
+// row of the previous one.
+struct PageCursor {
+    static const int DEFAULT_PAGE_SIZE = 100;
+
+    QDateTime created;
+    int id;
+    int limit;
+
+    explicit PageCursor(int limit = DEFAULT_PAGE_SIZE) :
+        id(-1),
+        limit(limit)
+    {}
+
+    explicit PageCursor(const QDateTime &created, int id, int limit = DEFAULT_PAGE_SIZE) :
+        created(created),
+        id(id),
+        limit(limit)
+    {}
+
+    explicit PageCursor(const QVariantMap &params) :
+        created(params.value("after_created").toDateTime()),
+        id(params.value("after_id", -1).toInt()),
+        limit(params.value("limit").toInt())
+    {}
+
+    inline bool isFirstPage() const { return id <= 0 || !created.isValid(); }
+    inline bool isPaginated() const { return limit > 0; }
+
+    inline QVariantMap toVariantMap() const {
+        return {
+            { "after_created", isFirstPage() ? QVariant(QVariant::DateTime) : created },
+            { "after_id", isFirstPage() ? QVariant(QVariant::Int) : id },
+            { "limit", limit }
+        };
+    }
+
+    // Pages are fetched with one extra row, which is only used to tell
+    // whether another page follows.
+    inline int fetchLimit() const { return limit + 1; }
+
+    inline bool trim(QVariantList &records) const {
+        if (records.count() <= limit)
+            return false;
+
+        records.erase(records.begin() + limit, records.end());
+        return true;
+    }
+};
+
+#endif // PAGEUTILS_H
@@ -0,0 +1,288 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/queryexecutor.h"
+#include "database/databaseexception.h"
+#include "database/preparedstatementcache.h"
+#include "testdatabase.h"
+
+class ProcedureCaller : public QueryExecutor
+{
+public:
+    explicit ProcedureCaller(const QString &connectionName) :
+        QueryExecutor()
+    {
+        setConnectionName(connectionName);
+    }
+
+    using QueryExecutor::callProcedure;
+};
+
+class BulkProceduresTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    BulkProceduresTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testAddSaleItems();
+    void testAddSaleItemsRejectsInsufficientQuantity();
+    void testAddSalePayments();
+    void testAddPurchaseItems();
+    void testAddPurchasePayments();
+private:
+    QScopedPointer<TestDatabase> m_database;
+
+    void addItems(const QString &procedure, int transactionId, const QVariantList &items, bool updateQuantity);
+    void addPayments(const QString &procedure, int transactionId, const QVariantList &payments, const QString &note);
+    double currentQuantity();
+};
+
+BulkProceduresTest::BulkProceduresTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void BulkProceduresTest::init()
+{
+    m_database.reset(new TestDatabase(QStringLiteral("rr_test_bulk_procedures")));
+    if (!m_database->isOpen())
+        QSKIP(qPrintable(QStringLiteral("No MySQL server: %1").arg(m_database->errorString())));
+
+    QVERIFY2(m_database->run(QStringLiteral("procedures/sales_bulk.sql")), qPrintable(m_database->errorString()));
+    QVERIFY2(m_database->run(QStringLiteral("procedures/purchase_bulk.sql")), qPrintable(m_database->errorString()));
+
+    // STEP: Stock 30 pieces of one item, which is also sold by the carton of 12.
+    const QStringList statements {
+        QStringLiteral("INSERT INTO category (category, archived, created, last_edited, user_id) "
+                       "VALUES ('Drinks', 0, NOW(), NOW(), 1)"),
+        QStringLiteral("INSERT INTO item (category_id, item, archived, created, last_edited, user_id) "
+                       "VALUES (1, 'Coke', 0, NOW(), NOW(), 1)"),
+        QStringLiteral("INSERT INTO unit (item_id, unit, base_unit_equivalent, preferred, cost_price, retail_price, "
+                       "currency, archived, created, last_edited, user_id) "
+                       "VALUES (1, 'piece', 1, 1, 4, 5, 'NGN', 0, NOW(), NOW(), 1)"),
+        QStringLiteral("INSERT INTO unit (item_id, unit, base_unit_equivalent, preferred, cost_price, retail_price, "
+                       "currency, archived, created, last_edited, user_id) "
+                       "VALUES (1, 'carton', 12, 0, 45, 50, 'NGN', 0, NOW(), NOW(), 1)"),
+        QStringLiteral("INSERT INTO current_quantity (item_id, quantity, unit_id, created, last_edited, user_id) "
+                       "VALUES (1, 30, 1, NOW(), NOW(), 1)"),
+        QStringLiteral("INSERT INTO sale_transaction (name, total_cost, amount_paid, balance, discount, suspended, "
+                       "note_id, archived, created, last_edited, user_id) "
+                       "VALUES ('Customer', 60, 60, 0, 0, 0, 0, 0, NOW(), NOW(), 1)"),
+        QStringLiteral("INSERT INTO purchase_transaction (name, total_cost, amount_paid, balance, discount, suspended, "
+                       "archived, created, last_edited, user_id) "
+                       "VALUES ('Vendor', 45, 45, 0, 0, 0, 0, NOW(), NOW(), 1)")
+    };
+
+    for (const QString &statement : statements)
+        QVERIFY2(m_database->exec(statement), qPrintable(m_database->errorString()));
+}
+
+void BulkProceduresTest::cleanup()
+{
+    if (m_database)
+        PreparedStatementCache::instance().clear(m_database->connectionName());
+    m_database.reset();
+}
+
+void BulkProceduresTest::addItems(const QString &procedure,
+                                  int transactionId,
+                                  const QVariantList &items,
+                                  bool updateQuantity)
+{
+    ProcedureCaller caller(m_database->connectionName());
+    caller.callProcedure(procedure, {
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "transaction_id",
+                                 transactionId
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "items",
+                                 items
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "update_quantity",
+                                 updateQuantity
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "reason",
+                                 procedure
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "currency",
+                                 QStringLiteral("NGN")
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "user_id",
+                                 1
+                             }
+                         });
+}
+
+void BulkProceduresTest::addPayments(const QString &procedure,
+                                     int transactionId,
+                                     const QVariantList &payments,
+                                     const QString &note)
+{
+    ProcedureCaller caller(m_database->connectionName());
+    caller.callProcedure(procedure, {
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "transaction_id",
+                                 transactionId
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "payments",
+                                 payments
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "currency",
+                                 QStringLiteral("NGN")
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "note",
+                                 note
+                             },
+                             ProcedureArgument {
+                                 ProcedureArgument::Type::In,
+                                 "user_id",
+                                 1
+                             }
+                         });
+}
+
+double BulkProceduresTest::currentQuantity()
+{
+    return m_database->value(QStringLiteral("SELECT quantity FROM current_quantity WHERE item_id = 1")).toDouble();
+}
+
+void BulkProceduresTest::testAddSaleItems()
+{
+    // STEP: Sell 2 pieces with a discount, and a carton.
+    addItems(QStringLiteral("AddSaleItems"), 1, {
+                 QVariantMap {
+                     { "item_id", 1 },
+                     { "unit_id", 1 },
+                     { "unit_price", 5.0 },
+                     { "quantity", 2.0 },
+                     { "cost", 9.0 },
+                     { "discount", 1.0 }
+                 },
+                 QVariantMap {
+                     { "item_id", 1 },
+                     { "unit_id", 2 },
+                     { "unit_price", 50.0 },
+                     { "quantity", 1.0 },
+                     { "cost", 50.0 }
+                 }
+             }, true);
+
+    // STEP: Ensure both lines were written, and the quantity deducted in pieces.
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM sale_item WHERE sale_transaction_id = 1")).toInt(), 2);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT SUM(cost) FROM sale_item")).toDouble(), 59.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT discount FROM sale_item WHERE unit_id = 1")).toDouble(), 1.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT discount FROM sale_item WHERE unit_id = 2")).toDouble(), 0.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT currency FROM sale_item WHERE unit_id = 2")).toString(),
+             QStringLiteral("NGN"));
+    QCOMPARE(currentQuantity(), 16.0);
+
+    // STEP: Ensure the quantity before the sale was kept.
+    QCOMPARE(m_database->value(QStringLiteral("SELECT quantity FROM initial_quantity WHERE item_id = 1")).toDouble(), 30.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT reason FROM initial_quantity WHERE item_id = 1")).toString(),
+             QStringLiteral("AddSaleItems"));
+}
+
+void BulkProceduresTest::testAddSaleItemsRejectsInsufficientQuantity()
+{
+    QVERIFY_EXCEPTION_THROWN(addItems(QStringLiteral("AddSaleItems"), 1, {
+                                          QVariantMap {
+                                              { "item_id", 1 },
+                                              { "unit_id", 2 },
+                                              { "unit_price", 50.0 },
+                                              { "quantity", 3.0 },
+                                              { "cost", 150.0 }
+                                          }
+                                      }, true), DatabaseException);
+
+    // STEP: Ensure a suspended sale does not touch the quantity.
+    addItems(QStringLiteral("AddSaleItems"), 1, {
+                 QVariantMap {
+                     { "item_id", 1 },
+                     { "unit_id", 2 },
+                     { "unit_price", 50.0 },
+                     { "quantity", 3.0 },
+                     { "cost", 150.0 }
+                 }
+             }, false);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM sale_item")).toInt(), 1);
+}
+
+void BulkProceduresTest::testAddSalePayments()
+{
+    addPayments(QStringLiteral("AddSalePayments"), 1, {
+                    QVariantMap { { "amount", 10.5 }, { "method", QStringLiteral("cash") } },
+                    QVariantMap { { "amount", 49.5 }, { "method", QStringLiteral("debit_card") } }
+                }, QStringLiteral("Paid in two parts"));
+
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM sale_payment WHERE sale_transaction_id = 1")).toInt(), 2);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT SUM(amount) FROM sale_payment")).toDouble(), 60.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT amount FROM sale_payment WHERE method = 'cash'")).toDouble(), 10.5);
+
+    // STEP: Ensure the note is written once and shared by the payments.
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM note WHERE table_name = 'sale_payment'")).toInt(), 1);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(DISTINCT note_id) FROM sale_payment "
+                                              "WHERE note_id IS NOT NULL")).toInt(), 1);
+}
+
+void BulkProceduresTest::testAddPurchaseItems()
+{
+    // STEP: Buy a carton.
+    addItems(QStringLiteral("AddPurchaseItems"), 1, {
+                 QVariantMap {
+                     { "item_id", 1 },
+                     { "unit_id", 2 },
+                     { "unit_price", 45.0 },
+                     { "quantity", 1.0 },
+                     { "cost", 43.0 },
+                     { "discount", 2.0 }
+                 }
+             }, true);
+
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM purchase_item WHERE purchase_transaction_id = 1")).toInt(), 1);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT unit_id FROM purchase_item")).toInt(), 2);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT discount FROM purchase_item")).toDouble(), 2.0);
+    QCOMPARE(currentQuantity(), 42.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT quantity FROM initial_quantity WHERE item_id = 1")).toDouble(), 30.0);
+}
+
+void BulkProceduresTest::testAddPurchasePayments()
+{
+    addPayments(QStringLiteral("AddPurchasePayments"), 1, {
+                    QVariantMap { { "amount", 44.5 }, { "method", QStringLiteral("cash") } },
+                    QVariantMap { { "amount", 0.5 }, { "method", QStringLiteral("cash") } }
+                }, QString());
+
+    // STEP: Ensure amounts keep their fraction, and no empty note is written.
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM purchase_payment WHERE purchase_transaction_id = 1")).toInt(), 2);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT SUM(amount) FROM purchase_payment")).toDouble(), 45.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT MIN(amount) FROM purchase_payment")).toDouble(), 0.5);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM note")).toInt(), 0);
+    QVERIFY(m_database->value(QStringLiteral("SELECT DATE(MAX(last_edited)) FROM purchase_payment")).toDate().isValid());
+}
+
+QTEST_MAIN(BulkProceduresTest)
+
+#include "tst_bulkprocedurestest.moc"
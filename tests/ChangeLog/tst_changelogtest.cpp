@@ -0,0 +1,200 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/changelog.h"
+#include "database/databaseexception.h"
+#include "testdatabase.h"
+
+class ChangeLogTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ChangeLogTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testPulledRowsKeepLocalRows();
+    void testPushedRowsKeepTheirOrigin();
+    void testDeletedRowsRoundTrip();
+    void testUnpulledReferenceRejectsBatch();
+private:
+    static inline const QString RACK_A = QStringLiteral("rack-a");
+    static inline const QString RACK_B = QStringLiteral("rack-b");
+
+    QScopedPointer<TestDatabase> m_rackA;
+    QScopedPointer<TestDatabase> m_rackB;
+
+    bool prepare(TestDatabase &database);
+    void sync(TestDatabase &from, const QString &fromRackId, TestDatabase &to, const QString &toRackId);
+    bool addCategory(TestDatabase &database, const QString &category);
+    bool addItem(TestDatabase &database, const QString &item, int categoryId);
+};
+
+ChangeLogTest::ChangeLogTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void ChangeLogTest::init()
+{
+    m_rackA.reset(new TestDatabase(QStringLiteral("rr_test_rack_a")));
+    if (!m_rackA->isOpen())
+        QSKIP(qPrintable(QStringLiteral("No MySQL server: %1").arg(m_rackA->errorString())));
+
+    m_rackB.reset(new TestDatabase(QStringLiteral("rr_test_rack_b")));
+    QVERIFY2(m_rackB->isOpen(), qPrintable(m_rackB->errorString()));
+    QVERIFY2(prepare(*m_rackA), qPrintable(m_rackA->errorString()));
+    QVERIFY2(prepare(*m_rackB), qPrintable(m_rackB->errorString()));
+}
+
+void ChangeLogTest::cleanup()
+{
+    m_rackB.reset();
+    m_rackA.reset();
+}
+
+bool ChangeLogTest::prepare(TestDatabase &database)
+{
+    return database.run(QStringLiteral("migrations/0002_change_log.sql"))
+            && database.run(QStringLiteral("migrations/0005_sync_origin.sql"))
+            && database.run(QStringLiteral("procedures/changelog.sql"));
+}
+
+void ChangeLogTest::sync(TestDatabase &from, const QString &fromRackId, TestDatabase &to, const QString &toRackId)
+{
+    const qint64 pushedSequence = ChangeLog::watermark(from.connectionName(), ChangeLog::PUSHED_WATERMARK);
+    const QVariantMap &batch = ChangeLog::collect(from.connectionName(), fromRackId, pushedSequence, 100);
+    ChangeLog::apply(to.connectionName(), toRackId, batch.value("changes").toMap(),
+                     batch.value("last_sequence").toLongLong());
+    ChangeLog::acknowledge(from.connectionName(), batch.value("last_sequence").toLongLong());
+}
+
+bool ChangeLogTest::addCategory(TestDatabase &database, const QString &category)
+{
+    return database.exec(QStringLiteral("INSERT INTO category (category, archived, created, last_edited, user_id) "
+                                        "VALUES (?, 0, NOW(), NOW(), 1)"), { category });
+}
+
+bool ChangeLogTest::addItem(TestDatabase &database, const QString &item, int categoryId)
+{
+    return database.exec(QStringLiteral("INSERT INTO item (category_id, item, archived, created, last_edited, user_id) "
+                                        "VALUES (?, ?, 0, NOW(), NOW(), 1)"), { categoryId, item });
+}
+
+void ChangeLogTest::testPulledRowsKeepLocalRows()
+{
+    // STEP: Write a category on rack B, and a category and an item under the same ids on rack A.
+    QVERIFY2(addCategory(*m_rackB, QStringLiteral("Local")), qPrintable(m_rackB->errorString()));
+    QVERIFY2(addCategory(*m_rackA, QStringLiteral("Drinks")), qPrintable(m_rackA->errorString()));
+    QVERIFY2(addItem(*m_rackA, QStringLiteral("Coke"), 1), qPrintable(m_rackA->errorString()));
+
+    sync(*m_rackA, RACK_A, *m_rackB, RACK_B);
+
+    // STEP: Ensure the local row is untouched and the pulled rows were given new ids.
+    QCOMPARE(m_rackB->value(QStringLiteral("SELECT category FROM category WHERE id = 1")).toString(),
+             QStringLiteral("Local"));
+    const int categoryId = m_rackB->value(QStringLiteral("SELECT id FROM category WHERE category = 'Drinks'")).toInt();
+    QCOMPARE(categoryId, 2);
+    QCOMPARE(m_rackB->value(QStringLiteral("SELECT category_id FROM item WHERE item = 'Coke'")).toInt(), categoryId);
+    QCOMPARE(m_rackB->value(QStringLiteral("SELECT local_id FROM sync_origin "
+                                           "WHERE table_name = 'category' AND origin_rack_id = ? AND origin_id = 1"),
+                            { RACK_A }).toInt(), categoryId);
+    QCOMPARE(m_rackB->value(QStringLiteral("SELECT COUNT(*) FROM sync_origin")).toInt(), 2);
+
+    // STEP: Ensure pulled rows are not logged to be pushed back.
+    QCOMPARE(m_rackB->value(QStringLiteral("SELECT COUNT(*) FROM change_log")).toInt(), 1);
+}
+
+void ChangeLogTest::testPushedRowsKeepTheirOrigin()
+{
+    QVERIFY2(addCategory(*m_rackB, QStringLiteral("Local")), qPrintable(m_rackB->errorString()));
+    QVERIFY2(addCategory(*m_rackA, QStringLiteral("Drinks")), qPrintable(m_rackA->errorString()));
+    QVERIFY2(addItem(*m_rackA, QStringLiteral("Coke"), 1), qPrintable(m_rackA->errorString()));
+    sync(*m_rackA, RACK_A, *m_rackB, RACK_B);
+
+    // STEP: Edit the pulled item on rack B.
+    const int itemId = m_rackB->value(QStringLiteral("SELECT id FROM item WHERE item = 'Coke'")).toInt();
+    QVERIFY2(m_rackB->exec(QStringLiteral("UPDATE item SET description = 'Edited' WHERE id = ?"), { itemId }),
+             qPrintable(m_rackB->errorString()));
+
+    // STEP: Ensure the item and its category are sent under their ids on rack A.
+    const QVariantMap &batch = ChangeLog::collect(m_rackB->connectionName(), RACK_B, 0, 100);
+    const QVariantMap &item = batch.value("changes").toMap().value("item").toMap()
+            .value("rows").toList().first().toMap();
+    QCOMPARE(item.value("origin_rack_id").toString(), RACK_A);
+    QCOMPARE(item.value("id").toInt(), 1);
+    QCOMPARE(item.value("category_id").toMap(), QVariantMap({ { "origin_rack_id", RACK_A }, { "id", 1 } }));
+
+    sync(*m_rackB, RACK_B, *m_rackA, RACK_A);
+
+    // STEP: Ensure the edit landed on the original row, and the category of rack B was added.
+    QCOMPARE(m_rackA->value(QStringLiteral("SELECT COUNT(*) FROM item")).toInt(), 1);
+    QCOMPARE(m_rackA->value(QStringLiteral("SELECT description FROM item WHERE id = 1")).toString(),
+             QStringLiteral("Edited"));
+    QCOMPARE(m_rackA->value(QStringLiteral("SELECT category_id FROM item WHERE id = 1")).toInt(), 1);
+    QCOMPARE(m_rackA->value(QStringLiteral("SELECT id FROM category WHERE category = 'Local'")).toInt(), 2);
+    QCOMPARE(m_rackA->value(QStringLiteral("SELECT origin_rack_id FROM sync_origin WHERE local_id = 2")).toString(),
+             RACK_B);
+}
+
+void ChangeLogTest::testDeletedRowsRoundTrip()
+{
+    QVERIFY2(addCategory(*m_rackB, QStringLiteral("Local")), qPrintable(m_rackB->errorString()));
+    QVERIFY2(addCategory(*m_rackA, QStringLiteral("Drinks")), qPrintable(m_rackA->errorString()));
+    QVERIFY2(addItem(*m_rackA, QStringLiteral("Coke"), 1), qPrintable(m_rackA->errorString()));
+    sync(*m_rackA, RACK_A, *m_rackB, RACK_B);
+    sync(*m_rackB, RACK_B, *m_rackA, RACK_A);
+
+    // STEP: Delete the pulled item on rack B.
+    QVERIFY2(m_rackB->exec(QStringLiteral("DELETE FROM item WHERE item = 'Coke'")),
+             qPrintable(m_rackB->errorString()));
+
+    // STEP: Ensure it is sent as deleted under its id on rack A.
+    const QVariantMap &batch = ChangeLog::collect(m_rackB->connectionName(), RACK_B,
+                                                  ChangeLog::watermark(m_rackB->connectionName(),
+                                                                       ChangeLog::PUSHED_WATERMARK), 100);
+    QCOMPARE(batch.value("changes").toMap().value("item").toMap().value("deleted").toList(),
+             QVariantList({ QVariantMap({ { "origin_rack_id", RACK_A }, { "id", 1 } }) }));
+
+    sync(*m_rackB, RACK_B, *m_rackA, RACK_A);
+
+    QCOMPARE(m_rackA->value(QStringLiteral("SELECT COUNT(*) FROM item")).toInt(), 0);
+    QCOMPARE(m_rackA->value(QStringLiteral("SELECT COUNT(*) FROM category")).toInt(), 2);
+}
+
+void ChangeLogTest::testUnpulledReferenceRejectsBatch()
+{
+    QVERIFY2(addCategory(*m_rackB, QStringLiteral("Local")), qPrintable(m_rackB->errorString()));
+
+    // STEP: Pull an item of rack C whose category was never pulled.
+    const QVariantMap changes {
+        { "item", QVariantMap {
+                { "rows", QVariantList {
+                        QVariantMap {
+                            { "origin_rack_id", QStringLiteral("rack-c") },
+                            { "id", 5 },
+                            { "category_id", QVariantMap { { "origin_rack_id", QStringLiteral("rack-c") }, { "id", 1 } } },
+                            { "item", QStringLiteral("Fanta") },
+                            { "archived", 0 },
+                            { "created", QDateTime::currentDateTime() },
+                            { "last_edited", QDateTime::currentDateTime() },
+                            { "user_id", 1 }
+                        }
+                    } },
+                { "deleted", QVariantList() }
+            } }
+    };
+    QVERIFY_EXCEPTION_THROWN(ChangeLog::apply(m_rackB->connectionName(), RACK_B, changes, 1), DatabaseException);
+
+    // STEP: Ensure the item was not written under the id of a local category.
+    QCOMPARE(m_rackB->value(QStringLiteral("SELECT COUNT(*) FROM item")).toInt(), 0);
+    QCOMPARE(m_rackB->value(QStringLiteral("SELECT COUNT(*) FROM sync_origin")).toInt(), 0);
+    QCOMPARE(ChangeLog::watermark(m_rackB->connectionName(), ChangeLog::PULLED_WATERMARK), 0);
+}
+
+QTEST_MAIN(ChangeLogTest)
+
+#include "tst_changelogtest.moc"
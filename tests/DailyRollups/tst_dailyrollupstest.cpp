@@ -0,0 +1,273 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QSqlRecord>
+
+#include "testdatabase.h"
+
+class DailyRollupsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    DailyRollupsTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testPurchaseRollupIsKeptPerUnit();
+    void testStockReportUsesBaseUnits();
+    void testOpeningStockIncludesManualEdits();
+    void testBackfill();
+private:
+    static const int ITEM_ID = 1;
+    static const int PIECE_UNIT_ID = 1;
+    static const int CARTON_UNIT_ID = 2;
+
+    QScopedPointer<TestDatabase> m_database;
+
+    bool prepare();
+    bool addItem(int daysAgo = 0);
+    int addPurchase(int daysAgo = 0);
+    int addSale(int daysAgo = 0);
+    bool addPurchaseItem(int purchaseTransactionId, int unitId, double quantity, double cost);
+    bool addSaleItem(int saleTransactionId, int unitId, double quantity, double cost);
+    bool changeStock(double quantity);
+    QList<QVariantMap> report(const QString &procedure, const QString &from);
+};
+
+DailyRollupsTest::DailyRollupsTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void DailyRollupsTest::init()
+{
+    m_database.reset(new TestDatabase(QStringLiteral("rr_test_rollups")));
+    if (!m_database->isOpen())
+        QSKIP(qPrintable(QStringLiteral("No MySQL server: %1").arg(m_database->errorString())));
+}
+
+void DailyRollupsTest::cleanup()
+{
+    m_database.reset();
+}
+
+bool DailyRollupsTest::prepare()
+{
+    return m_database->run(QStringLiteral("migrations/0004_daily_rollups.sql"))
+            && m_database->run(QStringLiteral("migrations/0006_rollup_category.sql"))
+            && m_database->run(QStringLiteral("migrations/0007_stock_rollup.sql"))
+            && m_database->run(QStringLiteral("procedures/rollups.sql"));
+}
+
+bool DailyRollupsTest::addItem(int daysAgo)
+{
+    return m_database->exec(QStringLiteral("INSERT INTO category (category, archived, created, last_edited, user_id) "
+                                           "VALUES ('Drinks', 0, NOW(), NOW(), 1)"))
+            && m_database->exec(QStringLiteral("INSERT INTO item (category_id, item, archived, created, last_edited, user_id) "
+                                               "VALUES (1, 'Coke', 0, NOW() - INTERVAL ? DAY, NOW(), 1)"), { daysAgo })
+            && m_database->exec(QStringLiteral("INSERT INTO unit (item_id, unit, base_unit_equivalent, cost_price, retail_price, "
+                                               "currency, archived, created, last_edited, user_id) "
+                                               "VALUES (1, 'piece', 1, 10, 12, 'NGN', 0, NOW(), NOW(), 1), "
+                                               "(1, 'carton', 12, 100, 120, 'NGN', 0, NOW(), NOW(), 1)"));
+}
+
+int DailyRollupsTest::addPurchase(int daysAgo)
+{
+    if (!m_database->exec(QStringLiteral("INSERT INTO purchase_transaction (name, total_cost, amount_paid, balance, discount, "
+                                         "suspended, archived, created, last_edited, user_id) "
+                                         "VALUES ('Vendor', 0, 0, 0, 0, 0, 0, NOW() - INTERVAL ? DAY, NOW(), 1)"), { daysAgo }))
+        return 0;
+
+    return m_database->value(QStringLiteral("SELECT MAX(id) FROM purchase_transaction")).toInt();
+}
+
+int DailyRollupsTest::addSale(int daysAgo)
+{
+    if (!m_database->exec(QStringLiteral("INSERT INTO sale_transaction (name, total_cost, amount_paid, balance, discount, "
+                                         "suspended, note_id, archived, created, last_edited, user_id) "
+                                         "VALUES ('Customer', 0, 0, 0, 0, 0, 0, 0, NOW() - INTERVAL ? DAY, NOW(), 1)"), { daysAgo }))
+        return 0;
+
+    return m_database->value(QStringLiteral("SELECT MAX(id) FROM sale_transaction")).toInt();
+}
+
+bool DailyRollupsTest::addPurchaseItem(int purchaseTransactionId, int unitId, double quantity, double cost)
+{
+    return m_database->exec(QStringLiteral("INSERT INTO purchase_item (purchase_transaction_id, item_id, unit_price, quantity, "
+                                           "unit_id, cost, currency, archived, created, last_edited, user_id) "
+                                           "VALUES (?, ?, 0, ?, ?, ?, 'NGN', 0, NOW(), NOW(), 1)"),
+                            { purchaseTransactionId, ITEM_ID, quantity, unitId, cost });
+}
+
+bool DailyRollupsTest::addSaleItem(int saleTransactionId, int unitId, double quantity, double cost)
+{
+    return m_database->exec(QStringLiteral("INSERT INTO sale_item (sale_transaction_id, item_id, unit_price, quantity, "
+                                           "unit_id, cost, currency, archived, created, last_edited, user_id) "
+                                           "VALUES (?, ?, 0, ?, ?, ?, 'NGN', 0, NOW(), NOW(), 1)"),
+                            { saleTransactionId, ITEM_ID, quantity, unitId, cost });
+}
+
+bool DailyRollupsTest::changeStock(double quantity)
+{
+    return m_database->exec(QStringLiteral("UPDATE current_quantity SET quantity = quantity + ? WHERE item_id = ?"),
+                            { quantity, ITEM_ID });
+}
+
+QList<QVariantMap> DailyRollupsTest::report(const QString &procedure, const QString &from)
+{
+    QSqlQuery query(m_database->query(QStringLiteral("CALL %1(%2, NULL, NULL, NULL, 'item', 'ascending')")
+                                      .arg(procedure, from)));
+    QList<QVariantMap> rows;
+    while (query.next()) {
+        QVariantMap row;
+        for (int i = 0; i < query.record().count(); ++i)
+            row.insert(query.record().fieldName(i), query.value(i));
+        rows.append(row);
+    }
+
+    // NOTE: Rows of the same item come in no particular unit order.
+    std::sort(rows.begin(), rows.end(), [](const QVariantMap &a, const QVariantMap &b) {
+        return a.value("item").toString() + a.value("unit").toString()
+                < b.value("item").toString() + b.value("unit").toString();
+    });
+
+    return rows;
+}
+
+void DailyRollupsTest::testPurchaseRollupIsKeptPerUnit()
+{
+    QVERIFY2(prepare(), qPrintable(m_database->errorString()));
+    QVERIFY2(addItem(), qPrintable(m_database->errorString()));
+
+    // STEP: Buy cartons and pieces of the same item.
+    const int purchaseTransactionId = addPurchase();
+    QVERIFY2(purchaseTransactionId > 0, qPrintable(m_database->errorString()));
+    QVERIFY2(addPurchaseItem(purchaseTransactionId, CARTON_UNIT_ID, 2, 200), qPrintable(m_database->errorString()));
+    QVERIFY2(addPurchaseItem(purchaseTransactionId, PIECE_UNIT_ID, 3, 30), qPrintable(m_database->errorString()));
+
+    // STEP: Ensure quantities are not summed across units.
+    QList<QVariantMap> rows = report(QStringLiteral("ViewPurchaseRollupReport"), QStringLiteral("NULL"));
+    QCOMPARE(rows.count(), 2);
+    QCOMPARE(rows.at(0).value("unit").toString(), QStringLiteral("carton"));
+    QCOMPARE(rows.at(0).value("quantity_bought").toDouble(), 2.0);
+    QCOMPARE(rows.at(0).value("total_amount").toDouble(), 200.0);
+    QCOMPARE(rows.at(1).value("unit").toString(), QStringLiteral("piece"));
+    QCOMPARE(rows.at(1).value("quantity_bought").toDouble(), 3.0);
+
+    // STEP: Ensure archiving an item removes it from its own unit only.
+    QVERIFY2(m_database->exec(QStringLiteral("UPDATE purchase_item SET archived = 1 WHERE unit_id = ?"), { CARTON_UNIT_ID }),
+             qPrintable(m_database->errorString()));
+    rows = report(QStringLiteral("ViewPurchaseRollupReport"), QStringLiteral("NULL"));
+    QCOMPARE(rows.count(), 1);
+    QCOMPARE(rows.at(0).value("unit").toString(), QStringLiteral("piece"));
+
+    // STEP: Ensure archiving the transaction removes the rest.
+    QVERIFY2(m_database->exec(QStringLiteral("UPDATE purchase_transaction SET archived = 1")),
+             qPrintable(m_database->errorString()));
+    QCOMPARE(report(QStringLiteral("ViewPurchaseRollupReport"), QStringLiteral("NULL")).count(), 0);
+}
+
+void DailyRollupsTest::testStockReportUsesBaseUnits()
+{
+    QVERIFY2(prepare(), qPrintable(m_database->errorString()));
+    QVERIFY2(addItem(), qPrintable(m_database->errorString()));
+    QVERIFY2(m_database->exec(QStringLiteral("INSERT INTO current_quantity (item_id, quantity, unit_id, created, last_edited, user_id) "
+                                             "VALUES (?, 10, ?, NOW(), NOW(), 1)"), { ITEM_ID, PIECE_UNIT_ID }),
+             qPrintable(m_database->errorString()));
+
+    // STEP: Buy 2 cartons and 3 pieces, and sell 1 carton.
+    const int purchaseTransactionId = addPurchase();
+    QVERIFY2(addPurchaseItem(purchaseTransactionId, CARTON_UNIT_ID, 2, 200), qPrintable(m_database->errorString()));
+    QVERIFY2(addPurchaseItem(purchaseTransactionId, PIECE_UNIT_ID, 3, 30), qPrintable(m_database->errorString()));
+    QVERIFY2(changeStock(27), qPrintable(m_database->errorString()));
+    const int saleTransactionId = addSale();
+    QVERIFY2(addSaleItem(saleTransactionId, CARTON_UNIT_ID, 1, 120), qPrintable(m_database->errorString()));
+    QVERIFY2(changeStock(-12), qPrintable(m_database->errorString()));
+
+    // STEP: Ensure quantities are reported in the unit the stock is kept in.
+    QList<QVariantMap> rows = report(QStringLiteral("ViewStockRollupReport"), QStringLiteral("CURRENT_DATE()"));
+    QCOMPARE(rows.count(), 1);
+    QCOMPARE(rows.at(0).value("unit").toString(), QStringLiteral("piece"));
+    QCOMPARE(rows.at(0).value("opening_stock_quantity").toDouble(), 0.0);
+    QCOMPARE(rows.at(0).value("quantity_bought").toDouble(), 27.0);
+    QCOMPARE(rows.at(0).value("quantity_sold").toDouble(), 12.0);
+    QCOMPARE(rows.at(0).value("quantity_in_stock").toDouble(), 25.0);
+
+    // STEP: Ensure a report that starts after today opens with the current stock.
+    rows = report(QStringLiteral("ViewStockRollupReport"), QStringLiteral("CURRENT_DATE() + INTERVAL 1 DAY"));
+    QCOMPARE(rows.count(), 1);
+    QCOMPARE(rows.at(0).value("opening_stock_quantity").toDouble(), 25.0);
+    QCOMPARE(rows.at(0).value("quantity_sold").toDouble(), 0.0);
+}
+
+void DailyRollupsTest::testOpeningStockIncludesManualEdits()
+{
+    QVERIFY2(prepare(), qPrintable(m_database->errorString()));
+    QVERIFY2(addItem(1), qPrintable(m_database->errorString()));
+    QVERIFY2(m_database->exec(QStringLiteral("INSERT INTO current_quantity (item_id, quantity, unit_id, created, last_edited, user_id) "
+                                             "VALUES (?, 10, ?, NOW(), NOW(), 1)"), { ITEM_ID, PIECE_UNIT_ID }),
+             qPrintable(m_database->errorString()));
+
+    // STEP: Move the stock that was entered to yesterday.
+    QVERIFY2(m_database->exec(QStringLiteral("UPDATE stock_daily_rollup SET day = CURRENT_DATE() - INTERVAL 1 DAY")),
+             qPrintable(m_database->errorString()));
+
+    // STEP: Edit the stock by hand today, without a sale or a purchase.
+    QVERIFY2(m_database->exec(QStringLiteral("UPDATE current_quantity SET quantity = 6 WHERE item_id = ?"), { ITEM_ID }),
+             qPrintable(m_database->errorString()));
+
+    const QList<QVariantMap> &rows = report(QStringLiteral("ViewStockRollupReport"), QStringLiteral("CURRENT_DATE()"));
+    QCOMPARE(rows.count(), 1);
+    QCOMPARE(rows.at(0).value("opening_stock_quantity").toDouble(), 10.0);
+    QCOMPARE(rows.at(0).value("quantity_sold").toDouble(), 0.0);
+    QCOMPARE(rows.at(0).value("quantity_bought").toDouble(), 0.0);
+    QCOMPARE(rows.at(0).value("quantity_in_stock").toDouble(), 6.0);
+
+    // STEP: Ensure a change of unit is not counted as a change of stock.
+    QVERIFY2(m_database->exec(QStringLiteral("UPDATE current_quantity SET quantity = 0.5, unit_id = ? WHERE item_id = ?"),
+                              { CARTON_UNIT_ID, ITEM_ID }),
+             qPrintable(m_database->errorString()));
+    QCOMPARE(m_database->value(QStringLiteral("SELECT SUM(quantity) FROM stock_daily_rollup WHERE day = CURRENT_DATE()"))
+             .toDouble(), -4.0);
+}
+
+void DailyRollupsTest::testBackfill()
+{
+    // STEP: Record an item created three days ago, bought two days ago and sold yesterday,
+    // before the rollups exist.
+    QVERIFY2(addItem(3), qPrintable(m_database->errorString()));
+    QVERIFY2(m_database->exec(QStringLiteral("INSERT INTO current_quantity (item_id, quantity, unit_id, created, last_edited, user_id) "
+                                             "VALUES (?, 25, ?, NOW(), NOW(), 1)"), { ITEM_ID, PIECE_UNIT_ID }),
+             qPrintable(m_database->errorString()));
+    const int purchaseTransactionId = addPurchase(2);
+    QVERIFY2(addPurchaseItem(purchaseTransactionId, CARTON_UNIT_ID, 2, 200), qPrintable(m_database->errorString()));
+    const int saleTransactionId = addSale(1);
+    QVERIFY2(addSaleItem(saleTransactionId, CARTON_UNIT_ID, 1, 120), qPrintable(m_database->errorString()));
+
+    QVERIFY2(prepare(), qPrintable(m_database->errorString()));
+
+    // STEP: Ensure purchases are rolled up per unit.
+    QCOMPARE(m_database->value(QStringLiteral("SELECT quantity FROM purchase_daily_rollup WHERE unit_id = ?"),
+                               { CARTON_UNIT_ID }).toDouble(), 2.0);
+
+    // STEP: Ensure stock changes add up to the stock in hand, with what is unknown put on the day the item was created.
+    QCOMPARE(m_database->value(QStringLiteral("SELECT quantity FROM stock_daily_rollup "
+                                              "WHERE day = CURRENT_DATE() - INTERVAL 3 DAY")).toDouble(), 13.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT quantity FROM stock_daily_rollup "
+                                              "WHERE day = CURRENT_DATE() - INTERVAL 2 DAY")).toDouble(), 24.0);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT quantity FROM stock_daily_rollup "
+                                              "WHERE day = CURRENT_DATE() - INTERVAL 1 DAY")).toDouble(), -12.0);
+
+    const QList<QVariantMap> &rows = report(QStringLiteral("ViewStockRollupReport"),
+                                            QStringLiteral("CURRENT_DATE() - INTERVAL 1 DAY"));
+    QCOMPARE(rows.count(), 1);
+    QCOMPARE(rows.at(0).value("opening_stock_quantity").toDouble(), 37.0);
+    QCOMPARE(rows.at(0).value("quantity_sold").toDouble(), 12.0);
+    QCOMPARE(rows.at(0).value("quantity_in_stock").toDouble(), 25.0);
+}
+
+QTEST_MAIN(DailyRollupsTest)
+
+#include "tst_dailyrollupstest.moc"
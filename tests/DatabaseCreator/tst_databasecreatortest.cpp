@@ -0,0 +1,57 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/databasecreator.h"
+
+class DatabaseCreatorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    DatabaseCreatorTest() = default;
+
+private slots:
+    void testMigrationVersion();
+    void testStatementsAreSplitOnSeparator();
+    void testCommentsAndNewLinesAreRemoved();
+};
+
+void DatabaseCreatorTest::testMigrationVersion()
+{
+    QCOMPARE(DatabaseCreator::migrationVersion(":/schema/sql/migrations/0001_schema_file.sql"), 1);
+    QCOMPARE(DatabaseCreator::migrationVersion("0012_add_rollups.sql"), 12);
+
+    // STEP: Ensure files that are not migrations are ignored.
+    QCOMPARE(DatabaseCreator::migrationVersion("schema_file.sql"), -1);
+    QCOMPARE(DatabaseCreator::migrationVersion("0003_indexes.txt"), -1);
+    QCOMPARE(DatabaseCreator::migrationVersion("0003.sql"), -1);
+}
+
+void DatabaseCreatorTest::testStatementsAreSplitOnSeparator()
+{
+    const QStringList &statements = DatabaseCreator::splitStatements(QStringLiteral("USE rr_test\n"
+                                                                                    "---\n"
+                                                                                    "CREATE PROCEDURE Test ()\n"
+                                                                                    "BEGIN\n"
+                                                                                    "\tSELECT 1;\n"
+                                                                                    "END\n"
+                                                                                    "---\n"
+                                                                                    "\n"));
+    QCOMPARE(statements, QStringList({
+                                         QStringLiteral("USE rr_test"),
+                                         QStringLiteral("CREATE PROCEDURE Test () BEGIN  SELECT 1; END")
+                                     }));
+}
+
+void DatabaseCreatorTest::testCommentsAndNewLinesAreRemoved()
+{
+    const QStringList &statements = DatabaseCreator::splitStatements(QStringLiteral("-- Create table\n"
+                                                                                    "CREATE TABLE t (\n"
+                                                                                    "/* Key */ id INT\n"
+                                                                                    ")"));
+    QCOMPARE(statements, QStringList({ QStringLiteral("CREATE TABLE t (   id INT )") }));
+}
+
+QTEST_MAIN(DatabaseCreatorTest)
+
+#include "tst_databasecreatortest.moc"
@@ -0,0 +1,186 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/queryexecutor.h"
+#include "queueddatabasethread.h"
+
+class DatabaseThreadTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    DatabaseThreadTest();
+
+private slots:
+    void testLateReadIsDropped();
+    void testReadsOfOtherCommandsAreKept();
+    void testWritesAreNotSuperseded();
+    void testCacheHitSupersedesPendingRead();
+    void testCacheHitIsSupersededByNewerRead();
+    void testReadsOfDestroyedReceiverAreDropped();
+private:
+    static inline const QString VIEW_ITEMS = QStringLiteral("view_stock_items");
+    static inline const QString VIEW_CATEGORIES = QStringLiteral("view_stock_categories");
+
+    void read(QueuedDatabaseThread &thread, QObject *receiver, const QString &command, int categoryId);
+    void listen(QueuedDatabaseThread &thread, QObject *receiver, QVariantList &outcomes);
+};
+
+DatabaseThreadTest::DatabaseThreadTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void DatabaseThreadTest::read(QueuedDatabaseThread &thread, QObject *receiver, const QString &command, int categoryId)
+{
+    emit thread.execute(new QueryExecutor(command,
+                                          QVariantMap { { "category_id", categoryId } },
+                                          QueryRequest::QueryGroup::Stock,
+                                          receiver));
+}
+
+void DatabaseThreadTest::listen(QueuedDatabaseThread &thread, QObject *receiver, QVariantList &outcomes)
+{
+    thread.addReceiver(receiver, [&outcomes](const QueryResult &result) {
+        if (result.isSuccessful())
+            outcomes.append(result.outcome());
+    });
+}
+
+void DatabaseThreadTest::testLateReadIsDropped()
+{
+    QueuedDatabaseThread thread;
+    QObject receiver;
+    QVariantList outcomes;
+    listen(thread, &receiver, outcomes);
+
+    // STEP: Issue a read, then a newer one of the same command.
+    read(thread, &receiver, VIEW_ITEMS, 1);
+    read(thread, &receiver, VIEW_ITEMS, 2);
+    QCOMPARE(thread.pendingCount(), 2);
+    QVERIFY(thread.isSuperseded(0));
+    QVERIFY(!thread.isSuperseded(1));
+
+    // STEP: Ensure only the newer read is delivered, even when the older one returns last.
+    thread.respond(1, 2);
+    thread.respond(0, 1);
+    QCOMPARE(outcomes, QVariantList({ 2 }));
+    QCOMPARE(thread.supersededCount(), 1);
+}
+
+void DatabaseThreadTest::testReadsOfOtherCommandsAreKept()
+{
+    QueuedDatabaseThread thread;
+    QObject receiver;
+    QObject otherReceiver;
+    QVariantList outcomes;
+    QVariantList otherOutcomes;
+    listen(thread, &receiver, outcomes);
+    listen(thread, &otherReceiver, otherOutcomes);
+
+    // STEP: Issue reads of two commands, and the same read from another receiver.
+    read(thread, &receiver, VIEW_ITEMS, 1);
+    read(thread, &receiver, VIEW_CATEGORIES, 1);
+    read(thread, &otherReceiver, VIEW_ITEMS, 2);
+    QCOMPARE(thread.pendingCount(), 3);
+
+    thread.respond(2, 3);
+    thread.respond(1, 2);
+    thread.respond(0, 1);
+    QCOMPARE(outcomes, QVariantList({ 2, 1 }));
+    QCOMPARE(otherOutcomes, QVariantList({ 3 }));
+    QCOMPARE(thread.supersededCount(), 0);
+}
+
+void DatabaseThreadTest::testWritesAreNotSuperseded()
+{
+    QueuedDatabaseThread thread;
+    QObject receiver;
+    QVariantList outcomes;
+    listen(thread, &receiver, outcomes);
+
+    read(thread, &receiver, QStringLiteral("add_stock_item"), 1);
+    read(thread, &receiver, QStringLiteral("add_stock_item"), 2);
+    QVERIFY(!thread.isSuperseded(0));
+
+    thread.respond(1, 2);
+    thread.respond(0, 1);
+    QCOMPARE(outcomes, QVariantList({ 2, 1 }));
+}
+
+void DatabaseThreadTest::testCacheHitSupersedesPendingRead()
+{
+    QueuedDatabaseThread thread;
+    thread.setResultCacheCapacity(1024 * 1024);
+    QObject receiver;
+    QVariantList outcomes;
+    listen(thread, &receiver, outcomes);
+
+    // STEP: Fill the cache with the read of category 1.
+    read(thread, &receiver, VIEW_ITEMS, 1);
+    thread.respond(0, 1);
+    QCOMPARE(outcomes, QVariantList({ 1 }));
+    outcomes.clear();
+
+    // STEP: Leave a read of category 2 in flight, then read category 1 again.
+    read(thread, &receiver, VIEW_ITEMS, 2);
+    read(thread, &receiver, VIEW_ITEMS, 1);
+    QCOMPARE(thread.pendingCount(), 1);
+    QVERIFY(thread.isSuperseded(0));
+
+    // STEP: Ensure the cached result is delivered asynchronously, and the late read dropped.
+    QVERIFY(outcomes.isEmpty());
+    QTRY_COMPARE(outcomes, QVariantList({ 1 }));
+    thread.respond(0, 2);
+    QCOMPARE(outcomes, QVariantList({ 1 }));
+    QCOMPARE(thread.supersededCount(), 1);
+}
+
+void DatabaseThreadTest::testCacheHitIsSupersededByNewerRead()
+{
+    QueuedDatabaseThread thread;
+    thread.setResultCacheCapacity(1024 * 1024);
+    QObject receiver;
+    QVariantList outcomes;
+    listen(thread, &receiver, outcomes);
+
+    read(thread, &receiver, VIEW_ITEMS, 1);
+    thread.respond(0, 1);
+    outcomes.clear();
+
+    // STEP: Hit the cache, then issue a newer read before the cached result is delivered.
+    read(thread, &receiver, VIEW_ITEMS, 1);
+    read(thread, &receiver, VIEW_ITEMS, 2);
+    QCOMPARE(thread.pendingCount(), 1);
+    QVERIFY(!thread.isSuperseded(0));
+
+    // STEP: Ensure only the newer read is delivered.
+    QTRY_COMPARE(thread.supersededCount(), 1);
+    QVERIFY(outcomes.isEmpty());
+    thread.respond(0, 2);
+    QCOMPARE(outcomes, QVariantList({ 2 }));
+}
+
+void DatabaseThreadTest::testReadsOfDestroyedReceiverAreDropped()
+{
+    QueuedDatabaseThread thread;
+    QVariantList outcomes;
+    QScopedPointer<QObject> receiver(new QObject);
+    listen(thread, receiver.data(), outcomes);
+
+    read(thread, receiver.data(), VIEW_ITEMS, 1);
+    QVERIFY(!thread.isSuperseded(0));
+
+    // STEP: Destroy the receiver while its read is in flight.
+    receiver.reset();
+    QVERIFY(thread.isSuperseded(0));
+
+    // STEP: Ensure the read is dropped when it returns.
+    thread.respond(0, 1);
+    QVERIFY(outcomes.isEmpty());
+    QCOMPARE(thread.supersededCount(), 1);
+}
+
+QTEST_MAIN(DatabaseThreadTest)
+
+#include "tst_databasethreadtest.moc"
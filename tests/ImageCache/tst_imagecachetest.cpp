@@ -0,0 +1,137 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QCryptographicHash>
+
+#include "database/imagecache.h"
+
+class ImageCacheTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImageCacheTest();
+
+private slots:
+    void testInsertReturnsProviderUrl();
+    void testIdenticalImagesShareHash();
+    void testImageIsWrittenWhenRequested();
+    void testDirectoryIsTrimmed();
+    void testMissingImageIsLoaded();
+    void testInvalidHashIsRejected();
+};
+
+ImageCacheTest::ImageCacheTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void ImageCacheTest::testInsertReturnsProviderUrl()
+{
+    QTemporaryDir directory;
+    ImageCache cache(directory.path());
+
+    const QUrl &imageUrl = cache.insert(QStringLiteral("stock_item/1"), QByteArray("image").toHex());
+
+    QVERIFY(ImageCache::isCacheUrl(imageUrl));
+    QCOMPARE(imageUrl.path(), QStringLiteral("/stock_item/1/%1").arg(cache.hashForKey("stock_item/1")));
+    QCOMPARE(cache.insert(QStringLiteral("stock_item/2"), QByteArray()), QUrl());
+}
+
+void ImageCacheTest::testIdenticalImagesShareHash()
+{
+    QTemporaryDir directory;
+    ImageCache cache(directory.path());
+
+    cache.insert(QStringLiteral("stock_item/1"), QByteArray("image").toHex());
+    cache.insert(QStringLiteral("stock_item/2"), QByteArray("image").toHex());
+    cache.insert(QStringLiteral("stock_item/3"), QByteArray("other image").toHex());
+
+    QCOMPARE(cache.hashForKey("stock_item/1"), cache.hashForKey("stock_item/2"));
+    QVERIFY(cache.hashForKey("stock_item/1") != cache.hashForKey("stock_item/3"));
+}
+
+void ImageCacheTest::testImageIsWrittenWhenRequested()
+{
+    QTemporaryDir directory;
+    ImageCache cache(directory.path());
+
+    const QUrl &imageUrl = cache.insert(QStringLiteral("stock_item/1"), QByteArray("image").toHex());
+
+    // STEP: Ensure the query did not write to disk.
+    QCOMPARE(QDir(directory.path()).entryList(QDir::Files).count(), 0);
+    QCOMPARE(cache.diskSize(), qint64(0));
+
+    // STEP: Ensure the image is persisted once requested.
+    QCOMPARE(cache.imageData(imageUrl), QByteArray("image"));
+    QCOMPARE(QDir(directory.path()).entryList(QDir::Files).count(), 1);
+    QCOMPARE(cache.diskSize(), qint64(QByteArray("image").size()));
+
+    // STEP: Ensure a new cache finds the persisted image.
+    ImageCache reopenedCache(directory.path());
+    QCOMPARE(reopenedCache.imageData(ImageCache::hashFromId(imageUrl.path())), QByteArray("image"));
+}
+
+void ImageCacheTest::testDirectoryIsTrimmed()
+{
+    QTemporaryDir directory;
+    ImageCache cache(directory.path(), 20);
+
+    for (int i = 0; i < 5; ++i) {
+        const QUrl &imageUrl = cache.insert(QStringLiteral("stock_item/%1").arg(i),
+                                            QStringLiteral("image #%1").arg(i).toUtf8().toHex());
+        QVERIFY(!cache.imageData(imageUrl).isEmpty());
+    }
+
+    QVERIFY(cache.diskSize() <= cache.maxDiskSize());
+}
+
+void ImageCacheTest::testMissingImageIsLoaded()
+{
+    QTemporaryDir directory;
+    ImageCache cache(directory.path(), 40);
+    QStringList loadedKeys;
+    cache.setLoader([&loadedKeys](const QString &key) {
+        loadedKeys.append(key);
+        return QStringLiteral("image of %1").arg(key).toUtf8().toHex();
+    });
+
+    const QString hash(QCryptographicHash::hash("image of stock_item/1", QCryptographicHash::Sha1).toHex());
+    const QUrl &imageUrl = cache.insertHash(QStringLiteral("stock_item/1"), hash);
+    QCOMPARE(imageUrl.path(), QStringLiteral("/stock_item/1/%1").arg(hash));
+    QCOMPARE(cache.insertHash(QStringLiteral("stock_item/2"), QString()), QUrl());
+
+    // STEP: Ensure only the hash was kept until the image is requested.
+    QCOMPARE(cache.diskSize(), qint64(0));
+    QVERIFY(loadedKeys.isEmpty());
+    QCOMPARE(cache.imageData(imageUrl), QByteArray("image of stock_item/1"));
+    QCOMPARE(loadedKeys, QStringList({ "stock_item/1" }));
+
+    // STEP: Ensure the image is not loaded again while it is on disk.
+    QCOMPARE(cache.imageData(hash, QStringLiteral("stock_item/1")), QByteArray("image of stock_item/1"));
+    QCOMPARE(loadedKeys.count(), 1);
+
+    // STEP: Ensure an image trimmed after its URL was handed out is loaded again.
+    QFile file(QStringLiteral("%1/%2.png").arg(directory.path(), hash));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(-60), QFileDevice::FileModificationTime));
+    file.close();
+
+    cache.imageData(cache.insertHash(QStringLiteral("stock_item/2"), QString(40, '0')));
+    QVERIFY(!file.exists());
+    QCOMPARE(cache.imageData(imageUrl), QByteArray("image of stock_item/1"));
+    QCOMPARE(loadedKeys, QStringList({ "stock_item/1", "stock_item/2", "stock_item/1" }));
+}
+
+void ImageCacheTest::testInvalidHashIsRejected()
+{
+    QTemporaryDir directory;
+    ImageCache cache(directory.path());
+
+    QCOMPARE(cache.imageData(QStringLiteral("../../etc/passwd")), QByteArray());
+    QCOMPARE(cache.imageData(QUrl("file:///tmp/image.png")), QByteArray());
+}
+
+QTEST_MAIN(ImageCacheTest)
+
+#include "tst_imagecachetest.moc"
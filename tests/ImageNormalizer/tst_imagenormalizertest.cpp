@@ -0,0 +1,74 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QImage>
+
+#include "database/imagenormalizer.h"
+#include "queryexecutors/stock/addstockitem.h"
+
+class ImageNormalizerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImageNormalizerTest();
+
+private slots:
+    void testPrefetchIsShared();
+    void testUnexecutedRequestReleasesPrefetch();
+
+private:
+    QUrl writeImage(const QTemporaryDir &directory) const;
+};
+
+ImageNormalizerTest::ImageNormalizerTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+QUrl ImageNormalizerTest::writeImage(const QTemporaryDir &directory) const
+{
+    QImage image(16, 16, QImage::Format_RGB32);
+    image.fill(Qt::red);
+
+    const QString &fileName = directory.filePath(QStringLiteral("image.png"));
+    image.save(fileName);
+    return QUrl::fromLocalFile(fileName);
+}
+
+void ImageNormalizerTest::testPrefetchIsShared()
+{
+    QTemporaryDir directory;
+    const QUrl &imageUrl = writeImage(directory);
+    ImageNormalizer &normalizer = ImageNormalizer::instance();
+
+    normalizer.prefetch(imageUrl);
+    normalizer.prefetch(imageUrl);
+    QCOMPARE(normalizer.pendingCount(), 1);
+    QVERIFY(!normalizer.take(imageUrl).image.isEmpty());
+
+    // STEP: Ensure the image is kept until every user has released it.
+    normalizer.release(imageUrl);
+    QCOMPARE(normalizer.pendingCount(), 1);
+    normalizer.release(imageUrl);
+    QCOMPARE(normalizer.pendingCount(), 0);
+}
+
+void ImageNormalizerTest::testUnexecutedRequestReleasesPrefetch()
+{
+    QTemporaryDir directory;
+    const QUrl &imageUrl = writeImage(directory);
+
+    auto queryExecutor = new StockQuery::AddStockItem("Category", "Item", "Description", 1.0, "pc", true, true,
+                                                      1.0, 2.0, 1.0, true, "NGN", imageUrl, QString(), QString(),
+                                                      nullptr);
+    QCOMPARE(ImageNormalizer::instance().pendingCount(), 1);
+
+    // STEP: Ensure a request that is dropped before it executes (e.g. tunnelled) does not leak its image.
+    delete queryExecutor;
+    QCOMPARE(ImageNormalizer::instance().pendingCount(), 0);
+}
+
+QTEST_MAIN(ImageNormalizerTest)
+
+#include "tst_imagenormalizertest.moc"
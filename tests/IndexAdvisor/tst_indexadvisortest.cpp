@@ -0,0 +1,108 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/indexadvisor.h"
+
+class IndexAdvisorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    IndexAdvisorTest();
+
+private slots:
+    void testStatementsAreExtracted();
+    void testVariablesAreReplaced();
+    void testSelectIntoIsStripped();
+    void testDeclaredVariables();
+    void testPlaceholders();
+    void testFindings();
+};
+
+IndexAdvisorTest::IndexAdvisorTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void IndexAdvisorTest::testStatementsAreExtracted()
+{
+    const QString body = QStringLiteral("BEGIN "
+                                        "IF EXISTS (SELECT 1 FROM debtor WHERE client_id = 2) THEN "
+                                        "UPDATE debtor SET archived = 0 WHERE client_id = 2; "
+                                        "ELSE DELETE FROM note WHERE id = 3; "
+                                        "END IF; "
+                                        "INSERT INTO note (note) VALUES ('x'); "
+                                        "/* SELECT * FROM item; */ "
+                                        "SELECT * FROM sale_item WHERE sale_transaction_id = 4; "
+                                        "END");
+
+    const QStringList &statements = IndexAdvisor::statements(body, {});
+    QCOMPARE(statements, QStringList({
+                                         QStringLiteral("UPDATE debtor SET archived = 0 WHERE client_id = 2"),
+                                         QStringLiteral("DELETE FROM note WHERE id = 3"),
+                                         QStringLiteral("SELECT * FROM sale_item WHERE sale_transaction_id = 4")
+                                     }));
+}
+
+void IndexAdvisorTest::testVariablesAreReplaced()
+{
+    const QString body = QStringLiteral("BEGIN SELECT * FROM sale_transaction "
+                                        "WHERE sale_transaction.created BETWEEN iFrom AND iTo "
+                                        "AND @iFrom IS NULL AND client_id = iClientId; END");
+
+    const QStringList &statements = IndexAdvisor::statements(body, {
+                                                                 { "iFrom", "datetime" },
+                                                                 { "iTo", "datetime" },
+                                                                 { "iClientId", "int" }
+                                                             });
+    QCOMPARE(statements.count(), 1);
+    QCOMPARE(statements.first(),
+             QStringLiteral("SELECT * FROM sale_transaction "
+                            "WHERE sale_transaction.created BETWEEN '2000-01-01 00:00:00' AND '2000-01-01 00:00:00' "
+                            "AND @iFrom IS NULL AND client_id = 1"));
+}
+
+void IndexAdvisorTest::testSelectIntoIsStripped()
+{
+    const QString body = QStringLiteral("BEGIN DECLARE vCount INT; "
+                                        "SELECT COUNT(*) INTO vCount FROM sale_item WHERE item_id = iItemId; END");
+
+    const QStringList &statements = IndexAdvisor::statements(body, IndexAdvisor::declaredVariables(body));
+    QCOMPARE(statements, QStringList({ QStringLiteral("SELECT COUNT(*) FROM sale_item WHERE item_id = iItemId") }));
+}
+
+void IndexAdvisorTest::testDeclaredVariables()
+{
+    const QHash<QString, QString> &variables = IndexAdvisor::declaredVariables(
+                QStringLiteral("BEGIN DECLARE vFrom, vTo DATETIME; DECLARE vName VARCHAR(20); "
+                               "DECLARE vCursor CURSOR FOR SELECT id FROM item; "
+                               "DECLARE CONTINUE HANDLER FOR NOT FOUND SET vDone = 1; END"));
+
+    QCOMPARE(variables.count(), 3);
+    QCOMPARE(variables.value("vFrom"), QStringLiteral("DATETIME"));
+    QCOMPARE(variables.value("vTo"), QStringLiteral("DATETIME"));
+    QCOMPARE(variables.value("vName"), QStringLiteral("VARCHAR"));
+}
+
+void IndexAdvisorTest::testPlaceholders()
+{
+    QCOMPARE(IndexAdvisor::placeholderFor("INT"), QStringLiteral("1"));
+    QCOMPARE(IndexAdvisor::placeholderFor("tinyint"), QStringLiteral("1"));
+    QCOMPARE(IndexAdvisor::placeholderFor("decimal"), QStringLiteral("1"));
+    QCOMPARE(IndexAdvisor::placeholderFor("date"), QStringLiteral("'2000-01-01'"));
+    QCOMPARE(IndexAdvisor::placeholderFor("datetime"), QStringLiteral("'2000-01-01 00:00:00'"));
+    QCOMPARE(IndexAdvisor::placeholderFor("varchar"), QStringLiteral("'a'"));
+}
+
+void IndexAdvisorTest::testFindings()
+{
+    QCOMPARE(IndexAdvisor::findingFor("ALL", QString()), IndexAdvisor::MISSING_INDEX);
+    QCOMPARE(IndexAdvisor::findingFor("ALL", "item_id"), IndexAdvisor::UNUSED_INDEX);
+    QCOMPARE(IndexAdvisor::findingFor("index", QString()), IndexAdvisor::MISSING_INDEX);
+    QCOMPARE(IndexAdvisor::findingFor("ref", "sale_transaction_id"), QString());
+    QCOMPARE(IndexAdvisor::findingFor("eq_ref", "PRIMARY"), QString());
+}
+
+QTEST_MAIN(IndexAdvisorTest)
+
+#include "tst_indexadvisortest.moc"
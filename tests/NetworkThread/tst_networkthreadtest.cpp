@@ -0,0 +1,252 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+
+#include "network/networkthread.h"
+#include "network/requestlogger.h"
+#include "network/wireformat.h"
+#include "database/changesync.h"
+
+// A reply that stays in flight until the test answers it.
+class FakeNetworkReply : public QNetworkReply
+{
+public:
+    explicit FakeNetworkReply(const QNetworkRequest &request, const QByteArray &body, QObject *parent = nullptr) :
+        QNetworkReply(parent),
+        m_requestBody(body),
+        m_offset(0)
+    {
+        setRequest(request);
+        setUrl(request.url());
+        setOperation(QNetworkAccessManager::PostOperation);
+        open(QIODevice::ReadOnly);
+    }
+
+    QByteArray requestBody() const { return m_requestBody; }
+
+    void respond(int statusCode, WireFormat::Encoding encoding, const QVariantMap &body)
+    {
+        m_body = WireFormat::encode(body, encoding);
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, statusCode);
+        setHeader(QNetworkRequest::ContentTypeHeader, WireFormat::contentType(encoding));
+        if (statusCode >= 400)
+            setError(QNetworkReply::UnknownContentError, QStringLiteral("HTTP %1").arg(statusCode));
+
+        setFinished(true);
+        emit finished();
+    }
+
+    void abort() override {}
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return m_body.size() - m_offset + QIODevice::bytesAvailable(); }
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 size = qMin(maxSize, qint64(m_body.size() - m_offset));
+        memcpy(data, m_body.constData() + m_offset, static_cast<size_t>(size));
+        m_offset += size;
+        return size;
+    }
+private:
+    QByteArray m_requestBody;
+    QByteArray m_body;
+    qint64 m_offset;
+};
+
+// Hands out fake replies instead of going to the network, and keeps them in the order they were sent.
+class FakeNetworkAccessManager : public QNetworkAccessManager
+{
+public:
+    QList<FakeNetworkReply *> replies;
+protected:
+    QNetworkReply *createRequest(Operation operation,
+                                 const QNetworkRequest &request,
+                                 QIODevice *outgoingData = nullptr) override
+    {
+        Q_UNUSED(operation)
+        FakeNetworkReply *reply = new FakeNetworkReply(request, outgoingData ? outgoingData->readAll() : QByteArray(), this);
+        replies.append(reply);
+        return reply;
+    }
+};
+
+class NetworkThreadTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    NetworkThreadTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testInteractiveLaneLimit();
+    void testSyncLaneLimit();
+    void testSyncNeverBlocksInteractive();
+    void testUnsupportedMediaTypeIsRetriedAsJson();
+private:
+    QScopedPointer<QTemporaryDir> m_directory;
+    FakeNetworkAccessManager *m_networkManager;
+    QScopedPointer<NetworkWorker> m_worker;
+    QList<ServerResponse> m_responses;
+
+    static ServerRequest interactiveRequest(int id);
+    static ServerRequest syncRequest(int id);
+    static int requestId(const FakeNetworkReply *reply);
+    static QNetworkRequest::Priority priority(const FakeNetworkReply *reply);
+};
+
+NetworkThreadTest::NetworkThreadTest() :
+    m_networkManager(nullptr)
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false\n*.warning=false"));
+}
+
+void NetworkThreadTest::init()
+{
+    m_directory.reset(new QTemporaryDir);
+    m_networkManager = new FakeNetworkAccessManager;
+    m_worker.reset(new NetworkWorker(m_networkManager, new RequestLogger(m_directory->path())));
+    m_responses.clear();
+    connect(m_worker.data(), &NetworkWorker::responseReady, this, [this](const ServerResponse &response) {
+        m_responses.append(response);
+    });
+}
+
+void NetworkThreadTest::cleanup()
+{
+    m_worker.reset();
+    m_networkManager = nullptr;
+    m_directory.reset();
+}
+
+ServerRequest NetworkThreadTest::interactiveRequest(int id)
+{
+    ServerRequest request;
+    request.setAction(QStringLiteral("link_account"), QVariantMap { { "id", id } });
+    return request;
+}
+
+ServerRequest NetworkThreadTest::syncRequest(int id)
+{
+    ServerRequest request;
+    request.setAction(ChangeSync::PUSH_ACTION, QVariantMap { { "id", id } });
+    return request;
+}
+
+int NetworkThreadTest::requestId(const FakeNetworkReply *reply)
+{
+    const WireFormat::Encoding encoding = WireFormat::encodingFor(reply->request().rawHeader("Content-Type"));
+    return WireFormat::decode(reply->requestBody(), encoding).value("data").toMap().value("id").toInt();
+}
+
+QNetworkRequest::Priority NetworkThreadTest::priority(const FakeNetworkReply *reply)
+{
+    return reply->request().priority();
+}
+
+void NetworkThreadTest::testInteractiveLaneLimit()
+{
+    const int requestCount = NetworkWorker::MAX_INTERACTIVE_IN_FLIGHT + 2;
+    for (int i = 1; i <= requestCount; ++i)
+        m_worker->execute(interactiveRequest(i));
+
+    // STEP: Ensure no more than the limit are in flight.
+    QCOMPARE(m_networkManager->replies.count(), NetworkWorker::MAX_INTERACTIVE_IN_FLIGHT);
+
+    // STEP: Ensure a queued request is sent, in order, as soon as one returns.
+    m_networkManager->replies.at(0)->respond(200, WireFormat::Encoding::Json, {});
+    QCOMPARE(m_responses.count(), 1);
+    QCOMPARE(m_networkManager->replies.count(), NetworkWorker::MAX_INTERACTIVE_IN_FLIGHT + 1);
+    QCOMPARE(requestId(m_networkManager->replies.last()), NetworkWorker::MAX_INTERACTIVE_IN_FLIGHT + 1);
+
+    // STEP: Ensure every request is sent once the others return.
+    for (int i = 1; i < m_networkManager->replies.count(); ++i)
+        m_networkManager->replies.at(i)->respond(200, WireFormat::Encoding::Json, {});
+
+    QCOMPARE(m_networkManager->replies.count(), requestCount);
+    QCOMPARE(m_responses.count(), requestCount);
+}
+
+void NetworkThreadTest::testSyncLaneLimit()
+{
+    for (int i = 1; i <= NetworkWorker::MAX_SYNC_IN_FLIGHT + 2; ++i)
+        m_worker->sync(syncRequest(i));
+
+    QCOMPARE(m_networkManager->replies.count(), NetworkWorker::MAX_SYNC_IN_FLIGHT);
+    QCOMPARE(priority(m_networkManager->replies.first()), QNetworkRequest::LowPriority);
+
+    m_networkManager->replies.at(1)->respond(200, WireFormat::Encoding::Json, {});
+    QCOMPARE(m_networkManager->replies.count(), NetworkWorker::MAX_SYNC_IN_FLIGHT + 1);
+    QCOMPARE(requestId(m_networkManager->replies.last()), NetworkWorker::MAX_SYNC_IN_FLIGHT + 1);
+}
+
+void NetworkThreadTest::testSyncNeverBlocksInteractive()
+{
+    // STEP: Fill the sync lane, and leave more sync requests queued.
+    for (int i = 1; i <= NetworkWorker::MAX_SYNC_IN_FLIGHT + 3; ++i)
+        m_worker->sync(syncRequest(i));
+    QCOMPARE(m_networkManager->replies.count(), NetworkWorker::MAX_SYNC_IN_FLIGHT);
+
+    // STEP: Ensure an interactive request is sent straight away, ahead of the queued sync requests.
+    m_worker->execute(interactiveRequest(100));
+    QCOMPARE(m_networkManager->replies.count(), NetworkWorker::MAX_SYNC_IN_FLIGHT + 1);
+    FakeNetworkReply *interactiveReply = m_networkManager->replies.last();
+    QCOMPARE(requestId(interactiveReply), 100);
+    QCOMPARE(priority(interactiveReply), QNetworkRequest::HighPriority);
+
+    // STEP: Ensure a full interactive lane does not hold up the sync lane either.
+    for (int i = 1; i < NetworkWorker::MAX_INTERACTIVE_IN_FLIGHT + 2; ++i)
+        m_worker->execute(interactiveRequest(100 + i));
+    const int sentCount = m_networkManager->replies.count();
+    QCOMPARE(sentCount, NetworkWorker::MAX_SYNC_IN_FLIGHT + NetworkWorker::MAX_INTERACTIVE_IN_FLIGHT);
+
+    m_networkManager->replies.first()->respond(200, WireFormat::Encoding::Json, {});
+    QCOMPARE(m_networkManager->replies.count(), sentCount + 1);
+    QCOMPARE(requestId(m_networkManager->replies.last()), NetworkWorker::MAX_SYNC_IN_FLIGHT + 1);
+    QCOMPARE(priority(m_networkManager->replies.last()), QNetworkRequest::LowPriority);
+
+    // STEP: Ensure the interactive reply is delivered while sync requests are still in flight.
+    interactiveReply->respond(200, WireFormat::Encoding::Json, {});
+    QCOMPARE(m_responses.count(), 2);
+    QCOMPARE(m_responses.last().request().data().value("id").toInt(), 100);
+}
+
+void NetworkThreadTest::testUnsupportedMediaTypeIsRetriedAsJson()
+{
+    // STEP: Answer in CBOR, so that request bodies switch to CBOR.
+    m_worker->execute(interactiveRequest(1));
+    m_networkManager->replies.last()->respond(200, WireFormat::Encoding::Cbor, {});
+    QCOMPARE(m_responses.count(), 1);
+
+    m_worker->execute(interactiveRequest(2));
+    FakeNetworkReply *cborReply = m_networkManager->replies.last();
+    QCOMPARE(WireFormat::encodingFor(cborReply->request().rawHeader("Content-Type")), WireFormat::Encoding::Cbor);
+
+    // STEP: Reject the CBOR body.
+    cborReply->respond(NetworkWorker::UNSUPPORTED_MEDIA_TYPE, WireFormat::Encoding::Json, {});
+
+    // STEP: Ensure the request is sent again as JSON, and the rejection is not delivered.
+    QCOMPARE(m_responses.count(), 1);
+    QCOMPARE(m_networkManager->replies.count(), 3);
+    FakeNetworkReply *jsonReply = m_networkManager->replies.last();
+    QCOMPARE(WireFormat::encodingFor(jsonReply->request().rawHeader("Content-Type")), WireFormat::Encoding::Json);
+    QCOMPARE(requestId(jsonReply), 2);
+    QCOMPARE(priority(jsonReply), QNetworkRequest::HighPriority);
+
+    jsonReply->respond(200, WireFormat::Encoding::Json, {});
+    QCOMPARE(m_responses.count(), 2);
+    QCOMPARE(m_responses.last().request().data().value("id").toInt(), 2);
+
+    // STEP: Ensure later requests stay in JSON.
+    m_worker->execute(interactiveRequest(3));
+    QCOMPARE(WireFormat::encodingFor(m_networkManager->replies.last()->request().rawHeader("Content-Type")),
+             WireFormat::Encoding::Json);
+}
+
+QTEST_MAIN(NetworkThreadTest)
+
+#include "tst_networkthreadtest.moc"
@@ -0,0 +1,209 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <functional>
+
+#include "queryexecutors/client.h"
+#include "queryexecutors/sales.h"
+#include "queryexecutors/purchase.h"
+#include "utility/pageutils.h"
+#include "testdatabase.h"
+
+class PaginationTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PaginationTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testCursor();
+    void testClientPages();
+    void testSaleTransactionPages();
+    void testPurchaseTransactionPages();
+private:
+    using ExecutorFactory = std::function<QueryExecutor *(const PageCursor &cursor)>;
+
+    QScopedPointer<TestDatabase> m_database;
+
+    void addRows(const std::function<bool(int, const QString &)> &addRow);
+    QList<int> pageThrough(const ExecutorFactory &createExecutor,
+                           const QString &recordsKey,
+                           const QString &idKey,
+                           int &pageCount);
+    QList<int> expectedIds(const QString &tableName);
+};
+
+PaginationTest::PaginationTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void PaginationTest::init()
+{
+    m_database.reset();
+    if (QString(QTest::currentTestFunction()) == QLatin1String("testCursor"))
+        return;
+
+    m_database.reset(new TestDatabase(QStringLiteral("rr_test_pagination")));
+    if (!m_database->isOpen())
+        QSKIP(qPrintable(QStringLiteral("No MySQL server: %1").arg(m_database->errorString())));
+
+    QVERIFY2(m_database->run(QStringLiteral("procedures/pagination.sql")), qPrintable(m_database->errorString()));
+}
+
+void PaginationTest::cleanup()
+{
+    m_database.reset();
+}
+
+void PaginationTest::addRows(const std::function<bool(int, const QString &)> &addRow)
+{
+    // NOTE: Five rows share the same time, so pages have to split them by id.
+    const QStringList created {
+        QStringLiteral("2020-03-28 11:05:00"),
+        QStringLiteral("2020-03-29 09:00:00"),
+        QStringLiteral("2020-03-28 11:05:00"),
+        QStringLiteral("2020-03-28 11:05:00"),
+        QStringLiteral("2020-03-27 17:30:00"),
+        QStringLiteral("2020-03-28 11:05:00"),
+        QStringLiteral("2020-03-28 11:05:00"),
+        QStringLiteral("2020-03-26 08:15:00")
+    };
+
+    for (int i = 0; i < created.count(); ++i)
+        QVERIFY2(addRow(i + 1, created.at(i)), qPrintable(m_database->errorString()));
+}
+
+QList<int> PaginationTest::pageThrough(const ExecutorFactory &createExecutor,
+                                       const QString &recordsKey,
+                                       const QString &idKey,
+                                       int &pageCount)
+{
+    QList<int> ids;
+    PageCursor cursor(2);
+    pageCount = 0;
+
+    // NOTE: Stops after more pages than there are rows, in case a cursor never moves on.
+    while (pageCount <= 10) {
+        QScopedPointer<QueryExecutor> executor(createExecutor(cursor));
+        executor->setConnectionName(m_database->connectionName());
+        const QVariantMap &outcome = executor->execute().outcome().toMap();
+        const QVariantList &records = outcome.value(recordsKey).toList();
+        pageCount++;
+
+        for (const QVariant &record : records)
+            ids.append(record.toMap().value(idKey).toInt());
+
+        if (!outcome.value("has_more").toBool() || records.isEmpty())
+            break;
+
+        const QVariantMap &lastRecord = records.last().toMap();
+        cursor = PageCursor(lastRecord.value("created").toDateTime(), lastRecord.value(idKey).toInt(), 2);
+    }
+
+    return ids;
+}
+
+QList<int> PaginationTest::expectedIds(const QString &tableName)
+{
+    QList<int> ids;
+    QSqlQuery q = m_database->query(QStringLiteral("SELECT id FROM %1 ORDER BY created DESC, id DESC").arg(tableName));
+    while (q.next())
+        ids.append(q.value(0).toInt());
+
+    return ids;
+}
+
+void PaginationTest::testCursor()
+{
+    // STEP: Ensure the first page carries no position.
+    const PageCursor first(2);
+    QVERIFY(first.isFirstPage());
+    QVERIFY(first.isPaginated());
+    QVERIFY(first.toVariantMap().value("after_created").isNull());
+    QVERIFY(first.toVariantMap().value("after_id").isNull());
+    QCOMPARE(PageCursor(first.toVariantMap()).isFirstPage(), true);
+
+    // STEP: Ensure a following page survives the trip through the request parameters.
+    const QDateTime created(QDate(2020, 3, 28), QTime(11, 5));
+    const PageCursor next(PageCursor(created, 7, 2).toVariantMap());
+    QVERIFY(!next.isFirstPage());
+    QCOMPARE(next.created, created);
+    QCOMPARE(next.id, 7);
+    QCOMPARE(next.limit, 2);
+    QCOMPARE(next.fetchLimit(), 3);
+
+    // STEP: Ensure the extra row is only used to tell that another page follows.
+    QVariantList records { 1, 2, 3 };
+    QVERIFY(next.trim(records));
+    QCOMPARE(records, QVariantList({ 1, 2 }));
+    QVERIFY(!next.trim(records));
+    QCOMPARE(records.count(), 2);
+
+    // STEP: Ensure requests without a limit are not paginated.
+    QVERIFY(!PageCursor(QVariantMap()).isPaginated());
+}
+
+void PaginationTest::testClientPages()
+{
+    addRows([this](int row, const QString &created) {
+        return m_database->exec(QStringLiteral("INSERT INTO client (preferred_name, phone_number, archived, "
+                                               "created, last_edited, user_id) VALUES (?, ?, 0, ?, ?, 1)"),
+                                { QStringLiteral("Client %1").arg(row), QString::number(1000 + row), created, created });
+    });
+
+    int pageCount = 0;
+    const QList<int> &ids = pageThrough([](const PageCursor &cursor) {
+        return new ClientQuery::ViewClients(cursor, nullptr);
+    }, QStringLiteral("clients"), QStringLiteral("client_id"), pageCount);
+
+    // STEP: Ensure every row is seen once, newest first, and paging stops at the end.
+    QCOMPARE(ids, expectedIds(QStringLiteral("client")));
+    QCOMPARE(ids.count(), 8);
+    QCOMPARE(pageCount, 4);
+}
+
+void PaginationTest::testSaleTransactionPages()
+{
+    addRows([this](int row, const QString &created) {
+        return m_database->exec(QStringLiteral("INSERT INTO sale_transaction (name, total_cost, amount_paid, balance, "
+                                               "discount, suspended, note_id, archived, created, last_edited, user_id) "
+                                               "VALUES (?, 10, 10, 0, 0, 0, 0, 0, ?, ?, 1)"),
+                                { QStringLiteral("Customer %1").arg(row), created, created });
+    });
+
+    int pageCount = 0;
+    const QList<int> &ids = pageThrough([](const PageCursor &cursor) {
+        return new SaleQuery::ViewSaleTransactions(QDateTime(), QDateTime(), false, false, cursor, nullptr);
+    }, QStringLiteral("transactions"), QStringLiteral("transaction_id"), pageCount);
+
+    QCOMPARE(ids, expectedIds(QStringLiteral("sale_transaction")));
+    QCOMPARE(ids.count(), 8);
+    QCOMPARE(pageCount, 4);
+}
+
+void PaginationTest::testPurchaseTransactionPages()
+{
+    addRows([this](int row, const QString &created) {
+        return m_database->exec(QStringLiteral("INSERT INTO purchase_transaction (name, total_cost, amount_paid, balance, "
+                                               "discount, suspended, archived, created, last_edited, user_id) "
+                                               "VALUES (?, 10, 10, 0, 0, 0, 0, ?, ?, 1)"),
+                                { QStringLiteral("Vendor %1").arg(row), created, created });
+    });
+
+    int pageCount = 0;
+    const QList<int> &ids = pageThrough([](const PageCursor &cursor) {
+        return new PurchaseQuery::ViewPurchaseTransactions(QDateTime(), QDateTime(), false, false, cursor, nullptr);
+    }, QStringLiteral("transactions"), QStringLiteral("transaction_id"), pageCount);
+
+    QCOMPARE(ids, expectedIds(QStringLiteral("purchase_transaction")));
+    QCOMPARE(ids.count(), 8);
+    QCOMPARE(pageCount, 4);
+}
+
+QTEST_MAIN(PaginationTest)
+
+#include "tst_paginationtest.moc"
@@ -0,0 +1,81 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/pendingwrites.h"
+
+class PendingWritesTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PendingWritesTest();
+
+private slots:
+    void testReadWaitsForWriteOfItsGroup();
+    void testReadWaitsForWriteOfAnotherGroup();
+    void testUnrelatedReadDoesNotWait();
+    void testEveryWriteMustEnd();
+};
+
+PendingWritesTest::PendingWritesTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void PendingWritesTest::testReadWaitsForWriteOfItsGroup()
+{
+    PendingWrites pendingWrites;
+    QVERIFY(!pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+
+    pendingWrites.begin(QueryRequest::QueryGroup::Stock);
+    QVERIFY(pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+
+    pendingWrites.end(QueryRequest::QueryGroup::Stock);
+    QVERIFY(!pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+}
+
+void PendingWritesTest::testReadWaitsForWriteOfAnotherGroup()
+{
+    PendingWrites pendingWrites;
+
+    // STEP: A pending sale deducts stock, so stock reads must see it.
+    pendingWrites.begin(QueryRequest::QueryGroup::Sales);
+    QVERIFY(pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+    QVERIFY(pendingWrites.affects(QueryRequest::QueryGroup::Dashboard));
+    QVERIFY(pendingWrites.affects(QueryRequest::QueryGroup::Debtor));
+
+    pendingWrites.end(QueryRequest::QueryGroup::Sales);
+    QVERIFY(!pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+}
+
+void PendingWritesTest::testUnrelatedReadDoesNotWait()
+{
+    PendingWrites pendingWrites;
+    pendingWrites.begin(QueryRequest::QueryGroup::Income);
+
+    QVERIFY(pendingWrites.affects(QueryRequest::QueryGroup::Dashboard));
+    QVERIFY(!pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+    QVERIFY(!pendingWrites.affects(QueryRequest::QueryGroup::Sales));
+}
+
+void PendingWritesTest::testEveryWriteMustEnd()
+{
+    PendingWrites pendingWrites;
+    pendingWrites.begin(QueryRequest::QueryGroup::Purchase);
+    pendingWrites.begin(QueryRequest::QueryGroup::Purchase);
+    QCOMPARE(pendingWrites.count(QueryRequest::QueryGroup::Purchase), 2);
+
+    pendingWrites.end(QueryRequest::QueryGroup::Purchase);
+    QVERIFY(pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+
+    // STEP: Ensure a write that ends more than once does not hide another one.
+    pendingWrites.end(QueryRequest::QueryGroup::Purchase);
+    pendingWrites.end(QueryRequest::QueryGroup::Purchase);
+    QCOMPARE(pendingWrites.count(QueryRequest::QueryGroup::Purchase), 0);
+    pendingWrites.begin(QueryRequest::QueryGroup::Purchase);
+    QVERIFY(pendingWrites.affects(QueryRequest::QueryGroup::Stock));
+}
+
+QTEST_MAIN(PendingWritesTest)
+
+#include "tst_pendingwritestest.moc"
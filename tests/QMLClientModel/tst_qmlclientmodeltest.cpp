@@ -4,6 +4,7 @@
 
 #include "qmlapi/qmlclientmodel.h"
 #include "mockdatabasethread.h"
+#include "queueddatabasethread.h"
 
 class QMLClientModelTest : public QObject
 {
@@ -17,6 +18,7 @@ private slots:
     void testViewClients();
     void testFilterByPreferredName();
     void testFilterByPhoneNumber();
+    void testFetchMore();
 private:
     QMLClientModel *m_clientModel;
     MockDatabaseThread m_thread;
@@ -225,6 +227,61 @@ void QMLClientModelTest::testFilterByPhoneNumber()
     QCOMPARE(m_clientModel->index(0).data(QMLClientModel::PhoneNumberRole).toString(), QStringLiteral("987654321"));
 }
 
+void QMLClientModelTest::testFetchMore()
+{
+    const QDateTime created(QDate(2020, 3, 28), QTime(11, 5));
+    auto client = [&created](int clientId) {
+        return QVariantMap {
+            { "client_id", clientId },
+            { "preferred_name", QStringLiteral("Client %1").arg(clientId) },
+            { "phone_number", QStringLiteral("12345") },
+            { "created", created }
+        };
+    };
+
+    QueuedDatabaseThread thread;
+    QMLClientModel clientModel(thread);
+
+    // STEP: Load the first page.
+    clientModel.componentComplete();
+    QCOMPARE(thread.pendingCount(), 1);
+    QVERIFY(thread.pendingRequest(0).params().value("after_created").isNull());
+    QVERIFY(thread.pendingRequest(0).params().value("after_id").isNull());
+    QCOMPARE(thread.pendingRequest(0).params().value("limit").toInt(), PageCursor::DEFAULT_PAGE_SIZE);
+
+    thread.respond(0, QVariantMap {
+                       { "clients", QVariantList { client(3), client(2) } },
+                       { "has_more", true }
+                   });
+    QCOMPARE(clientModel.rowCount(), 2);
+    QVERIFY(clientModel.canFetchMore(QModelIndex()));
+
+    // STEP: Ensure the next page starts after the last row, even when rows share the same time.
+    clientModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 1);
+    QCOMPARE(thread.pendingRequest(0).params().value("after_created").toDateTime(), created);
+    QCOMPARE(thread.pendingRequest(0).params().value("after_id").toInt(), 2);
+    QVERIFY(!clientModel.canFetchMore(QModelIndex()));
+
+    thread.respond(0, QVariantMap {
+                       { "clients", QVariantList { client(1) } },
+                       { "has_more", false }
+                   });
+    QCOMPARE(clientModel.rowCount(), 3);
+    QCOMPARE(clientModel.data(clientModel.index(2), QMLClientModel::ClientIdRole).toInt(), 1);
+
+    // STEP: Ensure fetching stops at the end.
+    QVERIFY(!clientModel.canFetchMore(QModelIndex()));
+    clientModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 0);
+
+    // STEP: Ensure a filter starts again from the first page.
+    clientModel.setFilterColumn(QMLClientModel::PreferredNameColumn);
+    clientModel.setFilterText(QStringLiteral("Client"));
+    QVERIFY(thread.pendingCount() > 0);
+    QVERIFY(thread.pendingRequest(thread.pendingCount() - 1).params().value("after_id").isNull());
+}
+
 QTEST_MAIN(QMLClientModelTest)
 
 #include "tst_qmlclientmodeltest.moc"
@@ -2,7 +2,9 @@
 #include <QCoreApplication>
 
 #include "qmlapi/qmlpurchasecartmodel.h"
+#include "database/stockcatalog.h"
 #include "mockdatabasethread.h"
+#include "queueddatabasethread.h"
 
 class QMLPurchaseCartModelTest : public QObject
 {
@@ -14,6 +16,7 @@ private slots:
     void init();
     void cleanup();
     void test_case1();
+    void testAddItemByBarcode();
 private:
     QMLPurchaseCartModel *m_purchaseCartModel;
     QueryResult m_result;
@@ -41,6 +44,42 @@ void QMLPurchaseCartModelTest::test_case1()
 
 }
 
+void QMLPurchaseCartModelTest::testAddItemByBarcode()
+{
+    const QVariantList items {
+        QVariantMap {
+            { "category_id", 1 },
+            { "category", "Category1" },
+            { "item_id", 1 },
+            { "item", "Item1" },
+            { "barcode", "1111" },
+            { "quantity", 0.0 },
+            { "unit_id", 1 },
+            { "unit", "Unit" },
+            { "cost_price", 8.0 },
+            { "retail_price", 10.0 }
+        }
+    };
+
+    QueuedDatabaseThread thread;
+    StockCatalog catalog(thread);
+    QMLPurchaseCartModel purchaseCartModel(thread, catalog);
+    QSignalSpy errorSpy(&purchaseCartModel, &QMLPurchaseCartModel::error);
+
+    catalog.loadNow();
+    thread.respond(0, QVariantMap { { "items", items } });
+
+    // STEP: Ensure an item that is out of stock can still be bought.
+    purchaseCartModel.addItemByBarcode("1111");
+    QCOMPARE(purchaseCartModel.rowCount(), 1);
+    QCOMPARE(purchaseCartModel.data(purchaseCartModel.index(0), QMLPurchaseCartModel::QuantityRole).toDouble(), 1.0);
+
+    purchaseCartModel.addItemByBarcode("1111");
+    QCOMPARE(purchaseCartModel.rowCount(), 1);
+    QCOMPARE(purchaseCartModel.data(purchaseCartModel.index(0), QMLPurchaseCartModel::QuantityRole).toDouble(), 2.0);
+    QCOMPARE(errorSpy.count(), 0);
+}
+
 QTEST_MAIN(QMLPurchaseCartModelTest)
 
 #include "tst_qmlpurchasecartmodeltest.moc"
@@ -3,6 +3,7 @@
 
 #include "qmlapi/qmlpurchasetransactionmodel.h"
 #include "mockdatabasethread.h"
+#include "queueddatabasethread.h"
 
 class QMLPurchaseTransactionModelTest : public QObject
 {
@@ -14,6 +15,7 @@ private slots:
     void init();
     void cleanup();
     void test_case1();
+    void testFetchMore();
 private:
     QMLPurchaseTransactionModel *m_purchaseTransactionModel;
     MockDatabaseThread m_thread;
@@ -41,6 +43,65 @@ void QMLPurchaseTransactionModelTest::test_case1()
 
 }
 
+void QMLPurchaseTransactionModelTest::testFetchMore()
+{
+    const QDateTime created(QDate(2020, 3, 28), QTime(11, 5));
+    auto transaction = [&created](int transactionId) {
+        return QVariantMap {
+            { "transaction_id", transactionId },
+            { "customer_name", QStringLiteral("Customer %1").arg(transactionId) },
+            { "created", created },
+            { "last_edited", created }
+        };
+    };
+
+    QueuedDatabaseThread thread;
+    QMLPurchaseTransactionModel purchaseTransactionModel(thread);
+    QSignalSpy successSpy(&purchaseTransactionModel, &QMLPurchaseTransactionModel::success);
+
+    // STEP: Load the first page.
+    purchaseTransactionModel.componentComplete();
+    QCOMPARE(thread.pendingCount(), 1);
+    QVERIFY(thread.pendingRequest(0).params().value("after_created").isNull());
+    QVERIFY(thread.pendingRequest(0).params().value("after_id").isNull());
+    QCOMPARE(thread.pendingRequest(0).params().value("limit").toInt(), PageCursor::DEFAULT_PAGE_SIZE);
+    QVERIFY(!purchaseTransactionModel.canFetchMore(QModelIndex()));
+
+    thread.respond(0, QVariantMap {
+                       { "transactions", QVariantList { transaction(3), transaction(2) } },
+                       { "has_more", true }
+                   });
+    QCOMPARE(purchaseTransactionModel.rowCount(), 2);
+    QVERIFY(purchaseTransactionModel.canFetchMore(QModelIndex()));
+
+    // STEP: Ensure the next page starts after the last row, even when rows share the same time.
+    purchaseTransactionModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 1);
+    QCOMPARE(thread.pendingRequest(0).params().value("after_created").toDateTime(), created);
+    QCOMPARE(thread.pendingRequest(0).params().value("after_id").toInt(), 2);
+
+    // STEP: Ensure no other page is asked for while one is in flight.
+    QVERIFY(!purchaseTransactionModel.canFetchMore(QModelIndex()));
+    purchaseTransactionModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 1);
+
+    // STEP: Append the last page.
+    thread.respond(0, QVariantMap {
+                       { "transactions", QVariantList { transaction(1) } },
+                       { "has_more", false }
+                   });
+    QCOMPARE(successSpy.count(), 2);
+    QCOMPARE(purchaseTransactionModel.rowCount(), 3);
+    QCOMPARE(purchaseTransactionModel.index(0, 0).data(QMLPurchaseTransactionModel::TransactionIdRole).toInt(), 3);
+    QCOMPARE(purchaseTransactionModel.index(1, 0).data(QMLPurchaseTransactionModel::TransactionIdRole).toInt(), 2);
+    QCOMPARE(purchaseTransactionModel.index(2, 0).data(QMLPurchaseTransactionModel::TransactionIdRole).toInt(), 1);
+
+    // STEP: Ensure fetching stops at the end.
+    QVERIFY(!purchaseTransactionModel.canFetchMore(QModelIndex()));
+    purchaseTransactionModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 0);
+}
+
 QTEST_MAIN(QMLPurchaseTransactionModelTest)
 
 #include "tst_qmlpurchasetransactionmodeltest.moc"
@@ -1,9 +1,14 @@
 #include <QString>
 #include <QtTest>
 #include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 
 #include "qmlapi/qmlsalecartmodel.h"
+#include "database/stockcatalog.h"
 #include "mockdatabasethread.h"
+#include "queueddatabasethread.h"
 #include "utility/saleutils.h"
 
 class QMLSaleCartModelTest : public QObject
@@ -40,10 +45,12 @@ private Q_SLOTS:
     void testSuspendTransaction();
     void testSetTransactionId();
     void testRetrieveSuspendedTransaction();
+    void testRetrievedItemNoteIsKept();
     void testSubmitEmptyTransaction();
     void testSuspendEmptyTransaction();
     void testRemoveItem();
     void testSetItemQuantity();
+    void testAddItemByBarcode();
 private:
     QMLSaleCartModel *m_saleCartModel;
     MockDatabaseThread m_thread;
@@ -853,6 +860,60 @@ void QMLSaleCartModelTest::testSetTransactionId()
 }
 
 
+void QMLSaleCartModelTest::testRetrievedItemNoteIsKept()
+{
+    const QVariantMap itemInfo {
+        { "category_id", 1 },
+        { "category", "Category1" },
+        { "item_id", 1 },
+        { "item", "Item1" },
+        { "quantity", 1.0 },
+        { "unit_id", 1 },
+        { "unit", "Unit1" },
+        { "cost_price", 2.0 },
+        { "retail_price", 3.0 },
+        { "unit_price", 13.0 },
+        { "cost", 13.0 },
+        { "amount_paid", 5.0 },
+        { "note", QStringLiteral("Gift wrap") },
+        { "available_quantity", 10.0 },
+        { "client_id", 1 },
+        { "customer_name", QStringLiteral("Customer") },
+        { "customer_phone_number", QStringLiteral("123456789") }
+    };
+    QSignalSpy errorSpy(m_saleCartModel, &QMLSaleCartModel::error);
+
+    m_result.setSuccessful(true);
+    m_result.setOutcome(QVariantMap {
+                            { "client_id", 1 },
+                            { "customer_name", QStringLiteral("Customer") },
+                            { "customer_phone_number", QStringLiteral("123456789") },
+                            { "items", QVariantList { { itemInfo } } }
+                        });
+
+    // STEP: Retrieve suspended transaction.
+    m_saleCartModel->setTransactionId(1);
+    QCOMPARE(errorSpy.count(), 0);
+    QCOMPARE(m_saleCartModel->rowCount(), 1);
+
+    // STEP: Ensure the item note is printed.
+    const QJsonObject &printable = QJsonDocument::fromJson(m_saleCartModel->toPrintableFormat().toUtf8()).object();
+    const QJsonObject &printedItem = printable.value("records").toArray().first().toObject();
+    QCOMPARE(printedItem.value("note").toString(), QStringLiteral("Gift wrap"));
+    QCOMPARE(printedItem.value("customer_name").toString(), QStringLiteral("Customer"));
+
+    m_result.setOutcome(QVariant());
+
+    // STEP: Submit transaction and ensure the item note and amount paid are passed back.
+    m_saleCartModel->addPayment(13.0, QMLSaleCartModel::Cash);
+    m_saleCartModel->submitTransaction();
+    QCOMPARE(errorSpy.count(), 0);
+
+    const QVariantMap &savedItem = m_result.request().params().value("items").toList().first().toMap();
+    QCOMPARE(savedItem.value("note").toString(), QStringLiteral("Gift wrap"));
+    QCOMPARE(savedItem.value("amount_paid").toDouble(), 5.0);
+}
+
 void QMLSaleCartModelTest::testSubmitEmptyTransaction()
 {
     auto databaseWillReturnEmptyResult = [this]() {
@@ -898,6 +959,70 @@ void QMLSaleCartModelTest::testSuspendEmptyTransaction()
     QCOMPARE(successSpy.count(), 0);
 }
 
+void QMLSaleCartModelTest::testAddItemByBarcode()
+{
+    const QVariantList items {
+        QVariantMap {
+            { "category_id", 1 },
+            { "category", "Category1" },
+            { "item_id", 1 },
+            { "item", "Item1" },
+            { "barcode", "1111" },
+            { "quantity", 2.0 },
+            { "unit_id", 1 },
+            { "unit", "Unit" },
+            { "retail_price", 10.0 }
+        },
+        QVariantMap {
+            { "category_id", 1 },
+            { "category", "Category1" },
+            { "item_id", 2 },
+            { "item", "Item2" },
+            { "barcode", "2222" },
+            { "quantity", 0.0 },
+            { "unit_id", 2 },
+            { "unit", "Unit" },
+            { "retail_price", 10.0 }
+        }
+    };
+
+    QueuedDatabaseThread thread;
+    StockCatalog catalog(thread);
+    QMLSaleCartModel saleCartModel(thread, catalog);
+    QSignalSpy errorSpy(&saleCartModel, &QMLSaleCartModel::error);
+
+    // STEP: Scan an item before the catalogue is loaded.
+    catalog.loadNow();
+    saleCartModel.addItemByBarcode("1111");
+    QCOMPARE(saleCartModel.rowCount(), 0);
+
+    // STEP: Ensure the scan is added once the catalogue is loaded.
+    thread.respond(0, QVariantMap { { "items", items } });
+    QCOMPARE(saleCartModel.rowCount(), 1);
+    QCOMPARE(saleCartModel.data(saleCartModel.index(0), QMLSaleCartModel::QuantityRole).toDouble(), 1.0);
+
+    // STEP: Scan the item until there is none left.
+    saleCartModel.addItemByBarcode("1111");
+    QCOMPARE(saleCartModel.data(saleCartModel.index(0), QMLSaleCartModel::QuantityRole).toDouble(), 2.0);
+    QCOMPARE(errorSpy.count(), 0);
+
+    saleCartModel.addItemByBarcode("1111");
+    QCOMPARE(saleCartModel.data(saleCartModel.index(0), QMLSaleCartModel::QuantityRole).toDouble(), 2.0);
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.takeFirst().first().toInt(), QMLSaleCartModel::OutOfStockError);
+
+    // STEP: Ensure an item that is out of stock is reported and not added.
+    saleCartModel.addItemByBarcode("2222");
+    QCOMPARE(saleCartModel.rowCount(), 1);
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.takeFirst().first().toInt(), QMLSaleCartModel::OutOfStockError);
+
+    // STEP: Ensure an unknown barcode is reported.
+    saleCartModel.addItemByBarcode("3333");
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.takeFirst().first().toInt(), QMLSaleCartModel::UnknownBarcodeError);
+}
+
 QTEST_MAIN(QMLSaleCartModelTest)
 
 #include "tst_qmlsalecartmodeltest.moc"
@@ -3,6 +3,7 @@
 
 #include "qmlapi/qmlsaletransactionmodel.h"
 #include "mockdatabasethread.h"
+#include "queueddatabasethread.h"
 
 class QMLSaleTransactionModelTest : public QObject
 {
@@ -15,6 +16,7 @@ private slots:
     void init();
     void cleanup();
     void testViewSaleTransactions();
+    void testFetchMore();
 
 private:
     QMLSaleTransactionModel *m_saleTransactionModel;
@@ -96,6 +98,65 @@ void QMLSaleTransactionModelTest::testViewSaleTransactions()
     QCOMPARE(m_saleTransactionModel->index(0, 0).data(QMLSaleTransactionModel::UserIdRole).toInt(), 1);
 }
 
+void QMLSaleTransactionModelTest::testFetchMore()
+{
+    const QDateTime created(QDate(2020, 3, 28), QTime(11, 5));
+    auto transaction = [&created](int transactionId) {
+        return QVariantMap {
+            { "transaction_id", transactionId },
+            { "customer_name", QStringLiteral("Customer %1").arg(transactionId) },
+            { "created", created },
+            { "last_edited", created }
+        };
+    };
+
+    QueuedDatabaseThread thread;
+    QMLSaleTransactionModel saleTransactionModel(thread);
+    QSignalSpy successSpy(&saleTransactionModel, &QMLSaleTransactionModel::success);
+
+    // STEP: Load the first page.
+    saleTransactionModel.componentComplete();
+    QCOMPARE(thread.pendingCount(), 1);
+    QVERIFY(thread.pendingRequest(0).params().value("after_created").isNull());
+    QVERIFY(thread.pendingRequest(0).params().value("after_id").isNull());
+    QCOMPARE(thread.pendingRequest(0).params().value("limit").toInt(), PageCursor::DEFAULT_PAGE_SIZE);
+    QVERIFY(!saleTransactionModel.canFetchMore(QModelIndex()));
+
+    thread.respond(0, QVariantMap {
+                       { "transactions", QVariantList { transaction(3), transaction(2) } },
+                       { "has_more", true }
+                   });
+    QCOMPARE(saleTransactionModel.rowCount(), 2);
+    QVERIFY(saleTransactionModel.canFetchMore(QModelIndex()));
+
+    // STEP: Ensure the next page starts after the last row, even when rows share the same time.
+    saleTransactionModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 1);
+    QCOMPARE(thread.pendingRequest(0).params().value("after_created").toDateTime(), created);
+    QCOMPARE(thread.pendingRequest(0).params().value("after_id").toInt(), 2);
+
+    // STEP: Ensure no other page is asked for while one is in flight.
+    QVERIFY(!saleTransactionModel.canFetchMore(QModelIndex()));
+    saleTransactionModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 1);
+
+    // STEP: Append the last page.
+    thread.respond(0, QVariantMap {
+                       { "transactions", QVariantList { transaction(1) } },
+                       { "has_more", false }
+                   });
+    QCOMPARE(successSpy.count(), 2);
+    QCOMPARE(saleTransactionModel.rowCount(), 3);
+    QCOMPARE(saleTransactionModel.index(0, 0).data(QMLSaleTransactionModel::TransactionIdRole).toInt(), 3);
+    QCOMPARE(saleTransactionModel.index(1, 0).data(QMLSaleTransactionModel::TransactionIdRole).toInt(), 2);
+    QCOMPARE(saleTransactionModel.index(2, 0).data(QMLSaleTransactionModel::TransactionIdRole).toInt(), 1);
+
+    // STEP: Ensure fetching stops at the end.
+    QVERIFY(!saleTransactionModel.canFetchMore(QModelIndex()));
+    saleTransactionModel.fetchMore(QModelIndex());
+    QCOMPARE(thread.pendingCount(), 0);
+}
+
 QTEST_MAIN(QMLSaleTransactionModelTest)
 
 #include "tst_qmlsaletransactionmodeltest.moc"
@@ -2,7 +2,10 @@
 #include <QCoreApplication>
 
 #include "qmlapi/qmlstockcategorymodel.h"
+#include "database/stockcatalog.h"
+#include "queryexecutors/stock.h"
 #include "mockdatabasethread.h"
+#include "queueddatabasethread.h"
 
 class QMLStockCategoryModelTest : public QObject
 {
@@ -17,6 +20,7 @@ private slots:
     void testViewStockCategories();
     void testFilterCategory();
     void testFilterItem();
+    void testFilterByItemFromCatalogIgnoresStaleReads();
 
 private:
     QMLStockCategoryModel *m_stockCategoryModel;
@@ -173,6 +177,69 @@ void QMLStockCategoryModelTest::testFilterItem()
     QCOMPARE(m_stockCategoryModel->rowCount(), 0);
 }
 
+void QMLStockCategoryModelTest::testFilterByItemFromCatalogIgnoresStaleReads()
+{
+    const QVariantList items {
+        QVariantMap {
+            { "category_id", 1 },
+            { "category", "Drinks" },
+            { "item_id", 1 },
+            { "item", "Coca Cola" }
+        },
+        QVariantMap {
+            { "category_id", 2 },
+            { "category", "Snacks" },
+            { "item_id", 2 },
+            { "item", "Cola Nuts" }
+        },
+        QVariantMap {
+            { "category_id", 3 },
+            { "category", "Soap" },
+            { "item_id", 3 },
+            { "item", "Lux" }
+        }
+    };
+    const QVariantList categories {
+        QVariantMap { { "category_id", 1 }, { "category", "Drinks" } },
+        QVariantMap { { "category_id", 2 }, { "category", "Snacks" } },
+        QVariantMap { { "category_id", 3 }, { "category", "Soap" } }
+    };
+
+    QueuedDatabaseThread thread;
+    StockCatalog catalog(thread);
+    QMLStockCategoryModel stockCategoryModel(thread, catalog);
+    QSignalSpy successSpy(&stockCategoryModel, &QMLStockCategoryModel::success);
+
+    // STEP: Load the catalogue.
+    catalog.loadNow();
+    QCOMPARE(thread.pendingCount(), 1);
+    QCOMPARE(thread.pendingRequest(0).command(), StockQuery::ViewStockCatalog::COMMAND);
+    thread.respond(0, QVariantMap { { "items", items } });
+    QVERIFY(catalog.isReady());
+
+    // STEP: Leave a read of every category in flight.
+    stockCategoryModel.componentComplete();
+    QCOMPARE(thread.pendingCount(), 1);
+    QVERIFY(stockCategoryModel.isBusy());
+
+    // STEP: Filter from the catalogue while the read is in flight.
+    stockCategoryModel.setItemFilterText("cola");
+    QVERIFY(!stockCategoryModel.isBusy());
+    QCOMPARE(successSpy.count(), 1);
+    successSpy.clear();
+    QCOMPARE(stockCategoryModel.rowCount(), 2);
+
+    // STEP: Ensure the read that returns late does not replace the filtered rows.
+    thread.respond(0, QVariantMap { { "categories", categories } });
+    QVERIFY(!stockCategoryModel.isBusy());
+    QCOMPARE(successSpy.count(), 0);
+    QCOMPARE(stockCategoryModel.rowCount(), 2);
+    QCOMPARE(stockCategoryModel.data(stockCategoryModel.index(0), QMLStockCategoryModel::CategoryRole).toString(),
+             QStringLiteral("Drinks"));
+    QCOMPARE(stockCategoryModel.data(stockCategoryModel.index(1), QMLStockCategoryModel::CategoryRole).toString(),
+             QStringLiteral("Snacks"));
+}
+
 QTEST_MAIN(QMLStockCategoryModelTest)
 
 #include "tst_qmlstockcategorymodeltest.moc"
@@ -2,7 +2,10 @@
 #include <QCoreApplication>
 
 #include "qmlapi/qmlstockitemmodel.h"
+#include "database/stockcatalog.h"
+#include "queryexecutors/stock.h"
 #include "mockdatabasethread.h"
+#include "queueddatabasethread.h"
 
 class QMLStockItemModelTest : public QObject
 {
@@ -20,6 +23,7 @@ private slots:
     void testRemoveItem();
     void testUndoRemoveItem();
     void testFilterItem();
+    void testFilterFromCatalogIgnoresStaleReads();
 private:
     QMLStockItemModel *m_stockItemModel;
     MockDatabaseThread m_thread;
@@ -364,6 +368,78 @@ void QMLStockItemModelTest::testFilterItem()
     QCOMPARE(m_stockItemModel->rowCount(), 0);
 }
 
+void QMLStockItemModelTest::testFilterFromCatalogIgnoresStaleReads()
+{
+    const QVariantMap cola {
+        { "category_id", 1 },
+        { "category", "Category1" },
+        { "item_id", 1 },
+        { "item", "Coca Cola" },
+        { "quantity", 10.0 },
+        { "unit_id", 1 },
+        { "unit", "Unit1" }
+    };
+    const QVariantMap pepsi {
+        { "category_id", 1 },
+        { "category", "Category1" },
+        { "item_id", 2 },
+        { "item", "Pepsi" },
+        { "quantity", 10.0 },
+        { "unit_id", 2 },
+        { "unit", "Unit2" }
+    };
+
+    QueuedDatabaseThread thread;
+    StockCatalog catalog(thread);
+    QMLStockItemModel stockItemModel(thread, catalog);
+    QSignalSpy successSpy(&stockItemModel, &QMLStockItemModel::success);
+
+    // STEP: Load the catalogue.
+    catalog.loadNow();
+    QCOMPARE(thread.pendingCount(), 1);
+    QCOMPARE(thread.pendingRequest(0).command(), StockQuery::ViewStockCatalog::COMMAND);
+    thread.respond(0, QVariantMap { { "items", QVariantList { cola, pepsi } } });
+    QVERIFY(catalog.isReady());
+
+    // STEP: Leave reads of the category in flight.
+    stockItemModel.setCategoryId(1);
+    stockItemModel.setSortColumn(QMLStockItemModel::ItemColumn);
+    stockItemModel.setFilterColumn(QMLStockItemModel::ItemColumn);
+    QCOMPARE(thread.pendingCount(), 3);
+    QVERIFY(stockItemModel.isBusy());
+
+    // STEP: Filter from the catalogue while the reads are in flight.
+    stockItemModel.setFilterText("cola");
+    QVERIFY(!stockItemModel.isBusy());
+    QCOMPARE(successSpy.count(), 1);
+    successSpy.clear();
+    QCOMPARE(stockItemModel.rowCount(), 1);
+
+    // STEP: Ensure the reads that return late do not replace the filtered rows.
+    while (thread.pendingCount() > 0)
+        thread.respond(0, QVariantMap { { "items", QVariantList { cola, pepsi } } });
+
+    QVERIFY(!stockItemModel.isBusy());
+    QCOMPARE(successSpy.count(), 0);
+    QCOMPARE(stockItemModel.rowCount(), 1);
+    QCOMPARE(stockItemModel.data(stockItemModel.index(0, 0), QMLStockItemModel::ItemRole).toString(),
+             QStringLiteral("Coca Cola"));
+
+    // STEP: Ensure a read that returns after the one that replaced it is ignored.
+    stockItemModel.setFilterText(QString());
+    stockItemModel.setSortOrder(Qt::DescendingOrder);
+    QCOMPARE(thread.pendingCount(), 2);
+
+    thread.respond(1, QVariantMap { { "items", QVariantList { pepsi, cola } } });
+    QVERIFY(!stockItemModel.isBusy());
+    thread.respond(0, QVariantMap { { "items", QVariantList { cola } } });
+
+    QCOMPARE(successSpy.count(), 1);
+    QCOMPARE(stockItemModel.rowCount(), 2);
+    QCOMPARE(stockItemModel.data(stockItemModel.index(0, 0), QMLStockItemModel::ItemRole).toString(),
+             QStringLiteral("Pepsi"));
+}
+
 QTEST_MAIN(QMLStockItemModelTest)
 
 #include "tst_qmlstockitemmodeltest.moc"
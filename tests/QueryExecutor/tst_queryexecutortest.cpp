@@ -0,0 +1,161 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/queryexecutor.h"
+#include "database/preparedstatementcache.h"
+#include "testdatabase.h"
+
+class ProcedureCaller : public QueryExecutor
+{
+public:
+    explicit ProcedureCaller(const QString &connectionName) :
+        QueryExecutor()
+    {
+        setConnectionName(connectionName);
+    }
+
+    using QueryExecutor::callProcedure;
+};
+
+class QueryExecutorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    QueryExecutorTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testConsecutiveCallsReturningRows();
+    void testCallWithOutArgument();
+    void testInValuesAreEscaped();
+private:
+    QScopedPointer<TestDatabase> m_database;
+};
+
+QueryExecutorTest::QueryExecutorTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void QueryExecutorTest::init()
+{
+    m_database.reset(new TestDatabase(QStringLiteral("rr_test_query_executor")));
+    if (!m_database->isOpen())
+        QSKIP(qPrintable(QStringLiteral("No MySQL server: %1").arg(m_database->errorString())));
+
+    QVERIFY2(m_database->exec(QStringLiteral("CREATE PROCEDURE ViewNumbers (IN iCount INTEGER) "
+                                             "BEGIN "
+                                             "SELECT 1 AS number UNION ALL SELECT 2 UNION ALL SELECT 3 LIMIT iCount; "
+                                             "END")),
+             qPrintable(m_database->errorString()));
+    QVERIFY2(m_database->exec(QStringLiteral("CREATE PROCEDURE AddNumber (IN iNumber INTEGER, OUT oDoubled INTEGER) "
+                                             "BEGIN "
+                                             "SET oDoubled = iNumber * 2; "
+                                             "END")),
+             qPrintable(m_database->errorString()));
+    QVERIFY2(m_database->exec(QStringLiteral("CREATE PROCEDURE ViewText (IN iText VARCHAR(100)) "
+                                             "BEGIN "
+                                             "SELECT iText AS text; "
+                                             "END")),
+             qPrintable(m_database->errorString()));
+}
+
+void QueryExecutorTest::cleanup()
+{
+    if (m_database)
+        PreparedStatementCache::instance().clear(m_database->connectionName());
+    m_database.reset();
+}
+
+void QueryExecutorTest::testConsecutiveCallsReturningRows()
+{
+    ProcedureCaller caller(m_database->connectionName());
+
+    // STEP: Ensure a second call on the same connection is not out of sync with the first.
+    for (int count = 3; count > 0; --count) {
+        const QList<QSqlRecord> &records = caller.callProcedure("ViewNumbers", {
+                                                                    ProcedureArgument {
+                                                                        ProcedureArgument::Type::In,
+                                                                        "count",
+                                                                        count
+                                                                    }
+                                                                });
+        QCOMPARE(records.count(), count);
+        QCOMPARE(records.first().value("number").toInt(), 1);
+    }
+
+    // STEP: Ensure plain statements still run after the calls.
+    QCOMPARE(m_database->value(QStringLiteral("SELECT 42")).toInt(), 42);
+}
+
+void QueryExecutorTest::testCallWithOutArgument()
+{
+    ProcedureCaller caller(m_database->connectionName());
+
+    const QList<QSqlRecord> &numbers = caller.callProcedure("ViewNumbers", {
+                                                                ProcedureArgument {
+                                                                    ProcedureArgument::Type::In,
+                                                                    "count",
+                                                                    2
+                                                                }
+                                                            });
+    QCOMPARE(numbers.count(), 2);
+
+    for (int number = 1; number <= 2; ++number) {
+        const QList<QSqlRecord> &records = caller.callProcedure("AddNumber", {
+                                                                    ProcedureArgument {
+                                                                        ProcedureArgument::Type::In,
+                                                                        "number",
+                                                                        number
+                                                                    },
+                                                                    ProcedureArgument {
+                                                                        ProcedureArgument::Type::Out,
+                                                                        "doubled",
+                                                                        {}
+                                                                    }
+                                                                });
+        QCOMPARE(records.count(), 1);
+        QCOMPARE(records.first().value("doubled").toInt(), number * 2);
+    }
+
+    QCOMPARE(caller.callProcedure("ViewNumbers", {
+                                      ProcedureArgument {
+                                          ProcedureArgument::Type::In,
+                                          "count",
+                                          3
+                                      }
+                                  }).count(), 3);
+}
+
+void QueryExecutorTest::testInValuesAreEscaped()
+{
+    ProcedureCaller caller(m_database->connectionName());
+    const QString text(QStringLiteral("O'Brien \\ \"quoted\"; DROP TABLE item"));
+
+    const QList<QSqlRecord> &records = caller.callProcedure("ViewText", {
+                                                                ProcedureArgument {
+                                                                    ProcedureArgument::Type::In,
+                                                                    "text",
+                                                                    text
+                                                                }
+                                                            });
+    QCOMPARE(records.count(), 1);
+    QCOMPARE(records.first().value("text").toString(), text);
+
+    const QList<QSqlRecord> &nullRecords = caller.callProcedure("ViewText", {
+                                                                    ProcedureArgument {
+                                                                        ProcedureArgument::Type::In,
+                                                                        "text",
+                                                                        QVariant()
+                                                                    }
+                                                                });
+    QCOMPARE(nullRecords.count(), 1);
+    QVERIFY(nullRecords.first().value("text").isNull());
+}
+
+QTEST_MAIN(QueryExecutorTest)
+
+#include "tst_queryexecutortest.moc"
@@ -0,0 +1,147 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <cmath>
+
+#include "database/querymetrics.h"
+#include "database/queryresult.h"
+
+class QueryMetricsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    QueryMetricsTest();
+
+private slots:
+    void testPercentiles();
+    void testResultsAreGroupedByCommandAndQueryGroup();
+    void testDump();
+    void testEstimateSizeSamplesLongLists();
+
+private:
+    QueryResult result(const QString &command,
+                       QueryRequest::QueryGroup queryGroup,
+                       bool successful,
+                       int recordCount) const;
+};
+
+QueryMetricsTest::QueryMetricsTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+QueryResult QueryMetricsTest::result(const QString &command,
+                                     QueryRequest::QueryGroup queryGroup,
+                                     bool successful,
+                                     int recordCount) const
+{
+    QueryRequest request;
+    request.setCommand(command, {}, queryGroup);
+    QueryResult result{ request };
+    result.setSuccessful(successful);
+    result.setOutcome(QVariantMap { { "record_count", recordCount } });
+    return result;
+}
+
+void QueryMetricsTest::testPercentiles()
+{
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.percentile(.5), qint64(0));
+
+    for (int i = 1; i <= 100; ++i)
+        histogram.record(i * 1000);
+
+    QCOMPARE(histogram.count(), qint64(100));
+
+    // STEP: Ensure each percentile is an upper bound within one bucket of the exact value.
+    const qreal bucketWidth = std::exp2(.25);
+    for (const qreal percentile : { .5, .95, .99 }) {
+        const qint64 exact = static_cast<qint64>(percentile * 100) * 1000;
+        QVERIFY(histogram.percentile(percentile) >= exact);
+        QVERIFY(histogram.percentile(percentile) <= exact * bucketWidth + 1);
+    }
+}
+
+void QueryMetricsTest::testResultsAreGroupedByCommandAndQueryGroup()
+{
+    QueryMetrics metrics;
+    metrics.recordResult(result("view_stock_items", QueryRequest::QueryGroup::Stock, true, 20), 2000);
+    metrics.recordResult(result("view_stock_items", QueryRequest::QueryGroup::Stock, false, 0), 4000);
+    metrics.recordResult(result("view_stock_categories", QueryRequest::QueryGroup::Stock, true, 5), 1000);
+
+    const QVariantList &commands = metrics.commandStatistics();
+    QCOMPARE(commands.count(), 2);
+
+    QVariantMap viewStockItems;
+    for (const QVariant &command : commands)
+        if (command.toMap().value("name") == "view_stock_items")
+            viewStockItems = command.toMap();
+
+    QCOMPARE(viewStockItems.value("count").toLongLong(), qint64(2));
+    QCOMPARE(viewStockItems.value("failure_count").toLongLong(), qint64(1));
+    QCOMPARE(viewStockItems.value("row_count").toLongLong(), qint64(20));
+    QVERIFY(viewStockItems.value("byte_count").toLongLong() > 0);
+
+    const QVariantList &queryGroups = metrics.queryGroupStatistics();
+    QCOMPARE(queryGroups.count(), 1);
+    QCOMPARE(queryGroups.first().toMap().value("name").toString(), QStringLiteral("Stock"));
+    QCOMPARE(queryGroups.first().toMap().value("count").toLongLong(), qint64(3));
+
+    // STEP: Ensure counters are reset, but commands are kept.
+    metrics.clear();
+    QCOMPARE(metrics.commandStatistics().first().toMap().value("count").toLongLong(), qint64(0));
+    QVERIFY(metrics.queryGroupStatistics().isEmpty());
+}
+
+void QueryMetricsTest::testDump()
+{
+    QTemporaryDir directory;
+    const QString filePath = directory.filePath("diagnostics/query_metrics.json");
+
+    QueryMetrics metrics;
+    metrics.recordResult(result("view_clients", QueryRequest::QueryGroup::Client, true, 1), 1500);
+    QVERIFY(metrics.dump(filePath));
+
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QJsonObject &object = QJsonDocument::fromJson(file.readAll()).object();
+    QCOMPARE(object.value("commands").toArray().count(), 1);
+    QCOMPARE(object.value("query_groups").toArray().count(), 1);
+}
+
+void QueryMetricsTest::testEstimateSizeSamplesLongLists()
+{
+    const QVariantMap row {
+        { "item", QStringLiteral("Item") },
+        { "quantity", 1.0 }
+    };
+    const qint64 rowSize = QueryMetrics::estimateSize(row);
+    QCOMPARE(rowSize, qint64(8 + 8 + 16 + 8));
+
+    // STEP: Ensure short lists are measured exactly.
+    QVariantList rows;
+    for (int i = 0; i < QueryMetrics::SIZE_SAMPLE_COUNT; ++i)
+        rows.append(row);
+    QCOMPARE(QueryMetrics::estimateSize(rows), rowSize * rows.count());
+
+    // STEP: Ensure a long list of alike rows is extrapolated from a sample.
+    for (int i = rows.count(); i < 100000; ++i)
+        rows.append(row);
+    QCOMPARE(QueryMetrics::estimateSize(QVariantMap { { "items", rows } }), qint64(10) + rowSize * rows.count());
+
+    // STEP: Ensure rows of different sizes are estimated within a reasonable margin.
+    QVariantList mixedRows;
+    qint64 expectedSize = 0;
+    for (int i = 0; i < 10000; ++i) {
+        const QString text(i % 7 + 1, 'x');
+        mixedRows.append(text);
+        expectedSize += text.size() * 2;
+    }
+    const qint64 estimatedSize = QueryMetrics::estimateSize(mixedRows);
+    QVERIFY(std::abs(estimatedSize - expectedSize) < expectedSize / 10);
+}
+
+QTEST_MAIN(QueryMetricsTest)
+
+#include "tst_querymetricstest.moc"
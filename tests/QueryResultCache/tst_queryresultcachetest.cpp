@@ -0,0 +1,166 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/queryresultcache.h"
+#include "database/queryresult.h"
+
+class QueryResultCacheTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    QueryResultCacheTest();
+
+private slots:
+    void testHitAfterRead();
+    void testWriteInvalidatesDependentGroup();
+    void testReadIssuedBeforeWriteIsNotCached();
+    void testWritesAreNotCacheable();
+    void testCapacityIsAByteBudget();
+
+private:
+    QueryRequest readRequest(const QString &command,
+                             const QVariantMap &params,
+                             QueryRequest::QueryGroup queryGroup) const;
+    QueryResult successfulResult(const QueryRequest &request, const QVariant &outcome) const;
+};
+
+QueryResultCacheTest::QueryResultCacheTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+QueryRequest QueryResultCacheTest::readRequest(const QString &command,
+                                               const QVariantMap &params,
+                                               QueryRequest::QueryGroup queryGroup) const
+{
+    QueryRequest request;
+    request.setCommand(command, params, queryGroup);
+    return request;
+}
+
+QueryResult QueryResultCacheTest::successfulResult(const QueryRequest &request, const QVariant &outcome) const
+{
+    QueryResult result{ request };
+    result.setSuccessful(true);
+    result.setOutcome(outcome);
+    return result;
+}
+
+void QueryResultCacheTest::testHitAfterRead()
+{
+    QueryResultCache cache;
+    const QueryRequest request(readRequest("view_stock_items",
+                                           { { "category_id", 1 } },
+                                           QueryRequest::QueryGroup::Stock));
+    const QVariantMap outcome { { "items", QVariantList { QVariantMap { { "item_id", 1 } } } } };
+    QVariant cachedOutcome;
+
+    QVERIFY(!cache.lookup(request, cachedOutcome));
+    cache.beginRead(request);
+    cache.endRead(successfulResult(request, outcome));
+
+    QVERIFY(cache.lookup(request, cachedOutcome));
+    QCOMPARE(cachedOutcome.toMap(), outcome);
+    QCOMPARE(cache.hitCount(), 1);
+    QCOMPARE(cache.missCount(), 1);
+
+    // Different params must not share an entry.
+    QVERIFY(!cache.lookup(readRequest("view_stock_items",
+                                      { { "category_id", 2 } },
+                                      QueryRequest::QueryGroup::Stock), cachedOutcome));
+}
+
+void QueryResultCacheTest::testWriteInvalidatesDependentGroup()
+{
+    QueryResultCache cache;
+    const QueryRequest stockRequest(readRequest("view_stock_items",
+                                                { { "category_id", 1 } },
+                                                QueryRequest::QueryGroup::Stock));
+    const QueryRequest expenseRequest(readRequest("view_expense_report",
+                                                  {},
+                                                  QueryRequest::QueryGroup::Expense));
+    QVariant cachedOutcome;
+
+    for (const auto &request : { stockRequest, expenseRequest }) {
+        cache.beginRead(request);
+        cache.endRead(successfulResult(request, QVariantMap { { "record_count", 1 } }));
+    }
+    QCOMPARE(cache.count(), 2);
+
+    cache.invalidate(QueryRequest::QueryGroup::Sales);
+
+    QVERIFY(!cache.lookup(stockRequest, cachedOutcome));
+    QVERIFY(cache.lookup(expenseRequest, cachedOutcome));
+}
+
+void QueryResultCacheTest::testReadIssuedBeforeWriteIsNotCached()
+{
+    QueryResultCache cache;
+    const QueryRequest request(readRequest("view_stock_items",
+                                           { { "category_id", 1 } },
+                                           QueryRequest::QueryGroup::Stock));
+    QVariant cachedOutcome;
+
+    cache.beginRead(request);
+    cache.invalidate(QueryRequest::QueryGroup::Stock);
+    cache.beginRead(request);
+    cache.endRead(successfulResult(request, QVariantMap { { "record_count", 1 } }));
+
+    QVERIFY(!cache.lookup(request, cachedOutcome));
+
+    cache.endRead(successfulResult(request, QVariantMap { { "record_count", 2 } }));
+    cache.beginRead(request);
+    cache.endRead(successfulResult(request, QVariantMap { { "record_count", 3 } }));
+
+    QVERIFY(cache.lookup(request, cachedOutcome));
+    QCOMPARE(cachedOutcome.toMap().value("record_count").toInt(), 3);
+}
+
+void QueryResultCacheTest::testWritesAreNotCacheable()
+{
+    QueryResultCache cache;
+    QueryRequest request;
+    request.setCommand("add_sale_transaction", {}, QueryRequest::QueryGroup::Sales);
+
+    QVERIFY(!cache.isCacheable(request));
+    QVERIFY(!QueryResultCache(0).isCacheable(readRequest("view_stock_items",
+                                                         {},
+                                                         QueryRequest::QueryGroup::Stock)));
+}
+
+void QueryResultCacheTest::testCapacityIsAByteBudget()
+{
+    QueryResultCache cache(2000);
+    const QueryRequest firstRequest(readRequest("view_stock_items",
+                                                { { "category_id", 1 } },
+                                                QueryRequest::QueryGroup::Stock));
+    const QueryRequest secondRequest(readRequest("view_stock_items",
+                                                 { { "category_id", 2 } },
+                                                 QueryRequest::QueryGroup::Stock));
+    const QueryRequest largeRequest(readRequest("view_stock_items",
+                                                { { "category_id", 3 } },
+                                                QueryRequest::QueryGroup::Stock));
+    QVariant cachedOutcome;
+
+    // STEP: Ensure an entry is dropped once the outcomes no longer fit in the budget.
+    for (const auto &request : { firstRequest, secondRequest }) {
+        cache.beginRead(request);
+        cache.endRead(successfulResult(request, QVariantMap { { "item", QString(600, 'a') } }));
+    }
+
+    QCOMPARE(cache.count(), 1);
+    QVERIFY(cache.totalCost() <= cache.capacity());
+    QVERIFY(!cache.lookup(firstRequest, cachedOutcome));
+    QVERIFY(cache.lookup(secondRequest, cachedOutcome));
+
+    // STEP: Ensure an outcome larger than the whole budget is not kept.
+    cache.beginRead(largeRequest);
+    cache.endRead(successfulResult(largeRequest, QVariantMap { { "item", QString(1200, 'a') } }));
+
+    QVERIFY(!cache.lookup(largeRequest, cachedOutcome));
+}
+
+QTEST_MAIN(QueryResultCacheTest)
+
+#include "tst_queryresultcachetest.moc"
@@ -0,0 +1,134 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "database/readreplica.h"
+#include "database/changelog.h"
+#include "database/databaseexception.h"
+#include "testdatabase.h"
+
+class ReadReplicaTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReadReplicaTest();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testEmptyTablesCanBeCopied();
+    void testPendingChangesAreKept();
+    void testRowsOfUnsyncedDatabaseAreKept();
+    void testSyncedRowsAreReplaced();
+private:
+    QScopedPointer<TestDatabase> m_database;
+
+    bool addCategory(const QString &category);
+    QVariantMap firstPage() const;
+};
+
+ReadReplicaTest::ReadReplicaTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void ReadReplicaTest::init()
+{
+    m_database.reset(new TestDatabase(QStringLiteral("rr_test_replica")));
+    if (!m_database->isOpen())
+        QSKIP(qPrintable(QStringLiteral("No MySQL server: %1").arg(m_database->errorString())));
+
+    QVERIFY2(m_database->run(QStringLiteral("migrations/0002_change_log.sql"))
+             && m_database->run(QStringLiteral("procedures/changelog.sql")),
+             qPrintable(m_database->errorString()));
+    QVERIFY(ReadReplica::readWatermarks(m_database->connectionName()).isEmpty());
+}
+
+void ReadReplicaTest::cleanup()
+{
+    m_database.reset();
+}
+
+bool ReadReplicaTest::addCategory(const QString &category)
+{
+    return m_database->exec(QStringLiteral("INSERT INTO category (category, archived, created, last_edited, user_id) "
+                                           "VALUES (?, 0, NOW(), NOW(), 1)"), { category });
+}
+
+QVariantMap ReadReplicaTest::firstPage() const
+{
+    return QVariantMap {
+        { "tables", QVariantMap {
+                { "category", QVariantMap {
+                        { "rows", QVariantList {
+                                QVariantMap {
+                                    { "id", 7 },
+                                    { "category", QStringLiteral("Server") },
+                                    { "archived", 0 },
+                                    { "created", QDateTime::currentDateTime() },
+                                    { "last_edited", QDateTime::currentDateTime() },
+                                    { "user_id", 1 }
+                                }
+                            } },
+                        { "deleted", QVariantList() }
+                    } }
+            } },
+        { "has_more", false }
+    };
+}
+
+void ReadReplicaTest::testEmptyTablesCanBeCopied()
+{
+    ReadReplica::checkUnsyncedRows(m_database->connectionName(), ReadReplica::tables());
+
+    ReadReplica::applyChanges(m_database->connectionName(), firstPage(), QVariantMap());
+    QCOMPARE(m_database->value(QStringLiteral("SELECT category FROM category WHERE id = 7")).toString(),
+             QStringLiteral("Server"));
+    QVERIFY(ReadReplica::readWatermarks(m_database->connectionName()).contains("category"));
+}
+
+void ReadReplicaTest::testPendingChangesAreKept()
+{
+    // STEP: Write a row locally that has not been pushed.
+    QVERIFY2(addCategory(QStringLiteral("Local")), qPrintable(m_database->errorString()));
+
+    QVERIFY_EXCEPTION_THROWN(ReadReplica::checkUnsyncedRows(m_database->connectionName(), ReadReplica::tables()),
+                             DatabaseException);
+
+    // STEP: Ensure tables that already have a copy are not checked again.
+    ReadReplica::checkUnsyncedRows(m_database->connectionName(), { QStringLiteral("client") });
+}
+
+void ReadReplicaTest::testRowsOfUnsyncedDatabaseAreKept()
+{
+    // STEP: Write a row that predates the change log.
+    QVERIFY2(m_database->exec(QStringLiteral("SET @rr_capture_suppressed = 1")), qPrintable(m_database->errorString()));
+    QVERIFY2(addCategory(QStringLiteral("Legacy")), qPrintable(m_database->errorString()));
+    QVERIFY2(m_database->exec(QStringLiteral("SET @rr_capture_suppressed = NULL")), qPrintable(m_database->errorString()));
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM change_log")).toInt(), 0);
+
+    QVERIFY_EXCEPTION_THROWN(ReadReplica::checkUnsyncedRows(m_database->connectionName(), ReadReplica::tables()),
+                             DatabaseException);
+}
+
+void ReadReplicaTest::testSyncedRowsAreReplaced()
+{
+    // STEP: Write a row locally and push it.
+    QVERIFY2(addCategory(QStringLiteral("Local")), qPrintable(m_database->errorString()));
+    const qint64 lastSequence = m_database->value(QStringLiteral("SELECT MAX(id) FROM change_log")).toLongLong();
+    ChangeLog::acknowledge(m_database->connectionName(), lastSequence);
+
+    ReadReplica::checkUnsyncedRows(m_database->connectionName(), ReadReplica::tables());
+
+    // STEP: Ensure the first page replaces the synced rows with the server's.
+    ReadReplica::applyChanges(m_database->connectionName(), firstPage(), QVariantMap());
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM category")).toInt(), 1);
+    QCOMPARE(m_database->value(QStringLiteral("SELECT category FROM category WHERE id = 7")).toString(),
+             QStringLiteral("Server"));
+    QCOMPARE(m_database->value(QStringLiteral("SELECT COUNT(*) FROM change_log")).toInt(), 0);
+}
+
+QTEST_MAIN(ReadReplicaTest)
+
+#include "tst_readreplicatest.moc"
@@ -0,0 +1,175 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "models/recordtable.h"
+
+class RecordTableTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    RecordTableTest();
+
+private slots:
+    void testValuesTakeColumnType();
+    void testNullValuesStayNull();
+    void testSetValue();
+    void testIndexOf();
+    void testInsertAndRemove();
+    void testUnknownRole();
+private:
+    enum Roles {
+        IdRole = Qt::UserRole,
+        NameRole,
+        // NOTE: Left out on purpose, so roles with a gap are covered.
+        UnusedRole,
+        PriceRole,
+        ArchivedRole
+    };
+
+    RecordTable table() const;
+};
+
+RecordTableTest::RecordTableTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+RecordTable RecordTableTest::table() const
+{
+    return RecordTable {
+        { IdRole, QStringLiteral("id"), QMetaType::Int },
+        { NameRole, QStringLiteral("name"), QMetaType::QString },
+        { PriceRole, QStringLiteral("price"), QMetaType::Double },
+        { ArchivedRole, QStringLiteral("archived"), QMetaType::Bool }
+    };
+}
+
+void RecordTableTest::testValuesTakeColumnType()
+{
+    RecordTable records(table());
+
+    // STEP: Load a record whose values come as text, like they do from the server.
+    records.setRecords({
+                           QVariantMap {
+                               { "id", QStringLiteral("7") },
+                               { "name", QStringLiteral("Coke") },
+                               { "price", QStringLiteral("2.5") },
+                               { "archived", 1 }
+                           }
+                       });
+
+    QCOMPARE(records.count(), 1);
+    QCOMPARE(records.value(0, IdRole).type(), QVariant::Int);
+    QCOMPARE(records.value(0, IdRole).toInt(), 7);
+    QCOMPARE(records.value(0, NameRole).toString(), QStringLiteral("Coke"));
+    QCOMPARE(records.value(0, PriceRole).type(), QVariant::Double);
+    QCOMPARE(records.value(0, PriceRole).toDouble(), 2.5);
+    QCOMPARE(records.value(0, ArchivedRole).type(), QVariant::Bool);
+    QCOMPARE(records.value(0, ArchivedRole).toBool(), true);
+}
+
+void RecordTableTest::testNullValuesStayNull()
+{
+    RecordTable records(table());
+
+    // STEP: Load a record with a missing name and a NULL price and flag.
+    records.setRecords({
+                           QVariantMap {
+                               { "id", 1 },
+                               { "price", QVariant(QVariant::Double) },
+                               { "archived", QVariant(QVariant::Bool) }
+                           }
+                       });
+
+    // STEP: Ensure they are not read as "", 0 or false.
+    QVERIFY(!records.value(0, NameRole).isValid());
+    QVERIFY(records.value(0, PriceRole).isNull());
+    QVERIFY(records.value(0, ArchivedRole).isNull());
+    QVERIFY(!records.value(0, IdRole).isNull());
+
+    // STEP: Ensure they are handed back as null.
+    const QVariantMap &record = records.toVariantMap(0);
+    QCOMPARE(record.count(), 4);
+    QVERIFY(record.value("name").isNull());
+    QVERIFY(record.value("price").isNull());
+    QVERIFY(record.value("archived").isNull());
+}
+
+void RecordTableTest::testSetValue()
+{
+    RecordTable records(table());
+    records.append(QVariantMap { { "id", 1 }, { "name", QStringLiteral("Coke") }, { "price", 2.5 } });
+
+    records.setValue(0, PriceRole, QStringLiteral("3"));
+    QCOMPARE(records.value(0, PriceRole).type(), QVariant::Double);
+    QCOMPARE(records.value(0, PriceRole).toDouble(), 3.0);
+
+    // STEP: Ensure a value can be cleared.
+    records.setValue(0, NameRole, QVariant());
+    QVERIFY(records.value(0, NameRole).isNull());
+    QVERIFY(records.value(0, NameRole) != QVariant(QString("")));
+}
+
+void RecordTableTest::testIndexOf()
+{
+    RecordTable records(table());
+    records.setRecords({
+                           QVariantMap { { "id", 1 }, { "name", QStringLiteral("Coke") } },
+                           QVariantMap { { "id", 2 } },
+                           QVariantMap { { "id", 3 }, { "name", QString("") } }
+                       });
+
+    QCOMPARE(records.indexOf(IdRole, QStringLiteral("3")), 2);
+    QCOMPARE(records.indexOf(NameRole, QStringLiteral("Coke")), 0);
+    QCOMPARE(records.indexOf(NameRole, QString("")), 2);
+    QCOMPARE(records.indexOf(IdRole, 4), -1);
+}
+
+void RecordTableTest::testInsertAndRemove()
+{
+    RecordTable records(table());
+    records.setRecords({
+                           QVariantMap { { "id", 1 } },
+                           QVariantMap { { "id", 3 } }
+                       });
+
+    // STEP: Insert a row between the two, and one out of range.
+    records.insert(1, QVariantMap { { "id", 2 } });
+    records.insert(5, QVariantMap { { "id", 5 } });
+    QCOMPARE(records.count(), 3);
+    QCOMPARE(records.value(1, IdRole).toInt(), 2);
+    QCOMPARE(records.value(2, IdRole).toInt(), 3);
+
+    records.appendRecords({ QVariantMap { { "id", 4 } } });
+    QCOMPARE(records.count(), 4);
+    QCOMPARE(records.value(3, IdRole).toInt(), 4);
+
+    // STEP: Remove the first row.
+    records.removeAt(0);
+    QCOMPARE(records.count(), 3);
+    QCOMPARE(records.value(0, IdRole).toInt(), 2);
+    QCOMPARE(records.toVariantList().count(), 3);
+
+    records.clear();
+    QVERIFY(records.isEmpty());
+    QVERIFY(!records.value(0, IdRole).isValid());
+}
+
+void RecordTableTest::testUnknownRole()
+{
+    RecordTable records(table());
+    records.append(QVariantMap { { "id", 1 } });
+
+    QVERIFY(!records.value(0, UnusedRole).isValid());
+    QVERIFY(!records.value(0, Qt::DisplayRole).isValid());
+    QCOMPARE(records.indexOf(UnusedRole, 1), -1);
+
+    // STEP: Ensure writing to an unknown role changes nothing.
+    records.setValue(0, UnusedRole, 5);
+    QCOMPARE(records.toVariantMap(0).count(), 4);
+}
+
+QTEST_MAIN(RecordTableTest)
+
+#include "tst_recordtabletest.moc"
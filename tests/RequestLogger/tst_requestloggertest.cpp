@@ -0,0 +1,212 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QTemporaryDir>
+
+#include "network/requestlogger.h"
+#include "network/serverrequest.h"
+
+class RequestLoggerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    RequestLoggerTest();
+
+private slots:
+    void testRequestsAreReplayedInOrder();
+    void testBacklogSurvivesRestart();
+    void testReplayedSegmentsAreRemoved();
+    void testTornRecordIsDiscarded();
+    void testDamagedRecordIsDiscarded();
+    void testReadAheadAndRewind();
+    void testRequestsGetIdempotencyKeys();
+private:
+    static ServerRequest createRequest(int id);
+    static int requestId(const ServerRequest &request);
+    static QString lastSegmentPath(const QString &directory);
+};
+
+RequestLoggerTest::RequestLoggerTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false\n*.warning=false"));
+}
+
+void RequestLoggerTest::testRequestsAreReplayedInOrder()
+{
+    QTemporaryDir directory;
+    RequestLogger requestLogger(directory.path());
+
+    QVERIFY(!requestLogger.hasNext());
+    for (int i = 1; i <= 3; ++i)
+        requestLogger.push(createRequest(i));
+
+    QCOMPARE(requestLogger.count(), 3);
+    for (int i = 1; i <= 3; ++i) {
+        QVERIFY(requestLogger.hasNext());
+        QCOMPARE(requestId(requestLogger.nextRequest()), i);
+        requestLogger.pop();
+    }
+
+    QVERIFY(!requestLogger.hasNext());
+    QCOMPARE(requestLogger.nextRequest().queryRequest().command(), QString());
+}
+
+void RequestLoggerTest::testBacklogSurvivesRestart()
+{
+    QTemporaryDir directory;
+    {
+        RequestLogger requestLogger(directory.path());
+        for (int i = 1; i <= 3; ++i)
+            requestLogger.push(createRequest(i));
+        requestLogger.pop();
+    }
+
+    // STEP: Ensure a new logger resumes after the request that was replayed.
+    RequestLogger requestLogger(directory.path());
+    QCOMPARE(requestLogger.count(), 2);
+    QCOMPARE(requestId(requestLogger.nextRequest()), 2);
+
+    requestLogger.push(createRequest(4));
+    requestLogger.pop();
+    requestLogger.pop();
+    QCOMPARE(requestId(requestLogger.nextRequest()), 4);
+}
+
+void RequestLoggerTest::testReplayedSegmentsAreRemoved()
+{
+    QTemporaryDir directory;
+    RequestLogger requestLogger(directory.path(), 512);
+
+    for (int i = 1; i <= 20; ++i)
+        requestLogger.push(createRequest(i));
+
+    QVERIFY(requestLogger.segmentCount() > 1);
+
+    // STEP: Ensure each segment is removed once replayed.
+    const int segmentCount = requestLogger.segmentCount();
+    for (int i = 1; i <= 20; ++i) {
+        QCOMPARE(requestId(requestLogger.nextRequest()), i);
+        requestLogger.pop();
+        QVERIFY(requestLogger.segmentCount() <= segmentCount);
+    }
+
+    // STEP: Ensure nothing but an empty segment is left once the backlog is replayed.
+    QCOMPARE(requestLogger.segmentCount(), 1);
+    QCOMPARE(QDir(directory.path()).entryList({ "segment_*" }, QDir::Files).count(), 1);
+    QVERIFY(requestLogger.size() < 512);
+}
+
+void RequestLoggerTest::testTornRecordIsDiscarded()
+{
+    QTemporaryDir directory;
+    {
+        RequestLogger requestLogger(directory.path());
+        requestLogger.push(createRequest(1));
+        requestLogger.push(createRequest(2));
+    }
+
+    // STEP: Simulate a crash in the middle of a write.
+    QFile segment(lastSegmentPath(directory.path()));
+    QVERIFY(segment.open(QIODevice::Append));
+    segment.write(QByteArray::fromHex("ff00000012"));
+    segment.close();
+
+    RequestLogger requestLogger(directory.path());
+    QCOMPARE(requestLogger.count(), 2);
+
+    requestLogger.push(createRequest(3));
+    requestLogger.pop();
+    requestLogger.pop();
+    QCOMPARE(requestId(requestLogger.nextRequest()), 3);
+}
+
+void RequestLoggerTest::testDamagedRecordIsDiscarded()
+{
+    QTemporaryDir directory;
+    {
+        RequestLogger requestLogger(directory.path());
+        requestLogger.push(createRequest(1));
+        requestLogger.push(createRequest(2));
+    }
+
+    // STEP: Damage the last byte of the last record.
+    QFile segment(lastSegmentPath(directory.path()));
+    QVERIFY(segment.open(QIODevice::ReadWrite));
+    QVERIFY(segment.seek(segment.size() - 1));
+    const char lastByte = segment.read(1).at(0);
+    QVERIFY(segment.seek(segment.size() - 1));
+    segment.write(QByteArray(1, static_cast<char>(lastByte ^ 0x55)));
+    segment.close();
+
+    RequestLogger requestLogger(directory.path());
+    QCOMPARE(requestLogger.count(), 1);
+    QCOMPARE(requestId(requestLogger.nextRequest()), 1);
+}
+
+void RequestLoggerTest::testReadAheadAndRewind()
+{
+    QTemporaryDir directory;
+    RequestLogger requestLogger(directory.path(), 512);
+
+    for (int i = 1; i <= 10; ++i)
+        requestLogger.push(createRequest(i));
+
+    // STEP: Hand out two batches before acknowledging the first.
+    for (int i = 1; i <= 6; ++i)
+        QCOMPARE(requestId(requestLogger.readAhead()), i);
+    QCOMPARE(requestLogger.unreadCount(), 4);
+
+    requestLogger.pop(3);
+    QCOMPARE(requestLogger.count(), 7);
+    QCOMPARE(requestLogger.unreadCount(), 4);
+    QCOMPARE(requestId(requestLogger.readAhead()), 7);
+
+    // STEP: Ensure unacknowledged requests are handed out again after a rewind.
+    requestLogger.rewind();
+    QCOMPARE(requestLogger.unreadCount(), 7);
+    QCOMPARE(requestId(requestLogger.readAhead()), 4);
+
+    requestLogger.pop(7);
+    QVERIFY(!requestLogger.hasNext());
+    QCOMPARE(requestLogger.unreadCount(), 0);
+    QCOMPARE(requestLogger.readAhead().queryRequest().command(), QString());
+}
+
+void RequestLoggerTest::testRequestsGetIdempotencyKeys()
+{
+    QTemporaryDir directory;
+    RequestLogger requestLogger(directory.path());
+
+    ServerRequest keyedRequest(createRequest(1));
+    keyedRequest.setIdempotencyKey(QStringLiteral("key"));
+    requestLogger.push(keyedRequest);
+    requestLogger.push(createRequest(2));
+
+    QCOMPARE(requestLogger.nextRequest().idempotencyKey(), QStringLiteral("key"));
+    requestLogger.pop();
+    QVERIFY(!requestLogger.nextRequest().idempotencyKey().isEmpty());
+}
+
+ServerRequest RequestLoggerTest::createRequest(int id)
+{
+    QueryRequest queryRequest;
+    queryRequest.setCommand(QStringLiteral("add_sale_transaction"),
+                            { { "transaction_id", id } },
+                            QueryRequest::QueryGroup::Sales);
+    return ServerRequest(queryRequest);
+}
+
+int RequestLoggerTest::requestId(const ServerRequest &request)
+{
+    return request.queryRequest().params().value("transaction_id").toInt();
+}
+
+QString RequestLoggerTest::lastSegmentPath(const QString &directory)
+{
+    const QStringList &fileNames = QDir(directory).entryList({ "segment_*" }, QDir::Files, QDir::Name);
+    return fileNames.isEmpty() ? QString() : QDir(directory).filePath(fileNames.last());
+}
+
+QTEST_MAIN(RequestLoggerTest)
+
+#include "tst_requestloggertest.moc"
@@ -0,0 +1,132 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QQuickWindow>
+#include <QJsonArray>
+#include <QStandardPaths>
+#include <QSGRendererInterface>
+
+#include "singletons/startupprofiler.h"
+
+class StartupProfilerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    StartupProfilerTest();
+
+private slots:
+    void initTestCase();
+
+    void testTasksRunAfterFirstFrameOfWindow();
+    void testTasksRunAfterTimeoutWithoutWindow();
+    void testTasksOfDestroyedContextAreDropped();
+    void testLateTasksRunFromEventLoop();
+private:
+    static bool hasSpan(const StartupProfiler &profiler, const QString &name);
+};
+
+StartupProfilerTest::StartupProfilerTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void StartupProfilerTest::initTestCase()
+{
+    // NOTE: The trace is written to disk when the profiler finishes.
+    QStandardPaths::setTestModeEnabled(true);
+
+    // NOTE: The software renderer needs no OpenGL, so a frame can be drawn on any machine.
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+}
+
+bool StartupProfilerTest::hasSpan(const StartupProfiler &profiler, const QString &name)
+{
+    for (const QJsonValue &span : profiler.toJson().value("spans").toArray()) {
+        if (span.toObject().value("name").toString() == name)
+            return true;
+    }
+
+    return false;
+}
+
+void StartupProfilerTest::testTasksRunAfterFirstFrameOfWindow()
+{
+    StartupProfiler profiler(60 * 1000);
+    QQuickWindow window;
+    QObject context;
+    int runCount = 0;
+
+    profiler.watch(&window);
+    profiler.runAfterFirstFrame(&context, [&runCount]() { runCount++; });
+    profiler.runAfterFirstFrame(&context, [&runCount]() { runCount++; });
+
+    // STEP: Ensure nothing runs before the window draws a frame.
+    QCoreApplication::processEvents();
+    QVERIFY(!profiler.isFirstFrameShown());
+    QCOMPARE(runCount, 0);
+
+    // STEP: Show the window.
+    window.resize(100, 100);
+    window.show();
+    QTRY_VERIFY(profiler.isFirstFrameShown());
+    QTRY_COMPARE(runCount, 2);
+    QVERIFY(hasSpan(profiler, QStringLiteral("first_frame")));
+    QVERIFY(!hasSpan(profiler, QStringLiteral("first_frame_timeout")));
+}
+
+void StartupProfilerTest::testTasksRunAfterTimeoutWithoutWindow()
+{
+    StartupProfiler profiler(100);
+    QObject context;
+    QSignalSpy firstFrameSpy(&profiler, &StartupProfiler::firstFrameShown);
+    int runCount = 0;
+
+    profiler.runAfterFirstFrame(&context, [&runCount]() { runCount++; });
+    QCOMPARE(runCount, 0);
+
+    // STEP: Ensure the task runs once the timeout stands in for the first frame.
+    QTRY_COMPARE(runCount, 1);
+    QCOMPARE(firstFrameSpy.count(), 1);
+    QVERIFY(profiler.isFirstFrameShown());
+    QVERIFY(hasSpan(profiler, QStringLiteral("first_frame_timeout")));
+
+    // STEP: Ensure it is not run again.
+    QTest::qWait(200);
+    QCOMPARE(runCount, 1);
+    QCOMPARE(firstFrameSpy.count(), 1);
+}
+
+void StartupProfilerTest::testTasksOfDestroyedContextAreDropped()
+{
+    StartupProfiler profiler(100);
+    QScopedPointer<QObject> context(new QObject);
+    QObject otherContext;
+    int runCount = 0;
+    int otherRunCount = 0;
+
+    profiler.runAfterFirstFrame(context.data(), [&runCount]() { runCount++; });
+    profiler.runAfterFirstFrame(&otherContext, [&otherRunCount]() { otherRunCount++; });
+    context.reset();
+
+    QTRY_COMPARE(otherRunCount, 1);
+    QCOMPARE(runCount, 0);
+}
+
+void StartupProfilerTest::testLateTasksRunFromEventLoop()
+{
+    StartupProfiler profiler(0);
+    QObject context;
+    int runCount = 0;
+
+    profiler.runAfterFirstFrame(&context, []() {});
+    QTRY_VERIFY(profiler.isFirstFrameShown());
+
+    // STEP: Ensure a task queued after the first frame still waits for the event loop.
+    profiler.runAfterFirstFrame(&context, [&runCount]() { runCount++; });
+    QCOMPARE(runCount, 0);
+    QTRY_COMPARE(runCount, 1);
+}
+
+QTEST_MAIN(StartupProfilerTest)
+
+#include "tst_startupprofilertest.moc"
@@ -0,0 +1,178 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include "database/stockcatalogindex.h"
+
+class StockCatalogIndexTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    StockCatalogIndexTest();
+
+private slots:
+    void testShortTextMatchesWordPrefixes();
+    void testLongTextMatchesSubstrings();
+    void testSearchByCategory();
+    void testInsertReplacesItem();
+    void testRemove();
+    void testFindByBarcode();
+    void testSearchLargeCatalogue();
+
+private:
+    StockCatalogItem item(int itemId, int categoryId, const QString &name) const;
+};
+
+StockCatalogIndexTest::StockCatalogIndexTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+StockCatalogItem StockCatalogIndexTest::item(int itemId, int categoryId, const QString &name) const
+{
+    StockCatalogItem item;
+    item.itemId = itemId;
+    item.categoryId = categoryId;
+    item.category = QStringLiteral("Category %1").arg(categoryId);
+    item.item = name;
+    item.unit = QStringLiteral("pc");
+    return item;
+}
+
+void StockCatalogIndexTest::testShortTextMatchesWordPrefixes()
+{
+    StockCatalogIndex index;
+    index.insert(item(1, 1, "Coca Cola"));
+    index.insert(item(2, 1, "Pepsi"));
+    index.insert(item(3, 2, "Cocoa Powder"));
+
+    QCOMPARE(index.search("co"), QVector<int>({ 1, 3 }));
+    QCOMPARE(index.search("CO"), QVector<int>({ 1, 3 }));
+    QCOMPARE(index.search("p"), QVector<int>({ 2, 3 }));
+
+    // STEP: Ensure text in the middle of a word is not matched when it is shorter than a trigram.
+    QCOMPARE(index.search("ps"), QVector<int>());
+}
+
+void StockCatalogIndexTest::testLongTextMatchesSubstrings()
+{
+    StockCatalogIndex index;
+    index.insert(item(1, 1, "Coca Cola"));
+    index.insert(item(2, 1, "Pepsi"));
+    index.insert(item(3, 2, "Cocoa Powder"));
+
+    QCOMPARE(index.search("eps"), QVector<int>({ 2 }));
+    QCOMPARE(index.search("coc"), QVector<int>({ 1, 3 }));
+    QCOMPARE(index.search("a cola"), QVector<int>({ 1 }));
+    QCOMPARE(index.search("  Coca   COLA "), QVector<int>({ 1 }));
+
+    // STEP: Ensure names that share every trigram with the text, but not the text itself, are not matched.
+    index.insert(item(4, 1, "abcd bcde"));
+    QCOMPARE(index.search("abcde"), QVector<int>());
+    QCOMPARE(index.search("zzz"), QVector<int>());
+}
+
+void StockCatalogIndexTest::testSearchByCategory()
+{
+    StockCatalogIndex index;
+    index.insert(item(1, 1, "Coca Cola"));
+    index.insert(item(2, 1, "Pepsi"));
+    index.insert(item(3, 2, "Cocoa Powder"));
+
+    QCOMPARE(index.search("coc", 2), QVector<int>({ 3 }));
+    QCOMPARE(index.search("", 1), QVector<int>({ 1, 2 }));
+    QCOMPARE(index.search("coc", 3), QVector<int>());
+}
+
+void StockCatalogIndexTest::testInsertReplacesItem()
+{
+    StockCatalogIndex index;
+    index.insert(item(1, 1, "Coca Cola"));
+
+    StockCatalogItem renamedItem(item(1, 2, "Fanta Orange"));
+    renamedItem.quantity = 12.0;
+    index.insert(renamedItem);
+
+    QCOMPARE(index.count(), 1);
+    QCOMPARE(index.search("cola"), QVector<int>());
+    QCOMPARE(index.search("fanta"), QVector<int>({ 1 }));
+    QCOMPARE(index.item(1).categoryId, 2);
+    QCOMPARE(index.item(1).quantity, 12.0);
+}
+
+void StockCatalogIndexTest::testRemove()
+{
+    StockCatalogIndex index;
+    for (int itemId = 1; itemId <= 200; ++itemId)
+        index.insert(item(itemId, 1, QStringLiteral("Item %1").arg(itemId)));
+
+    QVERIFY(index.remove(7));
+    QVERIFY(!index.remove(7));
+    QVERIFY(!index.contains(7));
+    QCOMPARE(index.search("item 7"), QVector<int>({ 70, 71, 72, 73, 74, 75, 76, 77, 78, 79 }));
+
+    // STEP: Ensure the index is still correct once enough items are removed for it to be compacted.
+    for (int itemId = 100; itemId <= 200; ++itemId)
+        QVERIFY(index.remove(itemId));
+
+    QCOMPARE(index.count(), 98);
+    QCOMPARE(index.search("item 9"), QVector<int>({ 9, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99 }));
+    QCOMPARE(index.search("it").count(), 98);
+}
+
+void StockCatalogIndexTest::testFindByBarcode()
+{
+    StockCatalogIndex index;
+    StockCatalogItem cola(item(1, 1, "Coca Cola"));
+    cola.barcode = "5449000000996";
+    cola.quantity = 24.0;
+    index.insert(cola);
+    index.insert(item(2, 1, "Pepsi"));
+
+    QCOMPARE(index.itemIdForBarcode("5449000000996"), 1);
+    QCOMPARE(index.itemIdForBarcode(" 5449000000996\n"), 1);
+    QCOMPARE(index.item(index.itemIdForBarcode("5449000000996")).quantity, 24.0);
+    QCOMPARE(index.itemIdForBarcode(""), 0);
+    QCOMPARE(index.itemIdForBarcode("0000"), 0);
+
+    // STEP: Ensure a barcode moves with the item when it is changed.
+    cola.barcode = "5449000131805";
+    index.insert(cola);
+    QCOMPARE(index.itemIdForBarcode("5449000000996"), 0);
+    QCOMPARE(index.itemIdForBarcode("5449000131805"), 1);
+
+    QVERIFY(index.remove(1));
+    QCOMPARE(index.itemIdForBarcode("5449000131805"), 0);
+}
+
+void StockCatalogIndexTest::testSearchLargeCatalogue()
+{
+    static const QStringList words {
+        "rice", "beans", "milk", "sugar", "salt", "bread", "soap", "water", "juice", "oil"
+    };
+
+    StockCatalogIndex index;
+    for (int itemId = 1; itemId <= 50000; ++itemId)
+        index.insert(item(itemId,
+                          itemId % 20 + 1,
+                          QStringLiteral("%1 %2 %3").arg(words.at(itemId % words.count()),
+                                                          words.at(itemId / words.count() % words.count()))
+                          .arg(itemId)));
+
+    QCOMPARE(index.count(), 50000);
+
+    QElapsedTimer timer;
+    timer.start();
+    const QVector<int> &itemIds = index.search("12345");
+    const qint64 elapsed = timer.elapsed();
+
+    QCOMPARE(itemIds, QVector<int>({ 12345 }));
+    QCOMPARE(index.search("milk sugar").count(), 500);
+    QCOMPARE(index.search("mi", 3).count(), 2500);
+    qInfo() << "Searched 50000 items in" << elapsed << "ms.";
+}
+
+QTEST_MAIN(StockCatalogIndexTest)
+
+#include "tst_stockcatalogindextest.moc"
@@ -0,0 +1,169 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QCborValue>
+
+#include "network/wireformat.h"
+#include "network/serverrequest.h"
+#include "network/serverresponse.h"
+#include "database/queryresult.h"
+
+class WireFormatTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    WireFormatTest();
+
+private slots:
+    void testQueryRequestRoundTrip();
+    void testServerRequestRoundTrip();
+    void testBinaryParamsSurviveCbor();
+    void testServerResponseFromCbor();
+    void testJsonFallback();
+    void testContentTypeNegotiation();
+    void testCompression();
+private:
+    static QueryRequest createRequest();
+};
+
+WireFormatTest::WireFormatTest()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void WireFormatTest::testQueryRequestRoundTrip()
+{
+    const QueryRequest &request = createRequest();
+
+    const QueryRequest &fromJson = QueryRequest::fromJson(request.toJson());
+    QCOMPARE(fromJson.command(), request.command());
+    QCOMPARE(fromJson.queryGroup(), request.queryGroup());
+    QCOMPARE(fromJson.params().value("customer_name").toString(), QStringLiteral("Ama"));
+
+    const QueryRequest &fromCbor = QueryRequest::fromCbor(request.toCbor());
+    QCOMPARE(fromCbor.command(), request.command());
+    QCOMPARE(fromCbor.queryGroup(), request.queryGroup());
+    QCOMPARE(fromCbor.params().value("customer_name").toString(), QStringLiteral("Ama"));
+    QCOMPARE(fromCbor.params().value("items").toList().count(), 2);
+
+    // STEP: Ensure CBOR is the smaller of the two.
+    QVERIFY(request.toCbor().size() < request.toJson().size());
+}
+
+void WireFormatTest::testServerRequestRoundTrip()
+{
+    ServerRequest request(createRequest());
+    request.setIdempotencyKey(QStringLiteral("key"));
+
+    const ServerRequest &fromCbor = ServerRequest::fromCbor(request.toCbor());
+    QCOMPARE(fromCbor.queryRequest().command(), request.queryRequest().command());
+    QCOMPARE(fromCbor.idempotencyKey(), QStringLiteral("key"));
+
+    ServerRequest actionRequest;
+    actionRequest.setAction(QStringLiteral("sign_in"), { { "email", "ama@example.com" } });
+    const ServerRequest &actionFromCbor = ServerRequest::fromCbor(actionRequest.toCbor());
+    QCOMPARE(actionFromCbor.action(), QStringLiteral("sign_in"));
+    QCOMPARE(actionFromCbor.data().value("email").toString(), QStringLiteral("ama@example.com"));
+}
+
+void WireFormatTest::testBinaryParamsSurviveCbor()
+{
+    QByteArray image(256, '\0');
+    for (int i = 0; i < image.size(); ++i)
+        image[i] = static_cast<char>(i);
+
+    QueryRequest request;
+    request.setCommand(QStringLiteral("add_stock_item"),
+                       { { "image", image } },
+                       QueryRequest::QueryGroup::Stock);
+
+    // STEP: Ensure byte arrays are sent as raw bytes rather than as text.
+    QCOMPARE(QueryRequest::fromCbor(request.toCbor()).params().value("image").toByteArray(), image);
+    QVERIFY(request.toCbor().size() < image.size() * 2);
+}
+
+void WireFormatTest::testServerResponseFromCbor()
+{
+    const QVariantMap &body {
+        { "successful", false },
+        { "outcome", QVariantMap { { "record_count", 2 },
+                                   { "records", QVariantList { QVariantMap { { "item_id", 1 } },
+                                                               QVariantMap { { "item_id", 2 } } } } } },
+        { "error", QVariantMap { { "code", "" }, { "errno", 1205 }, { "message", "Lock wait timeout" } } }
+    };
+
+    const QueryResult &result = QueryResult::fromCbor(WireFormat::encode(body, WireFormat::Encoding::Cbor),
+                                                      createRequest());
+    QCOMPARE(result.request().command(), createRequest().command());
+    QCOMPARE(result.errorCode(), 1205);
+    QCOMPARE(result.errorMessage(), QStringLiteral("Lock wait timeout"));
+    QCOMPARE(result.outcome().toMap().value("records").toList().count(), 2);
+
+    const ServerResponse &response = ServerResponse::fromCbor(WireFormat::encode(body, WireFormat::Encoding::Cbor),
+                                                              createRequest());
+    QCOMPARE(response.isSuccessful(), false);
+    QCOMPARE(response.errorMessage(), QStringLiteral("Lock wait timeout"));
+    QCOMPARE(response.queryResult().outcome().toMap().value("record_count").toInt(), 2);
+}
+
+void WireFormatTest::testJsonFallback()
+{
+    const QVariantMap &body {
+        { "successful", true },
+        { "outcome", QVariantMap { { "record_count", 1 } } },
+        { "error", QVariantMap { { "errno", 1213 } } }
+    };
+
+    const QByteArray &json = WireFormat::encode(body, WireFormat::Encoding::Json);
+    QVERIFY(json.startsWith('{'));
+    QVERIFY(WireFormat::decode(json, WireFormat::Encoding::Json).value("successful").toBool());
+
+    const QueryResult &fromJson = QueryResult::fromJson(json, createRequest());
+    const QueryResult &fromCbor = QueryResult::fromCbor(WireFormat::encode(body, WireFormat::Encoding::Cbor),
+                                                        createRequest());
+    QCOMPARE(fromJson.isSuccessful(), fromCbor.isSuccessful());
+    QCOMPARE(fromJson.errorCode(), fromCbor.errorCode());
+    QCOMPARE(fromJson.outcome().toMap().value("record_count").toInt(),
+             fromCbor.outcome().toMap().value("record_count").toInt());
+}
+
+void WireFormatTest::testContentTypeNegotiation()
+{
+    QCOMPARE(WireFormat::encodingFor("application/cbor"), WireFormat::Encoding::Cbor);
+    QCOMPARE(WireFormat::encodingFor("Application/CBOR; charset=binary"), WireFormat::Encoding::Cbor);
+    QCOMPARE(WireFormat::encodingFor("application/json; charset=utf-8"), WireFormat::Encoding::Json);
+    QCOMPARE(WireFormat::encodingFor(QByteArray()), WireFormat::Encoding::Json);
+
+    QVERIFY(WireFormat::acceptHeader().startsWith(WireFormat::contentType(WireFormat::Encoding::Cbor)));
+}
+
+void WireFormatTest::testCompression()
+{
+    QVariantList records;
+    for (int i = 0; i < 200; ++i)
+        records.append(QVariantMap { { "item_id", i }, { "item", QStringLiteral("Item %1").arg(i) } });
+
+    const QByteArray &body = WireFormat::encode({ { "records", records } }, WireFormat::Encoding::Cbor);
+    const QByteArray &compressed = WireFormat::compress(body);
+
+    // STEP: Ensure the output is a bare zlib stream, as HTTP "deflate" requires.
+    QCOMPARE(static_cast<quint8>(compressed.at(0)), static_cast<quint8>(0x78));
+    QVERIFY(compressed.size() < body.size());
+    QCOMPARE(WireFormat::uncompress(compressed), body);
+}
+
+QueryRequest WireFormatTest::createRequest()
+{
+    QueryRequest request;
+    request.setCommand(QStringLiteral("add_sale_transaction"),
+                       { { "customer_name", "Ama" },
+                         { "total_cost", 1250.5 },
+                         { "items", QVariantList { QVariantMap { { "item_id", 1 }, { "quantity", 2 } },
+                                                   QVariantMap { { "item_id", 2 }, { "quantity", 1 } } } } },
+                       QueryRequest::QueryGroup::Sales);
+    return request;
+}
+
+QTEST_MAIN(WireFormatTest)
+
+#include "tst_wireformattest.moc"
@@ -0,0 +1,125 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "qmlapi/qmlstockitemmodel.h"
+#include "queryexecutors/stock.h"
+#include "mockdatabasethread.h"
+
+class ResultDispatchBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    ResultDispatchBenchmark();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testResultReachesIssuingModelOnly();
+    void benchmarkDispatch_data();
+    void benchmarkDispatch();
+private:
+    QList<QMLStockItemModel *> m_models;
+    MockDatabaseThread m_thread;
+    QueryResult m_result;
+
+    void createModels(int count);
+    QueryResult resultFor(QMLStockItemModel *receiver) const;
+};
+
+ResultDispatchBenchmark::ResultDispatchBenchmark() :
+    m_thread(&m_result)
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void ResultDispatchBenchmark::init()
+{
+}
+
+void ResultDispatchBenchmark::cleanup()
+{
+    qDeleteAll(m_models);
+    m_models.clear();
+}
+
+void ResultDispatchBenchmark::createModels(int count)
+{
+    for (int i = 0; i < count; ++i)
+        m_models.append(new QMLStockItemModel(m_thread));
+}
+
+QueryResult ResultDispatchBenchmark::resultFor(QMLStockItemModel *receiver) const
+{
+    const QVariantList items {
+        QVariantMap {
+            { "category_id", 1 },
+            { "category", "Category1" },
+            { "item_id", 1 },
+            { "item", "Item1" },
+            { "quantity", 1.0 }
+        }
+    };
+
+    QueryRequest request(receiver);
+    request.setCommand(StockQuery::ViewStockItems::COMMAND, { { "category_id", 1 } },
+                       QueryRequest::QueryGroup::Stock);
+
+    QueryResult result{ request };
+    result.setSuccessful(true);
+    result.setOutcome(QVariantMap {
+                          { "items", items },
+                          { "record_count", items.count() }
+                      });
+
+    return result;
+}
+
+void ResultDispatchBenchmark::testResultReachesIssuingModelOnly()
+{
+    createModels(3);
+    QSignalSpy issuerSpy(m_models.at(0), &QMLStockItemModel::success);
+    QSignalSpy bystanderSpy1(m_models.at(1), &QMLStockItemModel::success);
+    QSignalSpy bystanderSpy2(m_models.at(2), &QMLStockItemModel::success);
+
+    emit m_thread.resultReady(resultFor(m_models.at(0)));
+
+    QCOMPARE(issuerSpy.count(), 1);
+    QCOMPARE(bystanderSpy1.count(), 0);
+    QCOMPARE(bystanderSpy2.count(), 0);
+    QCOMPARE(m_models.at(0)->rowCount(), 1);
+    QCOMPARE(m_models.at(1)->rowCount(), 0);
+
+    // A destroyed model must never be handed a result.
+    QMLStockItemModel *model = m_models.takeLast();
+    const QueryResult lateResult{ resultFor(model) };
+    delete model;
+    emit m_thread.resultReady(lateResult);
+}
+
+void ResultDispatchBenchmark::benchmarkDispatch_data()
+{
+    QTest::addColumn<int>("modelCount");
+
+    QTest::newRow("1 model") << 1;
+    QTest::newRow("10 models") << 10;
+    QTest::newRow("100 models") << 100;
+    QTest::newRow("1000 models") << 1000;
+}
+
+void ResultDispatchBenchmark::benchmarkDispatch()
+{
+    QFETCH(int, modelCount);
+
+    createModels(modelCount);
+    const QueryResult result{ resultFor(m_models.first()) };
+
+    QBENCHMARK {
+        emit m_thread.resultReady(result);
+    }
+}
+
+QTEST_MAIN(ResultDispatchBenchmark)
+
+#include "tst_resultdispatchbenchmark.moc"
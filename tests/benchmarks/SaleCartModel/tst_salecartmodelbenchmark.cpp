@@ -0,0 +1,134 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "qmlapi/qmlsalecartmodel.h"
+#include "mockdatabasethread.h"
+#include "syntheticdata.h"
+
+class SaleCartModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    SaleCartModelBenchmark();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void benchmarkAddItem_data();
+    void benchmarkAddItem();
+    void benchmarkAddSameItem();
+    void benchmarkCalculateTotal();
+    void benchmarkData();
+    void benchmarkGet();
+private:
+    QMLSaleCartModel *m_saleCartModel;
+    MockDatabaseThread m_thread;
+    QueryResult m_result;
+
+    void fillCart(int lineCount);
+};
+
+SaleCartModelBenchmark::SaleCartModelBenchmark() :
+    m_thread(&m_result)
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void SaleCartModelBenchmark::init()
+{
+    m_saleCartModel = new QMLSaleCartModel(m_thread, this);
+}
+
+void SaleCartModelBenchmark::cleanup()
+{
+    delete m_saleCartModel;
+}
+
+void SaleCartModelBenchmark::fillCart(int lineCount)
+{
+    for (int i = 1; i <= lineCount; ++i)
+        m_saleCartModel->addItem(SyntheticData::cartItem(i));
+
+    QCOMPARE(m_saleCartModel->rowCount(), lineCount);
+}
+
+void SaleCartModelBenchmark::benchmarkAddItem_data()
+{
+    QTest::addColumn<int>("lineCount");
+
+    QTest::newRow("50 lines") << 50;
+    QTest::newRow("500 lines") << 500;
+}
+
+void SaleCartModelBenchmark::benchmarkAddItem()
+{
+    QFETCH(int, lineCount);
+
+    QVariantList items;
+    for (int i = 1; i <= lineCount; ++i)
+        items.append(SyntheticData::cartItem(i));
+
+    // NOTE: Each iteration rings up a whole cart, from empty.
+    QBENCHMARK {
+        m_saleCartModel->clearAll();
+        for (const QVariant &item : items)
+            m_saleCartModel->addItem(item.toMap());
+    }
+
+    QCOMPARE(m_saleCartModel->rowCount(), lineCount);
+}
+
+void SaleCartModelBenchmark::benchmarkAddSameItem()
+{
+    fillCart(500);
+    const QVariantMap &lastItem = SyntheticData::cartItem(500);
+
+    // NOTE: Scanning the last item again is the worst case for finding a line.
+    QBENCHMARK {
+        m_saleCartModel->addItem(lastItem);
+    }
+}
+
+void SaleCartModelBenchmark::benchmarkCalculateTotal()
+{
+    fillCart(500);
+
+    // NOTE: Changing a quantity recalculates the total of the whole cart.
+    double quantity = 1.0;
+    QBENCHMARK {
+        quantity = quantity == 1.0 ? 2.0 : 1.0;
+        m_saleCartModel->setItemQuantity(250, quantity);
+    }
+
+    QVERIFY(m_saleCartModel->totalCost() > 0.0);
+}
+
+void SaleCartModelBenchmark::benchmarkData()
+{
+    fillCart(500);
+
+    QBENCHMARK {
+        for (int row = 0; row < m_saleCartModel->rowCount(); ++row) {
+            const QModelIndex index = m_saleCartModel->index(row);
+            m_saleCartModel->data(index, QMLSaleCartModel::ItemRole);
+            m_saleCartModel->data(index, QMLSaleCartModel::QuantityRole);
+            m_saleCartModel->data(index, QMLSaleCartModel::CostRole);
+        }
+    }
+}
+
+void SaleCartModelBenchmark::benchmarkGet()
+{
+    fillCart(500);
+
+    QBENCHMARK {
+        for (int row = 0; row < m_saleCartModel->rowCount(); ++row)
+            m_saleCartModel->get(row);
+    }
+}
+
+QTEST_MAIN(SaleCartModelBenchmark)
+
+#include "tst_salecartmodelbenchmark.moc"
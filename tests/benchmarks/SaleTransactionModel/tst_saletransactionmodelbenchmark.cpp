@@ -0,0 +1,161 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "qmlapi/qmlsaletransactionmodel.h"
+#include "queryexecutors/sales.h"
+#include "mockdatabasethread.h"
+#include "syntheticdata.h"
+
+class SaleTransactionModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    SaleTransactionModelBenchmark();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void benchmarkProcessResult_data();
+    void benchmarkProcessResult();
+    void benchmarkAppendPages();
+    void benchmarkData();
+    void benchmarkGet();
+    void benchmarkFilter();
+private:
+    QMLSaleTransactionModel *m_saleTransactionModel;
+    MockDatabaseThread m_thread;
+    QueryResult m_result;
+
+    QueryResult viewSaleTransactionsResult(const QVariantList &transactions,
+                                           const QVariantMap &params = QVariantMap()) const;
+    void populate(int transactionCount);
+};
+
+SaleTransactionModelBenchmark::SaleTransactionModelBenchmark() :
+    m_thread(&m_result)
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void SaleTransactionModelBenchmark::init()
+{
+    m_saleTransactionModel = new QMLSaleTransactionModel(m_thread, this);
+}
+
+void SaleTransactionModelBenchmark::cleanup()
+{
+    delete m_saleTransactionModel;
+}
+
+QueryResult SaleTransactionModelBenchmark::viewSaleTransactionsResult(const QVariantList &transactions,
+                                                                      const QVariantMap &params) const
+{
+    QueryRequest request(m_saleTransactionModel);
+    request.setCommand(SaleQuery::ViewSaleTransactions::COMMAND, params, QueryRequest::QueryGroup::Sales);
+
+    QueryResult result{ request };
+    result.setSuccessful(true);
+    result.setOutcome(QVariantMap {
+                          { "transactions", transactions },
+                          { "record_count", transactions.count() },
+                          { "has_more", false }
+                      });
+    return result;
+}
+
+void SaleTransactionModelBenchmark::populate(int transactionCount)
+{
+    emit m_thread.resultReady(viewSaleTransactionsResult(SyntheticData::saleTransactions(transactionCount)));
+    QCOMPARE(m_saleTransactionModel->rowCount(), transactionCount);
+}
+
+void SaleTransactionModelBenchmark::benchmarkProcessResult_data()
+{
+    QTest::addColumn<int>("transactionCount");
+
+    QTest::newRow("100 transactions") << 100;
+    QTest::newRow("5k transactions") << 5000;
+    QTest::newRow("50k transactions") << 50000;
+}
+
+void SaleTransactionModelBenchmark::benchmarkProcessResult()
+{
+    QFETCH(int, transactionCount);
+
+    const QueryResult result{ viewSaleTransactionsResult(SyntheticData::saleTransactions(transactionCount)) };
+
+    QBENCHMARK {
+        emit m_thread.resultReady(result);
+    }
+
+    QCOMPARE(m_saleTransactionModel->rowCount(), transactionCount);
+}
+
+void SaleTransactionModelBenchmark::benchmarkAppendPages()
+{
+    // NOTE: Scrolling through 50k transactions, one default-sized page at a time.
+    const QVariantList &transactions = SyntheticData::saleTransactions(50000);
+    QList<QueryResult> pages;
+    for (int i = PageCursor::DEFAULT_PAGE_SIZE; i < transactions.count(); i += PageCursor::DEFAULT_PAGE_SIZE) {
+        const QVariantMap &last = transactions.at(i - 1).toMap();
+        const PageCursor cursor(last.value("created").toDateTime(), last.value("transaction_id").toInt());
+        pages.append(viewSaleTransactionsResult(transactions.mid(i, PageCursor::DEFAULT_PAGE_SIZE),
+                                                cursor.toVariantMap()));
+    }
+
+    const QueryResult firstPage{ viewSaleTransactionsResult(transactions.mid(0, PageCursor::DEFAULT_PAGE_SIZE)) };
+
+    QBENCHMARK {
+        emit m_thread.resultReady(firstPage);
+        for (const QueryResult &page : pages)
+            emit m_thread.resultReady(page);
+    }
+
+    QCOMPARE(m_saleTransactionModel->rowCount(), 50000);
+}
+
+void SaleTransactionModelBenchmark::benchmarkData()
+{
+    populate(50000);
+
+    QBENCHMARK {
+        for (int row = 0; row < m_saleTransactionModel->rowCount(); ++row) {
+            const QModelIndex index = m_saleTransactionModel->index(row, 0);
+            m_saleTransactionModel->data(index, QMLSaleTransactionModel::TransactionIdRole);
+            m_saleTransactionModel->data(index, QMLSaleTransactionModel::CustomerNameRole);
+            m_saleTransactionModel->data(index, QMLSaleTransactionModel::TotalCostRole);
+        }
+    }
+}
+
+void SaleTransactionModelBenchmark::benchmarkGet()
+{
+    populate(50000);
+
+    QBENCHMARK {
+        for (int row = 0; row < 1000; ++row)
+            m_saleTransactionModel->get(row * 50, 0);
+    }
+}
+
+void SaleTransactionModelBenchmark::benchmarkFilter()
+{
+    // NOTE: Switching between completed and suspended transactions re-queries;
+    // the mock thread answers every query with 50k transactions.
+    m_result = viewSaleTransactionsResult(SyntheticData::saleTransactions(50000));
+
+    QBENCHMARK {
+        m_saleTransactionModel->setKeys(m_saleTransactionModel->keys() == QMLSaleTransactionModel::Completed
+                                        ? QMLSaleTransactionModel::Suspended
+                                        : QMLSaleTransactionModel::Completed);
+        m_saleTransactionModel->refresh();
+    }
+
+    QCOMPARE(m_saleTransactionModel->rowCount(), 50000);
+}
+
+QTEST_MAIN(SaleTransactionModelBenchmark)
+
+#include "tst_saletransactionmodelbenchmark.moc"
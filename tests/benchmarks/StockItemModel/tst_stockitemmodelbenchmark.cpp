@@ -0,0 +1,150 @@
+#include <QtTest>
+#include <QCoreApplication>
+
+#include "qmlapi/qmlstockitemmodel.h"
+#include "queryexecutors/stock.h"
+#include "mockdatabasethread.h"
+#include "syntheticdata.h"
+
+class StockItemModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    StockItemModelBenchmark();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void benchmarkProcessResult_data();
+    void benchmarkProcessResult();
+    void benchmarkData();
+    void benchmarkGet();
+    void benchmarkFilter();
+    void benchmarkSort();
+private:
+    QMLStockItemModel *m_stockItemModel;
+    MockDatabaseThread m_thread;
+    QueryResult m_result;
+
+    QueryResult viewStockItemsResult(const QVariantList &items) const;
+    void populate(int itemCount);
+};
+
+StockItemModelBenchmark::StockItemModelBenchmark() :
+    m_thread(&m_result)
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.info=false"));
+}
+
+void StockItemModelBenchmark::init()
+{
+    m_stockItemModel = new QMLStockItemModel(m_thread, this);
+}
+
+void StockItemModelBenchmark::cleanup()
+{
+    delete m_stockItemModel;
+}
+
+QueryResult StockItemModelBenchmark::viewStockItemsResult(const QVariantList &items) const
+{
+    QueryRequest request(m_stockItemModel);
+    request.setCommand(StockQuery::ViewStockItems::COMMAND, { { "category_id", -1 } },
+                       QueryRequest::QueryGroup::Stock);
+
+    QueryResult result{ request };
+    result.setSuccessful(true);
+    result.setOutcome(QVariantMap {
+                          { "items", items },
+                          { "record_count", items.count() }
+                      });
+    return result;
+}
+
+void StockItemModelBenchmark::populate(int itemCount)
+{
+    emit m_thread.resultReady(viewStockItemsResult(SyntheticData::stockItems(itemCount)));
+    QCOMPARE(m_stockItemModel->rowCount(), itemCount);
+}
+
+void StockItemModelBenchmark::benchmarkProcessResult_data()
+{
+    QTest::addColumn<int>("itemCount");
+
+    QTest::newRow("1k items") << 1000;
+    QTest::newRow("10k items") << 10000;
+    QTest::newRow("100k items") << 100000;
+}
+
+void StockItemModelBenchmark::benchmarkProcessResult()
+{
+    QFETCH(int, itemCount);
+
+    const QueryResult result{ viewStockItemsResult(SyntheticData::stockItems(itemCount)) };
+
+    QBENCHMARK {
+        emit m_thread.resultReady(result);
+    }
+
+    QCOMPARE(m_stockItemModel->rowCount(), itemCount);
+}
+
+void StockItemModelBenchmark::benchmarkData()
+{
+    populate(100000);
+
+    // NOTE: Reads the roles a table view row binds to, for every row.
+    QBENCHMARK {
+        for (int row = 0; row < m_stockItemModel->rowCount(); ++row) {
+            const QModelIndex index = m_stockItemModel->index(row, 0);
+            m_stockItemModel->data(index, QMLStockItemModel::ItemRole);
+            m_stockItemModel->data(index, QMLStockItemModel::QuantityRole);
+            m_stockItemModel->data(index, QMLStockItemModel::RetailPriceRole);
+            m_stockItemModel->data(index, QMLStockItemModel::ImageUrlRole);
+        }
+    }
+}
+
+void StockItemModelBenchmark::benchmarkGet()
+{
+    populate(100000);
+
+    QBENCHMARK {
+        for (int row = 0; row < 1000; ++row)
+            m_stockItemModel->get(row * 100, 0);
+    }
+}
+
+void StockItemModelBenchmark::benchmarkFilter()
+{
+    // NOTE: The mock thread answers the filter query with 100k items, so this
+    // measures a whole filter round trip without the database.
+    m_result = viewStockItemsResult(SyntheticData::stockItems(100000));
+    m_stockItemModel->setFilterColumn(QMLStockItemModel::ItemColumn);
+
+    int iteration = 0;
+    QBENCHMARK {
+        m_stockItemModel->setFilterText(QStringLiteral("Item %1").arg(++iteration));
+    }
+
+    QCOMPARE(m_stockItemModel->rowCount(), 100000);
+}
+
+void StockItemModelBenchmark::benchmarkSort()
+{
+    m_result = viewStockItemsResult(SyntheticData::stockItems(100000));
+    m_stockItemModel->setSortColumn(QMLStockItemModel::ItemColumn);
+
+    QBENCHMARK {
+        m_stockItemModel->setSortOrder(m_stockItemModel->sortOrder() == Qt::AscendingOrder ? Qt::DescendingOrder
+                                                                                          : Qt::AscendingOrder);
+    }
+
+    QCOMPARE(m_stockItemModel->rowCount(), 100000);
+}
+
+QTEST_MAIN(StockItemModelBenchmark)
+
+#include "tst_stockitemmodelbenchmark.moc"
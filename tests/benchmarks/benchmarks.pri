@@ -0,0 +1,9 @@
+INCLUDEPATH += $$PWD/utils
+
+HEADERS += \
+    $$PWD/utils/syntheticdata.h
+
+# "make benchmark" writes machine-readable results next to each binary,
+# so that runs of different releases can be compared.
+benchmark.commands = ./$$TARGET -o $${TARGET}.xml,xml -o -,txt
+QMAKE_EXTRA_TARGETS += benchmark
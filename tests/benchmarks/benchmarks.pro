@@ -0,0 +1,10 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    ResultDispatch \
+    StockItemModel \
+    SaleTransactionModel \
+    SaleCartModel
+
+benchmark.CONFIG = recursive
+QMAKE_EXTRA_TARGETS += benchmark
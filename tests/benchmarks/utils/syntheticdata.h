@@ -0,0 +1,85 @@
+#ifndef SYNTHETICDATA_H
+#define SYNTHETICDATA_H
+
+#include <QVariantList>
+#include <QVariantMap>
+#include <QDateTime>
+
+// Deterministic fake rows, shaped like the outcomes of the real executors.
+namespace SyntheticData {
+const int CATEGORY_COUNT = 50;
+
+inline QVariantMap stockItem(int itemId)
+{
+    const int categoryId = itemId % CATEGORY_COUNT + 1;
+    return {
+        { "category_id", categoryId },
+        { "category", QStringLiteral("Category %1").arg(categoryId) },
+        { "item_id", itemId },
+        { "item", QStringLiteral("Item %1").arg(itemId) },
+        { "description", QStringLiteral("Description of item %1").arg(itemId) },
+        { "divisible", itemId % 2 == 0 },
+        { "image_url", QString() },
+        { "quantity", static_cast<double>(itemId % 1000) },
+        { "unit", QStringLiteral("pcs") },
+        { "unit_id", 1 },
+        { "cost_price", 10.0 + itemId % 100 },
+        { "retail_price", 12.5 + itemId % 100 },
+        { "currency", QStringLiteral("NGN") },
+        { "created", QDateTime(QDate(2020, 1, 1)).addSecs(itemId) },
+        { "last_edited", QDateTime(QDate(2020, 1, 1)).addSecs(itemId) },
+        { "user", QStringLiteral("admin") }
+    };
+}
+
+inline QVariantList stockItems(int count)
+{
+    QVariantList items;
+    items.reserve(count);
+    for (int i = 1; i <= count; ++i)
+        items.append(stockItem(i));
+
+    return items;
+}
+
+inline QVariantMap saleTransaction(int transactionId)
+{
+    const double totalCost = 100.0 + transactionId % 5000;
+    return {
+        { "transaction_id", transactionId },
+        { "client_id", transactionId % 300 + 1 },
+        { "customer_name", QStringLiteral("Customer %1").arg(transactionId % 300 + 1) },
+        { "total_cost", totalCost },
+        { "amount_paid", totalCost },
+        { "balance", 0.0 },
+        { "discount", 0.0 },
+        { "note_id", QVariant(QVariant::Int) },
+        { "note", QString() },
+        { "suspended", false },
+        { "archived", false },
+        { "created", QDateTime(QDate(2020, 1, 1)).addSecs(transactionId * 60) },
+        { "last_edited", QDateTime(QDate(2020, 1, 1)).addSecs(transactionId * 60) },
+        { "user_id", 1 }
+    };
+}
+
+inline QVariantList saleTransactions(int count)
+{
+    QVariantList transactions;
+    transactions.reserve(count);
+    for (int i = count; i >= 1; --i)
+        transactions.append(saleTransaction(i));
+
+    return transactions;
+}
+
+inline QVariantMap cartItem(int itemId)
+{
+    QVariantMap item{ stockItem(itemId) };
+    item.insert("quantity", 1000.0);
+    item.insert("unit_price", item.value("retail_price"));
+    return item;
+}
+}
+
+#endif // SYNTHETICDATA_H
@@ -353,7 +353,9 @@ CREATE TABLE purchase_item (
     item_id INT(11) NOT NULL,
     unit_price DECIMAL(19,2) NOT NULL,
     quantity DOUBLE NOT NULL,
+    unit_id INT(11) NOT NULL,
     cost DOUBLE NOT NULL,
+    discount DECIMAL(19,2) NOT NULL DEFAULT '0.00',
     currency VARCHAR(4) NOT NULL,
     note_id INT(11) DEFAULT NULL,
     archived TINYINT NOT NULL DEFAULT 0,
@@ -368,12 +370,12 @@ DROP TABLE IF EXISTS purchase_payment;
 CREATE TABLE purchase_payment (
     id INT(11) NOT NULL AUTO_INCREMENT,
     purchase_transaction_id INT(11) NOT NULL,
-    amount INT(11) NOT NULL,
+    amount DECIMAL(19,2) NOT NULL,
     method VARCHAR(20) NOT NULL,
     currency VARCHAR(4) NOT NULL,
     note_id INT(11) DEFAULT NULL,
     created DATETIME NOT NULL,
-    last_edited INT(11) NOT NULL,
+    last_edited DATETIME NOT NULL,
     user_id INT(11) NOT NULL,
     PRIMARY KEY (id)
 ) ENGINE=InnoDB DEFAULT CHARSET=utf8;
@@ -31,4 +31,26 @@ SUBDIRS += \
     QMLSaleReportModel \
     QMLPurchaseReportModel \
     QMLIncomeReportModel \
-    QMLExpenseReportModel
+    QMLExpenseReportModel \
+    QueryResultCache \
+    PendingWrites \
+    DatabaseThread \
+    RecordTable \
+    ImageCache \
+    ImageNormalizer \
+    QueryMetrics \
+    StartupProfiler \
+    QueryExecutor \
+    BulkProcedures \
+    RequestLogger \
+    NetworkThread \
+    WireFormat \
+    IndexAdvisor \
+    StockCatalogIndex \
+    DatabaseCreator \
+    ChangeLog \
+    DailyRollups \
+    Pagination \
+    ReadReplica \
+    benchmarks \
+    workload
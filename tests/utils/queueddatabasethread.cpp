@@ -0,0 +1,53 @@
+#include "queueddatabasethread.h"
+#include "database/queryresult.h"
+#include "database/queryexecutor.h"
+
+QueuedDatabaseThread::QueuedDatabaseThread(QObject *parent) :
+    DatabaseThread(nullptr, parent)
+{
+    setResultCacheCapacity(0);
+    connect(this, &QueuedDatabaseThread::execute, this, &QueuedDatabaseThread::enqueue);
+}
+
+QueuedDatabaseThread::~QueuedDatabaseThread()
+{
+    for (const PendingRequest &pendingRequest : m_pending)
+        delete pendingRequest.queryExecutor;
+}
+
+int QueuedDatabaseThread::pendingCount() const
+{
+    return m_pending.count();
+}
+
+QueryRequest QueuedDatabaseThread::pendingRequest(int index) const
+{
+    return m_pending.at(index).queryExecutor->request();
+}
+
+bool QueuedDatabaseThread::isSuperseded(int index) const
+{
+    const PendingRequest &pendingRequest = m_pending.at(index);
+    return pendingRequest.superseded && pendingRequest.superseded->loadAcquire();
+}
+
+void QueuedDatabaseThread::respond(int index, const QVariant &outcome, bool successful)
+{
+    const PendingRequest pendingRequest = m_pending.takeAt(index);
+    QueryResult result(pendingRequest.queryExecutor->request());
+    result.setSuccessful(successful);
+    result.setOutcome(outcome);
+    delete pendingRequest.queryExecutor;
+
+    releaseRequest(result, pendingRequest.ticket);
+}
+
+void QueuedDatabaseThread::enqueue(QueryExecutor *queryExecutor)
+{
+    quint64 ticket = 0;
+    QSharedPointer<QAtomicInt> superseded;
+    if (!beginRequest(queryExecutor, ticket, superseded))
+        return;
+
+    m_pending.append(PendingRequest{ queryExecutor, ticket, superseded });
+}
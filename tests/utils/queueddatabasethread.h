@@ -0,0 +1,36 @@
+#ifndef QUEUEDDATABASETHREAD_H
+#define QUEUEDDATABASETHREAD_H
+
+#include "database/databasethread.h"
+#include "database/queryrequest.h"
+
+class QueryExecutor;
+
+// Holds every request until the test answers it, so that results can be
+// returned late or out of order. Requests are tracked and released the way
+// the database pool does it, so superseded reads are dropped; the result
+// cache is off unless a test gives it a capacity.
+class QueuedDatabaseThread : public DatabaseThread
+{
+    Q_OBJECT
+public:
+    explicit QueuedDatabaseThread(QObject *parent = nullptr);
+    ~QueuedDatabaseThread() override;
+
+    int pendingCount() const;
+    QueryRequest pendingRequest(int index) const;
+    bool isSuperseded(int index) const;
+    void respond(int index, const QVariant &outcome, bool successful = true);
+private:
+    struct PendingRequest {
+        QueryExecutor *queryExecutor;
+        quint64 ticket;
+        QSharedPointer<QAtomicInt> superseded;
+    };
+
+    QList<PendingRequest> m_pending;
+
+    void enqueue(QueryExecutor *queryExecutor);
+};
+
+#endif // QUEUEDDATABASETHREAD_H
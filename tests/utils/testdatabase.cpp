@@ -0,0 +1,157 @@
+#include "testdatabase.h"
+#include "database/databasecreator.h"
+
+#include <QFile>
+#include <QSqlError>
+#include <QRegularExpression>
+#include <QProcessEnvironment>
+
+TestDatabase::TestDatabase(const QString &databaseName) :
+    m_databaseName(databaseName),
+    m_connectionName(QStringLiteral("test_database_%1").arg(databaseName)),
+    m_open(false)
+{
+    m_open = create();
+}
+
+TestDatabase::~TestDatabase()
+{
+    {
+        QSqlDatabase connection = QSqlDatabase::database(m_connectionName, false);
+        if (connection.isOpen()) {
+            QSqlQuery(connection).exec(QStringLiteral("DROP DATABASE IF EXISTS %1").arg(m_databaseName));
+            connection.close();
+        }
+    }
+
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+bool TestDatabase::isOpen() const
+{
+    return m_open;
+}
+
+QString TestDatabase::errorString() const
+{
+    return m_errorString;
+}
+
+QString TestDatabase::databaseName() const
+{
+    return m_databaseName;
+}
+
+QString TestDatabase::connectionName() const
+{
+    return m_connectionName;
+}
+
+QSqlDatabase TestDatabase::connection() const
+{
+    return QSqlDatabase::database(m_connectionName);
+}
+
+bool TestDatabase::create()
+{
+    const QProcessEnvironment &environment = QProcessEnvironment::systemEnvironment();
+    QSqlDatabase connection = QSqlDatabase::addDatabase(QStringLiteral("QMYSQL"), m_connectionName);
+    connection.setHostName(environment.value(QStringLiteral("RR_TEST_DB_HOST"), QStringLiteral("localhost")));
+    connection.setPort(environment.value(QStringLiteral("RR_TEST_DB_PORT"), QStringLiteral("3306")).toInt());
+    connection.setUserName(environment.value(QStringLiteral("RR_TEST_DB_USER"), QStringLiteral("root")));
+    connection.setPassword(environment.value(QStringLiteral("RR_TEST_DB_PASSWORD")));
+    connection.setDatabaseName(QStringLiteral("mysql"));
+    if (!connection.open()) {
+        m_errorString = connection.lastError().text();
+        return false;
+    }
+
+    if (!exec(QStringLiteral("DROP DATABASE IF EXISTS %1").arg(m_databaseName))
+            || !exec(QStringLiteral("CREATE DATABASE %1").arg(m_databaseName))
+            || !exec(QStringLiteral("USE %1").arg(m_databaseName)))
+        return false;
+
+    QFile file(QStringLiteral(RR_TEST_SCHEMA_FILE));
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_errorString = file.errorString();
+        return false;
+    }
+
+    // NOTE: The test schema creates its own database, so only its tables are used.
+    static const QRegularExpression commentPattern(QStringLiteral("^--.*$"), QRegularExpression::MultilineOption);
+    static const QRegularExpression skippedPattern(QStringLiteral("^(USE|DROP DATABASE|CREATE DATABASE|START TRANSACTION|COMMIT)\\b"),
+                                                   QRegularExpression::CaseInsensitiveOption);
+    QStringList statements;
+    for (const QString &statement : QString::fromUtf8(file.readAll()).remove(commentPattern).split(';')) {
+        if (!statement.trimmed().isEmpty() && !skippedPattern.match(statement.trimmed()).hasMatch())
+            statements.append(statement.trimmed());
+    }
+
+    return execStatements(file.fileName(), statements);
+}
+
+bool TestDatabase::run(const QString &fileName)
+{
+    QFile file(QStringLiteral(RR_SCHEMA_DIR) + fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_errorString = QStringLiteral("%1: %2").arg(file.fileName(), file.errorString());
+        return false;
+    }
+
+    const QString &sqlData = QString::fromUtf8(file.readAll())
+            .replace(QStringLiteral("###DATABASENAME###"), m_databaseName);
+    return execStatements(fileName, DatabaseCreator::splitStatements(sqlData));
+}
+
+bool TestDatabase::execStatements(const QString &fileName, const QStringList &statements)
+{
+    for (const QString &statement : statements) {
+        if (!exec(statement)) {
+            m_errorString = QStringLiteral("%1: %2").arg(fileName, m_errorString);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TestDatabase::exec(const QString &statement, const QVariantList &values)
+{
+    QSqlQuery query(connection());
+    if (values.isEmpty()) {
+        if (query.exec(statement))
+            return true;
+    } else {
+        query.prepare(statement);
+        for (const QVariant &value : values)
+            query.addBindValue(value);
+        if (query.exec())
+            return true;
+    }
+
+    m_errorString = QStringLiteral("%1 (%2)").arg(query.lastError().text(), statement);
+    return false;
+}
+
+QSqlQuery TestDatabase::query(const QString &statement, const QVariantList &values)
+{
+    // NOTE: Statements without values use the text protocol, which is what procedures that
+    // return rows are called with.
+    QSqlQuery query(connection());
+    if (!values.isEmpty()) {
+        query.prepare(statement);
+        for (const QVariant &value : values)
+            query.addBindValue(value);
+    }
+
+    if (!(values.isEmpty() ? query.exec(statement) : query.exec()))
+        m_errorString = QStringLiteral("%1 (%2)").arg(query.lastError().text(), statement);
+
+    return query;
+}
+
+QVariant TestDatabase::value(const QString &statement, const QVariantList &values)
+{
+    QSqlQuery query(this->query(statement, values));
+    return query.next() ? query.value(0) : QVariant();
+}
@@ -0,0 +1,44 @@
+#ifndef TESTDATABASE_H
+#define TESTDATABASE_H
+
+#include <QString>
+#include <QVariantList>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+// A scratch MySQL database for tests that need a real server.
+// It is created from the test schema (tests/database/databaseclient/init_updated.sql),
+// and files under src/rrcore/schema/sql are run on top of it with run(). The
+// server is read from RR_TEST_DB_HOST, RR_TEST_DB_PORT, RR_TEST_DB_USER and
+// RR_TEST_DB_PASSWORD; tests should skip when isOpen() is false.
+// The database is dropped when this object is destroyed.
+class TestDatabase
+{
+public:
+    explicit TestDatabase(const QString &databaseName);
+    ~TestDatabase();
+
+    TestDatabase(TestDatabase const &) = delete;
+    void operator=(TestDatabase const &) = delete;
+
+    bool isOpen() const;
+    QString errorString() const;
+    QString databaseName() const;
+    QString connectionName() const;
+    QSqlDatabase connection() const;
+
+    bool run(const QString &fileName);
+    bool exec(const QString &statement, const QVariantList &values = {});
+    QSqlQuery query(const QString &statement, const QVariantList &values = {});
+    QVariant value(const QString &statement, const QVariantList &values = {});
+private:
+    QString m_databaseName;
+    QString m_connectionName;
+    QString m_errorString;
+    bool m_open;
+
+    bool create();
+    bool execStatements(const QString &fileName, const QStringList &statements);
+};
+
+#endif // TESTDATABASE_H
@@ -1,5 +1,13 @@
 SOURCES += \
-    $$PWD/mockdatabasethread.cpp
+    $$PWD/mockdatabasethread.cpp \
+    $$PWD/queueddatabasethread.cpp \
+    $$PWD/testdatabase.cpp
 
 HEADERS += \
-    $$PWD/mockdatabasethread.h
+    $$PWD/mockdatabasethread.h \
+    $$PWD/queueddatabasethread.h \
+    $$PWD/testdatabase.h
+
+DEFINES += \
+    RR_SCHEMA_DIR=\\\"$$PWD/../../src/rrcore/schema/sql/\\\" \
+    RR_TEST_SCHEMA_FILE=\\\"$$PWD/../database/databaseclient/init_updated.sql\\\"
@@ -0,0 +1,29 @@
+QT       += core sql
+
+QT       -= gui
+
+TARGET = rrworkload
+CONFIG   += console
+CONFIG   -= app_bundle
+
+INCLUDEPATH += ../../src/rrcore
+
+LIBS += -L$$OUT_PWD/../../src/rrcore -lrrcore
+
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+        main.cpp \
+        seeder.cpp \
+        till.cpp \
+        workloadreport.cpp
+
+HEADERS += \
+        seeder.h \
+        till.h \
+        workloadoptions.h \
+        workloadreport.h
+
+DEFINES += SRCDIR=\\\"$$PWD/\\\"
@@ -0,0 +1,143 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QSettings>
+#include <QLoggingCategory>
+#include <algorithm>
+
+#include "database/databaseexception.h"
+#include "workloadoptions.h"
+#include "workloadreport.h"
+#include "seeder.h"
+#include "till.h"
+
+// NOTE: The same connection settings the tests/database harness uses.
+const QString DEFAULT_CONFIG_FILE(QStringLiteral(SRCDIR "../database/databaseclient/config.ini"));
+
+static bool parseMix(const QString &value, WorkloadOptions &options)
+{
+    int mix[OPERATION_COUNT] = { 0 };
+    for (const QString &entry : value.split(',', QString::SkipEmptyParts)) {
+        const QString &name = entry.section('=', 0, 0).trimmed();
+        bool ok = false;
+        const int weight = entry.section('=', 1, 1).toInt(&ok);
+        if (!ok || weight < 0)
+            return false;
+
+        int index = 0;
+        while (index < OPERATION_COUNT && operationName(static_cast<Operation>(index)) != name)
+            ++index;
+        if (index == OPERATION_COUNT)
+            return false;
+
+        mix[index] = weight;
+    }
+
+    std::copy(mix, mix + OPERATION_COUNT, options.mix);
+    return options.totalWeight() > 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("rrworkload"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Drives the rrcore executors from many simulated tills "
+                                                    "against a MySQL server and reports throughput and latency."));
+    parser.addHelpOption();
+
+    const QCommandLineOption configOption("config", "Connection settings ([mysql] section).", "file", DEFAULT_CONFIG_FILE);
+    const QCommandLineOption tillsOption("tills", "Number of simulated tills.", "count", "8");
+    const QCommandLineOption durationOption("duration", "Measured run time.", "seconds", "60");
+    const QCommandLineOption warmupOption("warmup", "Unmeasured run time before the measured run.", "seconds", "5");
+    const QCommandLineOption thinkTimeOption("think-time", "Mean pause between operations of a till.", "ms", "500");
+    const QCommandLineOption mixOption("mix", "Relative weight of each operation (sale, view, filter, purchase).",
+                                       "mix", "sale=50,view=25,filter=15,purchase=10");
+    const QCommandLineOption itemsOption("items", "Number of stock items to seed.", "count", "1000");
+    const QCommandLineOption categoriesOption("categories", "Number of categories to seed.", "count", "20");
+    const QCommandLineOption cartSizeOption("cart-size", "Maximum number of items in a sale.", "count", "5");
+    const QCommandLineOption noSeedOption("no-seed", "Reuse the existing database instead of recreating it.");
+    const QCommandLineOption jsonOption("json", "Also write the report as JSON.", "file");
+    parser.addOptions({ configOption, tillsOption, durationOption, warmupOption, thinkTimeOption, mixOption,
+                        itemsOption, categoriesOption, cartSizeOption, noSeedOption, jsonOption });
+    parser.process(app);
+
+    WorkloadOptions options;
+    QSettings settings(parser.value(configOption), QSettings::IniFormat);
+    settings.beginGroup("mysql");
+    options.hostName = settings.value("host", "localhost").toString();
+    options.port = settings.value("port", 3306).toInt();
+    options.databaseName = settings.value("database", "rr_test").toString();
+    options.userName = settings.value("user", "root").toString();
+    options.password = settings.value("password").toString();
+    settings.endGroup();
+
+    options.tillCount = qMax(1, parser.value(tillsOption).toInt());
+    options.duration = qMax(1, parser.value(durationOption).toInt());
+    options.warmup = qMax(0, parser.value(warmupOption).toInt());
+    options.thinkTime = qMax(0, parser.value(thinkTimeOption).toInt());
+    options.itemCount = qMax(1, parser.value(itemsOption).toInt());
+    options.categoryCount = qMax(1, parser.value(categoriesOption).toInt());
+    options.maxCartSize = qMax(1, parser.value(cartSizeOption).toInt());
+    options.seed = !parser.isSet(noSeedOption);
+    options.jsonPath = parser.value(jsonOption);
+
+    if (!parseMix(parser.value(mixOption), options)) {
+        qCritical("Invalid mix '%s'.", qPrintable(parser.value(mixOption)));
+        return 1;
+    }
+
+    QLoggingCategory::setFilterRules(QStringLiteral("rrcore.*.info=false\nrrcore.*.debug=false"));
+
+    QList<CatalogueItem> catalogue;
+    try {
+        Seeder seeder(options);
+        if (options.seed) {
+            seeder.createDatabase();
+            seeder.seedCatalogue();
+        }
+
+        catalogue = seeder.loadCatalogue();
+    } catch (DatabaseException &e) {
+        qCritical() << "Seeding failed:" << e;
+        return 1;
+    }
+
+    if (catalogue.isEmpty()) {
+        qCritical("No stock items to sell. Run without --no-seed first.");
+        return 1;
+    }
+
+    WorkloadReport report(options);
+    QList<Till *> tills;
+    for (int i = 0; i < options.tillCount; ++i)
+        tills.append(new Till(i + 1, options, catalogue, report, &app));
+
+    qInfo("Running %d tills for %d s (plus %d s warm-up)...", options.tillCount, options.duration, options.warmup);
+    for (Till *till : tills)
+        till->start();
+
+    QElapsedTimer clock;
+    clock.start();
+    for (Till *till : tills)
+        till->wait();
+
+    report.setElapsed(qMax<qint64>(1, clock.elapsed() - options.warmup * 1000));
+
+    QTextStream stream(stdout);
+    report.print(stream);
+
+    if (!options.jsonPath.isEmpty() && !report.write(options.jsonPath)) {
+        qCritical("Failed to write '%s'.", qPrintable(options.jsonPath));
+        return 1;
+    }
+
+    for (Till *till : tills) {
+        if (!till->isConnected())
+            return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include "seeder.h"
+#include "database/databaseexception.h"
+#include "database/preparedstatementcache.h"
+#include "queryexecutors/stock/addstockitem.h"
+#include "queryexecutors/stock/viewstockcategories.h"
+#include "queryexecutors/stock/viewstockitems.h"
+#include "schema/schema.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFile>
+#include <QRegularExpression>
+#include <QUrl>
+
+Q_LOGGING_CATEGORY(seeder, "rrworkload.seeder");
+
+const QString CONNECTION_NAME(QStringLiteral("workload_seeder"));
+const QString PROCEDURE_SEPARATOR(QStringLiteral("---"));
+const QString DATABASE_NAME_PATTERN(QStringLiteral("###DATABASENAME###"));
+const QRegularExpression COMMENTS_AND_WHITESPACE(QStringLiteral("(\\/\\*(.|\\n)*?\\*\\/|^--.*\\n|\\t|\\n)"),
+                                                 QRegularExpression::CaseInsensitiveOption
+                                                 | QRegularExpression::MultilineOption);
+
+Seeder::Seeder(const WorkloadOptions &options) :
+    m_options(options)
+{
+
+}
+
+Seeder::~Seeder()
+{
+    PreparedStatementCache::instance().clear(CONNECTION_NAME);
+    if (QSqlDatabase::contains(CONNECTION_NAME)) {
+        QSqlDatabase::database(CONNECTION_NAME, false).close();
+        QSqlDatabase::removeDatabase(CONNECTION_NAME);
+    }
+}
+
+void Seeder::createDatabase()
+{
+    if (m_options.databaseName.toLower() == QStringLiteral("mysql"))
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                QString(), QStringLiteral("Database name cannot be mysql."));
+
+    openConnection(QStringLiteral("mysql"));
+
+    QSqlQuery q(QSqlDatabase::database(CONNECTION_NAME));
+    if (!q.exec(QStringLiteral("DROP DATABASE IF EXISTS %1").arg(m_options.databaseName))
+            || !q.exec(QStringLiteral("CREATE DATABASE %1").arg(m_options.databaseName)))
+        throw DatabaseException(DatabaseError::QueryErrorCode::DatabaseInitializationFailed,
+                                q.lastError().text(),
+                                QStringLiteral("Failed to create database '%1'.").arg(m_options.databaseName));
+
+    qCInfo(seeder) << "Creating tables in" << m_options.databaseName;
+    executeScript(Schema::Common::INIT_SQL_FILE, false);
+
+    // NOTE: Local procedures depend on tables defined by the shared schema, so they are created last.
+    for (const QString &procedureDir : { Schema::Common::PROCEDURE_DIR, Schema::Common::LOCAL_PROCEDURE_DIR }) {
+        QDirIterator iter(procedureDir);
+        while (iter.hasNext()) {
+            const QString &fileName = iter.next();
+            if (QFileInfo(fileName).suffix() == QStringLiteral("sql"))
+                executeScript(fileName, true);
+        }
+    }
+
+    openConnection(m_options.databaseName);
+}
+
+void Seeder::seedCatalogue()
+{
+    if (!QSqlDatabase::database(CONNECTION_NAME, false).isOpen())
+        openConnection(m_options.databaseName);
+
+    qCInfo(seeder) << "Seeding" << m_options.itemCount << "items in" << m_options.categoryCount << "categories";
+    const int categoryCount = qMax(1, m_options.categoryCount);
+    for (int i = 0; i < m_options.itemCount; ++i) {
+        const qreal costPrice = 50 + (i % 200) * 5;
+        StockQuery::AddStockItem addStockItem(QStringLiteral("Category %1").arg(i % categoryCount + 1),
+                                              QStringLiteral("Item %1").arg(i + 1, 5, 10, QLatin1Char('0')),
+                                              QStringLiteral("Workload item #%1").arg(i + 1),
+                                              1000000,
+                                              QStringLiteral("unit"),
+                                              true,
+                                              false,
+                                              costPrice,
+                                              costPrice * 1.25,
+                                              1,
+                                              true,
+                                              QStringLiteral("NGN"),
+                                              QUrl(),
+                                              QString(),
+                                              QString(),
+                                              nullptr);
+        addStockItem.setConnectionName(CONNECTION_NAME);
+        const QueryResult &result = addStockItem.execute();
+        if (!result.isSuccessful())
+            throw DatabaseException(result.errorCode(), result.errorMessage(), result.errorUserMessage());
+    }
+}
+
+QList<CatalogueItem> Seeder::loadCatalogue()
+{
+    if (!QSqlDatabase::database(CONNECTION_NAME, false).isOpen())
+        openConnection(m_options.databaseName);
+
+    StockQuery::ViewStockCategories viewStockCategories(Qt::AscendingOrder, false, nullptr);
+    viewStockCategories.setConnectionName(CONNECTION_NAME);
+
+    QList<CatalogueItem> catalogue;
+    const QVariantList &categories = viewStockCategories.execute().outcome().toMap().value("categories").toList();
+    for (const QVariant &category : categories) {
+        StockQuery::ViewStockItems viewStockItems(category.toMap().value("category_id").toInt(),
+                                                  Qt::AscendingOrder,
+                                                  nullptr);
+        viewStockItems.setConnectionName(CONNECTION_NAME);
+
+        const QVariantList &items = viewStockItems.execute().outcome().toMap().value("items").toList();
+        for (const QVariant &item : items) {
+            const QVariantMap &itemRecord = item.toMap();
+            catalogue.append(CatalogueItem {
+                                 itemRecord.value("category_id").toInt(),
+                                 itemRecord.value("item_id").toInt(),
+                                 itemRecord.value("unit_id").toInt(),
+                                 itemRecord.value("item").toString(),
+                                 itemRecord.value("cost_price").toDouble(),
+                                 itemRecord.value("retail_price").toDouble()
+                             });
+        }
+    }
+
+    qCInfo(seeder) << "Loaded" << catalogue.count() << "items from" << categories.count() << "categories";
+    return catalogue;
+}
+
+void Seeder::openConnection(const QString &databaseName)
+{
+    PreparedStatementCache::instance().clear(CONNECTION_NAME);
+
+    QSqlDatabase connection = QSqlDatabase::contains(CONNECTION_NAME)
+            ? QSqlDatabase::database(CONNECTION_NAME, false)
+            : QSqlDatabase::addDatabase(QStringLiteral("QMYSQL"), CONNECTION_NAME);
+    if (connection.isOpen())
+        connection.close();
+
+    connection.setHostName(m_options.hostName);
+    connection.setPort(m_options.port);
+    connection.setUserName(m_options.userName);
+    connection.setPassword(m_options.password);
+    connection.setDatabaseName(databaseName);
+
+    if (!connection.open())
+        throw DatabaseException(DatabaseError::QueryErrorCode::ConnectToTestDatabaseFailed,
+                                connection.lastError().text(),
+                                QStringLiteral("Failed to connect to '%1' on %2:%3.")
+                                .arg(databaseName, m_options.hostName).arg(m_options.port));
+}
+
+void Seeder::executeScript(const QString &fileName, bool procedures)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+        throw DatabaseException(DatabaseError::QueryErrorCode::RunSqlOnTestDatabaseFailed,
+                                file.errorString(),
+                                QStringLiteral("Failed to open '%1'.").arg(fileName));
+
+    QString sqlData = QString::fromUtf8(file.readAll()).replace(DATABASE_NAME_PATTERN, m_options.databaseName);
+
+    // NOTE: Procedure bodies contain semicolons, so procedure files are split on their own
+    // separator before comments are stripped (the separator looks like a comment).
+    QStringList statements;
+    if (procedures)
+        statements = sqlData.split(PROCEDURE_SEPARATOR);
+    else
+        statements = sqlData.replace(COMMENTS_AND_WHITESPACE, QStringLiteral(" ")).split(';');
+
+    QSqlQuery q(QSqlDatabase::database(CONNECTION_NAME));
+    for (QString &statement : statements) {
+        statement = statement.replace(COMMENTS_AND_WHITESPACE, QStringLiteral(" ")).trimmed();
+        if (statement.isEmpty())
+            continue;
+
+        if (!q.exec(statement))
+            throw DatabaseException(DatabaseError::QueryErrorCode::RunSqlOnTestDatabaseFailed,
+                                    q.lastError().text(),
+                                    QStringLiteral("Failed to execute '%1' from %2.").arg(statement.left(80), fileName));
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef SEEDER_H
+#define SEEDER_H
+
+#include <QString>
+#include <QList>
+#include <QLoggingCategory>
+#include "workloadoptions.h"
+
+struct CatalogueItem
+{
+    int categoryId;
+    int itemId;
+    int unitId;
+    QString item;
+    qreal costPrice;
+    qreal retailPrice;
+};
+
+// Creates the database from the schema that tests/database loads (the shared
+// init script plus every stored procedure rrcore ships) and fills it with a
+// stock catalogue through the same executors the application uses.
+class Seeder
+{
+public:
+    explicit Seeder(const WorkloadOptions &options);
+    ~Seeder();
+
+    void createDatabase(); // throws DatabaseException!
+    void seedCatalogue(); // throws DatabaseException!
+    QList<CatalogueItem> loadCatalogue(); // throws DatabaseException!
+private:
+    const WorkloadOptions &m_options;
+
+    void openConnection(const QString &databaseName); // throws DatabaseException!
+    void executeScript(const QString &fileName, bool procedures); // throws DatabaseException!
+};
+
+Q_DECLARE_LOGGING_CATEGORY(seeder);
+
+#endif // SEEDER_H
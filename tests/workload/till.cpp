@@ -0,0 +1,233 @@
+#include "till.h"
+#include "workloadreport.h"
+#include "database/databaseexception.h"
+#include "database/preparedstatementcache.h"
+#include "queryexecutors/sales/addsaletransaction.h"
+#include "queryexecutors/purchase/addpurchasetransaction.h"
+#include "queryexecutors/stock/viewstockitems.h"
+#include "queryexecutors/stock/filterstockitems.h"
+#include "utility/saleutils.h"
+#include "utility/purchaseutils.h"
+#include "utility/stockutils.h"
+
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QScopedPointer>
+#include <cmath>
+
+Q_LOGGING_CATEGORY(till, "rrworkload.till");
+
+Till::Till(int number,
+           const WorkloadOptions &options,
+           const QList<CatalogueItem> &catalogue,
+           WorkloadReport &report,
+           QObject *parent) :
+    QThread(parent),
+    m_number(number),
+    m_options(options),
+    m_catalogue(catalogue),
+    m_report(report),
+    m_random(static_cast<quint32>(number)),
+    m_connectionName(QStringLiteral("workload_till_%1").arg(number)),
+    m_connected(false)
+{
+
+}
+
+bool Till::isConnected() const
+{
+    return m_connected;
+}
+
+void Till::run()
+{
+    if (!openConnection())
+        return;
+
+    const qint64 warmup = m_options.warmup * 1000;
+    const qint64 end = warmup + m_options.duration * 1000;
+
+    QElapsedTimer clock;
+    clock.start();
+
+    while (clock.elapsed() < end) {
+        const Operation operation = nextOperation();
+        QScopedPointer<QueryExecutor> queryExecutor(createExecutor(operation));
+        queryExecutor->setConnectionName(m_connectionName);
+
+        int errorCode = 0;
+        QElapsedTimer timer;
+        timer.start();
+
+        try {
+            const QueryResult &result = queryExecutor->execute();
+            if (!result.isSuccessful())
+                errorCode = result.errorCode() != 0 ? result.errorCode() : -1;
+        } catch (DatabaseException &e) {
+            errorCode = e.code() != 0 ? e.code() : -1;
+            qCDebug(till) << "Till" << m_number << e;
+        }
+
+        const qint64 elapsed = timer.nsecsElapsed() / 1000;
+
+        // NOTE: Operations that finish during the warm-up only prime the statement caches.
+        if (clock.elapsed() >= warmup)
+            m_report.record(operation, elapsed, errorCode);
+
+        const unsigned long pause = thinkTime();
+        if (pause > 0)
+            msleep(pause);
+    }
+
+    closeConnection();
+}
+
+bool Till::openConnection()
+{
+    QSqlDatabase connection = QSqlDatabase::addDatabase(QStringLiteral("QMYSQL"), m_connectionName);
+    connection.setHostName(m_options.hostName);
+    connection.setPort(m_options.port);
+    connection.setUserName(m_options.userName);
+    connection.setPassword(m_options.password);
+    connection.setDatabaseName(m_options.databaseName);
+
+    m_connected = connection.open();
+    if (!m_connected)
+        qCCritical(till) << "Till" << m_number << "failed to connect:" << connection.lastError().text();
+
+    return m_connected;
+}
+
+void Till::closeConnection()
+{
+    PreparedStatementCache::instance().clear(m_connectionName);
+    QSqlDatabase::database(m_connectionName, false).close();
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+Operation Till::nextOperation()
+{
+    int weight = m_random.bounded(m_options.totalWeight());
+    for (int i = 0; i < OPERATION_COUNT; ++i) {
+        if (weight < m_options.mix[i])
+            return static_cast<Operation>(i);
+        weight -= m_options.mix[i];
+    }
+
+    return Operation::Sale;
+}
+
+QueryExecutor *Till::createExecutor(Operation operation)
+{
+    switch (operation) {
+    case Operation::Sale:
+    {
+        StockItemList items;
+        qreal totalCost = 0;
+        const int itemCount = m_random.bounded(1, m_options.maxCartSize + 1);
+        for (int i = 0; i < itemCount; ++i) {
+            const CatalogueItem &catalogueItem = randomItem();
+            const double quantity = m_random.bounded(1, 4);
+            const qreal cost = quantity * catalogueItem.retailPrice;
+            items.append(StockItem{ catalogueItem.categoryId,
+                                    catalogueItem.itemId,
+                                    quantity,
+                                    catalogueItem.unitId,
+                                    catalogueItem.retailPrice,
+                                    catalogueItem.retailPrice,
+                                    cost,
+                                    cost,
+                                    QString() });
+            totalCost += cost;
+        }
+
+        return new SaleQuery::AddSaleTransaction(0,
+                                                 QStringLiteral("Till %1 customer").arg(m_number),
+                                                 -1,
+                                                 QString(),
+                                                 totalCost,
+                                                 totalCost,
+                                                 0,
+                                                 false,
+                                                 QDateTime(),
+                                                 QString(),
+                                                 QString(),
+                                                 SalePaymentList{
+                                                     SalePayment{ totalCost,
+                                                                  SalePayment::PaymentMethod::Cash,
+                                                                  QString(),
+                                                                  QStringLiteral("NGN") }
+                                                 },
+                                                 items,
+                                                 nullptr);
+    }
+    case Operation::ViewStock:
+        return new StockQuery::ViewStockItems(randomItem().categoryId,
+                                              Qt::AscendingOrder,
+                                              nullptr);
+    case Operation::FilterStock:
+    {
+        const CatalogueItem &catalogueItem = randomItem();
+        return new StockQuery::FilterStockItems(catalogueItem.categoryId,
+                                                catalogueItem.item.left(catalogueItem.item.size() - 1),
+                                                QStringLiteral("item"),
+                                                Qt::AscendingOrder,
+                                                QStringLiteral("item"),
+                                                nullptr);
+    }
+    case Operation::Purchase:
+    {
+        // NOTE: Restocks keep the sales from running the seeded quantities down.
+        const CatalogueItem &catalogueItem = randomItem();
+        const double quantity = m_random.bounded(10, 100);
+        const qreal cost = quantity * catalogueItem.costPrice;
+        PurchasePaymentList payments;
+        payments.append(PurchasePayment{ cost,
+                                         PurchasePayment::PaymentMethod::Cash,
+                                         QString(),
+                                         QStringLiteral("NGN") });
+
+        return new PurchaseQuery::AddPurchaseTransaction(0,
+                                                         -1,
+                                                         QStringLiteral("Till %1 supplier").arg(m_number),
+                                                         QString(),
+                                                         cost,
+                                                         cost,
+                                                         0,
+                                                         false,
+                                                         QDateTime(),
+                                                         QString(),
+                                                         payments,
+                                                         StockItemList{
+                                                             StockItem{ catalogueItem.categoryId,
+                                                                        catalogueItem.itemId,
+                                                                        quantity,
+                                                                        catalogueItem.unitId,
+                                                                        catalogueItem.retailPrice,
+                                                                        catalogueItem.costPrice,
+                                                                        cost,
+                                                                        cost,
+                                                                        QString() }
+                                                         },
+                                                         QString(),
+                                                         nullptr);
+    }
+    }
+
+    return nullptr;
+}
+
+const CatalogueItem &Till::randomItem()
+{
+    return m_catalogue.at(m_random.bounded(m_catalogue.count()));
+}
+
+unsigned long Till::thinkTime()
+{
+    if (m_options.thinkTime <= 0)
+        return 0;
+
+    // NOTE: Exponentially distributed pauses model cashiers arriving independently.
+    return static_cast<unsigned long>(-m_options.thinkTime * std::log(1 - m_random.generateDouble()));
+}
@@ -0,0 +1,48 @@
+#ifndef TILL_H
+#define TILL_H
+
+#include <QThread>
+#include <QRandomGenerator>
+#include <QLoggingCategory>
+#include "workloadoptions.h"
+#include "seeder.h"
+
+class QueryExecutor;
+class WorkloadReport;
+
+// A simulated cashier. Each till owns a connection and runs the executors
+// directly on its own thread, the way a DatabaseWorker would, pausing for a
+// random think time between operations.
+class Till : public QThread
+{
+    Q_OBJECT
+public:
+    explicit Till(int number,
+                  const WorkloadOptions &options,
+                  const QList<CatalogueItem> &catalogue,
+                  WorkloadReport &report,
+                  QObject *parent = nullptr);
+
+    bool isConnected() const;
+protected:
+    void run() override;
+private:
+    const int m_number;
+    const WorkloadOptions &m_options;
+    const QList<CatalogueItem> &m_catalogue;
+    WorkloadReport &m_report;
+    QRandomGenerator m_random;
+    QString m_connectionName;
+    bool m_connected;
+
+    bool openConnection();
+    void closeConnection();
+    Operation nextOperation();
+    QueryExecutor *createExecutor(Operation operation);
+    const CatalogueItem &randomItem();
+    unsigned long thinkTime();
+};
+
+Q_DECLARE_LOGGING_CATEGORY(till);
+
+#endif // TILL_H
@@ -0,0 +1,59 @@
+#ifndef WORKLOADOPTIONS_H
+#define WORKLOADOPTIONS_H
+
+#include <QString>
+#include <QStringList>
+
+enum class Operation {
+    Sale,
+    ViewStock,
+    FilterStock,
+    Purchase
+};
+
+static const int OPERATION_COUNT = static_cast<int>(Operation::Purchase) + 1;
+
+inline QString operationName(Operation operation)
+{
+    switch (operation) {
+    case Operation::Sale:
+        return QStringLiteral("sale");
+    case Operation::ViewStock:
+        return QStringLiteral("view");
+    case Operation::FilterStock:
+        return QStringLiteral("filter");
+    case Operation::Purchase:
+        return QStringLiteral("purchase");
+    }
+
+    return QString();
+}
+
+struct WorkloadOptions
+{
+    QString hostName;
+    int port = 3306;
+    QString databaseName;
+    QString userName;
+    QString password;
+
+    int tillCount = 8;
+    int duration = 60; // seconds
+    int warmup = 5; // seconds
+    int thinkTime = 500; // milliseconds, mean
+    int categoryCount = 20;
+    int itemCount = 1000;
+    int maxCartSize = 5;
+    bool seed = true;
+    int mix[OPERATION_COUNT] = { 50, 25, 15, 10 };
+    QString jsonPath;
+
+    int totalWeight() const {
+        int weight = 0;
+        for (int i = 0; i < OPERATION_COUNT; ++i)
+            weight += mix[i];
+        return weight;
+    }
+};
+
+#endif // WORKLOADOPTIONS_H
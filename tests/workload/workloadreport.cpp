@@ -0,0 +1,163 @@
+#include "workloadreport.h"
+#include "database/databaseerror.h"
+
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QSaveFile>
+#include <QDateTime>
+
+OperationStatistics::OperationStatistics() :
+    failureCount(0),
+    lockWaitCount(0),
+    deadlockCount(0)
+{
+
+}
+
+WorkloadReport::WorkloadReport(const WorkloadOptions &options) :
+    m_options(options),
+    m_elapsed(0)
+{
+
+}
+
+void WorkloadReport::record(Operation operation, qint64 microseconds, int errorCode)
+{
+    OperationStatistics &statistics = m_operations[static_cast<int>(operation)];
+    statistics.latency.record(microseconds);
+    m_latency.record(microseconds);
+
+    if (errorCode == 0)
+        return;
+
+    statistics.failureCount.fetchAndAddRelaxed(1);
+    if (errorCode == static_cast<int>(DatabaseError::MySqlErrorCode::LockWaitTimeoutError))
+        statistics.lockWaitCount.fetchAndAddRelaxed(1);
+    else if (errorCode == static_cast<int>(DatabaseError::MySqlErrorCode::DeadlockError))
+        statistics.deadlockCount.fetchAndAddRelaxed(1);
+}
+
+void WorkloadReport::setElapsed(qint64 milliseconds)
+{
+    m_elapsed = milliseconds;
+}
+
+qint64 WorkloadReport::operationCount() const
+{
+    return m_latency.count();
+}
+
+qint64 WorkloadReport::failureCount() const
+{
+    qint64 failureCount = 0;
+    for (const OperationStatistics &statistics : m_operations)
+        failureCount += statistics.failureCount.loadAcquire();
+
+    return failureCount;
+}
+
+qreal WorkloadReport::transactionsPerSecond() const
+{
+    if (m_elapsed <= 0)
+        return 0;
+
+    return (operationCount() - failureCount()) * 1000.0 / m_elapsed;
+}
+
+QJsonObject WorkloadReport::toJson() const
+{
+    qint64 lockWaitCount = 0;
+    qint64 deadlockCount = 0;
+    QJsonArray operations;
+    for (int i = 0; i < OPERATION_COUNT; ++i) {
+        const OperationStatistics &statistics = m_operations[i];
+        lockWaitCount += statistics.lockWaitCount.loadAcquire();
+        deadlockCount += statistics.deadlockCount.loadAcquire();
+
+        QJsonObject operation = statisticsToJson(statistics.latency,
+                                                 statistics.failureCount.loadAcquire(),
+                                                 statistics.lockWaitCount.loadAcquire(),
+                                                 statistics.deadlockCount.loadAcquire());
+        operation.insert("name", operationName(static_cast<Operation>(i)));
+        operations.append(operation);
+    }
+
+    QJsonObject mix;
+    for (int i = 0; i < OPERATION_COUNT; ++i)
+        mix.insert(operationName(static_cast<Operation>(i)), m_options.mix[i]);
+
+    return QJsonObject {
+        { "generated", QDateTime::currentDateTime().toString(Qt::ISODate) },
+        { "host", m_options.hostName },
+        { "database", m_options.databaseName },
+        { "tills", m_options.tillCount },
+        { "duration_ms", m_elapsed },
+        { "think_time_ms", m_options.thinkTime },
+        { "mix", mix },
+        { "tps", transactionsPerSecond() },
+        { "total", statisticsToJson(m_latency, failureCount(), lockWaitCount, deadlockCount) },
+        { "operations", operations }
+    };
+}
+
+void WorkloadReport::print(QTextStream &stream) const
+{
+    const QJsonObject &report = toJson();
+    const auto printRow = [&stream](const QString &name, const QJsonObject &statistics) {
+        stream << qSetFieldWidth(10) << left << name << right
+               << statistics.value("count").toInt()
+               << statistics.value("failure_count").toInt()
+               << statistics.value("lock_wait_count").toInt()
+               << statistics.value("deadlock_count").toInt()
+               << statistics.value("p50_ms").toDouble()
+               << statistics.value("p95_ms").toDouble()
+               << statistics.value("p99_ms").toDouble()
+               << qSetFieldWidth(0) << '\n';
+    };
+
+    stream << QStringLiteral("%1 tills for %2 s, think time %3 ms\n")
+              .arg(m_options.tillCount)
+              .arg(m_elapsed / 1000.0, 0, 'f', 1)
+              .arg(m_options.thinkTime);
+    stream << QStringLiteral("%1 transactions per second\n\n").arg(transactionsPerSecond(), 0, 'f', 1);
+
+    stream << qSetFieldWidth(10) << left << "operation" << right
+           << "count" << "failed" << "lock wait" << "deadlock" << "p50 ms" << "p95 ms" << "p99 ms"
+           << qSetFieldWidth(0) << '\n';
+    stream.setRealNumberNotation(QTextStream::FixedNotation);
+    stream.setRealNumberPrecision(2);
+
+    for (const QJsonValue &operation : report.value("operations").toArray())
+        printRow(operation.toObject().value("name").toString(), operation.toObject());
+    printRow(QStringLiteral("total"), report.value("total").toObject());
+
+    stream.flush();
+}
+
+bool WorkloadReport::write(const QString &filePath) const
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    file.write(QJsonDocument(toJson()).toJson());
+    return file.commit();
+}
+
+QJsonObject WorkloadReport::statisticsToJson(const LatencyHistogram &latency, qint64 failureCount,
+                                             qint64 lockWaitCount, qint64 deadlockCount) const
+{
+    const qint64 count = latency.count();
+    return QJsonObject {
+        { "count", count },
+        { "failure_count", failureCount },
+        { "lock_wait_count", lockWaitCount },
+        { "deadlock_count", deadlockCount },
+        { "tps", m_elapsed > 0 ? (count - failureCount) * 1000.0 / m_elapsed : 0 },
+        { "mean_ms", count > 0 ? latency.total() / 1000.0 / count : 0 },
+        { "p50_ms", latency.percentile(.5) / 1000.0 },
+        { "p95_ms", latency.percentile(.95) / 1000.0 },
+        { "p99_ms", latency.percentile(.99) / 1000.0 }
+    };
+}
@@ -0,0 +1,49 @@
+#ifndef WORKLOADREPORT_H
+#define WORKLOADREPORT_H
+
+#include <QString>
+#include <QJsonObject>
+#include <QAtomicInteger>
+#include "database/querymetrics.h"
+#include "workloadoptions.h"
+
+class QTextStream;
+
+struct OperationStatistics
+{
+    LatencyHistogram latency;
+    QAtomicInteger<qint64> failureCount;
+    QAtomicInteger<qint64> lockWaitCount;
+    QAtomicInteger<qint64> deadlockCount;
+
+    OperationStatistics();
+};
+
+// Shared by every till. Counters are updated atomically, so tills never wait on
+// each other to record an operation.
+class WorkloadReport
+{
+public:
+    explicit WorkloadReport(const WorkloadOptions &options);
+
+    void record(Operation operation, qint64 microseconds, int errorCode);
+    void setElapsed(qint64 milliseconds);
+
+    qint64 operationCount() const;
+    qint64 failureCount() const;
+    qreal transactionsPerSecond() const;
+
+    QJsonObject toJson() const;
+    void print(QTextStream &stream) const;
+    bool write(const QString &filePath) const;
+private:
+    const WorkloadOptions &m_options;
+    OperationStatistics m_operations[OPERATION_COUNT];
+    LatencyHistogram m_latency;
+    qint64 m_elapsed;
+
+    QJsonObject statisticsToJson(const LatencyHistogram &latency, qint64 failureCount,
+                                 qint64 lockWaitCount, qint64 deadlockCount) const;
+};
+
+#endif // WORKLOADREPORT_H